@@ -0,0 +1,154 @@
+#include <cstdio>
+
+#include "GraphicsEngine.h"
+
+#include "layer0/json/JSONdocument.h"
+#include "layer0/os/Directory.h"
+
+#include "JsonCorpus.h"
+
+using namespace std;
+
+#define NUMBER_DEEP_VALUES 4096
+#define NUMBER_LONG_STRINGS 64
+#define LONG_STRING_LENGTH (256 * 1024)
+#define NUMBER_NUMBERS (2 * 1024 * 1024)
+
+bool loadJsonCorpus(const string& directory, vector<JsonCorpusEntry>& allEntries)
+{
+	vector<string> allFileNames;
+
+	if (!Directory::findFiles(directory, ".gltf", allFileNames))
+	{
+		return false;
+	}
+
+	sort(allFileNames.begin(), allFileNames.end());
+
+	for (const string& currentFileName : allFileNames)
+	{
+		GLUSbinaryfile binaryfile;
+
+		if (!glusFileLoadBinary(currentFileName.c_str(), &binaryfile))
+		{
+			printf("Error: Could not load %s\n", currentFileName.c_str());
+
+			return false;
+		}
+
+		JsonCorpusEntry entry;
+
+		entry.name = currentFileName;
+		entry.jsonText.assign(reinterpret_cast<const char*>(binaryfile.binary), binaryfile.length);
+		entry.valid = true;
+
+		glusFileDestroyBinary(&binaryfile);
+
+		allEntries.push_back(entry);
+	}
+
+	return true;
+}
+
+static string createNestedText(int32_t depth)
+{
+	string jsonText;
+
+	for (int32_t i = 0; i < depth; i++)
+	{
+		jsonText += i % 2 == 0 ? "{\"a\":" : "[";
+	}
+
+	jsonText += "0";
+
+	for (int32_t i = depth - 1; i >= 0; i--)
+	{
+		jsonText += i % 2 == 0 ? "}" : "]";
+	}
+
+	return jsonText;
+}
+
+void createSyntheticJsonCorpus(vector<JsonCorpusEntry>& allEntries)
+{
+	JsonCorpusEntry entry;
+
+	// Values nested up to the limit of the parsers, the surrounding array included.
+
+	entry.name = "synthetic deep nesting";
+	entry.jsonText = "[";
+
+	for (int32_t i = 0; i < NUMBER_DEEP_VALUES; i++)
+	{
+		entry.jsonText += createNestedText(1 + i % (JSON_DOCUMENT_MAX_DEPTH - 1));
+		entry.jsonText += i + 1 < NUMBER_DEEP_VALUES ? ",\n" : "]\n";
+	}
+
+	entry.valid = true;
+
+	allEntries.push_back(entry);
+
+	// Without a limit, this overflows the stack of a recursive parser.
+
+	entry.name = "synthetic too deep nesting";
+	entry.jsonText = string(1000000, '[') + string(1000000, ']');
+	entry.valid = false;
+
+	allEntries.push_back(entry);
+
+	// Strings, with an escape sequence now and then.
+
+	entry.name = "synthetic long strings";
+	entry.jsonText = "{";
+
+	char buffer[64];
+
+	for (int32_t i = 0; i < NUMBER_LONG_STRINGS; i++)
+	{
+		snprintf(buffer, sizeof(buffer), "\"string_%d\": \"", i);
+
+		entry.jsonText += buffer;
+
+		for (int32_t k = 0; k < LONG_STRING_LENGTH; k++)
+		{
+			if (k % 4096 == 4095)
+			{
+				entry.jsonText += (k / 4096) % 2 == 0 ? "\\n" : "\\u00e4";
+			}
+			else
+			{
+				entry.jsonText += static_cast<char>('a' + (k * 7 + i) % 26);
+			}
+		}
+
+		entry.jsonText += i + 1 < NUMBER_LONG_STRINGS ? "\",\n" : "\"}\n";
+	}
+
+	entry.valid = true;
+
+	allEntries.push_back(entry);
+
+	// Floats and integers, like accessor bounds or vertex data written as text.
+
+	entry.name = "synthetic number array";
+	entry.jsonText = "[";
+
+	for (int32_t i = 0; i < NUMBER_NUMBERS; i++)
+	{
+		if (i % 3 == 0)
+		{
+			snprintf(buffer, sizeof(buffer), "%d", i * 37 - 1000000);
+		}
+		else
+		{
+			snprintf(buffer, sizeof(buffer), "%.7g", static_cast<float>(i) * (i % 3 == 1 ? 0.001953125f : -1.0e-7f));
+		}
+
+		entry.jsonText += buffer;
+		entry.jsonText += i + 1 < NUMBER_NUMBERS ? (i % 16 == 15 ? ",\n" : ",") : "]\n";
+	}
+
+	entry.valid = true;
+
+	allEntries.push_back(entry);
+}
@@ -0,0 +1,27 @@
+#ifndef JSONCORPUS_H_
+#define JSONCORPUS_H_
+
+#include <string>
+#include <vector>
+
+struct JsonCorpusEntry
+{
+	std::string name;
+
+	std::string jsonText;
+
+	// Text is expected to be decoded, otherwise to be rejected.
+	bool valid;
+};
+
+/**
+ * Loads all .gltf files below the directory.
+ */
+bool loadJsonCorpus(const std::string& directory, std::vector<JsonCorpusEntry>& allEntries);
+
+/**
+ * Appends large generated texts: deep nesting, long strings and huge arrays of numbers.
+ */
+void createSyntheticJsonCorpus(std::vector<JsonCorpusEntry>& allEntries);
+
+#endif /* JSONCORPUS_H_ */
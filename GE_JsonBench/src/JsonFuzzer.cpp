@@ -0,0 +1,394 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "layer0/json/JSONdecoder.h"
+#include "layer0/json/JSONdocument.h"
+#include "layer0/json/JSONencoder.h"
+#include "layer0/json/JSONreader.h"
+#include "layer0/json/JSONstringSink.h"
+#include "layer0/json/JSONstructuralIndex.h"
+#include "layer0/json/JSONtokenizer.h"
+#include "layer0/json/JSONwriter.h"
+
+#include "JsonFuzzer.h"
+
+using namespace std;
+
+/**
+ * Records the events of a JSONreader as text, so two reads can be compared.
+ */
+class RecordingHandler : public JSONhandler
+{
+
+public:
+
+	string events;
+
+	RecordingHandler() : JSONhandler(), events()
+	{
+	}
+
+	void record(char type, const void* data, size_t length)
+	{
+		uint32_t size = static_cast<uint32_t>(length);
+
+		events += type;
+		events.append(reinterpret_cast<const char*>(&size), sizeof(size));
+		events.append(reinterpret_cast<const char*>(data), length);
+	}
+
+	virtual bool beginObject() { record('{', nullptr, 0); return true; }
+
+	virtual bool key(const std::string& key) { record('k', key.data(), key.length()); return true; }
+
+	virtual bool endObject() { record('}', nullptr, 0); return true; }
+
+	virtual bool beginArray() { record('[', nullptr, 0); return true; }
+
+	virtual bool endArray() { record(']', nullptr, 0); return true; }
+
+	virtual bool stringValue(const std::string& value) { record('s', value.data(), value.length()); return true; }
+
+	virtual bool floatValue(float value) { record('f', &value, sizeof(value)); return true; }
+
+	virtual bool integerValue(std::int32_t value) { record('i', &value, sizeof(value)); return true; }
+
+	virtual bool trueValue() { record('t', nullptr, 0); return true; }
+
+	virtual bool falseValue() { record('F', nullptr, 0); return true; }
+
+	virtual bool nullValue() { record('n', nullptr, 0); return true; }
+
+};
+
+static bool isEqualTokenized(const char* begin, const char* end, JSONscanKernel kernel)
+{
+	JSONstructuralIndex index;
+
+	// If no index can be built, the parsers scan the text.
+	if (!index.build(begin, end, kernel))
+	{
+		return true;
+	}
+
+	JSONtokenizer scanTokenizer(begin, end);
+	JSONtokenizer indexTokenizer(begin, end, index);
+
+	JSONtoken scanToken;
+	JSONtoken indexToken;
+
+	while (true)
+	{
+		bool scanResult = scanTokenizer.next(scanToken);
+		bool indexResult = indexTokenizer.next(indexToken);
+
+		if (scanResult != indexResult || scanToken.type != indexToken.type)
+		{
+			return false;
+		}
+
+		if (!scanResult || scanToken.type == JSON_TOKEN_END)
+		{
+			return true;
+		}
+
+		if (scanToken.begin != indexToken.begin || scanToken.end != indexToken.end || scanToken.escaped != indexToken.escaped || scanToken.isFloat != indexToken.isFloat)
+		{
+			return false;
+		}
+	}
+}
+
+static bool isEqualFloat(float value0, float value1)
+{
+	return memcmp(&value0, &value1, sizeof(float)) == 0;
+}
+
+static bool isEqualNode(const JSONnode& node0, const JSONnode& node1)
+{
+	// Accessing the size decodes a lazy node.
+	if (node0.size() != node1.size() || node0.getType() != node1.getType())
+	{
+		return false;
+	}
+
+	switch (node0.getType())
+	{
+		case JSON_NODE_FLOAT:
+			return isEqualFloat(node0.getFloatValue(), node1.getFloatValue());
+		case JSON_NODE_INTEGER:
+			return node0.getIntegerValue() == node1.getIntegerValue();
+		case JSON_NODE_STRING:
+			return node0.getLength() == node1.getLength() && memcmp(node0.getStringValue(), node1.getStringValue(), node0.getLength()) == 0;
+		case JSON_NODE_ARRAY:
+			for (uint32_t i = 0; i < node0.size(); i++)
+			{
+				if (!isEqualNode(node0.getValueAt(i), node1.getValueAt(i)))
+				{
+					return false;
+				}
+			}
+			return true;
+		case JSON_NODE_OBJECT:
+			for (uint32_t i = 0; i < node0.size(); i++)
+			{
+				const JSONkey* key0 = node0.getMemberAt(i).key;
+				const JSONkey* key1 = node1.getMemberAt(i).key;
+
+				if (key0->length != key1->length || memcmp(key0->text, key1->text, key0->length) != 0 || !isEqualNode(node0.getMemberAt(i).value, node1.getMemberAt(i).value))
+				{
+					return false;
+				}
+			}
+			return true;
+		default:
+			break;
+	}
+
+	return true;
+}
+
+/**
+ * Compares a value of the JSONdecoder with a node of the JSONdocument. Of duplicate keys, both keep the last value.
+ */
+static bool isEqualValue(const JSONvalueSP& value, const JSONnode& node)
+{
+	if (value->isJsonObject())
+	{
+		const auto& allKeyValues = dynamic_pointer_cast<JSONobject>(value)->getAllKeyValues();
+
+		if (!node.isObject() || node.size() != allKeyValues.size())
+		{
+			return false;
+		}
+
+		uint32_t i = 0;
+
+		for (auto walker = allKeyValues.begin(); walker != allKeyValues.end(); walker++, i++)
+		{
+			const string& key = walker->first->getValue();
+			const JSONmember& member = node.getMemberAt(i);
+
+			if (key.length() != member.key->length || memcmp(key.data(), member.key->text, key.length()) != 0 || !isEqualValue(walker->second, member.value))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+	else if (value->isJsonArray())
+	{
+		const auto& allValues = dynamic_pointer_cast<JSONarray>(value)->getAllValues();
+
+		if (!node.isArray() || node.size() != allValues.size())
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < node.size(); i++)
+		{
+			if (!isEqualValue(allValues[i], node.getValueAt(i)))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+	else if (value->isJsonNumber())
+	{
+		JSONnumberSP number = dynamic_pointer_cast<JSONnumber>(value);
+
+		if (number->isFloatValue())
+		{
+			return node.isFloat() && isEqualFloat(number->getFloatValue(), node.getFloatValue());
+		}
+
+		return node.getType() == JSON_NODE_INTEGER && number->getIntegerValue() == node.getIntegerValue();
+	}
+	else if (value->isJsonString())
+	{
+		const string& text = dynamic_pointer_cast<JSONstring>(value)->getValue();
+
+		return node.isString() && node.getLength() == text.length() && memcmp(node.getStringValue(), text.data(), text.length()) == 0;
+	}
+	else if (value->isJsonTrue())
+	{
+		return node.getType() == JSON_NODE_TRUE;
+	}
+	else if (value->isJsonFalse())
+	{
+		return node.getType() == JSON_NODE_FALSE;
+	}
+
+	return node.isNull();
+}
+
+static bool fail(const char* message)
+{
+	printf("Error: %s\n", message);
+
+	return false;
+}
+
+bool checkJson(const char* begin, const char* end, int32_t maxDepth)
+{
+	static const JSONscanKernel allKernels[] = {JSON_SCAN_SCALAR, JSON_SCAN_SSE2, JSON_SCAN_AVX2};
+
+	for (int32_t k = 0; k <= static_cast<int32_t>(JSONstructuralIndex::getBestKernel()); k++)
+	{
+		if (!isEqualTokenized(begin, end, allKernels[k]))
+		{
+			return fail("Tokens with structural index differ from scanned ones");
+		}
+	}
+
+	JSONdecoder decoder(maxDepth);
+	JSONvalueSP jsonValue;
+
+	bool decoderResult = decoder.decode(begin, end, jsonValue);
+
+	JSONdocument document(maxDepth);
+
+	if (document.decode(begin, end) != decoderResult)
+	{
+		return fail("JSONdocument and JSONdecoder differ in accepting the text");
+	}
+
+	if (decoderResult && !isEqualValue(jsonValue, document.getRoot()))
+	{
+		return fail("JSONdocument and JSONdecoder differ in the decoded values");
+	}
+
+	// Lazily, errors in nested objects and arrays are only found on access.
+	JSONdocument lazyDocument(maxDepth);
+
+	bool lazyResult = lazyDocument.decode(begin, end, true);
+
+	if (decoderResult && (!lazyResult || !lazyDocument.getRoot().expandAll() || lazyDocument.hasError() || !isEqualNode(document.getRoot(), lazyDocument.getRoot())))
+	{
+		return fail("Lazy and eager JSONdocument differ");
+	}
+
+	if (!decoderResult && lazyResult && (lazyDocument.getRoot().expandAll() || !lazyDocument.hasError()))
+	{
+		return fail("Lazy JSONdocument accepts an invalid text");
+	}
+
+	RecordingHandler handler;
+	JSONreader reader(handler, maxDepth);
+
+	if (reader.read(begin, end) != decoderResult)
+	{
+		return fail("JSONreader and JSONdecoder differ in accepting the text");
+	}
+
+	// Chunks of a few bytes split most of the tokens.
+	RecordingHandler chunkedHandler;
+	JSONreader chunkedReader(chunkedHandler, maxDepth);
+
+	size_t chunkSize = 1 + (end - begin) % 13;
+
+	bool chunkedResult = true;
+
+	for (const char* chunk = begin; chunk < end && chunkedResult; chunk += chunkSize)
+	{
+		chunkedResult = chunkedReader.feed(chunk, end - chunk < static_cast<ptrdiff_t>(chunkSize) ? end : chunk + chunkSize);
+	}
+
+	chunkedResult = chunkedResult && chunkedReader.finish();
+
+	if (chunkedResult != decoderResult || (decoderResult && chunkedHandler.events != handler.events))
+	{
+		return fail("JSONreader differs, if the text is fed in chunks");
+	}
+
+	if (!decoderResult)
+	{
+		return true;
+	}
+
+	// Strings with control characters and infinite numbers can not be written, otherwise the text has to decode to the
+	// same values.
+	for (int32_t pretty = 0; pretty < 2; pretty++)
+	{
+		JSONencoder encoder(pretty == 1);
+		string encodedText;
+
+		if (!encoder.encode(jsonValue, encodedText))
+		{
+			continue;
+		}
+
+		JSONdocument encodedDocument(maxDepth);
+
+		if (!encodedDocument.decode(encodedText) || !isEqualNode(document.getRoot(), encodedDocument.getRoot()))
+		{
+			return fail("Text of JSONencoder decodes to different values");
+		}
+	}
+
+	string writtenText;
+
+	JSONstringSink sink(writtenText);
+	JSONwriter writer(sink);
+	JSONreader writingReader(writer, maxDepth);
+
+	if (writingReader.read(begin, end) && writer.finish())
+	{
+		JSONdocument writtenDocument(maxDepth);
+
+		if (!writtenDocument.decode(writtenText) || !isEqualNode(document.getRoot(), writtenDocument.getRoot()))
+		{
+			return fail("Text of JSONwriter decodes to different values");
+		}
+	}
+
+	return true;
+}
+
+bool fuzzJsonFile(const string& filename)
+{
+	FILE* file = fopen(filename.c_str(), "rb");
+
+	if (!file)
+	{
+		return false;
+	}
+
+	vector<char> text(JSON_FUZZ_MAX_SIZE);
+
+	size_t length = fread(text.data(), 1, text.size(), file);
+
+	fclose(file);
+
+	if (!checkJson(text.data(), text.data() + length, JSON_FUZZ_MAX_DEPTH))
+	{
+		abort();
+	}
+
+	return true;
+}
+
+#if defined(GE_JSON_FUZZER)
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	if (size > JSON_FUZZ_MAX_SIZE)
+	{
+		return 0;
+	}
+
+	const char* begin = reinterpret_cast<const char*>(data);
+
+	if (!checkJson(begin, begin + size, JSON_FUZZ_MAX_DEPTH))
+	{
+		abort();
+	}
+
+	return 0;
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef JSONFUZZER_H_
+#define JSONFUZZER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Larger inputs only slow down fuzzing. The depth is the same for all parsers, so they reject the same texts.
+#define JSON_FUZZ_MAX_SIZE (1024 * 1024)
+#define JSON_FUZZ_MAX_DEPTH 64
+
+/**
+ * Decodes the text with all JSON parsers and compares the results: JSONdecoder, JSONdocument eager and lazy, JSONreader
+ * at once and in chunks, the tokens of each structural index kernel and the text written again by JSONencoder and
+ * JSONwriter. Returns false on the first difference and prints it.
+ */
+bool checkJson(const char* begin, const char* end, std::int32_t maxDepth);
+
+/**
+ * Checks a file like the libFuzzer entry point does, so AFL can run the benchmark executable with -fuzz @@.
+ * Aborts on a difference.
+ */
+bool fuzzJsonFile(const std::string& filename);
+
+#endif /* JSONFUZZER_H_ */
@@ -0,0 +1,334 @@
+#include "GraphicsEngine.h"
+
+#include "layer0/json/JSONdecoder.h"
+#include "layer0/json/JSONdocument.h"
+#include "layer0/json/JSONreader.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkHarness.h"
+
+#include "JsonCorpus.h"
+#include "JsonFuzzer.h"
+
+using namespace std;
+
+// Prefixes of each text, which are checked like truncated files.
+#define NUMBER_TRUNCATIONS 64
+
+/**
+ * Counts the events, so only the reader is measured.
+ */
+class CountingHandler : public JSONhandler
+{
+
+public:
+
+	std::int32_t count;
+
+	CountingHandler() : JSONhandler(), count(0)
+	{
+	}
+
+	virtual bool beginObject() { count++; return true; }
+
+	virtual bool key(const std::string&) { count++; return true; }
+
+	virtual bool endObject() { count++; return true; }
+
+	virtual bool beginArray() { count++; return true; }
+
+	virtual bool endArray() { count++; return true; }
+
+	virtual bool stringValue(const std::string&) { count++; return true; }
+
+	virtual bool floatValue(float) { count++; return true; }
+
+	virtual bool integerValue(std::int32_t) { count++; return true; }
+
+	virtual bool trueValue() { count++; return true; }
+
+	virtual bool falseValue() { count++; return true; }
+
+	virtual bool nullValue() { count++; return true; }
+
+};
+
+static void printUsage()
+{
+	printf("Usage: GE_JsonBench [-warmups n] [-samples n] [-filter group] [-directory name] [-csv filename]\n");
+	printf("       GE_JsonBench -fuzz filename ...\n");
+}
+
+static string getShortName(const string& name)
+{
+	size_t position = name.find_last_of("/\\");
+
+	return position == string::npos ? name : name.substr(position + 1);
+}
+
+static void printThroughput(const BenchmarkHarness& harness)
+{
+	const BenchmarkResult& result = harness.getResults().back();
+
+	if (result.median > 0.0)
+	{
+		// Nanoseconds per byte to megabytes per second.
+		printf("%-14s %-48s %10.2f MB/s\n", result.group.c_str(), result.name.c_str(), 1000.0 / result.median);
+	}
+}
+
+/**
+ * Checks the complete text and prefixes of it. Parsers have to agree on every prefix, like on a truncated file.
+ */
+static bool validateEntry(const JsonCorpusEntry& entry)
+{
+	const char* begin = entry.jsonText.data();
+	const char* end = entry.jsonText.data() + entry.jsonText.length();
+
+	int32_t failures = checkJson(begin, end, JSON_DOCUMENT_MAX_DEPTH) ? 0 : 1;
+
+	JSONdocument document;
+
+	failures += document.decode(begin, end) == entry.valid ? 0 : 1;
+
+	// Prefixes are taken from the start of large texts, so checking stays fast. The last one misses only a byte.
+	size_t length = entry.jsonText.length() < JSON_FUZZ_MAX_SIZE ? entry.jsonText.length() : JSON_FUZZ_MAX_SIZE;
+
+	for (int32_t i = 0; i < NUMBER_TRUNCATIONS; i++)
+	{
+		size_t truncatedLength = i + 1 < NUMBER_TRUNCATIONS ? (length * i) / NUMBER_TRUNCATIONS + i % 7 : entry.jsonText.length() - 1;
+
+		if (truncatedLength < entry.jsonText.length())
+		{
+			failures += checkJson(begin, begin + truncatedLength, JSON_DOCUMENT_MAX_DEPTH) ? 0 : 1;
+		}
+	}
+
+	printf("Validation %-40s %s (%d failures)\n", getShortName(entry.name).c_str(), failures == 0 ? "passed" : "FAILED", failures);
+
+	return failures == 0;
+}
+
+static void benchmarkEntry(BenchmarkHarness& harness, const string& group, const JsonCorpusEntry& entry)
+{
+	if (!harness.isEnabled(group) || !entry.valid)
+	{
+		return;
+	}
+
+	const char* begin = entry.jsonText.data();
+	const char* end = entry.jsonText.data() + entry.jsonText.length();
+
+	string name = getShortName(entry.name);
+
+	int32_t length = static_cast<int32_t>(entry.jsonText.length());
+
+	// Time is per byte of JSON text.
+
+	harness.run(group, name + " JSONdecoder", length, [&]()
+	{
+		JSONdecoder decoder;
+		JSONvalueSP jsonValue;
+
+		if (!decoder.decode(begin, end, jsonValue))
+		{
+			printf("Error: Could not decode %s\n", name.c_str());
+		}
+
+		harness.consume(jsonValue.get() ? 1.0f : 0.0f);
+	});
+
+	printThroughput(harness);
+
+	JSONdocument document;
+
+	harness.run(group, name + " JSONdocument", length, [&]()
+	{
+		if (!document.decode(begin, end))
+		{
+			printf("Error: Could not decode %s\n", name.c_str());
+		}
+
+		harness.consume(static_cast<float>(document.getRoot().size()));
+	});
+
+	printThroughput(harness);
+
+	// Only the top level is decoded, like when looking up a few keys of a large file.
+	harness.run(group, name + " JSONdocument lazy", length, [&]()
+	{
+		if (!document.decode(begin, end, true))
+		{
+			printf("Error: Could not decode %s\n", name.c_str());
+		}
+
+		harness.consume(static_cast<float>(document.getRoot().size()));
+	});
+
+	printThroughput(harness);
+
+	harness.run(group, name + " JSONreader", length, [&]()
+	{
+		CountingHandler handler;
+		JSONreader reader(handler);
+
+		if (!reader.read(begin, end))
+		{
+			printf("Error: Could not read %s\n", name.c_str());
+		}
+
+		harness.consume(static_cast<float>(handler.count));
+	});
+
+	printThroughput(harness);
+
+	// Allocations of one decode.
+	{
+		int64_t start = getAllocationCount();
+
+		JSONdecoder decoder;
+		JSONvalueSP jsonValue;
+
+		decoder.decode(begin, end, jsonValue);
+
+		int64_t decoderCount = getAllocationCount() - start;
+
+		start = getAllocationCount();
+
+		document.decode(begin, end);
+
+		int64_t documentCount = getAllocationCount() - start;
+
+		start = getAllocationCount();
+
+		CountingHandler handler;
+		JSONreader reader(handler);
+
+		reader.read(begin, end);
+
+		int64_t readerCount = getAllocationCount() - start;
+
+		printf("%-14s %-48s %10lld allocations\n", group.c_str(), (name + " JSONdecoder").c_str(), static_cast<long long>(decoderCount));
+		printf("%-14s %-48s %10lld allocations\n", group.c_str(), (name + " JSONdocument reused").c_str(), static_cast<long long>(documentCount));
+		printf("%-14s %-48s %10lld allocations\n", group.c_str(), (name + " JSONreader").c_str(), static_cast<long long>(readerCount));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int32_t warmups = 2;
+	int32_t samples = 11;
+	string filter = "";
+	string directory = ".";
+	string csvFilename = "";
+
+	// Files of a fuzzer, e.g. afl-fuzz -i in -o out -- GE_JsonBench -fuzz @@
+	if (argc > 2 && string(argv[1]) == "-fuzz")
+	{
+		for (int32_t i = 2; i < argc; i++)
+		{
+			if (!fuzzJsonFile(argv[i]))
+			{
+				printf("Error: Could not load %s\n", argv[i]);
+
+				return 1;
+			}
+		}
+
+		return 0;
+	}
+
+	for (int32_t i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+
+		if (i + 1 >= argc)
+		{
+			printUsage();
+
+			return 1;
+		}
+
+		if (argument == "-warmups")
+		{
+			warmups = atoi(argv[++i]);
+		}
+		else if (argument == "-samples")
+		{
+			samples = atoi(argv[++i]);
+		}
+		else if (argument == "-filter")
+		{
+			filter = argv[++i];
+		}
+		else if (argument == "-directory")
+		{
+			directory = argv[++i];
+		}
+		else if (argument == "-csv")
+		{
+			csvFilename = argv[++i];
+		}
+		else
+		{
+			printUsage();
+
+			return 1;
+		}
+	}
+
+	vector<JsonCorpusEntry> allCorpusEntries;
+
+	if (!loadJsonCorpus(directory, allCorpusEntries))
+	{
+		printf("Error: Could not search %s\n", directory.c_str());
+
+		return 1;
+	}
+
+	printf("Found %d glTF files in %s\n", static_cast<int32_t>(allCorpusEntries.size()), directory.c_str());
+
+	vector<JsonCorpusEntry> allSyntheticEntries;
+
+	createSyntheticJsonCorpus(allSyntheticEntries);
+
+	bool result = true;
+
+	for (const JsonCorpusEntry& currentEntry : allCorpusEntries)
+	{
+		result = validateEntry(currentEntry) && result;
+	}
+
+	for (const JsonCorpusEntry& currentEntry : allSyntheticEntries)
+	{
+		result = validateEntry(currentEntry) && result;
+	}
+
+	if (!result)
+	{
+		return 1;
+	}
+
+	BenchmarkHarness harness(warmups, samples, filter);
+
+	for (const JsonCorpusEntry& currentEntry : allCorpusEntries)
+	{
+		benchmarkEntry(harness, "corpus", currentEntry);
+	}
+
+	for (const JsonCorpusEntry& currentEntry : allSyntheticEntries)
+	{
+		benchmarkEntry(harness, "synthetic", currentEntry);
+	}
+
+	harness.printSummary();
+
+	if (csvFilename != "" && !harness.writeCsv(csvFilename))
+	{
+		printf("Error: Could not write %s\n", csvFilename.c_str());
+
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,560 @@
+#include "GraphicsEngine.h"
+
+#include "layer3/mesh/MeshFactory.h"
+#include "layer5/node/NodeTreeFactory.h"
+#include "layer6/model/Model.h"
+
+#include "BenchmarkHarness.h"
+
+using namespace std;
+
+#define SCENE_NAME "LoadBench"
+
+#define LEVEL_NAME "LoadBenchLevel"
+
+#define LEVEL_IMAGE_SIZE 64
+
+static int32_t warmups = 1;
+static int32_t samples = 5;
+static string filter = "";
+static string csvFilename = "";
+
+static int32_t numberImages = 128;
+static int32_t imageSize = 512;
+static int32_t numberWorkers = 0;
+static int32_t numberModels = 200;
+
+static bool benchmarkPassed = false;
+
+static void printUsage()
+{
+	printf("Usage: GE_LoadBench [-warmups n] [-samples n] [-filter group] [-images n] [-size n] [-workers n] [-models n] [-csv filename]\n");
+}
+
+/**
+ * Every image is different, so nothing is shared by accident.
+ */
+static void fillPixels(vector<uint8_t>& pixels, int32_t size, int32_t index)
+{
+	for (int32_t k = 0; k < size * size; k++)
+	{
+		pixels[k * 4 + 0] = static_cast<uint8_t>(k % size + index);
+		pixels[k * 4 + 1] = static_cast<uint8_t>(k / size + index * 3);
+		pixels[k * 4 + 2] = static_cast<uint8_t>((k * 7) ^ index);
+		pixels[k * 4 + 3] = 255;
+	}
+}
+
+/**
+ * Scene with one textured cube per image, saved as glTF with the images as TGA files.
+ */
+static bool createScene()
+{
+	char buffer[128];
+
+	GlTfEntityEncoderFactory glTFentityEncoderFactory;
+	SurfaceMaterialFactory surfaceMaterialFactory;
+	MeshFactory meshFactory;
+	NodeTreeFactory nodeTreeFactory;
+
+	vector<AnimationStackSP> allAnimStacks;
+
+	NodeSP rootNode = nodeTreeFactory.createNode(SCENE_NAME, "", MeshSP(), CameraSP(), LightSP(), allAnimStacks);
+
+	vector<uint8_t> pixels(imageSize * imageSize * 4);
+
+	for (int32_t i = 0; i < numberImages; i++)
+	{
+		sprintf(buffer, "%03d", i);
+
+		fillPixels(pixels, imageSize, i);
+
+		Texture2DSP texture = Texture2DManager::getInstance()->createTexture(string("Image_") + buffer, GL_RGBA8, imageSize, imageSize, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0], static_cast<uint32_t>(pixels.size()));
+
+		SurfaceMaterialSP surfaceMaterial = surfaceMaterialFactory.createSurfaceMaterial(string("Material_") + buffer, Color::DEFAULT_EMISSIVE, Color::DEFAULT_AMBIENT, Color::DEFAULT_DIFFUSE, texture, Color::DEFAULT_SPECULAR, 0.0f);
+
+		GLUSshape shape;
+
+		glusShapeCreateCubef(&shape, 0.5f);
+
+		MeshSP mesh = meshFactory.createMesh(string("Mesh_") + buffer, shape, surfaceMaterial);
+
+		nodeTreeFactory.createNode(string("Node_") + buffer, SCENE_NAME, mesh, CameraSP(), LightSP(), allAnimStacks);
+	}
+
+	BoundingSphere boundingSphere;
+	boundingSphere.setRadius(glusMathLengthf(0.5f, 0.5f, 0.5f));
+
+	ModelSP model = ModelSP(new Model(boundingSphere, rootNode, 0, false, false));
+
+	ModelEntitySP entity = ModelEntitySP(new ModelEntity(SCENE_NAME, model, 1.0f, 1.0f, 1.0f));
+
+	return glTFentityEncoderFactory.saveGlTfModelFile(entity, SCENE_NAME);
+}
+
+static string getLevelModelName(int32_t index)
+{
+	char buffer[128];
+
+	sprintf(buffer, "%s_%03d", LEVEL_NAME, index);
+
+	return buffer;
+}
+
+/**
+ * Level of many small models, each one a textured cube saved as its own glTF.
+ */
+static bool createLevel()
+{
+	GlTfEntityEncoderFactory glTFentityEncoderFactory;
+	SurfaceMaterialFactory surfaceMaterialFactory;
+	MeshFactory meshFactory;
+
+	vector<AnimationStackSP> allAnimStacks;
+
+	vector<uint8_t> pixels(LEVEL_IMAGE_SIZE * LEVEL_IMAGE_SIZE * 4);
+
+	for (int32_t i = 0; i < numberModels; i++)
+	{
+		string name = getLevelModelName(i);
+
+		NodeTreeFactory nodeTreeFactory;
+
+		NodeSP rootNode = nodeTreeFactory.createNode(name, "", MeshSP(), CameraSP(), LightSP(), allAnimStacks);
+
+		fillPixels(pixels, LEVEL_IMAGE_SIZE, i);
+
+		Texture2DSP texture = Texture2DManager::getInstance()->createTexture(name + "_Image", GL_RGBA8, LEVEL_IMAGE_SIZE, LEVEL_IMAGE_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0], static_cast<uint32_t>(pixels.size()));
+
+		SurfaceMaterialSP surfaceMaterial = surfaceMaterialFactory.createSurfaceMaterial(name + "_Material", Color::DEFAULT_EMISSIVE, Color::DEFAULT_AMBIENT, Color::DEFAULT_DIFFUSE, texture, Color::DEFAULT_SPECULAR, 0.0f);
+
+		GLUSshape shape;
+
+		glusShapeCreateCubef(&shape, 0.5f);
+
+		MeshSP mesh = meshFactory.createMesh(name + "_Mesh", shape, surfaceMaterial);
+
+		nodeTreeFactory.createNode(name + "_Node", name, mesh, CameraSP(), LightSP(), allAnimStacks);
+
+		BoundingSphere boundingSphere;
+		boundingSphere.setRadius(glusMathLengthf(0.5f, 0.5f, 0.5f));
+
+		ModelSP model = ModelSP(new Model(boundingSphere, rootNode, 0, false, false));
+
+		ModelEntitySP entity = ModelEntitySP(new ModelEntity(name, model, 1.0f, 1.0f, 1.0f));
+
+		if (!glTFentityEncoderFactory.saveGlTfModelFile(entity, name))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static ModelEntitySP loadScene()
+{
+	GlTfEntityDecoderFactory glTFentityDecoderFactory;
+
+	return glTFentityDecoderFactory.loadGlTfModelFile(SCENE_NAME, string(SCENE_NAME) + ".json", string("assets/") + SCENE_NAME + "/", 1.0f);
+}
+
+/**
+ * Loads from the cache. Without a cache, the scene is imported and the cache is written.
+ */
+static ModelEntitySP loadCachedScene(bool cold)
+{
+	CacheEntityFactory cacheEntityFactory;
+
+	if (cold)
+	{
+		remove((string("assets/") + SCENE_NAME + "/" + CacheEntityFactory::getCacheFileName(string(SCENE_NAME) + ".json")).c_str());
+	}
+
+	return cacheEntityFactory.loadGlTfModelFile(SCENE_NAME, string(SCENE_NAME) + ".json", string("assets/") + SCENE_NAME + "/", 1.0f);
+}
+
+/**
+ * Starts the level: a cold start imports every model and writes its cache, a warm start loads all models from their
+ * caches. Returns the number of loaded models.
+ */
+static int32_t loadLevel(bool cold)
+{
+	int32_t numberLoaded = 0;
+
+	for (int32_t i = 0; i < numberModels; i++)
+	{
+		string name = getLevelModelName(i);
+
+		string folderName = string("assets/") + name + "/";
+
+		CacheEntityFactory cacheEntityFactory;
+
+		if (cold)
+		{
+			remove((folderName + CacheEntityFactory::getCacheFileName(name + ".json")).c_str());
+		}
+
+		if (cacheEntityFactory.loadGlTfModelFile(name, name + ".json", folderName, 1.0f).get())
+		{
+			numberLoaded++;
+		}
+	}
+
+	return numberLoaded;
+}
+
+static void setNumberWorkers(int32_t number)
+{
+	WorkerManager::getInstance()->removeAllWorker();
+
+	for (int32_t i = 0; i < number; i++)
+	{
+		WorkerManager::getInstance()->addWorker();
+	}
+}
+
+/**
+ * Node order, meshes and materials have to be the same, regardless of the number of workers.
+ */
+static bool compareScenes(const ModelEntitySP& expected, const ModelEntitySP& actual)
+{
+	if (!expected.get() || !actual.get())
+	{
+		return false;
+	}
+
+	const ModelSP& expectedModel = expected->getModel();
+	const ModelSP& actualModel = actual->getModel();
+
+	if (expectedModel->getNodeCount() != actualModel->getNodeCount() || expectedModel->getBoundingSphere().getRadius() != actualModel->getBoundingSphere().getRadius())
+	{
+		return false;
+	}
+
+	for (int32_t i = 0; i < expectedModel->getNodeCount(); i++)
+	{
+		NodeSP expectedNode = expectedModel->getNodeAt(i);
+		NodeSP actualNode = actualModel->getNodeAt(i);
+
+		if (expectedNode->getName() != actualNode->getName() || (expectedNode->getMesh().get() == nullptr) != (actualNode->getMesh().get() == nullptr))
+		{
+			return false;
+		}
+
+		const MeshSP& expectedMesh = expectedNode->getMesh();
+		const MeshSP& actualMesh = actualNode->getMesh();
+
+		if (!expectedMesh.get())
+		{
+			continue;
+		}
+
+		if (expectedMesh->getNumberVertices() != actualMesh->getNumberVertices() || expectedMesh->getNumberIndices() != actualMesh->getNumberIndices() || expectedMesh->getSurfaceMaterialsCount() != actualMesh->getSurfaceMaterialsCount())
+		{
+			return false;
+		}
+
+		if (expectedMesh->getVertices() && actualMesh->getVertices() && memcmp(expectedMesh->getVertices(), actualMesh->getVertices(), expectedMesh->getNumberVertices() * 4 * sizeof(float)) != 0)
+		{
+			return false;
+		}
+
+		if (expectedMesh->getIndices() && actualMesh->getIndices() && memcmp(expectedMesh->getIndices(), actualMesh->getIndices(), expectedMesh->getNumberIndices() * sizeof(uint32_t)) != 0)
+		{
+			return false;
+		}
+
+		for (uint32_t k = 0; k < expectedMesh->getSurfaceMaterialsCount(); k++)
+		{
+			const Texture2DSP& expectedTexture = expectedMesh->getSurfaceMaterialAt(static_cast<int32_t>(k))->getDiffuseTexture();
+			const Texture2DSP& actualTexture = actualMesh->getSurfaceMaterialAt(static_cast<int32_t>(k))->getDiffuseTexture();
+
+			if ((expectedTexture.get() == nullptr) != (actualTexture.get() == nullptr))
+			{
+				return false;
+			}
+
+			if (expectedTexture.get() && expectedTexture->getIdentifier() != actualTexture->getIdentifier())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static void printLoadTime(const BenchmarkHarness& harness)
+{
+	const BenchmarkResult& result = harness.getResults().back();
+
+	// Nanoseconds to milliseconds.
+	printf("%-14s %-48s %10.2f ms\n", result.group.c_str(), result.name.c_str(), result.median / 1000000.0);
+}
+
+GLUSboolean initGame(GLUSvoid)
+{
+	// Only errors, so the log of the loader does not end up in the measurement.
+	if (!initEngine(GLUS_LOG_ERROR, 0))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!createScene())
+	{
+		printf("Error: Could not create scene\n");
+
+		return GLUS_FALSE;
+	}
+
+	printf("Created scene with %d images of %dx%d pixels\n", numberImages, imageSize, imageSize);
+
+	if (!createLevel())
+	{
+		printf("Error: Could not create level\n");
+
+		return GLUS_FALSE;
+	}
+
+	printf("Created level with %d models\n", numberModels);
+
+	//
+
+	ModelEntitySP expected = loadScene();
+
+	if (!expected.get())
+	{
+		printf("Error: Could not load scene\n");
+
+		return GLUS_FALSE;
+	}
+
+	setNumberWorkers(numberWorkers);
+
+	ModelEntitySP actual = loadScene();
+
+	benchmarkPassed = compareScenes(expected, actual);
+
+	printf("Validation %-40s %s\n", "sequential vs. parallel", benchmarkPassed ? "passed" : "FAILED");
+
+	if (!benchmarkPassed)
+	{
+		return GLUS_TRUE;
+	}
+
+	// The first load writes the cache, the second one reads it.
+	loadCachedScene(true);
+
+	actual = loadCachedScene(false);
+
+	benchmarkPassed = compareScenes(expected, actual);
+
+	printf("Validation %-40s %s\n", "imported vs. cached", benchmarkPassed ? "passed" : "FAILED");
+
+	if (!benchmarkPassed)
+	{
+		return GLUS_TRUE;
+	}
+
+	benchmarkPassed = loadLevel(true) == numberModels && loadLevel(false) == numberModels;
+
+	printf("Validation %-40s %s\n", "level cold vs. cached", benchmarkPassed ? "passed" : "FAILED");
+
+	if (!benchmarkPassed)
+	{
+		return GLUS_TRUE;
+	}
+
+	expected.reset();
+	actual.reset();
+
+	//
+
+	BenchmarkHarness harness(warmups, samples, filter);
+
+	// Textures are kept by the manager, so after the first load mainly the decoding is measured.
+	vector<int32_t> allNumberWorkers;
+	allNumberWorkers.push_back(0);
+	allNumberWorkers.push_back(numberWorkers);
+
+	for (int32_t currentNumberWorkers : allNumberWorkers)
+	{
+		if (!harness.isEnabled("load"))
+		{
+			break;
+		}
+
+		setNumberWorkers(currentNumberWorkers);
+
+		string name = currentNumberWorkers == 0 ? "sequential" : "parallel, " + to_string(currentNumberWorkers) + " workers";
+
+		harness.run("load", name, 1, [&]()
+		{
+			ModelEntitySP entity = loadScene();
+
+			harness.consume(entity.get() ? 1.0f : 0.0f);
+		});
+
+		printLoadTime(harness);
+	}
+
+	// Startup of the level: importing every model and writing its cache against loading all models from their caches.
+	if (harness.isEnabled("startup"))
+	{
+		setNumberWorkers(numberWorkers);
+
+		double allMedians[2];
+
+		for (int32_t cold = 1; cold >= 0; cold--)
+		{
+			string name = (cold ? "cold, " : "cached, ") + to_string(numberModels) + " models";
+
+			harness.run("startup", name, numberModels, [&]()
+			{
+				harness.consume(static_cast<float>(loadLevel(cold != 0)));
+			});
+
+			// Per model, so the total is the median times the number of models.
+			allMedians[cold] = harness.getResults().back().median * numberModels;
+
+			printf("%-14s %-48s %10.2f ms\n", "startup", name.c_str(), allMedians[cold] / 1000000.0);
+		}
+
+		printf("%-14s %-48s %10.2fx\n", "startup", "speedup of the cached start", allMedians[0] > 0.0 ? allMedians[1] / allMedians[0] : 0.0);
+	}
+
+	setNumberWorkers(0);
+
+	harness.printSummary();
+
+	if (csvFilename != "" && !harness.writeCsv(csvFilename))
+	{
+		printf("Error: Could not write %s\n", csvFilename.c_str());
+
+		benchmarkPassed = false;
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid reshapeGame(GLUSint width, GLUSint height)
+{
+	reshapeEngine(width, height);
+}
+
+GLUSboolean updateGame(GLUSfloat)
+{
+	// Everything is done during initialization.
+	return GLUS_FALSE;
+}
+
+GLUSvoid terminateGame(GLUSvoid)
+{
+	terminateEngine();
+}
+
+int main(int argc, char* argv[])
+{
+	for (int32_t i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+
+		if (i + 1 >= argc)
+		{
+			printUsage();
+
+			return 1;
+		}
+
+		if (argument == "-warmups")
+		{
+			warmups = atoi(argv[++i]);
+		}
+		else if (argument == "-samples")
+		{
+			samples = atoi(argv[++i]);
+		}
+		else if (argument == "-filter")
+		{
+			filter = argv[++i];
+		}
+		else if (argument == "-images")
+		{
+			numberImages = atoi(argv[++i]);
+		}
+		else if (argument == "-size")
+		{
+			imageSize = atoi(argv[++i]);
+		}
+		else if (argument == "-workers")
+		{
+			numberWorkers = atoi(argv[++i]);
+		}
+		else if (argument == "-models")
+		{
+			numberModels = atoi(argv[++i]);
+		}
+		else if (argument == "-csv")
+		{
+			csvFilename = argv[++i];
+		}
+		else
+		{
+			printUsage();
+
+			return 1;
+		}
+	}
+
+	if (numberImages < 1 || numberImages > 1000 || imageSize < 1 || numberModels < 1 || numberModels > 1000)
+	{
+		printUsage();
+
+		return 1;
+	}
+
+	// By default, one worker per core besides this thread.
+	if (numberWorkers <= 0)
+	{
+		numberWorkers = static_cast<int32_t>(thread::hardware_concurrency()) - 1;
+
+		if (numberWorkers < 1)
+		{
+			numberWorkers = 1;
+		}
+	}
+
+	EGLint eglConfigAttributes[] = {
+	        EGL_RED_SIZE, 8,
+	        EGL_GREEN_SIZE, 8,
+	        EGL_BLUE_SIZE, 8,
+	        EGL_DEPTH_SIZE, 24,
+	        EGL_STENCIL_SIZE, 8,
+	        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+	        EGL_NONE
+	};
+
+    EGLint eglContextAttributes[] = {
+    		EGL_CONTEXT_MAJOR_VERSION, 4,
+    		EGL_CONTEXT_MINOR_VERSION, 4,
+    		EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE, EGL_TRUE,
+    		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    		EGL_NONE
+    };
+
+	glusWindowSetInitFunc(::initGame);
+	glusWindowSetReshapeFunc(::reshapeGame);
+	glusWindowSetUpdateFunc(::updateGame);
+	glusWindowSetTerminateFunc(::terminateGame);
+
+	// Loading needs a context for the textures and meshes.
+	if (!glusWindowCreate("GE_LoadBench", 64, 64, GLUS_FALSE, GLUS_TRUE, eglConfigAttributes, eglContextAttributes, 0))
+	{
+		return 1;
+	}
+
+	glusWindowRun();
+
+	return benchmarkPassed ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+using namespace std;
+
+static atomic<int64_t> allocationCount(0);
+
+static void* countedAllocate(size_t size)
+{
+	allocationCount++;
+
+	void* result = malloc(size > 0 ? size : 1);
+
+	if (result == nullptr)
+	{
+		throw bad_alloc();
+	}
+
+	return result;
+}
+
+void* operator new(size_t size)
+{
+	return countedAllocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return countedAllocate(size);
+}
+
+void operator delete(void* pointer) throw()
+{
+	free(pointer);
+}
+
+void operator delete[](void* pointer) throw()
+{
+	free(pointer);
+}
+
+int64_t getAllocationCount()
+{
+	return allocationCount.load();
+}
@@ -0,0 +1,11 @@
+#ifndef ALLOCATIONCOUNTER_H_
+#define ALLOCATIONCOUNTER_H_
+
+#include <cstdint>
+
+/**
+ * Number of calls of the global operator new since program start.
+ */
+std::int64_t getAllocationCount();
+
+#endif /* ALLOCATIONCOUNTER_H_ */
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "BenchmarkHarness.h"
+
+using namespace std;
+
+BenchmarkHarness::BenchmarkHarness(int32_t warmups, int32_t samples, const string& filter) :
+	warmups(warmups), samples(max(samples, 1)), filter(filter), allResults(), sink(0.0f)
+{
+}
+
+BenchmarkHarness::~BenchmarkHarness()
+{
+}
+
+bool BenchmarkHarness::isEnabled(const string& group) const
+{
+	return filter.empty() || group.find(filter) != string::npos;
+}
+
+void BenchmarkHarness::run(const string& group, const string& name, int32_t operations, const function<void()>& function, const std::function<void()>& setup)
+{
+	if (!isEnabled(group))
+	{
+		return;
+	}
+
+	for (int32_t i = 0; i < warmups; i++)
+	{
+		if (setup)
+		{
+			setup();
+		}
+
+		function();
+	}
+
+	vector<double> allTimes(samples);
+
+	for (int32_t i = 0; i < samples; i++)
+	{
+		if (setup)
+		{
+			setup();
+		}
+
+		auto start = chrono::high_resolution_clock::now();
+
+		function();
+
+		allTimes[i] = chrono::duration<double, nano>(chrono::high_resolution_clock::now() - start).count() / static_cast<double>(max(operations, 1));
+	}
+
+	sort(allTimes.begin(), allTimes.end());
+
+	BenchmarkResult result;
+
+	result.group = group;
+	result.name = name;
+	result.operations = operations;
+	result.samples = samples;
+
+	result.minimum = allTimes[0];
+
+	if (samples % 2 == 0)
+	{
+		result.median = (allTimes[samples / 2 - 1] + allTimes[samples / 2]) * 0.5;
+	}
+	else
+	{
+		result.median = allTimes[samples / 2];
+	}
+
+	int32_t p99Index = static_cast<int32_t>(ceil(0.99 * static_cast<double>(samples))) - 1;
+
+	result.p99 = allTimes[max(p99Index, 0)];
+
+	result.mean = 0.0;
+
+	for (int32_t i = 0; i < samples; i++)
+	{
+		result.mean += allTimes[i];
+	}
+
+	result.mean /= static_cast<double>(samples);
+
+	allResults.push_back(result);
+
+	printf("%-14s %-40s median: %10.2f ns  p99: %10.2f ns  min: %10.2f ns\n", result.group.c_str(), result.name.c_str(), result.median, result.p99, result.minimum);
+}
+
+void BenchmarkHarness::consume(float value)
+{
+	sink = sink + value;
+}
+
+void BenchmarkHarness::printSummary() const
+{
+	printf("%d benchmarks, %d warmups, %d samples each\n", static_cast<int32_t>(allResults.size()), warmups, samples);
+}
+
+bool BenchmarkHarness::writeCsv(const string& filename) const
+{
+	FILE* file = fopen(filename.c_str(), "w");
+
+	if (!file)
+	{
+		return false;
+	}
+
+	fprintf(file, "group,name,operations,samples,median_ns,p99_ns,min_ns,mean_ns\n");
+
+	for (const BenchmarkResult& result : allResults)
+	{
+		fprintf(file, "%s,%s,%d,%d,%.3f,%.3f,%.3f,%.3f\n", result.group.c_str(), result.name.c_str(), result.operations, result.samples, result.median, result.p99, result.minimum, result.mean);
+	}
+
+	fclose(file);
+
+	return true;
+}
+
+const vector<BenchmarkResult>& BenchmarkHarness::getResults() const
+{
+	return allResults;
+}
@@ -0,0 +1,67 @@
+#ifndef BENCHMARKHARNESS_H_
+#define BENCHMARKHARNESS_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Times are in nanoseconds per operation.
+ */
+struct BenchmarkResult
+{
+	std::string group;
+	std::string name;
+
+	std::int32_t operations;
+	std::int32_t samples;
+
+	double minimum;
+	double median;
+	double p99;
+	double mean;
+};
+
+/**
+ * Runs a function for a number of warmup and measured samples. One call of the function is one sample and does a given number of operations.
+ */
+class BenchmarkHarness
+{
+
+private:
+
+	std::int32_t warmups;
+	std::int32_t samples;
+
+	std::string filter;
+
+	std::vector<BenchmarkResult> allResults;
+
+	volatile float sink;
+
+public:
+
+	BenchmarkHarness(std::int32_t warmups, std::int32_t samples, const std::string& filter);
+	~BenchmarkHarness();
+
+	bool isEnabled(const std::string& group) const;
+
+	/**
+	 * Setup is called before every sample and is not measured, e.g. to restore unsorted data.
+	 */
+	void run(const std::string& group, const std::string& name, std::int32_t operations, const std::function<void()>& function, const std::function<void()>& setup = std::function<void()>());
+
+	/**
+	 * Keeps the compiler from removing calculations, which results are otherwise unused.
+	 */
+	void consume(float value);
+
+	void printSummary() const;
+
+	bool writeCsv(const std::string& filename) const;
+
+	const std::vector<BenchmarkResult>& getResults() const;
+
+};
+
+#endif /* BENCHMARKHARNESS_H_ */
@@ -0,0 +1,51 @@
+#include "GraphicsEngine.h"
+
+#include "BenchmarkHarness.h"
+
+#include "FrustumBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_SPHERES 10000
+
+static float getRandom(float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+void benchmarkFrustum(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("frustum"))
+	{
+		return;
+	}
+
+	srand(1);
+
+	PerspectiveCamera camera("bench");
+
+	camera.perspective(40.0f, Viewport(0, 0, 1280, 720), 0.1f, 1000.0f);
+	camera.lookAt(Point4(0.0f, 10.0f, 50.0f), Point4(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
+
+	const ViewFrustum& viewFrustum = camera.getViewFrustum();
+
+	// Scene around the camera, so about a quarter of the spheres is visible.
+	vector<BoundingSphere> allBoundingSpheres(NUMBER_SPHERES);
+
+	for (int32_t i = 0; i < NUMBER_SPHERES; i++)
+	{
+		allBoundingSpheres[i] = BoundingSphere(Point4(getRandom(-500.0f, 500.0f), getRandom(-50.0f, 50.0f), getRandom(-500.0f, 500.0f)), getRandom(0.5f, 10.0f));
+	}
+
+	harness.run("frustum", "isVisible", NUMBER_SPHERES, [&]()
+	{
+		int32_t visible = 0;
+
+		for (int32_t i = 0; i < NUMBER_SPHERES; i++)
+		{
+			visible += viewFrustum.isVisible(allBoundingSpheres[i]) ? 1 : 0;
+		}
+
+		harness.consume(static_cast<float>(visible));
+	});
+}
@@ -0,0 +1,8 @@
+#ifndef FRUSTUMBENCHMARK_H_
+#define FRUSTUMBENCHMARK_H_
+
+class BenchmarkHarness;
+
+void benchmarkFrustum(BenchmarkHarness& harness);
+
+#endif /* FRUSTUMBENCHMARK_H_ */
@@ -0,0 +1,259 @@
+#include "GraphicsEngine.h"
+
+#include "layer0/stl/Helper.h"
+
+#include "BenchmarkHarness.h"
+
+#include "InterpolationBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_CHANNELS 256
+#define NUMBER_KEYS 64
+#define NUMBER_TIMES 100
+
+#define NUMBER_LAYER_KEYS 32
+#define NUMBER_LAYER_TIMES 1000
+
+#define LAYER_TOLERANCE 1.0e-5f
+
+static float getRandom(float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+/**
+ * Sampling as done before the kernels: The interpolator of the last key before the time interpolates the whole table.
+ */
+static float getReferenceValue(const map<float, float>& allValues, const map<float, const Interpolator*>& allInterpolators, float time)
+{
+	auto walker = less_equal_bound<float, const Interpolator*>(allInterpolators, time);
+
+	if (walker == allInterpolators.end())
+	{
+		return allValues.begin()->second;
+	}
+
+	return walker->second->interpolate(allValues, time);
+}
+
+static int32_t validateLayer(const Interpolator* allInterpolators[3])
+{
+	int32_t failures = 0;
+
+	AnimationLayer animationLayer;
+
+	// Keys are added out of order and some are overwritten, like by the importers.
+	vector<int32_t> allKeys(NUMBER_LAYER_KEYS);
+
+	for (int32_t key = 0; key < NUMBER_LAYER_KEYS; key++)
+	{
+		allKeys[key] = key;
+	}
+
+	for (int32_t key = NUMBER_LAYER_KEYS - 1; key > 0; key--)
+	{
+		swap(allKeys[key], allKeys[rand() % (key + 1)]);
+	}
+
+	for (int32_t i = 0; i < NUMBER_LAYER_KEYS + NUMBER_LAYER_KEYS / 4; i++)
+	{
+		float time = static_cast<float>(allKeys[i % NUMBER_LAYER_KEYS]) * 0.1f;
+
+		for (enum AnimationLayer::eCHANNELS_XYZ channel = AnimationLayer::X; channel <= AnimationLayer::Z; channel = static_cast<enum AnimationLayer::eCHANNELS_XYZ>(channel + 1))
+		{
+			animationLayer.addTranslationValue(channel, time, getRandom(-10.0f, 10.0f), *allInterpolators[rand() % 3]);
+			animationLayer.addRotationValue(channel, time, getRandom(-180.0f, 180.0f), *allInterpolators[rand() % 3]);
+		}
+
+		// Scaling has only keys on the y channel.
+		animationLayer.addScalingValue(AnimationLayer::Y, time, getRandom(0.5f, 2.0f), *allInterpolators[rand() % 3]);
+	}
+
+	float endTime = static_cast<float>(NUMBER_LAYER_KEYS) * 0.1f;
+
+	for (int32_t sample = 0; sample < NUMBER_LAYER_TIMES; sample++)
+	{
+		// Before the first, exactly at and after the last key.
+		float time = sample % 10 == 0 ? static_cast<float>(sample / 10 % NUMBER_LAYER_KEYS) * 0.1f : getRandom(-0.5f, endTime + 0.5f);
+
+		float translation[3] = {0.0f, 0.0f, 0.0f};
+		float rotation[3] = {0.0f, 0.0f, 0.0f};
+		float scaling[3] = {1.0f, 1.0f, 1.0f};
+
+		animationLayer.getTransformValues(translation, rotation, scaling, time);
+
+		for (enum AnimationLayer::eCHANNELS_XYZ channel = AnimationLayer::X; channel <= AnimationLayer::Z; channel = static_cast<enum AnimationLayer::eCHANNELS_XYZ>(channel + 1))
+		{
+			float referenceTranslation = getReferenceValue(animationLayer.getAllTranslationValues(channel), animationLayer.getAllTranslationInterpolators(channel), time);
+			float referenceRotation = getReferenceValue(animationLayer.getAllRotationValues(channel), animationLayer.getAllRotationInterpolators(channel), time);
+
+			if (fabsf(translation[channel] - referenceTranslation) > LAYER_TOLERANCE * 10.0f || fabsf(animationLayer.getTranslationValue(channel, time) - referenceTranslation) > LAYER_TOLERANCE * 10.0f)
+			{
+				failures++;
+			}
+
+			if (fabsf(rotation[channel] - referenceRotation) > LAYER_TOLERANCE * 180.0f || fabsf(animationLayer.getRotationValue(channel, time) - referenceRotation) > LAYER_TOLERANCE * 180.0f)
+			{
+				failures++;
+			}
+		}
+
+		float referenceScaling = getReferenceValue(animationLayer.getAllScalingValues(AnimationLayer::Y), animationLayer.getAllScalingInterpolators(AnimationLayer::Y), time);
+
+		if (scaling[0] != 1.0f || fabsf(scaling[1] - referenceScaling) > LAYER_TOLERANCE * 2.0f || scaling[2] != 1.0f || animationLayer.getScalingValue(AnimationLayer::X, time) != 1.0f)
+		{
+			failures++;
+		}
+	}
+
+	return failures;
+}
+
+static void benchmarkMode(BenchmarkHarness& harness, const string& name, const Interpolator& interpolator, InterpolationMode mode)
+{
+	vector<map<float, float> > allTables(NUMBER_CHANNELS);
+
+	vector<float> allTimes(NUMBER_CHANNELS * NUMBER_KEYS);
+	vector<float> allValues(NUMBER_CHANNELS * NUMBER_KEYS);
+	vector<float> allTangents(NUMBER_CHANNELS * NUMBER_KEYS);
+
+	vector<KeySpan> allKeySpans(NUMBER_CHANNELS);
+
+	for (int32_t channel = 0; channel < NUMBER_CHANNELS; channel++)
+	{
+		for (int32_t key = 0; key < NUMBER_KEYS; key++)
+		{
+			int32_t index = channel * NUMBER_KEYS + key;
+
+			allTimes[index] = static_cast<float>(key) * 0.1f;
+			allValues[index] = sinf(static_cast<float>(channel + key) * 0.37f);
+
+			allTables[channel][allTimes[index]] = allValues[index];
+		}
+
+		calculateHermiteTangents(&allTangents[channel * NUMBER_KEYS], &allTimes[channel * NUMBER_KEYS], &allValues[channel * NUMBER_KEYS], NUMBER_KEYS);
+
+		allKeySpans[channel].times = &allTimes[channel * NUMBER_KEYS];
+		allKeySpans[channel].values = &allValues[channel * NUMBER_KEYS];
+		allKeySpans[channel].tangents = &allTangents[channel * NUMBER_KEYS];
+		allKeySpans[channel].numberKeys = NUMBER_KEYS;
+	}
+
+	vector<float> allResults(NUMBER_CHANNELS);
+
+	float endTime = static_cast<float>(NUMBER_KEYS) * 0.1f;
+
+	// There is no virtual Hermite interpolator, so the cubic one is the reference.
+
+	harness.run("interpolation", name + " virtual", NUMBER_CHANNELS * NUMBER_TIMES, [&]()
+	{
+		for (int32_t sample = 0; sample < NUMBER_TIMES; sample++)
+		{
+			float time = endTime * static_cast<float>(sample) / static_cast<float>(NUMBER_TIMES);
+
+			for (int32_t channel = 0; channel < NUMBER_CHANNELS; channel++)
+			{
+				allResults[channel] = interpolator.interpolate(allTables[channel], time);
+			}
+
+			harness.consume(allResults[sample % NUMBER_CHANNELS]);
+		}
+	});
+
+	harness.run("interpolation", name + " kernel", NUMBER_CHANNELS * NUMBER_TIMES, [&]()
+	{
+		for (int32_t sample = 0; sample < NUMBER_TIMES; sample++)
+		{
+			float time = endTime * static_cast<float>(sample) / static_cast<float>(NUMBER_TIMES);
+
+			interpolateBatch(&allResults[0], &allKeySpans[0], NUMBER_CHANNELS, time, mode);
+
+			harness.consume(allResults[sample % NUMBER_CHANNELS]);
+		}
+	});
+}
+
+/**
+ * Keys are inserted in front of and overwrite the first key, which changes the interpolation mode of the first key.
+ */
+static int32_t validateKeyOrder()
+{
+	int32_t failures = 0;
+
+	for (int32_t order = 0; order < 3; order++)
+	{
+		AnimationLayer animationLayer;
+
+		if (order == 0)
+		{
+			animationLayer.addTranslationValue(AnimationLayer::X, 1.0f, 10.0f, LinearInterpolator::interpolator);
+			animationLayer.addTranslationValue(AnimationLayer::X, 2.0f, 20.0f, LinearInterpolator::interpolator);
+			animationLayer.addTranslationValue(AnimationLayer::X, 0.0f, 0.0f, ConstantInterpolator::interpolator);
+		}
+		else
+		{
+			animationLayer.addTranslationValue(AnimationLayer::X, 0.0f, 0.0f, LinearInterpolator::interpolator);
+			animationLayer.addTranslationValue(AnimationLayer::X, 1.0f, 10.0f, LinearInterpolator::interpolator);
+			animationLayer.addTranslationValue(AnimationLayer::X, 2.0f, 20.0f, LinearInterpolator::interpolator);
+			animationLayer.addTranslationValue(AnimationLayer::X, 0.0f, 5.0f, ConstantInterpolator::interpolator);
+
+			// Makes the channel uniform again.
+			if (order == 2)
+			{
+				animationLayer.addTranslationValue(AnimationLayer::X, 0.0f, 5.0f, LinearInterpolator::interpolator);
+			}
+		}
+
+		for (float time = -0.5f; time <= 2.5f; time += 0.25f)
+		{
+			float referenceTranslation = getReferenceValue(animationLayer.getAllTranslationValues(AnimationLayer::X), animationLayer.getAllTranslationInterpolators(AnimationLayer::X), time);
+
+			if (fabsf(animationLayer.getTranslationValue(AnimationLayer::X, time) - referenceTranslation) > LAYER_TOLERANCE * 10.0f)
+			{
+				failures++;
+			}
+		}
+	}
+
+	return failures;
+}
+
+bool validateInterpolation()
+{
+	srand(1);
+
+	int32_t failures = 0;
+
+	const Interpolator* allInterpolators[3] = {&ConstantInterpolator::interpolator, &LinearInterpolator::interpolator, &CubicInterpolator::interpolator};
+
+	// One interpolator per layer and all of them mixed in one layer.
+
+	for (int32_t i = 0; i < 3; i++)
+	{
+		const Interpolator* allSameInterpolators[3] = {allInterpolators[i], allInterpolators[i], allInterpolators[i]};
+
+		failures += validateLayer(allSameInterpolators);
+	}
+
+	failures += validateLayer(allInterpolators);
+
+	failures += validateKeyOrder();
+
+	printf("Validation %-16s %s (%d failures)\n", "animation layer", failures == 0 ? "passed" : "FAILED", failures);
+
+	return failures == 0;
+}
+
+void benchmarkInterpolation(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("interpolation"))
+	{
+		return;
+	}
+
+	benchmarkMode(harness, "constant", ConstantInterpolator::interpolator, INTERPOLATION_CONSTANT);
+	benchmarkMode(harness, "linear", LinearInterpolator::interpolator, INTERPOLATION_LINEAR);
+	benchmarkMode(harness, "cubic", CubicInterpolator::interpolator, INTERPOLATION_CUBIC);
+	benchmarkMode(harness, "hermite", CubicInterpolator::interpolator, INTERPOLATION_HERMITE);
+}
@@ -0,0 +1,10 @@
+#ifndef INTERPOLATIONBENCHMARK_H_
+#define INTERPOLATIONBENCHMARK_H_
+
+class BenchmarkHarness;
+
+bool validateInterpolation();
+
+void benchmarkInterpolation(BenchmarkHarness& harness);
+
+#endif /* INTERPOLATIONBENCHMARK_H_ */
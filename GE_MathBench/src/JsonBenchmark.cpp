@@ -0,0 +1,820 @@
+#include "GraphicsEngine.h"
+
+#include "layer0/json/JSONdecoder.h"
+#include "layer0/json/JSONdocument.h"
+#include "layer0/json/JSONencoder.h"
+#include "layer0/json/JSONfloat.h"
+#include "layer0/json/JSONreader.h"
+#include "layer0/json/JSONstructuralIndex.h"
+#include "layer0/json/JSONtokenizer.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkHarness.h"
+
+#include "JsonBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_NODES 2000
+#define NUMBER_VALIDATIONS 2000
+#define NUMBER_NUMBER_VALIDATIONS 200000
+#define NUMBER_NUMBERS 4096
+
+/**
+ * Text similar to a glTF scene description, with nested objects, arrays, numbers and strings.
+ */
+static string createJsonText()
+{
+	string jsonText = "{\n\t\"asset\": {\"generator\": \"GE_MathBench\", \"version\": \"1.0\"},\n\t\"nodes\": [\n";
+
+	char buffer[512];
+
+	for (int32_t i = 0; i < NUMBER_NODES; i++)
+	{
+		snprintf(buffer, sizeof(buffer), "\t\t{\"name\": \"node_%d\", \"mesh\": %d, \"translation\": [%f, %f, %f], \"rotation\": [0.0, 0.707107, 0.0, 0.707107], \"scale\": [1.0, 2.5e-1, 1.0], \"children\": [%d, %d], \"visible\": %s, \"extras\": null}%s\n", i, i % 17, static_cast<float>(i) * 0.5f, -static_cast<float>(i) * 0.25f, 3.0f, i + 1, i + 2, i % 2 == 0 ? "true" : "false", i + 1 < NUMBER_NODES ? "," : "");
+
+		jsonText += buffer;
+	}
+
+	jsonText += "\t]\n}\n";
+
+	return jsonText;
+}
+
+/**
+ * Buffers embedded as base64 data URIs, so most of the text is inside of long strings.
+ */
+static string createDataUriJsonText()
+{
+	static const char base64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	string jsonText = "{\n\t\"buffers\": {\n";
+
+	char buffer[128];
+
+	for (int32_t i = 0; i < 8; i++)
+	{
+		snprintf(buffer, sizeof(buffer), "\t\t\"buffer_%d\": {\"byteLength\": %d, \"uri\": \"data:application/octet-stream;base64,", i, 3 * 16384);
+
+		jsonText += buffer;
+
+		for (int32_t k = 0; k < 4 * 16384; k++)
+		{
+			jsonText += base64[(k * 7 + i) % 64];
+		}
+
+		jsonText += i + 1 < 8 ? "\"},\n" : "\"}\n";
+	}
+
+	jsonText += "\t}\n}\n";
+
+	return jsonText;
+}
+
+/**
+ * Counts the events, so only the reader is measured.
+ */
+class CountingHandler : public JSONhandler
+{
+
+public:
+
+	std::int32_t count;
+
+	CountingHandler() : JSONhandler(), count(0)
+	{
+	}
+
+	virtual bool beginObject() { count++; return true; }
+
+	virtual bool key(const std::string&) { count++; return true; }
+
+	virtual bool endObject() { count++; return true; }
+
+	virtual bool beginArray() { count++; return true; }
+
+	virtual bool endArray() { count++; return true; }
+
+	virtual bool stringValue(const std::string&) { count++; return true; }
+
+	virtual bool floatValue(float) { count++; return true; }
+
+	virtual bool integerValue(std::int32_t) { count++; return true; }
+
+	virtual bool trueValue() { count++; return true; }
+
+	virtual bool falseValue() { count++; return true; }
+
+	virtual bool nullValue() { count++; return true; }
+
+};
+
+/**
+ * Discards the text, so only the writer is measured.
+ */
+class CountingSink : public JSONsink
+{
+
+public:
+
+	size_t length;
+
+	CountingSink() : JSONsink(), length(0)
+	{
+	}
+
+	virtual bool write(const char*, size_t length) { this->length += length; return true; }
+
+};
+
+/**
+ * Inserts, removes or replaces a few characters, which are relevant for the structure of the text.
+ */
+static string mutateJsonText(const string& jsonText)
+{
+	static const char characters[] = "\"\\{}[]:,. -1e\tx\x01";
+
+	string result = jsonText;
+
+	int32_t count = 1 + rand() % 4;
+
+	for (int32_t i = 0; i < count && !result.empty(); i++)
+	{
+		size_t position = static_cast<size_t>(rand()) % result.length();
+		char c = characters[rand() % (sizeof(characters) - 1)];
+
+		switch (rand() % 3)
+		{
+			case 0:
+				result.erase(position, 1);
+				break;
+			case 1:
+				result.insert(position, 1, c);
+				break;
+			default:
+				result[position] = c;
+				break;
+		}
+	}
+
+	return result;
+}
+
+static bool isEqualTokenized(const string& jsonText, JSONscanKernel kernel)
+{
+	const char* begin = jsonText.data();
+	const char* end = jsonText.data() + jsonText.length();
+
+	JSONstructuralIndex index;
+
+	// If no index can be built, the decoders scan the text.
+	if (!index.build(begin, end, kernel))
+	{
+		return true;
+	}
+
+	JSONtokenizer scanTokenizer(begin, end);
+	JSONtokenizer indexTokenizer(begin, end, index);
+
+	JSONtoken scanToken;
+	JSONtoken indexToken;
+
+	while (true)
+	{
+		bool scanResult = scanTokenizer.next(scanToken);
+		bool indexResult = indexTokenizer.next(indexToken);
+
+		if (scanResult != indexResult || scanToken.type != indexToken.type)
+		{
+			return false;
+		}
+
+		if (!scanResult || scanToken.type == JSON_TOKEN_END)
+		{
+			return true;
+		}
+
+		if (scanToken.begin != indexToken.begin || scanToken.end != indexToken.end || scanToken.escaped != indexToken.escaped || scanToken.isFloat != indexToken.isFloat)
+		{
+			return false;
+		}
+	}
+}
+
+bool validateJson()
+{
+	srand(1);
+
+	static const JSONscanKernel allKernels[] = {JSON_SCAN_SCALAR, JSON_SCAN_SSE2, JSON_SCAN_AVX2};
+	static const char* allNames[] = {"JSON scalar", "JSON SSE2", "JSON AVX2"};
+
+	// Escaped backslashes and quotation marks in front of the closing quotation mark.
+	string jsonText = createJsonText();
+	jsonText.insert(jsonText.length() - 3, ", \"escaped\": [\"a\\\\\", \"\\\"\\\\\\\\\", \"\\u00e4\\n\\\\\\\"\\\\\"]");
+
+	string smallJsonText = jsonText.substr(0, 4096) + "]}";
+
+	bool result = true;
+
+	for (int32_t k = 0; k <= static_cast<int32_t>(JSONstructuralIndex::getBestKernel()); k++)
+	{
+		int32_t failures = isEqualTokenized(jsonText, allKernels[k]) ? 0 : 1;
+
+		for (int32_t i = 0; i < NUMBER_VALIDATIONS; i++)
+		{
+			failures += isEqualTokenized(mutateJsonText(smallJsonText), allKernels[k]) ? 0 : 1;
+		}
+
+		printf("Validation %-16s %s (%d failures)\n", allNames[k], failures == 0 ? "passed" : "FAILED", failures);
+
+		result = result && failures == 0;
+	}
+
+	return result;
+}
+
+static bool isEqualNode(const JSONnode& eagerNode, const JSONnode& lazyNode)
+{
+	// Accessing the size decodes a lazy node.
+	if (eagerNode.size() != lazyNode.size() || eagerNode.getType() != lazyNode.getType())
+	{
+		return false;
+	}
+
+	switch (eagerNode.getType())
+	{
+		case JSON_NODE_FLOAT:
+		case JSON_NODE_INTEGER:
+		{
+			float eagerFloat = eagerNode.getFloatValue();
+			float lazyFloat = lazyNode.getFloatValue();
+
+			return eagerNode.getIntegerValue() == lazyNode.getIntegerValue() && memcmp(&eagerFloat, &lazyFloat, sizeof(float)) == 0;
+		}
+		case JSON_NODE_STRING:
+			return eagerNode.getLength() == lazyNode.getLength() && memcmp(eagerNode.getStringValue(), lazyNode.getStringValue(), eagerNode.getLength()) == 0;
+		case JSON_NODE_ARRAY:
+			for (uint32_t i = 0; i < eagerNode.size(); i++)
+			{
+				if (!isEqualNode(eagerNode.getValueAt(i), lazyNode.getValueAt(i)))
+				{
+					return false;
+				}
+			}
+			return true;
+		case JSON_NODE_OBJECT:
+			for (uint32_t i = 0; i < eagerNode.size(); i++)
+			{
+				const JSONkey* eagerKey = eagerNode.getMemberAt(i).key;
+				const JSONkey* lazyKey = lazyNode.getMemberAt(i).key;
+
+				if (eagerKey->length != lazyKey->length || memcmp(eagerKey->text, lazyKey->text, eagerKey->length) != 0 || !isEqualNode(eagerNode.getMemberAt(i).value, lazyNode.getMemberAt(i).value))
+				{
+					return false;
+				}
+			}
+			return true;
+		default:
+			break;
+	}
+
+	return true;
+}
+
+static bool isEqualDecoded(const string& jsonText)
+{
+	JSONdocument eagerDocument;
+	JSONdocument lazyDocument;
+
+	bool eagerResult = eagerDocument.decode(jsonText);
+	bool lazyResult = lazyDocument.decode(jsonText, true);
+
+	if (eagerResult)
+	{
+		return lazyResult && lazyDocument.getRoot().expandAll() && !lazyDocument.hasError() && isEqualNode(eagerDocument.getRoot(), lazyDocument.getRoot());
+	}
+
+	if (!eagerDocument.hasError())
+	{
+		return false;
+	}
+
+	// Errors inside of nested objects and arrays are found on expansion.
+	return !lazyResult || (!lazyDocument.getRoot().expandAll() && lazyDocument.hasError());
+}
+
+bool validateJsonLazy()
+{
+	srand(2);
+
+	string jsonText = createJsonText();
+	jsonText.insert(jsonText.length() - 3, ", \"escaped\": [\"a\\\\\", \"\\\"]\\\\\\\\\", \"{[\\u00e4\\n\\\\\\\"\\\\\"], \"nested\": [[[{\"a\": [{}]}], []], {\"b\": {\"c\": [1, 2.5]}}]");
+
+	string smallJsonText = jsonText.substr(0, 4096) + "]}";
+
+	int32_t failures = isEqualDecoded(jsonText) ? 0 : 1;
+
+	failures += isEqualDecoded(createDataUriJsonText()) ? 0 : 1;
+
+	// Valid brackets around invalid values, so the lazy decode itself succeeds.
+	const char* allMalformedTexts[] = {"{\"a\": [1, 2,], \"b\": {}}", "[{\"a\": 1}, [1 2]]", "{\"a\": {\"b\": {\"c\": }}}", "[[[\"\\x\"]]]", "{\"a\": [1e]}"};
+
+	for (int32_t i = 0; i < 5; i++)
+	{
+		JSONdocument lazyDocument;
+
+		if (!lazyDocument.decode(allMalformedTexts[i], true) || lazyDocument.hasError() || lazyDocument.getRoot().expandAll() || !lazyDocument.hasError() || !isEqualDecoded(allMalformedTexts[i]))
+		{
+			failures++;
+		}
+	}
+
+	for (int32_t i = 0; i < NUMBER_VALIDATIONS; i++)
+	{
+		failures += isEqualDecoded(mutateJsonText(smallJsonText)) ? 0 : 1;
+	}
+
+	printf("Validation %-16s %s (%d failures)\n", "JSON lazy", failures == 0 ? "passed" : "FAILED", failures);
+
+	return failures == 0;
+}
+
+static uint64_t getRandomBits()
+{
+	uint64_t bits = 0;
+
+	for (int32_t i = 0; i < 4; i++)
+	{
+		bits = (bits << 16) ^ static_cast<uint64_t>(rand() & 0xFFFF);
+	}
+
+	return bits;
+}
+
+/**
+ * Random JSON number with up to 40 digits and exponents over the whole double range.
+ */
+static string getRandomNumberText()
+{
+	string text = rand() % 2 == 0 ? "-" : "";
+
+	int32_t digits = 1 + rand() % 40;
+	int32_t point = rand() % (digits + 1);
+
+	text += static_cast<char>('1' + rand() % 9);
+
+	for (int32_t i = 1; i < digits; i++)
+	{
+		if (i == point)
+		{
+			text += '.';
+		}
+
+		text += static_cast<char>('0' + rand() % 10);
+	}
+
+	if (rand() % 2 == 0)
+	{
+		char buffer[16];
+
+		snprintf(buffer, sizeof(buffer), "e%d", rand() % 700 - 350);
+
+		text += buffer;
+	}
+
+	return text;
+}
+
+static bool isEqualBits(const void* value0, const void* value1, size_t size)
+{
+	return memcmp(value0, value1, size) == 0;
+}
+
+bool validateJsonNumber()
+{
+	srand(1);
+
+	int32_t printFailures = 0;
+	int32_t parseFailures = 0;
+
+	char buffer[JSON_FLOAT_MAX_LENGTH];
+
+	for (int32_t i = 0; i < NUMBER_NUMBER_VALIDATIONS; i++)
+	{
+		uint64_t bits = getRandomBits();
+
+		float floatValue;
+		uint32_t floatBits = static_cast<uint32_t>(bits);
+		memcpy(&floatValue, &floatBits, sizeof(float));
+
+		if (jsonPrintFloat(buffer, floatValue) >= 0)
+		{
+			float result = 0.0f;
+
+			jsonParseFloat(buffer, buffer + strlen(buffer), result);
+
+			printFailures += isEqualBits(&result, &floatValue, sizeof(float)) && strtof(buffer, nullptr) == floatValue ? 0 : 1;
+		}
+
+		double doubleValue;
+		memcpy(&doubleValue, &bits, sizeof(double));
+
+		if (jsonPrintDouble(buffer, doubleValue) >= 0)
+		{
+			double result = 0.0;
+
+			jsonParseDouble(buffer, buffer + strlen(buffer), result);
+
+			printFailures += isEqualBits(&result, &doubleValue, sizeof(double)) && strtod(buffer, nullptr) == doubleValue ? 0 : 1;
+		}
+
+		string text = getRandomNumberText();
+
+		float parsedFloat = 0.0f;
+		float expectedFloat = strtof(text.c_str(), nullptr);
+
+		double parsedDouble = 0.0;
+		double expectedDouble = strtod(text.c_str(), nullptr);
+
+		bool result = jsonParseFloat(text.data(), text.data() + text.length(), parsedFloat) && jsonParseDouble(text.data(), text.data() + text.length(), parsedDouble);
+
+		parseFailures += result && isEqualBits(&parsedFloat, &expectedFloat, sizeof(float)) && isEqualBits(&parsedDouble, &expectedDouble, sizeof(double)) ? 0 : 1;
+	}
+
+	printf("Validation %-16s %s (%d failures)\n", "JSON print", printFailures == 0 ? "passed" : "FAILED", printFailures);
+	printf("Validation %-16s %s (%d failures)\n", "JSON parse", parseFailures == 0 ? "passed" : "FAILED", parseFailures);
+
+	return printFailures == 0 && parseFailures == 0;
+}
+
+static void printThroughput(const BenchmarkHarness& harness)
+{
+	const BenchmarkResult& result = harness.getResults().back();
+
+	if (result.median > 0.0)
+	{
+		// Nanoseconds per byte to megabytes per second.
+		printf("%-14s %-40s %10.2f MB/s\n", result.group.c_str(), result.name.c_str(), 1000.0 / result.median);
+	}
+}
+
+void benchmarkJson(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("json"))
+	{
+		return;
+	}
+
+	string jsonText = createJsonText();
+
+	// Time is per byte of JSON text.
+
+	harness.run("json", "JSONdecoder decode", static_cast<int32_t>(jsonText.length()), [&]()
+	{
+		JSONdecoder decoder;
+		JSONvalueSP jsonValue;
+
+		if (!decoder.decode(jsonText, jsonValue))
+		{
+			printf("Error: Could not decode JSON text.\n");
+		}
+
+		harness.consume(jsonValue.get() ? 1.0f : 0.0f);
+	});
+
+	printThroughput(harness);
+
+	JSONdocument document;
+
+	harness.run("json", "JSONdocument decode", static_cast<int32_t>(jsonText.length()), [&]()
+	{
+		if (!document.decode(jsonText))
+		{
+			printf("Error: Could not decode JSON document.\n");
+		}
+
+		harness.consume(static_cast<float>(document.getRoot().size()));
+	});
+
+	printThroughput(harness);
+
+	// Nested objects and arrays are only matched, like when reading the top level keys of a large file.
+
+	harness.run("json", "JSONdocument decode lazy", static_cast<int32_t>(jsonText.length()), [&]()
+	{
+		if (!document.decode(jsonText, true))
+		{
+			printf("Error: Could not decode JSON document.\n");
+		}
+
+		harness.consume(static_cast<float>(document.getRoot().size()));
+	});
+
+	printThroughput(harness);
+
+	document.decode(jsonText);
+
+	// Allocations of one decode.
+	{
+		int64_t start = getAllocationCount();
+
+		JSONdecoder decoder;
+		JSONvalueSP jsonValue;
+
+		decoder.decode(jsonText, jsonValue);
+
+		int64_t decoderCount = getAllocationCount() - start;
+
+		start = getAllocationCount();
+
+		JSONdocument newDocument;
+
+		newDocument.decode(jsonText);
+
+		int64_t newDocumentCount = getAllocationCount() - start;
+
+		start = getAllocationCount();
+
+		newDocument.decode(jsonText);
+
+		int64_t reusedDocumentCount = getAllocationCount() - start;
+
+		printf("%-14s %-40s %10lld allocations\n", "json", "JSONdecoder decode", static_cast<long long>(decoderCount));
+		printf("%-14s %-40s %10lld allocations\n", "json", "JSONdocument decode", static_cast<long long>(newDocumentCount));
+		printf("%-14s %-40s %10lld allocations\n", "json", "JSONdocument decode reused", static_cast<long long>(reusedDocumentCount));
+	}
+
+	// Lookups of a key in each node, the way the glTF loader does it.
+
+	JSONdecoder decoder;
+	JSONvalueSP jsonValue;
+
+	decoder.decode(jsonText, jsonValue);
+
+	JSONarraySP nodesArray = dynamic_pointer_cast<JSONarray>(dynamic_pointer_cast<JSONobject>(jsonValue)->getValue(JSONstringSP(new JSONstring("nodes"))));
+
+	harness.run("json", "JSONobject getValue", static_cast<int32_t>(nodesArray->size()), [&]()
+	{
+		int32_t sum = 0;
+
+		for (auto& currentNode : nodesArray->getAllValues())
+		{
+			JSONstringSP meshString = JSONstringSP(new JSONstring("mesh"));
+
+			sum += dynamic_pointer_cast<JSONnumber>(dynamic_pointer_cast<JSONobject>(currentNode)->getValue(meshString))->getIntegerValue();
+		}
+
+		harness.consume(static_cast<float>(sum));
+	});
+
+	const JSONnode* nodesNode = document.getRoot().find("nodes");
+
+	harness.run("json", "JSONnode find", static_cast<int32_t>(nodesNode->size()), [&]()
+	{
+		int32_t sum = 0;
+
+		for (uint32_t i = 0; i < nodesNode->size(); i++)
+		{
+			sum += nodesNode->getValueAt(i).find("mesh")->getIntegerValue();
+		}
+
+		harness.consume(static_cast<float>(sum));
+	});
+
+	// Time is per byte of encoded text.
+
+	string encodedText;
+
+	JSONencoder encoder;
+
+	encoder.encode(jsonValue, encodedText);
+
+	harness.run("json", "JSONencoder encode string", static_cast<int32_t>(encodedText.length()), [&]()
+	{
+		string currentText;
+
+		if (!encoder.encode(jsonValue, currentText))
+		{
+			printf("Error: Could not encode JSON value.\n");
+		}
+
+		harness.consume(static_cast<float>(currentText.length()));
+	});
+
+	printThroughput(harness);
+
+	harness.run("json", "JSONencoder encode streamed", static_cast<int32_t>(encodedText.length()), [&]()
+	{
+		CountingSink sink;
+
+		if (!encoder.encode(jsonValue, sink))
+		{
+			printf("Error: Could not encode JSON value.\n");
+		}
+
+		harness.consume(static_cast<float>(sink.length));
+	});
+
+	printThroughput(harness);
+
+	// Allocations of one encode. Streaming only allocates the buffer of the writer.
+	{
+		int64_t start = getAllocationCount();
+
+		string currentText;
+
+		encoder.encode(jsonValue, currentText);
+
+		int64_t stringCount = getAllocationCount() - start;
+
+		start = getAllocationCount();
+
+		CountingSink sink;
+
+		encoder.encode(jsonValue, sink);
+
+		int64_t streamedCount = getAllocationCount() - start;
+
+		printf("%-14s %-40s %10lld allocations\n", "json", "JSONencoder encode string", static_cast<long long>(stringCount));
+		printf("%-14s %-40s %10lld allocations\n", "json", "JSONencoder encode streamed", static_cast<long long>(streamedCount));
+	}
+
+	harness.run("json", "JSONreader read", static_cast<int32_t>(jsonText.length()), [&]()
+	{
+		CountingHandler handler;
+		JSONreader reader(handler);
+
+		if (!reader.read(jsonText.data(), jsonText.data() + jsonText.length()))
+		{
+			printf("Error: Could not read JSON text.\n");
+		}
+
+		harness.consume(static_cast<float>(handler.count));
+	});
+
+	printThroughput(harness);
+
+	harness.run("json", "JSONtokenizer next", static_cast<int32_t>(jsonText.length()), [&]()
+	{
+		JSONtokenizer tokenizer(jsonText.data(), jsonText.data() + jsonText.length());
+		JSONtoken token;
+
+		int32_t count = 0;
+
+		while (tokenizer.next(token) && token.type != JSON_TOKEN_END)
+		{
+			count++;
+		}
+
+		harness.consume(static_cast<float>(count));
+	});
+
+	printThroughput(harness);
+
+	JSONstructuralIndex index;
+
+	static const JSONscanKernel allKernels[] = {JSON_SCAN_SCALAR, JSON_SCAN_SSE2, JSON_SCAN_AVX2};
+	static const char* allNames[] = {"JSONstructuralIndex build scalar", "JSONstructuralIndex build SSE2", "JSONstructuralIndex build AVX2"};
+
+	for (int32_t k = 0; k <= static_cast<int32_t>(JSONstructuralIndex::getBestKernel()); k++)
+	{
+		harness.run("json", allNames[k], static_cast<int32_t>(jsonText.length()), [&]()
+		{
+			if (!index.build(jsonText.data(), jsonText.data() + jsonText.length(), allKernels[k]))
+			{
+				printf("Error: Could not build structural index.\n");
+			}
+
+			harness.consume(static_cast<float>(index.getPositions().size()));
+		});
+
+		printThroughput(harness);
+	}
+
+	// Time of the indexed tokenizer includes building the index.
+
+	string dataUriJsonText = createDataUriJsonText();
+
+	const string* allTexts[] = {&jsonText, &dataUriJsonText};
+	static const char* allScanNames[] = {"JSONtokenizer next", "JSONtokenizer next data URI"};
+	static const char* allIndexedNames[] = {"JSONtokenizer next indexed", "JSONtokenizer next data URI indexed"};
+
+	for (int32_t t = 0; t < 2; t++)
+	{
+		const char* begin = allTexts[t]->data();
+		const char* end = allTexts[t]->data() + allTexts[t]->length();
+
+		if (t > 0)
+		{
+			harness.run("json", allScanNames[t], static_cast<int32_t>(end - begin), [&]()
+			{
+				JSONtokenizer tokenizer(begin, end);
+				JSONtoken token;
+
+				int32_t count = 0;
+
+				while (tokenizer.next(token) && token.type != JSON_TOKEN_END)
+				{
+					count++;
+				}
+
+				harness.consume(static_cast<float>(count));
+			});
+
+			printThroughput(harness);
+		}
+
+		harness.run("json", allIndexedNames[t], static_cast<int32_t>(end - begin), [&]()
+		{
+			index.build(begin, end);
+
+			JSONtokenizer tokenizer(begin, end, index);
+			JSONtoken token;
+
+			int32_t count = 0;
+
+			while (tokenizer.next(token) && token.type != JSON_TOKEN_END)
+			{
+				count++;
+			}
+
+			harness.consume(static_cast<float>(count));
+		});
+
+		printThroughput(harness);
+	}
+
+	// Time is per number.
+
+	vector<string> allNumberTexts;
+	vector<float> allFloats;
+
+	for (int32_t i = 0; i < NUMBER_NUMBERS; i++)
+	{
+		float value = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * 200.0f - 100.0f;
+
+		char buffer[32];
+
+		// Typical for glTF accessors and matrices.
+		snprintf(buffer, sizeof(buffer), "%.9g", value);
+
+		allNumberTexts.push_back(buffer);
+		allFloats.push_back(value);
+	}
+
+	harness.run("json", "strtof", NUMBER_NUMBERS, [&]()
+	{
+		float sum = 0.0f;
+
+		for (auto& currentText : allNumberTexts)
+		{
+			sum += strtof(currentText.c_str(), nullptr);
+		}
+
+		harness.consume(sum);
+	});
+
+	harness.run("json", "jsonParseFloat", NUMBER_NUMBERS, [&]()
+	{
+		float sum = 0.0f;
+
+		for (auto& currentText : allNumberTexts)
+		{
+			float value = 0.0f;
+
+			jsonParseFloat(currentText.data(), currentText.data() + currentText.length(), value);
+
+			sum += value;
+		}
+
+		harness.consume(sum);
+	});
+
+	harness.run("json", "snprintf %.9g", NUMBER_NUMBERS, [&]()
+	{
+		char buffer[32];
+
+		int32_t length = 0;
+
+		for (float currentFloat : allFloats)
+		{
+			length += snprintf(buffer, sizeof(buffer), "%.9g", currentFloat);
+		}
+
+		harness.consume(static_cast<float>(length));
+	});
+
+	harness.run("json", "jsonPrintFloat", NUMBER_NUMBERS, [&]()
+	{
+		char buffer[JSON_FLOAT_MAX_LENGTH];
+
+		int32_t length = 0;
+
+		for (float currentFloat : allFloats)
+		{
+			length += jsonPrintFloat(buffer, currentFloat);
+		}
+
+		harness.consume(static_cast<float>(length));
+	});
+}
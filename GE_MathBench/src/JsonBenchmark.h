@@ -0,0 +1,26 @@
+#ifndef JSONBENCHMARK_H_
+#define JSONBENCHMARK_H_
+
+class BenchmarkHarness;
+
+/**
+ * Compares the tokens found with a structural index of each kernel with the ones found by scanning. Returns false, if
+ * a token differs.
+ */
+bool validateJson();
+
+/**
+ * Compares lazily and eagerly decoded JSON documents of valid and mutated texts. Returns false, if a node differs or an
+ * error is lost.
+ */
+bool validateJsonLazy();
+
+/**
+ * Compares the JSON float parsing and printing with strtod and strtof. Returns false, if a value differs or does not
+ * round trip.
+ */
+bool validateJsonNumber();
+
+void benchmarkJson(BenchmarkHarness& harness);
+
+#endif /* JSONBENCHMARK_H_ */
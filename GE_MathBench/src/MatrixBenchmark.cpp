@@ -0,0 +1,248 @@
+#include "GraphicsEngine.h"
+
+#include "BenchmarkHarness.h"
+
+#include "MatrixBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_MATRICES 1024
+#define NUMBER_VALIDATIONS 10000
+
+static float getRandom(float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+/**
+ * Translation, rotation and non uniform scale, so the matrices are well conditioned.
+ */
+static Matrix4x4 getRandomMatrix()
+{
+	Matrix4x4 result;
+
+	result.translate(getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f));
+	result.rotateRzRyRx(getRandom(-180.0f, 180.0f), getRandom(-180.0f, 180.0f), getRandom(-180.0f, 180.0f));
+	result.scale(getRandom(0.1f, 10.0f), getRandom(0.1f, 10.0f), getRandom(0.1f, 10.0f));
+
+	return result;
+}
+
+static bool isEqual(const float* result, const float* expected, int32_t count, float tolerance)
+{
+	for (int32_t i = 0; i < count; i++)
+	{
+		if (fabsf(result[i] - expected[i]) > tolerance * max(1.0f, fabsf(expected[i])))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool report(const char* name, int32_t failures)
+{
+	printf("Validation %-16s %s (%d failures)\n", name, failures == 0 ? "passed" : "FAILED", failures);
+
+	return failures == 0;
+}
+
+bool validateMatrix()
+{
+	srand(1);
+
+	int32_t multiplyFailures = 0;
+	int32_t transposeFailures = 0;
+	int32_t inverseFailures = 0;
+	int32_t inverseAffineFailures = 0;
+	int32_t pointFailures = 0;
+	int32_t vectorFailures = 0;
+	int32_t normalFailures = 0;
+	int32_t normalTypeFailures = 0;
+
+	for (int32_t i = 0; i < NUMBER_VALIDATIONS; i++)
+	{
+		Matrix4x4 matrix0 = getRandomMatrix();
+		Matrix4x4 matrix1 = getRandomMatrix();
+
+		float expected[16];
+		Matrix4x4 result;
+
+		glusMatrix4x4Multiplyf(expected, matrix0.getM(), matrix1.getM());
+		result = matrix0 * matrix1;
+		multiplyFailures += isEqual(result.getM(), expected, 16, 1.0e-6f) ? 0 : 1;
+
+		glusMatrix4x4Copyf(expected, matrix0.getM(), GLUS_FALSE);
+		glusMatrix4x4Transposef(expected);
+		result = matrix0;
+		result.transpose();
+		transposeFailures += isEqual(result.getM(), expected, 16, 0.0f) ? 0 : 1;
+
+		glusMatrix4x4Copyf(expected, matrix0.getM(), GLUS_FALSE);
+		glusMatrix4x4Inversef(expected);
+		result = matrix0;
+		inverseFailures += result.inverse() && isEqual(result.getM(), expected, 16, 1.0e-4f) ? 0 : 1;
+
+		result = matrix0;
+		inverseAffineFailures += result.inverseAffine() && isEqual(result.getM(), expected, 16, 1.0e-4f) ? 0 : 1;
+
+		float point[4] = {getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f), 1.0f};
+
+		glusMatrix4x4MultiplyPoint4f(expected, matrix0.getM(), point);
+		Point4 resultPoint = matrix0 * Point4(point);
+		pointFailures += isEqual(resultPoint.getP(), expected, 4, 1.0e-6f) ? 0 : 1;
+
+		glusMatrix4x4MultiplyVector3f(expected, matrix0.getM(), point);
+		Vector3 resultVector = matrix0 * Vector3(point);
+		vectorFailures += isEqual(resultVector.getV(), expected, 3, 1.0e-6f) ? 0 : 1;
+
+		// Random rotation and scale is non uniform, a product of two of them is sheared in general.
+
+		Matrix4x4 rigid;
+		rigid.rotateRzRyRx(getRandom(-180.0f, 180.0f), getRandom(-180.0f, 180.0f), getRandom(-180.0f, 180.0f));
+
+		Matrix4x4 uniform = rigid;
+		float uniformScale = getRandom(0.1f, 10.0f);
+		uniform.scale(uniformScale, uniformScale, uniformScale);
+
+		Matrix4x4 sheared = matrix0 * matrix1;
+
+		normalTypeFailures += rigid.getNormalMatrixType() == NORMAL_MATRIX_RIGID ? 0 : 1;
+		normalTypeFailures += uniform.getNormalMatrixType() == NORMAL_MATRIX_UNIFORM_SCALE ? 0 : 1;
+
+		const Matrix4x4* allNormalMatrices[4] = {&rigid, &uniform, &matrix0, &sheared};
+
+		for (int32_t k = 0; k < 4; k++)
+		{
+			glusMatrix4x4ExtractMatrix3x3f(expected, allNormalMatrices[k]->getM());
+			glusMatrix3x3Inversef(expected);
+			Matrix3x3 resultNormal = allNormalMatrices[k]->extractNormalMatrix3x3();
+			normalFailures += isEqual(resultNormal.getM(), expected, 9, 1.0e-4f) ? 0 : 1;
+		}
+	}
+
+	bool passed = true;
+
+	passed = report("multiply", multiplyFailures) && passed;
+	passed = report("transpose", transposeFailures) && passed;
+	passed = report("inverse", inverseFailures) && passed;
+	passed = report("inverseAffine", inverseAffineFailures) && passed;
+	passed = report("point", pointFailures) && passed;
+	passed = report("vector", vectorFailures) && passed;
+	passed = report("normal", normalFailures) && passed;
+	passed = report("normalType", normalTypeFailures) && passed;
+
+	return passed;
+}
+
+void benchmarkMatrix(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("matrix"))
+	{
+		return;
+	}
+
+	srand(1);
+
+	vector<Matrix4x4> allMatrices(NUMBER_MATRICES);
+	vector<Matrix4x4> allResults(NUMBER_MATRICES);
+	vector<Matrix3x3> allNormalMatrices(NUMBER_MATRICES);
+	vector<Point4> allPoints(NUMBER_MATRICES);
+
+	for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+	{
+		allMatrices[i] = getRandomMatrix();
+		allPoints[i] = Point4(getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f));
+	}
+
+	harness.run("matrix", "multiply GLUS", NUMBER_MATRICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			glusMatrix4x4Multiplyf(const_cast<float*>(allResults[i].getM()), allMatrices[i].getM(), allMatrices[(i + 1) % NUMBER_MATRICES].getM());
+		}
+	});
+
+	harness.run("matrix", "multiply", NUMBER_MATRICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			allResults[i] = allMatrices[i] * allMatrices[(i + 1) % NUMBER_MATRICES];
+		}
+	});
+
+	harness.run("matrix", "inverse GLUS", NUMBER_MATRICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			allResults[i] = allMatrices[i];
+			glusMatrix4x4Inversef(const_cast<float*>(allResults[i].getM()));
+		}
+	});
+
+	harness.run("matrix", "inverse", NUMBER_MATRICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			allResults[i] = allMatrices[i];
+			allResults[i].inverse();
+		}
+	});
+
+	harness.run("matrix", "inverseAffine", NUMBER_MATRICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			allResults[i] = allMatrices[i];
+			allResults[i].inverseAffine();
+		}
+	});
+
+	harness.run("matrix", "normal GLUS", NUMBER_MATRICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			allNormalMatrices[i] = allMatrices[i].extractMatrix3x3();
+			allNormalMatrices[i].inverse();
+		}
+	});
+
+	harness.run("matrix", "normal", NUMBER_MATRICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			allNormalMatrices[i] = allMatrices[i].extractNormalMatrix3x3();
+		}
+	});
+
+	harness.run("matrix", "normal TRS", NUMBER_MATRICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			allNormalMatrices[i] = allMatrices[i].extractNormalMatrix3x3(NORMAL_MATRIX_NON_UNIFORM_SCALE);
+		}
+	});
+
+	harness.run("matrix", "point GLUS", NUMBER_MATRICES, [&]()
+	{
+		float transformed[4];
+
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			glusMatrix4x4MultiplyPoint4f(transformed, allMatrices[i].getM(), allPoints[i].getP());
+			harness.consume(transformed[0]);
+		}
+	});
+
+	harness.run("matrix", "point", NUMBER_MATRICES, [&]()
+	{
+		float transformed[4];
+
+		for (int32_t i = 0; i < NUMBER_MATRICES; i++)
+		{
+			simdMatrix4x4MultiplyPoint4f(transformed, allMatrices[i].getM(), allPoints[i].getP());
+			harness.consume(transformed[0]);
+		}
+	});
+}
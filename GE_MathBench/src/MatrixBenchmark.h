@@ -0,0 +1,13 @@
+#ifndef MATRIXBENCHMARK_H_
+#define MATRIXBENCHMARK_H_
+
+class BenchmarkHarness;
+
+/**
+ * Compares the SIMD matrix functions with GLUS. Returns false, if a result is out of tolerance.
+ */
+bool validateMatrix();
+
+void benchmarkMatrix(BenchmarkHarness& harness);
+
+#endif /* MATRIXBENCHMARK_H_ */
@@ -0,0 +1,238 @@
+#include "GraphicsEngine.h"
+
+#include "layer3/mesh/VertexFormat.h"
+
+#include "BenchmarkHarness.h"
+
+#include "QuantizationBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_VERTICES 4096
+#define NUMBER_VALIDATIONS 100000
+
+// Half a step of the quantization plus float rounding.
+#define SNORM16_TOLERANCE (0.5f / 32767.0f + 1.0e-6f)
+#define UNORM16_TOLERANCE (0.5f / 65535.0f + 1.0e-6f)
+
+// Largest distance of a decoded to the original unit direction.
+#define OCTAHEDRAL16_TOLERANCE 1.0e-4f
+#define OCTAHEDRAL8_TOLERANCE 2.5e-2f
+
+static float getRandom(float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+static void getRandomDirection(float* direction)
+{
+	float length;
+
+	do
+	{
+		direction[0] = getRandom(-1.0f, 1.0f);
+		direction[1] = getRandom(-1.0f, 1.0f);
+		direction[2] = getRandom(-1.0f, 1.0f);
+
+		length = sqrtf(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+	} while (length < 0.01f || length > 1.0f);
+
+	direction[0] /= length;
+	direction[1] /= length;
+	direction[2] /= length;
+}
+
+static float getDistance(const float* direction0, const float* direction1)
+{
+	float x = direction0[0] - direction1[0];
+	float y = direction0[1] - direction1[1];
+	float z = direction0[2] - direction1[2];
+
+	return sqrtf(x * x + y * y + z * z);
+}
+
+static bool report(const char* name, int32_t failures)
+{
+	printf("Validation %-16s %s (%d failures)\n", name, failures == 0 ? "passed" : "FAILED", failures);
+
+	return failures == 0;
+}
+
+bool validateQuantization()
+{
+	srand(1);
+
+	int32_t snormFailures = 0;
+	int32_t unormFailures = 0;
+	int32_t octahedralFailures = 0;
+	int32_t sizeFailures = 0;
+
+	// Values are unpacked the same way as by OpenGL and the shader, so the error is the one seen when rendering.
+
+	for (int32_t i = 0; i < NUMBER_VALIDATIONS; i++)
+	{
+		float value = getRandom(-1.0f, 1.0f);
+
+		int16_t packedSnorm = VertexFormat::packSnorm16(value);
+
+		float unpacked;
+		VertexFormat(GL_SHORT, 1, GL_TRUE, false, 0).unpack(&unpacked, 1, &packedSnorm, 1);
+
+		if (fabsf(unpacked - value) > SNORM16_TOLERANCE)
+		{
+			snormFailures++;
+		}
+
+		value = getRandom(0.0f, 1.0f);
+
+		uint16_t packedUnorm = VertexFormat::packUnorm16(value);
+
+		VertexFormat(GL_UNSIGNED_SHORT, 1, GL_TRUE, false, 0).unpack(&unpacked, 1, &packedUnorm, 1);
+
+		if (fabsf(unpacked - value) > UNORM16_TOLERANCE)
+		{
+			unormFailures++;
+		}
+
+		float direction[3];
+		getRandomDirection(direction);
+
+		int16_t packedOctahedral16[2];
+		VertexFormat::packOctahedral16(packedOctahedral16, direction);
+
+		float unpackedDirection[3];
+		VertexFormat(GL_SHORT, 2, GL_TRUE, true, 0).unpack(unpackedDirection, 3, packedOctahedral16, 1);
+
+		if (getDistance(unpackedDirection, direction) > OCTAHEDRAL16_TOLERANCE)
+		{
+			octahedralFailures++;
+		}
+
+		int8_t packedOctahedral8[2];
+		VertexFormat::packOctahedral8(packedOctahedral8, direction);
+
+		VertexFormat(GL_BYTE, 2, GL_TRUE, true, 0).unpack(unpackedDirection, 3, packedOctahedral8, 1);
+
+		if (getDistance(unpackedDirection, direction) > OCTAHEDRAL8_TOLERANCE)
+		{
+			octahedralFailures++;
+		}
+	}
+
+	// Extremes and the poles, where the octahedron is folded.
+	if (VertexFormat::packSnorm16(-1.0f) != -32767 || VertexFormat::packSnorm16(2.0f) != 32767 || VertexFormat::packUnorm16(1.0f) != 65535 || VertexFormat::packUnorm16(-1.0f) != 0)
+	{
+		snormFailures++;
+	}
+
+	const float allPoles[6][3] = {{1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}};
+
+	for (int32_t i = 0; i < 6; i++)
+	{
+		int16_t packedOctahedral16[2];
+		VertexFormat::packOctahedral16(packedOctahedral16, allPoles[i]);
+
+		float unpackedDirection[3];
+		VertexFormat(GL_SHORT, 2, GL_TRUE, true, 0).unpack(unpackedDirection, 3, packedOctahedral16, 1);
+
+		if (getDistance(unpackedDirection, allPoles[i]) > OCTAHEDRAL16_TOLERANCE)
+		{
+			octahedralFailures++;
+		}
+	}
+
+	// Bytes uploaded to the VBOs: the padding after the last element is not read.
+	VertexFormat positionFormat(GL_SHORT, 3, GL_FALSE, false, 8);
+	VertexFormat normalFormat(GL_SHORT, 2, GL_TRUE, true, 0);
+	VertexFormat texCoordFormat(GL_UNSIGNED_SHORT, 2, GL_TRUE, false, 0);
+
+	if (positionFormat.getByteSize(NUMBER_VERTICES) != (NUMBER_VERTICES - 1) * 8 + 6 || normalFormat.getByteSize(NUMBER_VERTICES) != NUMBER_VERTICES * 4 || texCoordFormat.getByteSize(NUMBER_VERTICES) != NUMBER_VERTICES * 4 || VertexFormat(4).getByteSize(NUMBER_VERTICES) != NUMBER_VERTICES * 16 || positionFormat.getByteSize(0) != 0)
+	{
+		sizeFailures++;
+	}
+
+	if (positionFormat.isFloat() || !VertexFormat(3).isFloat() || VertexFormat(GL_FLOAT, 3, GL_FALSE, false, 16).isFloat())
+	{
+		sizeFailures++;
+	}
+
+	// Positions are not normalized and get w of one.
+	const int16_t position[4] = {-3, 7, 32767, 0};
+
+	float unpackedPosition[4];
+	positionFormat.unpack(unpackedPosition, 4, position, 1);
+
+	if (unpackedPosition[0] != -3.0f || unpackedPosition[1] != 7.0f || unpackedPosition[2] != 32767.0f || unpackedPosition[3] != 1.0f)
+	{
+		sizeFailures++;
+	}
+
+	bool result = true;
+
+	result = report("snorm16", snormFailures) && result;
+	result = report("unorm16", unormFailures) && result;
+	result = report("octahedral", octahedralFailures) && result;
+	result = report("vertex format", sizeFailures) && result;
+
+	// Position, normal, bitangent, tangent and texture coordinate.
+	int32_t floatBytes = VertexFormat(4).getElementSize() + 3 * VertexFormat(3).getElementSize() + VertexFormat(2).getElementSize();
+	int32_t packedBytes = positionFormat.getElementStride() + 3 * normalFormat.getElementStride() + texCoordFormat.getElementStride();
+
+	printf("Vertex size      %d bytes as floats, %d bytes quantized\n", floatBytes, packedBytes);
+
+	return result;
+}
+
+void benchmarkQuantization(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("quantization"))
+	{
+		return;
+	}
+
+	srand(1);
+
+	vector<int16_t> positions(NUMBER_VERTICES * 4);
+	vector<int16_t> normals(NUMBER_VERTICES * 2);
+	vector<float> directions(NUMBER_VERTICES * 3);
+	vector<float> unpacked(NUMBER_VERTICES * 4);
+
+	for (int32_t i = 0; i < NUMBER_VERTICES; i++)
+	{
+		for (int32_t k = 0; k < 3; k++)
+		{
+			positions[i * 4 + k] = VertexFormat::packSnorm16(getRandom(-1.0f, 1.0f));
+		}
+		positions[i * 4 + 3] = 0;
+
+		getRandomDirection(&directions[i * 3]);
+
+		VertexFormat::packOctahedral16(&normals[i * 2], &directions[i * 3]);
+	}
+
+	VertexFormat positionFormat(GL_SHORT, 3, GL_TRUE, false, 8);
+	VertexFormat normalFormat(GL_SHORT, 2, GL_TRUE, true, 0);
+
+	// One operation is one vertex.
+
+	harness.run("quantization", "unpack snorm16 position", NUMBER_VERTICES, [&]()
+	{
+		positionFormat.unpack(unpacked.data(), 4, positions.data(), NUMBER_VERTICES);
+		harness.consume(unpacked[0]);
+	});
+
+	harness.run("quantization", "unpack octahedral16 normal", NUMBER_VERTICES, [&]()
+	{
+		normalFormat.unpack(unpacked.data(), 3, normals.data(), NUMBER_VERTICES);
+		harness.consume(unpacked[0]);
+	});
+
+	harness.run("quantization", "pack octahedral16 normal", NUMBER_VERTICES, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_VERTICES; i++)
+		{
+			VertexFormat::packOctahedral16(&normals[i * 2], &directions[i * 3]);
+		}
+		harness.consume(static_cast<float>(normals[0]));
+	});
+}
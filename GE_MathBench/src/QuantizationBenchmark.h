@@ -0,0 +1,10 @@
+#ifndef QUANTIZATIONBENCHMARK_H_
+#define QUANTIZATIONBENCHMARK_H_
+
+class BenchmarkHarness;
+
+bool validateQuantization();
+
+void benchmarkQuantization(BenchmarkHarness& harness);
+
+#endif /* QUANTIZATIONBENCHMARK_H_ */
@@ -0,0 +1,196 @@
+#include "GraphicsEngine.h"
+
+#include "BenchmarkHarness.h"
+
+#include "QuaternionBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_QUATERNIONS 1024
+#define NUMBER_VALIDATIONS 10000
+
+static float getRandom(float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+static CompactQuaternion getRandomQuaternion()
+{
+	CompactQuaternion result;
+
+	result.rotateRzRyRxf(getRandom(-180.0f, 180.0f), getRandom(-180.0f, 180.0f), getRandom(-180.0f, 180.0f));
+
+	return result;
+}
+
+static bool isEqual(const float* result, const float* expected, int32_t count, float tolerance)
+{
+	for (int32_t i = 0; i < count; i++)
+	{
+		if (fabsf(result[i] - expected[i]) > tolerance * max(1.0f, fabsf(expected[i])))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool report(const char* name, int32_t failures)
+{
+	printf("Validation %-16s %s (%d failures)\n", name, failures == 0 ? "passed" : "FAILED", failures);
+
+	return failures == 0;
+}
+
+bool validateQuaternion()
+{
+	srand(1);
+
+	int32_t matrixFailures = 0;
+	int32_t rotateFailures = 0;
+	int32_t batchFailures = 0;
+	int32_t slerpFailures = 0;
+
+	for (int32_t i = 0; i < NUMBER_VALIDATIONS; i++)
+	{
+		CompactQuaternion quaternion0 = getRandomQuaternion();
+		CompactQuaternion quaternion1 = getRandomQuaternion();
+
+		float expected[16];
+		float result[16];
+
+		glusQuaternionGetMatrix4x4f(expected, quaternion0.getQ());
+		quaternion0.getRotationMatrix4x4(result);
+		matrixFailures += isEqual(result, expected, 16, 1.0e-6f) ? 0 : 1;
+
+		Vector3 vector(getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f));
+
+		Vector3 expectedVector = Quaternion(quaternion0) * vector;
+		Vector3 resultVector = quaternion0 * vector;
+		rotateFailures += isEqual(resultVector.getV(), expectedVector.getV(), 3, 1.0e-4f) ? 0 : 1;
+
+		quaternion0.rotate(&resultVector, &vector, 1);
+		batchFailures += isEqual(resultVector.getV(), expectedVector.getV(), 3, 1.0e-4f) ? 0 : 1;
+
+		// GLUS does not take the shorter arc.
+		if (quaternion0.dot(quaternion1) >= 0.0f)
+		{
+			float t = getRandom(0.0f, 1.0f);
+
+			glusQuaternionSlerpf(expected, quaternion0.getQ(), quaternion1.getQ(), t);
+			CompactQuaternion resultQuaternion = quaternion0.slerp(quaternion1, t);
+			slerpFailures += isEqual(resultQuaternion.getQ(), expected, 4, 1.0e-3f) ? 0 : 1;
+		}
+	}
+
+	bool passed = true;
+
+	passed = report("quaternionMatrix", matrixFailures) && passed;
+	passed = report("quaternionRotate", rotateFailures) && passed;
+	passed = report("quaternionBatch", batchFailures) && passed;
+	passed = report("quaternionSlerp", slerpFailures) && passed;
+
+	return passed;
+}
+
+void benchmarkQuaternion(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("quaternion"))
+	{
+		return;
+	}
+
+	srand(1);
+
+	printf("Quaternion size: %d bytes  CompactQuaternion size: %d bytes\n", static_cast<int32_t>(sizeof(Quaternion)), static_cast<int32_t>(sizeof(CompactQuaternion)));
+
+	vector<CompactQuaternion> allQuaternions(NUMBER_QUATERNIONS);
+	vector<Quaternion> allAdapters(NUMBER_QUATERNIONS);
+
+	vector<Vector3> allVectors(NUMBER_QUATERNIONS);
+	vector<Vector3> allResults(NUMBER_QUATERNIONS);
+
+	for (int32_t i = 0; i < NUMBER_QUATERNIONS; i++)
+	{
+		allQuaternions[i] = getRandomQuaternion();
+		allAdapters[i] = Quaternion(allQuaternions[i]);
+
+		allVectors[i] = Vector3(getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f), getRandom(-100.0f, 100.0f));
+	}
+
+	// Assigned every time, as entities do when a new rotation is set.
+
+	harness.run("quaternion", "matrix adapter", NUMBER_QUATERNIONS, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_QUATERNIONS; i++)
+		{
+			allAdapters[i] = allAdapters[(i + 1) % NUMBER_QUATERNIONS];
+			harness.consume(allAdapters[i].getRotationMatrix4x4().getM()[0]);
+		}
+	});
+
+	harness.run("quaternion", "matrix compact", NUMBER_QUATERNIONS, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_QUATERNIONS; i++)
+		{
+			allQuaternions[i] = allQuaternions[(i + 1) % NUMBER_QUATERNIONS];
+			harness.consume(allQuaternions[i].getRotationMatrix4x4().getM()[0]);
+		}
+	});
+
+	harness.run("quaternion", "fromMatrix3x3", NUMBER_QUATERNIONS, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_QUATERNIONS; i++)
+		{
+			harness.consume(CompactQuaternion(allQuaternions[i].getRotationMatrix3x3()).getQ()[0]);
+		}
+	});
+
+	harness.run("quaternion", "rotate adapter", NUMBER_QUATERNIONS, [&]()
+	{
+		const Quaternion& rotation = allAdapters[0];
+
+		for (int32_t i = 0; i < NUMBER_QUATERNIONS; i++)
+		{
+			allResults[i] = rotation * allVectors[i];
+		}
+
+		harness.consume(allResults[0].getX());
+	});
+
+	harness.run("quaternion", "rotate compact", NUMBER_QUATERNIONS, [&]()
+	{
+		const CompactQuaternion& rotation = allQuaternions[0];
+
+		for (int32_t i = 0; i < NUMBER_QUATERNIONS; i++)
+		{
+			allResults[i] = rotation * allVectors[i];
+		}
+
+		harness.consume(allResults[0].getX());
+	});
+
+	harness.run("quaternion", "rotate batch", NUMBER_QUATERNIONS, [&]()
+	{
+		allQuaternions[0].rotate(&allResults[0], &allVectors[0], NUMBER_QUATERNIONS);
+
+		harness.consume(allResults[0].getX());
+	});
+
+	harness.run("quaternion", "slerp", NUMBER_QUATERNIONS, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_QUATERNIONS; i++)
+		{
+			harness.consume(allQuaternions[i].slerp(allQuaternions[(i + 1) % NUMBER_QUATERNIONS], 0.25f).getQ()[0]);
+		}
+	});
+
+	harness.run("quaternion", "nlerp", NUMBER_QUATERNIONS, [&]()
+	{
+		for (int32_t i = 0; i < NUMBER_QUATERNIONS; i++)
+		{
+			harness.consume(allQuaternions[i].nlerp(allQuaternions[(i + 1) % NUMBER_QUATERNIONS], 0.25f).getQ()[0]);
+		}
+	});
+}
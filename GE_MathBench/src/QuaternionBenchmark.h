@@ -0,0 +1,10 @@
+#ifndef QUATERNIONBENCHMARK_H_
+#define QUATERNIONBENCHMARK_H_
+
+class BenchmarkHarness;
+
+bool validateQuaternion();
+
+void benchmarkQuaternion(BenchmarkHarness& harness);
+
+#endif /* QUATERNIONBENCHMARK_H_ */
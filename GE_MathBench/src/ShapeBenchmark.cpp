@@ -0,0 +1,83 @@
+#include "GraphicsEngine.h"
+
+#include "BenchmarkHarness.h"
+
+#include "ShapeBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_SLICES 64
+
+// One operation is one created and destroyed shape.
+
+static void consumeShape(BenchmarkHarness& harness, GLUSshape& shape)
+{
+	harness.consume(static_cast<float>(shape.numberVertices));
+
+	glusShapeDestroyf(&shape);
+}
+
+void benchmarkShape(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("shape"))
+	{
+		return;
+	}
+
+	GLUSshape shape;
+
+	harness.run("shape", "glusShapeCreatePlanef", 1, [&]()
+	{
+		glusShapeCreatePlanef(&shape, 1.0f);
+		consumeShape(harness, shape);
+	});
+
+	harness.run("shape", "glusShapeCreateCubef", 1, [&]()
+	{
+		glusShapeCreateCubef(&shape, 1.0f);
+		consumeShape(harness, shape);
+	});
+
+	harness.run("shape", "glusShapeCreateSpheref", 1, [&]()
+	{
+		glusShapeCreateSpheref(&shape, 1.0f, NUMBER_SLICES);
+		consumeShape(harness, shape);
+	});
+
+	harness.run("shape", "glusShapeCreateDomef", 1, [&]()
+	{
+		glusShapeCreateDomef(&shape, 1.0f, NUMBER_SLICES);
+		consumeShape(harness, shape);
+	});
+
+	harness.run("shape", "glusShapeCreateTorusf", 1, [&]()
+	{
+		glusShapeCreateTorusf(&shape, 0.5f, 1.0f, NUMBER_SLICES, NUMBER_SLICES);
+		consumeShape(harness, shape);
+	});
+
+	harness.run("shape", "glusShapeCreateCylinderf", 1, [&]()
+	{
+		glusShapeCreateCylinderf(&shape, 1.0f, 0.5f, NUMBER_SLICES);
+		consumeShape(harness, shape);
+	});
+
+	harness.run("shape", "glusShapeCreateConef", 1, [&]()
+	{
+		glusShapeCreateConef(&shape, 1.0f, 0.5f, NUMBER_SLICES, NUMBER_SLICES);
+		consumeShape(harness, shape);
+	});
+
+	harness.run("shape", "glusShapeCreateRectangularGridPlanef", 1, [&]()
+	{
+		glusShapeCreateRectangularGridPlanef(&shape, 1.0f, 1.0f, NUMBER_SLICES, NUMBER_SLICES, GLUS_FALSE);
+		consumeShape(harness, shape);
+	});
+
+	harness.run("shape", "glusShapeCalculateTangentBitangentf", 1, [&]()
+	{
+		glusShapeCreateSpheref(&shape, 1.0f, NUMBER_SLICES);
+		glusShapeCalculateTangentBitangentf(&shape);
+		consumeShape(harness, shape);
+	});
+}
@@ -0,0 +1,8 @@
+#ifndef SHAPEBENCHMARK_H_
+#define SHAPEBENCHMARK_H_
+
+class BenchmarkHarness;
+
+void benchmarkShape(BenchmarkHarness& harness);
+
+#endif /* SHAPEBENCHMARK_H_ */
@@ -0,0 +1,449 @@
+#include "GraphicsEngine.h"
+
+#include "BenchmarkHarness.h"
+
+#include "SkeletonBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_NODES 64
+#define NUMBER_JOINTS 64
+
+#define NUMBER_RIG_NODES 256
+#define NUMBER_RIG_JOINTS 2048
+
+#define NUMBER_PALETTE_JOINTS 300
+
+#define PALETTE_TOLERANCE 1.0e-4f
+
+/**
+ * Instance nodes of the benchmarks do neither render nor have lights or cameras.
+ */
+class EmptyNodeOwner : public NodeOwner
+{
+
+public:
+
+	EmptyNodeOwner() :
+			NodeOwner()
+	{
+	}
+
+	virtual ~EmptyNodeOwner()
+	{
+	}
+
+	virtual void renderNode(const Node& node, const InstanceNode& instanceNode, float time, int32_t animStackIndex, int32_t animLayerIndex) const
+	{
+		(void)node;
+		(void)instanceNode;
+		(void)time;
+		(void)animStackIndex;
+		(void)animLayerIndex;
+	}
+
+	virtual void addLightNode(const InstanceNodeSP& lightNode)
+	{
+		(void)lightNode;
+	}
+
+	virtual void addCameraNode(const InstanceNodeSP& cameraNode)
+	{
+		(void)cameraNode;
+	}
+
+};
+
+/**
+ * Creates a root with a chain of nodes and a skeleton of two joints per parent joint below it.
+ */
+static void createRig(NodeTreeFactory& nodeTreeFactory, int32_t numberNodes, int32_t numberJoints)
+{
+	vector<AnimationStackSP> allAnimStacks;
+
+	nodeTreeFactory.reset();
+
+	nodeTreeFactory.createNode("root", "", MeshSP(), CameraSP(), LightSP(), allAnimStacks);
+
+	string parentName = "root";
+
+	for (int32_t i = 0; i < numberNodes; i++)
+	{
+		string name = "node_" + to_string(i);
+
+		nodeTreeFactory.createNode(name, parentName, MeshSP(), CameraSP(), LightSP(), allAnimStacks);
+
+		parentName = name;
+	}
+
+	for (int32_t i = 0; i < numberJoints; i++)
+	{
+		string name = "joint_" + to_string(i);
+
+		nodeTreeFactory.createNode(name, i == 0 ? "root" : "joint_" + to_string((i - 1) / 2), MeshSP(), CameraSP(), LightSP(), allAnimStacks);
+
+		nodeTreeFactory.setJoint(name);
+	}
+
+	nodeTreeFactory.createIndex();
+}
+
+static float getRandom(float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+static Matrix4x4 getRandomTransform()
+{
+	Matrix4x4 matrix;
+
+	matrix.translate(getRandom(-10.0f, 10.0f), getRandom(-10.0f, 10.0f), getRandom(-10.0f, 10.0f));
+	matrix.rotateRzRyRx(getRandom(-180.0f, 180.0f), getRandom(-180.0f, 180.0f), getRandom(-180.0f, 180.0f));
+	matrix.scale(getRandom(0.5f, 2.0f), getRandom(0.5f, 2.0f), getRandom(0.5f, 2.0f));
+
+	return matrix;
+}
+
+/**
+ * Name lookup as done by the importers before the name index, by comparing all names of the tree.
+ */
+static int32_t getJointIndexRecursive(const Node& node, const string& name)
+{
+	if (node.getName().compare(name) == 0)
+	{
+		return node.getJointIndex();
+	}
+
+	for (uint32_t i = 0; i < node.getChildCount(); i++)
+	{
+		int32_t childIndex = getJointIndexRecursive(*node.getChild(i), name);
+
+		if (childIndex != -1)
+		{
+			return childIndex;
+		}
+	}
+
+	return -1;
+}
+
+static bool report(const char* name, int32_t failures)
+{
+	printf("Validation %-16s %s (%d failures)\n", name, failures == 0 ? "passed" : "FAILED", failures);
+
+	return failures == 0;
+}
+
+bool validateStatistic()
+{
+	int32_t failures = 0;
+
+	NodeTreeFactory nodeTreeFactory;
+
+	createRig(nodeTreeFactory, NUMBER_NODES, NUMBER_JOINTS);
+
+	NodeSP rootNode = nodeTreeFactory.getRootNode();
+
+	EmptyNodeOwner nodeOwner;
+
+	InstanceNodeSP rootInstanceNode = InstanceNodeSP(new InstanceNode(rootNode.get()));
+
+	rootNode->updateInstanceNode(nodeOwner, rootInstanceNode);
+
+	vector<Matrix4x4> inverseBindMatrices(NUMBER_JOINTS);
+	vector<Matrix3x3> inverseBindNormalMatrices(NUMBER_JOINTS);
+
+	rootNode->updateInverseBindMatrix(&inverseBindMatrices[0], &inverseBindNormalMatrices[0]);
+
+	PoseCache poseCache;
+	poseCache.setTimeStep(1.0f / 30.0f);
+
+	// Values of earlier validations are not part of the first frame.
+	StatisticCounter::nextFrameAll();
+
+	// First frame: All instance nodes are dirty and two instances share one pose.
+
+	rootNode->updateRenderMatrix(nodeOwner, *rootInstanceNode, Matrix4x4(), 0.0f, -1, -1, false);
+
+	int32_t animatedJoints;
+
+	poseCache.getPose(*rootNode, &inverseBindMatrices[0], &inverseBindNormalMatrices[0], NUMBER_JOINTS, 0.0f, 0, 0, animatedJoints);
+	ModelEntity::animatedJoints.increase(animatedJoints);
+
+	poseCache.getPose(*rootNode, &inverseBindMatrices[0], &inverseBindNormalMatrices[0], NUMBER_JOINTS, 0.0f, 0, 0, animatedJoints);
+	ModelEntity::animatedJoints.increase(animatedJoints);
+
+	StatisticCounter::nextFrameAll();
+
+	printf("Frame 1: %d recalculated nodes, %d animated joints, %d pose hits, %d pose misses\n", Node::recalculatedNodes.getLastValue(), ModelEntity::animatedJoints.getLastValue(), PoseCache::hits.getLastValue(), PoseCache::misses.getLastValue());
+
+	// The root and the chain of nodes, joints are not recalculated by the render matrix update.
+	if (Node::recalculatedNodes.getLastValue() != NUMBER_NODES + 1 || Node::recalculatedNodes.getCurrentValue() != 0)
+	{
+		failures++;
+	}
+
+	if (ModelEntity::animatedJoints.getLastValue() != NUMBER_JOINTS)
+	{
+		failures++;
+	}
+
+	if (PoseCache::hits.getLastValue() != 1 || PoseCache::misses.getLastValue() != 1 || PoseCache::getLastHitRate() != 0.5f)
+	{
+		failures++;
+	}
+
+	// Second frame: Nothing did change, so nothing is recalculated.
+
+	rootNode->updateRenderMatrix(nodeOwner, *rootInstanceNode, Matrix4x4(), 0.0f, -1, -1, false);
+
+	poseCache.getPose(*rootNode, &inverseBindMatrices[0], &inverseBindNormalMatrices[0], NUMBER_JOINTS, 0.0f, 0, 0, animatedJoints);
+	ModelEntity::animatedJoints.increase(animatedJoints);
+
+	StatisticCounter::nextFrameAll();
+
+	printf("Frame 2: %d recalculated nodes, %d animated joints, %d pose hits, %d pose misses\n", Node::recalculatedNodes.getLastValue(), ModelEntity::animatedJoints.getLastValue(), PoseCache::hits.getLastValue(), PoseCache::misses.getLastValue());
+
+	if (Node::recalculatedNodes.getLastValue() != 0 || ModelEntity::animatedJoints.getLastValue() != 0)
+	{
+		failures++;
+	}
+
+	if (PoseCache::hits.getLastValue() != 1 || PoseCache::misses.getLastValue() != 0 || PoseCache::getLastHitRate() != 1.0f)
+	{
+		failures++;
+	}
+
+	return report("statistic", failures);
+}
+
+bool validateSkinningPalette()
+{
+	srand(1);
+
+	int32_t matrixFailures = 0;
+	int32_t normalFailures = 0;
+	int32_t sizeFailures = 0;
+
+	vector<Matrix4x4> bindMatrices(NUMBER_PALETTE_JOINTS);
+	vector<Matrix3x3> bindNormalMatrices(NUMBER_PALETTE_JOINTS);
+	vector<Matrix4x4> inverseBindMatrices(NUMBER_PALETTE_JOINTS);
+	vector<Matrix3x3> inverseBindNormalMatrices(NUMBER_PALETTE_JOINTS);
+
+	for (int32_t i = 0; i < NUMBER_PALETTE_JOINTS; i++)
+	{
+		bindMatrices[i] = getRandomTransform();
+		bindNormalMatrices[i] = bindMatrices[i].extractNormalMatrix3x3();
+
+		inverseBindMatrices[i] = getRandomTransform();
+		inverseBindNormalMatrices[i] = inverseBindMatrices[i].extractNormalMatrix3x3();
+	}
+
+	SkinningPalette skinningPalette;
+
+	skinningPalette.build(&bindMatrices[0], &bindNormalMatrices[0], &inverseBindMatrices[0], &inverseBindNormalMatrices[0], NUMBER_PALETTE_JOINTS);
+
+	const float* data = skinningPalette.getData();
+
+	// Texels are read back as by the shader and compared to the CPU joint matrices.
+
+	for (int32_t i = 0; i < NUMBER_PALETTE_JOINTS; i++)
+	{
+		const float* texels = &data[SkinningPalette::getTexelOffset(i) * 4];
+
+		const float* bindMatrix = bindMatrices[i].getM();
+		const float* inverseBindMatrix = inverseBindMatrices[i].getM();
+
+		float skinningMatrix[16];
+
+		for (int32_t column = 0; column < 4; column++)
+		{
+			for (int32_t row = 0; row < 4; row++)
+			{
+				skinningMatrix[column * 4 + row] = 0.0f;
+
+				for (int32_t k = 0; k < 4; k++)
+				{
+					skinningMatrix[column * 4 + row] += bindMatrix[k * 4 + row] * inverseBindMatrix[column * 4 + k];
+				}
+			}
+		}
+
+		float maximum = 1.0f;
+
+		for (int32_t k = 0; k < 16; k++)
+		{
+			maximum = fmaxf(maximum, fabsf(skinningMatrix[k]));
+		}
+
+		for (int32_t k = 0; k < 16; k++)
+		{
+			if (fabsf(texels[k] - skinningMatrix[k]) > PALETTE_TOLERANCE * maximum)
+			{
+				matrixFailures++;
+
+				break;
+			}
+		}
+
+		// The normal matrix is the inverse transpose of the upper 3x3, which is the cofactor matrix divided by the determinant.
+		const float* m = skinningMatrix;
+
+		float cofactor[9];
+
+		cofactor[0] = m[5] * m[10] - m[6] * m[9];
+		cofactor[1] = m[6] * m[8] - m[4] * m[10];
+		cofactor[2] = m[4] * m[9] - m[5] * m[8];
+		cofactor[3] = m[2] * m[9] - m[1] * m[10];
+		cofactor[4] = m[0] * m[10] - m[2] * m[8];
+		cofactor[5] = m[1] * m[8] - m[0] * m[9];
+		cofactor[6] = m[1] * m[6] - m[2] * m[5];
+		cofactor[7] = m[2] * m[4] - m[0] * m[6];
+		cofactor[8] = m[0] * m[5] - m[1] * m[4];
+
+		float determinant = m[0] * cofactor[0] + m[1] * cofactor[1] + m[2] * cofactor[2];
+
+		maximum = 1.0f;
+
+		for (int32_t k = 0; k < 9; k++)
+		{
+			cofactor[k] /= determinant;
+
+			maximum = fmaxf(maximum, fabsf(cofactor[k]));
+		}
+
+		for (int32_t column = 0; column < 3; column++)
+		{
+			const float* texel = &texels[16 + column * 4];
+
+			if (fabsf(texel[0] - cofactor[column * 3 + 0]) > PALETTE_TOLERANCE * maximum || fabsf(texel[1] - cofactor[column * 3 + 1]) > PALETTE_TOLERANCE * maximum || fabsf(texel[2] - cofactor[column * 3 + 2]) > PALETTE_TOLERANCE * maximum || texel[3] != 0.0f)
+			{
+				normalFailures++;
+
+				break;
+			}
+		}
+	}
+
+	// The texture buffer has to hold the last texel fetched by the shader and nothing more.
+
+	if (SkinningPalette::getTexelOffset(0) != 0 || SkinningPalette::getTexelOffset(1) != SkinningPalette::TEXELS_PER_JOINT)
+	{
+		sizeFailures++;
+	}
+
+	GLsizeiptr texelSize = 4 * sizeof(float);
+
+	if (skinningPalette.getByteSize() != static_cast<GLsizeiptr>(SkinningPalette::getTexelOffset(NUMBER_PALETTE_JOINTS - 1) + SkinningPalette::TEXELS_PER_JOINT) * texelSize)
+	{
+		sizeFailures++;
+	}
+
+	// Fewer joints reuse the buffer, so only their part is uploaded.
+	skinningPalette.build(&bindMatrices[0], &bindNormalMatrices[0], &inverseBindMatrices[0], &inverseBindNormalMatrices[0], NUMBER_PALETTE_JOINTS / 2);
+
+	if (skinningPalette.getByteSize() != static_cast<GLsizeiptr>(SkinningPalette::getTexelOffset(NUMBER_PALETTE_JOINTS / 2)) * texelSize || skinningPalette.isUploaded())
+	{
+		sizeFailures++;
+	}
+
+	skinningPalette.build(&bindMatrices[0], &bindNormalMatrices[0], &inverseBindMatrices[0], &inverseBindNormalMatrices[0], 0);
+
+	if (skinningPalette.getByteSize() != 0 || skinningPalette.getData() != nullptr)
+	{
+		sizeFailures++;
+	}
+
+	bool result = report("palette matrix", matrixFailures);
+	result = report("palette normal", normalFailures) && result;
+	result = report("palette size", sizeFailures) && result;
+
+	return result;
+}
+
+void benchmarkSkeleton(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("skeleton"))
+	{
+		return;
+	}
+
+	NodeTreeFactory nodeTreeFactory;
+
+	createRig(nodeTreeFactory, NUMBER_RIG_NODES, NUMBER_RIG_JOINTS);
+
+	NodeSP rootNode = nodeTreeFactory.getRootNode();
+
+	// Joints are looked up in a scattered order, like the joint names of a skin.
+	vector<string> allJointNames(NUMBER_RIG_JOINTS);
+
+	for (int32_t i = 0; i < NUMBER_RIG_JOINTS; i++)
+	{
+		allJointNames[i] = "joint_" + to_string((i * 7919) % NUMBER_RIG_JOINTS);
+	}
+
+	string suffix = " " + to_string(NUMBER_RIG_NODES + NUMBER_RIG_JOINTS + 1);
+
+	harness.run("skeleton", "create rig" + suffix, NUMBER_RIG_NODES + NUMBER_RIG_JOINTS + 1, [&]()
+	{
+		NodeTreeFactory currentNodeTreeFactory;
+
+		createRig(currentNodeTreeFactory, NUMBER_RIG_NODES, NUMBER_RIG_JOINTS);
+
+		harness.consume(static_cast<float>(currentNodeTreeFactory.getIndex("joint_1")));
+	});
+
+	harness.run("skeleton", "joint index recursive" + suffix, NUMBER_RIG_JOINTS, [&]()
+	{
+		int32_t sum = 0;
+
+		for (int32_t i = 0; i < NUMBER_RIG_JOINTS; i++)
+		{
+			sum += getJointIndexRecursive(*rootNode, allJointNames[i]);
+		}
+
+		harness.consume(static_cast<float>(sum));
+	});
+
+	harness.run("skeleton", "joint index name index" + suffix, NUMBER_RIG_JOINTS, [&]()
+	{
+		int32_t sum = 0;
+
+		for (int32_t i = 0; i < NUMBER_RIG_JOINTS; i++)
+		{
+			sum += nodeTreeFactory.getIndex(allJointNames[i]);
+		}
+
+		harness.consume(static_cast<float>(sum));
+	});
+
+	harness.run("skeleton", "node recursive" + suffix, NUMBER_RIG_JOINTS, [&]()
+	{
+		int32_t count = 0;
+
+		for (int32_t i = 0; i < NUMBER_RIG_JOINTS; i++)
+		{
+			if (rootNode->findChildRecursive(allJointNames[i]).get())
+			{
+				count++;
+			}
+		}
+
+		harness.consume(static_cast<float>(count));
+	});
+
+	harness.run("skeleton", "node name index" + suffix, NUMBER_RIG_JOINTS, [&]()
+	{
+		int32_t count = 0;
+
+		for (int32_t i = 0; i < NUMBER_RIG_JOINTS; i++)
+		{
+			if (nodeTreeFactory.getNode(allJointNames[i]).get())
+			{
+				count++;
+			}
+		}
+
+		harness.consume(static_cast<float>(count));
+	});
+}
@@ -0,0 +1,12 @@
+#ifndef SKELETONBENCHMARK_H_
+#define SKELETONBENCHMARK_H_
+
+class BenchmarkHarness;
+
+bool validateStatistic();
+
+bool validateSkinningPalette();
+
+void benchmarkSkeleton(BenchmarkHarness& harness);
+
+#endif /* SKELETONBENCHMARK_H_ */
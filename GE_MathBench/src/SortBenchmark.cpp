@@ -0,0 +1,78 @@
+#include <algorithm>
+
+#include "GraphicsEngine.h"
+
+#include "layer0/algorithm/Quicksort.h"
+#include "layer0/algorithm/QuicksortPointer.h"
+
+#include "BenchmarkHarness.h"
+
+#include "SortBenchmark.h"
+
+using namespace std;
+
+#define NUMBER_ELEMENTS 100000
+
+void benchmarkSort(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("sort"))
+	{
+		return;
+	}
+
+	srand(1);
+
+	vector<float> allUnsorted(NUMBER_ELEMENTS);
+
+	for (int32_t i = 0; i < NUMBER_ELEMENTS; i++)
+	{
+		allUnsorted[i] = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+	}
+
+	vector<float> allElements;
+
+	vector<const float*> allUnsortedPointers(NUMBER_ELEMENTS);
+
+	for (int32_t i = 0; i < NUMBER_ELEMENTS; i++)
+	{
+		allUnsortedPointers[i] = &allUnsorted[i];
+	}
+
+	vector<const float*> allPointers;
+
+	// Setup restores the unsorted order before every sample.
+
+	Quicksort<float> quicksort;
+
+	harness.run("sort", "Quicksort", NUMBER_ELEMENTS, [&]()
+	{
+		quicksort.sort(allElements);
+
+		harness.consume(allElements[0]);
+	}, [&]()
+	{
+		allElements = allUnsorted;
+	});
+
+	harness.run("sort", "std::sort", NUMBER_ELEMENTS, [&]()
+	{
+		sort(allElements.begin(), allElements.end());
+
+		harness.consume(allElements[0]);
+	}, [&]()
+	{
+		allElements = allUnsorted;
+	});
+
+	QuicksortPointer<const float*> quicksortPointer;
+
+	harness.run("sort", "QuicksortPointer", NUMBER_ELEMENTS, [&]()
+	{
+		quicksortPointer.sort(allPointers);
+
+		harness.consume(*allPointers[0]);
+	}, [&]()
+	{
+		allPointers = allUnsortedPointers;
+	});
+}
@@ -0,0 +1,8 @@
+#ifndef SORTBENCHMARK_H_
+#define SORTBENCHMARK_H_
+
+class BenchmarkHarness;
+
+void benchmarkSort(BenchmarkHarness& harness);
+
+#endif /* SORTBENCHMARK_H_ */
@@ -0,0 +1,91 @@
+#include "GraphicsEngine.h"
+
+#include "BenchmarkHarness.h"
+
+#include "TransformBenchmark.h"
+
+using namespace std;
+
+static float getRandom(float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+}
+
+static void benchmarkCount(BenchmarkHarness& harness, const Matrix4x4& matrix, int32_t count)
+{
+	vector<Point4> allPoints(count);
+	vector<Point4> allResults(count);
+
+	vector<float> allX(count), allY(count), allZ(count);
+	vector<float> allResultX(count), allResultY(count), allResultZ(count);
+
+	vector<float> allSpheres(count * 4);
+	vector<float> allResultSpheres(count * 4);
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		allX[i] = getRandom(-100.0f, 100.0f);
+		allY[i] = getRandom(-100.0f, 100.0f);
+		allZ[i] = getRandom(-100.0f, 100.0f);
+
+		allPoints[i] = Point4(allX[i], allY[i], allZ[i]);
+
+		allSpheres[i * 4 + 0] = allX[i];
+		allSpheres[i * 4 + 1] = allY[i];
+		allSpheres[i * 4 + 2] = allZ[i];
+		allSpheres[i * 4 + 3] = getRandom(0.1f, 10.0f);
+	}
+
+	string suffix = " " + to_string(count);
+
+	harness.run("transform", "single" + suffix, count, [&]()
+	{
+		for (int32_t i = 0; i < count; i++)
+		{
+			allResults[i] = matrix * allPoints[i];
+		}
+
+		harness.consume(allResults[count - 1].getX());
+	});
+
+	harness.run("transform", "batch AoS" + suffix, count, [&]()
+	{
+		matrix.transform(&allResults[0], &allPoints[0], count);
+
+		harness.consume(allResults[count - 1].getX());
+	});
+
+	harness.run("transform", "batch SoA" + suffix, count, [&]()
+	{
+		simdMatrix4x4MultiplyPoints3f(&allResultX[0], &allResultY[0], &allResultZ[0], matrix.getM(), &allX[0], &allY[0], &allZ[0], count);
+
+		harness.consume(allResultX[count - 1]);
+	});
+
+	harness.run("transform", "spheres" + suffix, count, [&]()
+	{
+		simdMatrix4x4MultiplySpheresf(&allResultSpheres[0], matrix.getM(), &allSpheres[0], count);
+
+		harness.consume(allResultSpheres[(count - 1) * 4]);
+	});
+}
+
+void benchmarkTransform(BenchmarkHarness& harness)
+{
+	if (!harness.isEnabled("transform"))
+	{
+		return;
+	}
+
+	srand(1);
+
+	Matrix4x4 matrix;
+	matrix.translate(1.0f, 2.0f, 3.0f);
+	matrix.rotateRzRyRx(30.0f, 45.0f, 60.0f);
+	matrix.scale(1.0f, 2.0f, 3.0f);
+
+	for (int32_t count = 1000; count <= 1000000; count *= 10)
+	{
+		benchmarkCount(harness, matrix, count);
+	}
+}
@@ -0,0 +1,8 @@
+#ifndef TRANSFORMBENCHMARK_H_
+#define TRANSFORMBENCHMARK_H_
+
+class BenchmarkHarness;
+
+void benchmarkTransform(BenchmarkHarness& harness);
+
+#endif /* TRANSFORMBENCHMARK_H_ */
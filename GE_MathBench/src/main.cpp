@@ -0,0 +1,133 @@
+#include "GraphicsEngine.h"
+
+#include "BenchmarkHarness.h"
+
+#include "FrustumBenchmark.h"
+#include "InterpolationBenchmark.h"
+#include "JsonBenchmark.h"
+#include "MatrixBenchmark.h"
+#include "QuantizationBenchmark.h"
+#include "QuaternionBenchmark.h"
+#include "ShapeBenchmark.h"
+#include "SkeletonBenchmark.h"
+#include "SortBenchmark.h"
+#include "TransformBenchmark.h"
+
+using namespace std;
+
+static void printUsage()
+{
+	printf("Usage: GE_MathBench [-warmups n] [-samples n] [-filter group] [-csv filename]\n");
+}
+
+int main(int argc, char* argv[])
+{
+	int32_t warmups = 3;
+	int32_t samples = 31;
+	string filter = "";
+	string csvFilename = "";
+
+	for (int32_t i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+
+		if (i + 1 >= argc)
+		{
+			printUsage();
+
+			return 1;
+		}
+
+		if (argument == "-warmups")
+		{
+			warmups = atoi(argv[++i]);
+		}
+		else if (argument == "-samples")
+		{
+			samples = atoi(argv[++i]);
+		}
+		else if (argument == "-filter")
+		{
+			filter = argv[++i];
+		}
+		else if (argument == "-csv")
+		{
+			csvFilename = argv[++i];
+		}
+		else
+		{
+			printUsage();
+
+			return 1;
+		}
+	}
+
+	if (!validateMatrix())
+	{
+		return 1;
+	}
+
+	if (!validateQuaternion())
+	{
+		return 1;
+	}
+
+	if (!validateInterpolation())
+	{
+		return 1;
+	}
+
+	if (!validateJson())
+	{
+		return 1;
+	}
+
+	if (!validateJsonLazy())
+	{
+		return 1;
+	}
+
+	if (!validateJsonNumber())
+	{
+		return 1;
+	}
+
+	if (!validateQuantization())
+	{
+		return 1;
+	}
+
+	if (!validateStatistic())
+	{
+		return 1;
+	}
+
+	if (!validateSkinningPalette())
+	{
+		return 1;
+	}
+
+	BenchmarkHarness harness(warmups, samples, filter);
+
+	benchmarkMatrix(harness);
+	benchmarkTransform(harness);
+	benchmarkQuaternion(harness);
+	benchmarkFrustum(harness);
+	benchmarkInterpolation(harness);
+	benchmarkSort(harness);
+	benchmarkJson(harness);
+	benchmarkShape(harness);
+	benchmarkQuantization(harness);
+	benchmarkSkeleton(harness);
+
+	harness.printSummary();
+
+	if (csvFilename != "" && !harness.writeCsv(csvFilename))
+	{
+		printf("Error: Could not write %s\n", csvFilename.c_str());
+
+		return 1;
+	}
+
+	return 0;
+}
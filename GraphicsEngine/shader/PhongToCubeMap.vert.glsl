@@ -1,17 +1,17 @@
 #version 410 core
 
 #define MAX_SKIN_INDICES 8
-#define MAX_MATRICES 64
+#define TEXELS_PER_JOINT 7
 
 uniform mat4 u_modelMatrix;
 uniform mat3 u_normalModelMatrix;
 
-uniform mat4 u_bindMatrix[MAX_MATRICES];
-uniform mat3 u_bindNormalMatrix[MAX_MATRICES];
-uniform mat4 u_inverseBindMatrix[MAX_MATRICES];
-uniform mat3 u_inverseBindNormalMatrix[MAX_MATRICES];
+// Per joint: Four texels skinning matrix, three texels skinning normal matrix.
+uniform samplerBuffer u_skinningPalette;
 
 uniform int u_hasSkinning;
+uniform int u_hasOctahedralNormals;
+uniform int u_hasOctahedralTangents;
 uniform	int u_hasDiffuseTexture;
 uniform	int u_hasNormalMapTexture;
 
@@ -37,8 +37,36 @@ out vec3 v_g_bitangent;
 out vec3 v_g_tangent;
 out vec2 v_g_texCoord;
 
+vec3 decodeOctahedral(vec2 encoded)
+{
+	vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+
+	if (direction.z < 0.0)
+	{
+		direction.xy = (1.0 - abs(encoded.yx)) * vec2(encoded.x >= 0.0 ? 1.0 : -1.0, encoded.y >= 0.0 ? 1.0 : -1.0);
+	}
+
+	return normalize(direction);
+}
+
 void main(void)
 {
+	// Quantized directions with two components, see VertexFormat::unpackOctahedral.
+	vec3 inNormal = a_normal;
+	vec3 inBitangent = a_bitangent;
+	vec3 inTangent = a_tangent;
+
+	if (u_hasOctahedralNormals != 0)
+	{
+		inNormal = decodeOctahedral(a_normal.xy);
+	}
+
+	if (u_hasOctahedralTangents != 0)
+	{
+		inBitangent = decodeOctahedral(a_bitangent.xy);
+		inTangent = decodeOctahedral(a_tangent.xy);
+	}
+
 	vec4 vertex = vec4(0.0);
 	vec3 normal = vec3(0.0);
 	vec3 bitangent = vec3(0.0);
@@ -52,12 +80,12 @@ void main(void)
 	if (u_hasSkinning == 0)
 	{
 		vertex = a_vertex;
-		normal = a_normal;
+		normal = inNormal;
 		
 		if (u_hasNormalMapTexture != 0)
 		{
-			bitangent = a_bitangent;
-			tangent = a_tangent;
+			bitangent = inBitangent;
+			tangent = inTangent;
 		}
 	}
 	else
@@ -67,12 +95,12 @@ void main(void)
 		if (boneCounter == 0)
 		{
 			vertex = a_vertex;
-			normal = a_normal;
+			normal = inNormal;
 			
 			if (u_hasNormalMapTexture != 0)
 			{
-				bitangent = a_bitangent;
-				tangent = a_tangent;
+				bitangent = inBitangent;
+				tangent = inTangent;
 			}
 		}
 		else
@@ -90,14 +118,19 @@ void main(void)
 					currentWeight = a_boneWeight_1[i-4];
 				}
 				
-				vertex += (u_bindMatrix[currentBone] * u_inverseBindMatrix[currentBone] * a_vertex) * currentWeight;
+				int paletteIndex = currentBone * TEXELS_PER_JOINT;
+				
+				mat4 skinningMatrix = mat4(texelFetch(u_skinningPalette, paletteIndex), texelFetch(u_skinningPalette, paletteIndex + 1), texelFetch(u_skinningPalette, paletteIndex + 2), texelFetch(u_skinningPalette, paletteIndex + 3));
+				mat3 skinningNormalMatrix = mat3(texelFetch(u_skinningPalette, paletteIndex + 4).xyz, texelFetch(u_skinningPalette, paletteIndex + 5).xyz, texelFetch(u_skinningPalette, paletteIndex + 6).xyz);
+				
+				vertex += (skinningMatrix * a_vertex) * currentWeight;
 				
-				normal += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * a_normal) * currentWeight;
+				normal += (skinningNormalMatrix * inNormal) * currentWeight;
 
 				if (u_hasNormalMapTexture != 0)
 				{
-					bitangent += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * a_bitangent) * currentWeight;
-					tangent += (u_bindNormalMatrix[currentBone] * u_inverseBindNormalMatrix[currentBone] * a_tangent) * currentWeight;
+					bitangent += (skinningNormalMatrix * inBitangent) * currentWeight;
+					tangent += (skinningNormalMatrix * inTangent) * currentWeight;
 				}
 			}
 		}
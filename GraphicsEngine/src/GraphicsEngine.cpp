@@ -78,6 +78,8 @@ GLUSboolean updateEngine(GLUSfloat deltaTime)
 {
 	User::defaultUser.update(deltaTime);
 
+	StatisticCounter::nextFrameAll();
+
 	return GLUS_TRUE;
 }
 
@@ -16,6 +16,7 @@
 #include "layer0/noise/PerlinNoise2D.h"
 #include "layer0/noise/PerlinNoise3D.h"
 #include "layer0/statistic/FrameCounter.h"
+#include "layer0/statistic/StatisticCounter.h"
 #include "layer1/command/WorkerManager.h"
 #include "layer1/event/EventManager.h"
 #include "layer1/renderbuffer/RenderBuffer.h"
@@ -48,6 +49,7 @@
 #include "layer2/ground/GroundManager.h"
 #include "layer2/interpolation/ConstantInterpolator.h"
 #include "layer2/interpolation/CubicInterpolator.h"
+#include "layer2/interpolation/InterpolationKernel.h"
 #include "layer2/interpolation/LinearInterpolator.h"
 #include "layer2/material/RefractiveIndices.h"
 #include "layer2/material/SurfaceMaterial.h"
@@ -87,6 +89,7 @@
 #include "layer8/path/PathEntityManager.h"
 #include "layer8/path/OrientedCirclePath.h"
 #include "layer8/path/OrientedLinePath.h"
+#include "layer9/cachefactory/CacheEntityFactory.h"
 #include "layer9/camerafactory/CameraEntityFactory.h"
 #ifndef GE_NO_FBX
 #include "layer9/fbxfactory/FbxEntityFactory.h"
@@ -0,0 +1,69 @@
+/*
+ * BinaryWriter.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "BinaryWriter.h"
+
+using namespace std;
+
+BinaryWriter::BinaryWriter() :
+	data()
+{
+}
+
+BinaryWriter::~BinaryWriter()
+{
+}
+
+void BinaryWriter::addData(const void* data, size_t length)
+{
+	this->data.insert(this->data.end(), (const uint8_t*)data, (const uint8_t*)data + length);
+}
+
+void BinaryWriter::addFloats(const float* values, size_t count)
+{
+	addData(values, count * sizeof(float));
+}
+
+void BinaryWriter::addString(const string& value)
+{
+	addValue((uint32_t)value.length());
+
+	addData(value.c_str(), value.length());
+}
+
+void BinaryWriter::addPadding(size_t alignment)
+{
+	while (data.size() % alignment != 0)
+	{
+		data.push_back(0);
+	}
+}
+
+size_t BinaryWriter::getLength() const
+{
+	return data.size();
+}
+
+const uint8_t* BinaryWriter::getData() const
+{
+	return data.data();
+}
+
+bool BinaryWriter::save(FILE* file) const
+{
+	if (data.size() == 0)
+	{
+		return true;
+	}
+
+	return fwrite(data.data(), 1, data.size(), file) == data.size();
+}
+
+void BinaryWriter::reset()
+{
+	data.clear();
+}
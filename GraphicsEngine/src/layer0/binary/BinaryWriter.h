@@ -0,0 +1,60 @@
+/*
+ * BinaryWriter.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef BINARYWRITER_H_
+#define BINARYWRITER_H_
+
+#include <cstdio>
+
+#include "../../UsedLibs.h"
+
+/**
+ * Growing buffer for binary files. Values are appended in the byte order of the machine.
+ */
+class BinaryWriter
+{
+
+private:
+
+	std::vector<std::uint8_t> data;
+
+public:
+
+	BinaryWriter();
+	virtual ~BinaryWriter();
+
+	template<typename T>
+	void addValue(const T& value)
+	{
+		addData(&value, sizeof(T));
+	}
+
+	void addData(const void* data, std::size_t length);
+
+	void addFloats(const float* values, std::size_t count);
+
+	/**
+	 * Appends the length as an unsigned 32 bit integer and then the characters without a terminating zero.
+	 */
+	void addString(const std::string& value);
+
+	/**
+	 * Appends zeros until the length is a multiple of the alignment.
+	 */
+	void addPadding(std::size_t alignment);
+
+	std::size_t getLength() const;
+
+	const std::uint8_t* getData() const;
+
+	bool save(FILE* file) const;
+
+	void reset();
+
+};
+
+#endif /* BINARYWRITER_H_ */
@@ -0,0 +1,80 @@
+/*
+ * JSONarena.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "JSONarena.h"
+
+using namespace std;
+
+static size_t getPadding(const uint8_t* address, size_t alignment)
+{
+	return static_cast<size_t>(0 - reinterpret_cast<uintptr_t>(address)) & (alignment - 1);
+}
+
+JSONarena::JSONarena(size_t blockSize) :
+	allBlocks(), allLargeBlocks(), blockSize(blockSize), current(nullptr), remaining(0)
+{
+}
+
+JSONarena::~JSONarena()
+{
+}
+
+void JSONarena::addBlock()
+{
+	allBlocks.push_back(unique_ptr<uint8_t[]>(new uint8_t[blockSize]));
+
+	current = allBlocks.back().get();
+	remaining = blockSize;
+}
+
+void* JSONarena::allocate(size_t size, size_t alignment)
+{
+	size_t padding = getPadding(current, alignment);
+
+	if (current == nullptr || padding + size > remaining)
+	{
+		if (size + alignment > blockSize / 4)
+		{
+			allLargeBlocks.push_back(unique_ptr<uint8_t[]>(new uint8_t[size + alignment]));
+
+			uint8_t* block = allLargeBlocks.back().get();
+
+			return block + getPadding(block, alignment);
+		}
+
+		addBlock();
+
+		padding = getPadding(current, alignment);
+	}
+
+	uint8_t* result = current + padding;
+
+	current += padding + size;
+	remaining -= padding + size;
+
+	return result;
+}
+
+void JSONarena::clear()
+{
+	allLargeBlocks.clear();
+
+	if (allBlocks.empty())
+	{
+		return;
+	}
+
+	allBlocks.resize(1);
+
+	current = allBlocks[0].get();
+	remaining = blockSize;
+}
+
+int32_t JSONarena::getNumberBlocks() const
+{
+	return static_cast<int32_t>(allBlocks.size() + allLargeBlocks.size());
+}
@@ -0,0 +1,55 @@
+/*
+ * JSONarena.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONARENA_H_
+#define JSONARENA_H_
+
+#include "../../UsedLibs.h"
+
+#define JSON_ARENA_BLOCK_SIZE 65536
+
+/**
+ * Hands out memory from large blocks. Single allocations are never freed, all memory is released at once.
+ */
+class JSONarena
+{
+
+private:
+
+	std::vector<std::unique_ptr<std::uint8_t[]> > allBlocks;
+
+	// Allocations larger than a quarter block.
+	std::vector<std::unique_ptr<std::uint8_t[]> > allLargeBlocks;
+
+	std::size_t blockSize;
+
+	std::uint8_t* current;
+
+	std::size_t remaining;
+
+	void addBlock();
+
+public:
+
+	JSONarena(std::size_t blockSize = JSON_ARENA_BLOCK_SIZE);
+	~JSONarena();
+
+	/**
+	 * Alignment has to be a power of two.
+	 */
+	void* allocate(std::size_t size, std::size_t alignment = 8);
+
+	/**
+	 * Releases all memory. The first block is kept for reuse.
+	 */
+	void clear();
+
+	std::int32_t getNumberBlocks() const;
+
+};
+
+#endif /* JSONARENA_H_ */
@@ -5,13 +5,11 @@
  *      Author: nopper
  */
 
-#include "JSONtokens.h"
-
 #include "JSONdecoder.h"
 
 using namespace std;
 
-JSONdecoder::JSONdecoder() : jsonText("")
+JSONdecoder::JSONdecoder(int32_t maxDepth) : maxDepth(maxDepth), depth(0)
 {
 }
 
@@ -21,712 +19,237 @@ JSONdecoder::~JSONdecoder()
 
 //
 
-bool JSONdecoder::match(const string token, size_t& index)
-{
-	size_t length = token.length();
-
-	if (jsonText.length() < index + length)
-	{
-		return false;
-	}
-
-	if (jsonText.substr(index, length).compare(token) == 0)
-	{
-		index += length;
-
-		return true;
-	}
-
-	return false;
-}
-
-//
-
-bool JSONdecoder::decodeWhitespace(size_t& index)
-{
-	return match(JSON_Encode_character_tabulation, index) || match(JSON_Encode_line_feed, index) ||match(JSON_Encode_carriage_return, index) || match(JSON_space, index);
-}
-
-//
-
-bool JSONdecoder::decodeLeftSquareBracket(size_t& index)
-{
-	return match(JSON_left_square_bracket, index);
-}
-
-bool JSONdecoder::decodeLeftCurlyBracket(size_t& index)
-{
-	return match(JSON_left_curly_bracket, index);
-}
-
-bool JSONdecoder::decodeRightSquareBracket(size_t& index)
-{
-	return match(JSON_right_square_bracket, index);
-}
-
-bool JSONdecoder::decodeRightCurlyBracket(size_t& index)
-{
-	return match(JSON_right_curly_bracket, index);
-}
-
-bool JSONdecoder::decodeColon(size_t& index)
-{
-	return match(JSON_colon, index);
-}
-
-bool JSONdecoder::decodeComma(size_t& index)
-{
-	return match(JSON_comma, index);
-}
-
-//
-
-bool JSONdecoder::decodePlus(size_t& index, string& characters)
-{
-	if (match(JSON_plus, index))
-	{
-		characters += JSON_plus;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeMinus(size_t& index, string& characters)
-{
-	if (match(JSON_minus, index))
-	{
-		characters += JSON_minus;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodePoint(size_t& index, string& characters)
-{
-	if (match(JSON_point, index))
-	{
-		characters += JSON_point;
-
-		return true;
-	}
-
-	return false;
-}
-
-//
-
-bool JSONdecoder::decodeHexadecimalDigit(size_t& index, string& characters, int32_t& value)
-{
-	if (match(JSON_A, index) || match(JSON_B, index) || match(JSON_C, index) || match(JSON_D, index) || match(JSON_E, index) || match(JSON_F, index))
-	{
-		characters += jsonText.substr(index - 1, 1);
-
-		value = static_cast<int32_t>(jsonText.substr(index - 1, 1)[0] - JSON_A[0]);
-
-		return true;
-	}
-	if (match(JSON_a, index) || match(JSON_b, index) || match(JSON_c, index) || match(JSON_d, index) || match(JSON_e, index) || match(JSON_f, index))
-	{
-		characters += jsonText.substr(index - 1, 1);
-
-		value = static_cast<int32_t>(jsonText.substr(index - 1, 1)[0] - JSON_a[0]);
-
-		return true;
-	}
-
-	return false;
-}
-
-//
-
-bool JSONdecoder::decodeDigit_0(size_t& index, string& characters, int32_t& value)
-{
-	if (match(JSON_0, index))
-	{
-		characters += JSON_0;
-
-		value = 0;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeDigit_1_9(size_t& index, string& characters, int32_t& value)
-{
-	if (match(JSON_1, index) || match(JSON_2, index) || match(JSON_3, index) || match(JSON_4, index) || match(JSON_5, index) || match(JSON_6, index) || match(JSON_7, index) || match(JSON_8, index) || match(JSON_9, index))
-	{
-		characters += jsonText.substr(index - 1, 1);
-
-		value = atoi(jsonText.substr(index - 1, 1).c_str());
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeDigit(size_t& index, string& characters, int32_t& value)
-{
-	return decodeDigit_0(index, characters, value) || decodeDigit_1_9(index, characters, value);
-}
-
-bool JSONdecoder::decodeExponent(size_t& index, string& characters)
-{
-	if (match(JSON_e, index) || match(JSON_E, index))
-	{
-		characters += JSON_e;
-
-		return true;
-	}
-
-	return false;
-}
-
-//
-
-bool JSONdecoder::decodeQuotationMark(size_t& index, string& characters)
-{
-	if (match(JSON_quotation_mark, index))
-	{
-		characters += JSON_quotation_mark;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeReverseSolidus(size_t& index, string& characters)
-{
-	if (match(JSON_reverse_solidus, index))
-	{
-		// Do nothing.
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeSolidus(size_t& index, string& characters)
-{
-	if (match(JSON_solidus, index))
-	{
-		characters += JSON_solidus;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeBackspace(size_t& index, string& characters)
-{
-	if (match(JSON_Decode_backspace, index))
-	{
-		characters += JSON_Encode_backspace;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeFormFeed(size_t& index, string& characters)
-{
-	if (match(JSON_Decode_form_feed, index))
-	{
-		characters += JSON_Encode_form_feed;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeLineFeed(size_t& index, string& characters)
-{
-	if (match(JSON_Decode_line_feed, index))
-	{
-		characters += JSON_Encode_line_feed;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeCarriageReturn(size_t& index, string& characters)
-{
-	if (match(JSON_Decode_carriage_return, index))
-	{
-		characters += JSON_Encode_carriage_return;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeCharacterTabulation(size_t& index, string& characters)
-{
-	if (match(JSON_Decode_character_tabulation, index))
-	{
-		characters += JSON_Encode_character_tabulation;
-
-		return true;
-	}
-
-	return false;
-}
-
-bool JSONdecoder::decodeHexadecimalNumber(size_t& index, string& characters)
-{
-	int32_t value = 0;
-	int32_t tempValue = 0;
-
-	size_t tempIndex = index;
-
-	if (!match(JSON_u, tempIndex))
-	{
-		return false;
-	}
-
-	if (tempIndex + 4 > jsonText.length())
-	{
-		return false;
-	}
-
-	while (tempIndex < jsonText.length())
-	{
-		if (!decodeDigit(tempIndex, characters, tempValue) && !decodeHexadecimalDigit(tempIndex, characters, tempValue))
-		{
-			return false;
-		}
-
-		value = value * 16 + tempValue;
-	}
-
-	characters += static_cast<char>(value & 0xFF);
-
-	index = tempIndex;
-
-	return true;
-}
-
-//
-
-bool JSONdecoder::decodeObject(size_t& index, JSONobjectSP& jsonObject)
+bool JSONdecoder::decodeObject(JSONtokenizer& tokenizer, JSONobjectSP& jsonObject)
 {
 	JSONobjectSP tempJsonObject = JSONobjectSP(new JSONobject());
 
-	size_t tempIndex = index;
-
-	bool loop = true;
+	JSONtoken token;
 
-	while (decodeWhitespace(tempIndex));
-
-	if (!decodeLeftCurlyBracket(tempIndex))
+	if (!tokenizer.next(token))
 	{
 		return false;
 	}
 
-	while (decodeWhitespace(tempIndex));
-
-	if (decodeRightCurlyBracket(tempIndex))
+	if (token.type != JSON_TOKEN_RIGHT_CURLY_BRACKET)
 	{
-		//
-	}
-	else
-	{
-		while (decodeWhitespace(tempIndex));
+		bool loop = true;
 
 		while (loop)
 		{
-			JSONstringSP jsonString;
-			JSONvalueSP jsonValue;
-
-			loop = false;
-
-			if (!decodeString(tempIndex, jsonString))
+			if (token.type != JSON_TOKEN_STRING)
 			{
 				return false;
 			}
 
-			while (decodeWhitespace(tempIndex));
+			JSONstringSP jsonString = JSONstringSP(new JSONstring());
+			JSONvalueSP jsonValue;
+
+			string key;
+
+			JSONtokenizer::decodeString(key, token);
 
-			if (!decodeColon(tempIndex))
+			jsonString->setValue(key);
+
+			if (!tokenizer.next(token) || token.type != JSON_TOKEN_COLON)
 			{
 				return false;
 			}
 
-			while (decodeWhitespace(tempIndex));
-
-			if (!decodeValue(tempIndex, jsonValue))
+			if (!tokenizer.next(token) || !decodeValue(tokenizer, token, jsonValue))
 			{
 				return false;
 			}
 
 			tempJsonObject->addKeyValue(jsonString, jsonValue);
 
-			while (decodeWhitespace(tempIndex));
-
-			if (decodeComma(tempIndex))
+			if (!tokenizer.next(token))
 			{
-				loop = true;
+				return false;
 			}
 
-			while (decodeWhitespace(tempIndex));
-		}
-
-		if (!decodeRightCurlyBracket(tempIndex))
-		{
-			return false;
+			if (token.type == JSON_TOKEN_COMMA)
+			{
+				if (!tokenizer.next(token))
+				{
+					return false;
+				}
+			}
+			else if (token.type == JSON_TOKEN_RIGHT_CURLY_BRACKET)
+			{
+				loop = false;
+			}
+			else
+			{
+				return false;
+			}
 		}
 	}
 
-	while (decodeWhitespace(tempIndex));
-
 	jsonObject = tempJsonObject;
 
-	index = tempIndex;
-
 	return true;
 }
 
-bool JSONdecoder::decodeArray(size_t& index, JSONarraySP& jsonArray)
+bool JSONdecoder::decodeArray(JSONtokenizer& tokenizer, JSONarraySP& jsonArray)
 {
 	JSONarraySP tempJsonArray = JSONarraySP(new JSONarray());
 
-	size_t tempIndex = index;
-
-	bool loop = true;
+	JSONtoken token;
 
-	while (decodeWhitespace(tempIndex));
-
-	if (!decodeLeftSquareBracket(tempIndex))
+	if (!tokenizer.next(token))
 	{
 		return false;
 	}
 
-	while (decodeWhitespace(tempIndex));
-
-	if (decodeRightSquareBracket(tempIndex))
-	{
-		//
-	}
-	else
+	if (token.type != JSON_TOKEN_RIGHT_SQUARE_BRACKET)
 	{
-		while (decodeWhitespace(tempIndex));
+		bool loop = true;
 
 		while (loop)
 		{
 			JSONvalueSP jsonValue;
 
-			loop = false;
-
-			if (!decodeValue(tempIndex, jsonValue))
+			if (!decodeValue(tokenizer, token, jsonValue))
 			{
 				return false;
 			}
 
 			tempJsonArray->addValue(jsonValue);
 
-			while (decodeWhitespace(tempIndex));
-
-			if (decodeComma(tempIndex))
+			if (!tokenizer.next(token))
 			{
-				loop = true;
+				return false;
 			}
 
-			while (decodeWhitespace(tempIndex));
-		}
-
-		if (!decodeRightSquareBracket(tempIndex))
-		{
-			return false;
+			if (token.type == JSON_TOKEN_COMMA)
+			{
+				if (!tokenizer.next(token))
+				{
+					return false;
+				}
+			}
+			else if (token.type == JSON_TOKEN_RIGHT_SQUARE_BRACKET)
+			{
+				loop = false;
+			}
+			else
+			{
+				return false;
+			}
 		}
 	}
 
-	while (decodeWhitespace(tempIndex));
-
 	jsonArray = tempJsonArray;
 
-	index = tempIndex;
-
 	return true;
 }
 
-bool JSONdecoder::decodeNumber(size_t& index, JSONnumberSP& jsonNumber)
-{
-	string tempString = "";
-	int32_t dummy;
-
-	size_t tempIndex = index;
-
-	bool isFloat = false;
-
-	while (decodeWhitespace(tempIndex));
+//
 
-	if (decodeMinus(tempIndex, tempString))
-	{
-		//
-	}
+bool JSONdecoder::decodeValue(JSONtokenizer& tokenizer, const JSONtoken& token, JSONvalueSP& jsonValue)
+{
+	jsonValue = JSONvalueSP();
 
-	if (decodeDigit_0(tempIndex, tempString, dummy))
-	{
-		//
-	}
-	else if (decodeDigit_1_9(tempIndex, tempString, dummy))
+	switch (token.type)
 	{
-		bool loop = true;
-
-		while (loop)
+		case JSON_TOKEN_LEFT_CURLY_BRACKET:
 		{
-			loop = false;
-
-			loop = decodeDigit(tempIndex, tempString, dummy);
-		}
-	}
-	else
-	{
-		return false;
-	}
+			JSONobjectSP jsonObject;
 
-	if (decodePoint(tempIndex, tempString))
-	{
-		isFloat = true;
-
-		bool loop = true;
-
-		if (!decodeDigit(tempIndex, tempString, dummy))
-		{
-			return false;
-		}
-
-		while (loop)
-		{
-			loop = false;
-
-			loop = decodeDigit(tempIndex, tempString, dummy);
-		}
-	}
-
-	if (decodeExponent(tempIndex, tempString))
-	{
-		bool loop = true;
+			if (depth < maxDepth)
+			{
+				depth++;
 
-		if (decodePlus(tempIndex, tempString) || decodeMinus(tempIndex, tempString))
-		{
-			//
-		}
+				if (decodeObject(tokenizer, jsonObject))
+				{
+					jsonValue = jsonObject;
+				}
 
-		if (!decodeDigit(tempIndex, tempString, dummy))
-		{
-			return false;
+				depth--;
+			}
 		}
-
-		while (loop)
+		break;
+		case JSON_TOKEN_LEFT_SQUARE_BRACKET:
 		{
-			loop = false;
-
-			loop = decodeDigit(tempIndex, tempString, dummy);
-		}
-	}
-
-	while (decodeWhitespace(tempIndex));
+			JSONarraySP jsonArray;
 
-	jsonNumber = JSONnumberSP(new JSONnumber(tempString, isFloat));
-
-	index = tempIndex;
-
-	return true;
-}
-
-bool JSONdecoder::decodeString(size_t& index, JSONstringSP& jsonString)
-{
-	string dummyString = "";
-	string tempString = "";
-
-	size_t tempIndex = index;
-
-	bool loop = true;
-
-	while (decodeWhitespace(tempIndex));
-
-	if (!decodeQuotationMark(tempIndex, dummyString))
-	{
-		return false;
-	}
-
-	while (loop)
-	{
-		loop = false;
+			if (depth < maxDepth)
+			{
+				depth++;
 
-		if (decodeQuotationMark(tempIndex, dummyString))
-		{
-			break;
-		}
+				if (decodeArray(tokenizer, jsonArray))
+				{
+					jsonValue = jsonArray;
+				}
 
-		if (decodeReverseSolidus(tempIndex, tempString))
-		{
-			if (decodeQuotationMark(tempIndex, tempString) || decodeReverseSolidus(tempIndex, tempString) || decodeSolidus(tempIndex, tempString) || decodeBackspace(tempIndex, tempString) || decodeSolidus(tempIndex, tempString) || decodeFormFeed(tempIndex, tempString) || decodeLineFeed(tempIndex, tempString) || decodeCarriageReturn(tempIndex, tempString) || decodeCharacterTabulation(tempIndex, tempString) || decodeHexadecimalNumber(tempIndex, tempString))
-			{
-				loop = true;
+				depth--;
 			}
-			else
-			{
-				return false;
-			}
-		}
-		else if ((jsonText[tempIndex] >= JSON_C0_start && jsonText[tempIndex] <= JSON_C0_end) || (jsonText[tempIndex] >= JSON_C1_start && jsonText[tempIndex] <= JSON_C1_end))
-		{
-			return false;
 		}
-		else
-		{
-			tempString += jsonText.substr(tempIndex, 1);
-
-			if (tempIndex + 1 < jsonText.length())
+		break;
+		case JSON_TOKEN_NUMBER:
+			if (token.isFloat)
 			{
-				tempIndex++;
-
-				loop = true;
+				jsonValue = JSONnumberSP(new JSONnumber(JSONtokenizer::decodeFloat(token)));
 			}
 			else
 			{
-				return false;
+				jsonValue = JSONnumberSP(new JSONnumber(JSONtokenizer::decodeInteger(token)));
 			}
-		}
-	}
-
-	while (decodeWhitespace(tempIndex));
-
-	jsonString = JSONstringSP(new JSONstring(tempString));
-
-	index = tempIndex;
-
-	return true;
-}
-
-
-bool JSONdecoder::decodeTrue(size_t& index, JSONtrueSP& jsonTrue)
-{
-	bool result;
+			break;
+		case JSON_TOKEN_STRING:
+		{
+			JSONstringSP jsonString = JSONstringSP(new JSONstring());
 
-	while (decodeWhitespace(index));
+			string value;
 
-	result = match(JSON_true, index);
+			JSONtokenizer::decodeString(value, token);
 
-	while (decodeWhitespace(index));
+			jsonString->setValue(value);
 
-	if (result)
-	{
-		jsonTrue = JSONtrueSP(new JSONtrue());
+			jsonValue = jsonString;
+		}
+		break;
+		case JSON_TOKEN_TRUE:
+			jsonValue = JSONtrueSP(new JSONtrue());
+			break;
+		case JSON_TOKEN_FALSE:
+			jsonValue = JSONfalseSP(new JSONfalse());
+			break;
+		case JSON_TOKEN_NULL:
+			jsonValue = JSONnullSP(new JSONnull());
+			break;
+		default:
+			break;
 	}
 
-	return result;
+	return jsonValue.get() != nullptr;
 }
 
-bool JSONdecoder::decodeFalse(size_t& index, JSONfalseSP& jsonFalse)
-{
-	bool result;
-
-	while (decodeWhitespace(index));
-
-	result = match(JSON_false, index);
-
-	while (decodeWhitespace(index));
-
-	if (result)
-	{
-		jsonFalse = JSONfalseSP(new JSONfalse());
-	}
+//
 
-	return result;
+bool JSONdecoder::decode(const string& jsonText, JSONvalueSP& jsonValue)
+{
+	return decode(jsonText.data(), jsonText.data() + jsonText.length(), jsonValue);
 }
 
-bool JSONdecoder::decodeNull(size_t& index, JSONnullSP& jsonNull)
+bool JSONdecoder::decode(const char* begin, const char* end, JSONvalueSP& jsonValue)
 {
-	bool result;
-
-	while (decodeWhitespace(index));
-
-	result =  match(JSON_null, index);
-
-	while (decodeWhitespace(index));
-
-	if (result)
-	{
-		jsonNull = JSONnullSP(new JSONnull());
-	}
-
-	return result;
-}
+	JSONstructuralIndex index;
 
-//
+	// Without an index, the same tokens and errors are found by scanning.
+	JSONtokenizer tokenizer = index.build(begin, end) ? JSONtokenizer(begin, end, index) : JSONtokenizer(begin, end);
 
-bool JSONdecoder::decodeValue(size_t& index, JSONvalueSP& jsonValue)
-{
-	JSONobjectSP jsonObject;
-	JSONarraySP jsonArray;
-	JSONnumberSP jsonNumber;
-	JSONstringSP jsonString;
-	JSONtrueSP jsonTrue;
-	JSONfalseSP jsonFalse;
-	JSONnullSP jsonNull;
+	JSONtoken token;
 
 	jsonValue = JSONvalueSP();
 
-	while (decodeWhitespace(index));
+	depth = 0;
 
-	if (decodeObject(index, jsonObject))
+	if (!tokenizer.next(token))
 	{
-		jsonValue = jsonObject;
-	}
-	else if (decodeArray(index, jsonArray))
-	{
-		jsonValue = jsonArray;
-	}
-	else if (decodeNumber(index, jsonNumber))
-	{
-		jsonValue = jsonNumber;
-	}
-	else if (decodeString(index, jsonString))
-	{
-		jsonValue = jsonString;
-	}
-	else if (decodeTrue(index, jsonTrue))
-	{
-		jsonValue = jsonTrue;
-	}
-	else if (decodeFalse(index, jsonFalse))
-	{
-		jsonValue = jsonFalse;
-	}
-	else if (decodeNull(index, jsonNull))
-	{
-		jsonValue = jsonNull;
+		return false;
 	}
 
-	while (decodeWhitespace(index));
-
-	return jsonValue.get() != nullptr;
-}
-
-//
-
-bool JSONdecoder::decode(const string& jsonText, JSONvalueSP& jsonValue)
-{
-	size_t index = 0;
-
-	this->jsonText = jsonText;
-
-	return decodeValue(index, jsonValue);
+	// Text after the value is ignored.
+	return decodeValue(tokenizer, token, jsonValue);
 }
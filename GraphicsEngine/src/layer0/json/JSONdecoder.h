@@ -19,75 +19,42 @@
 #include "JSONfalse.h"
 #include "JSONnull.h"
 
+#include "JSONtokenizer.h"
+
+#define JSON_DECODER_MAX_DEPTH 256
+
 class JSONdecoder
 {
 
 private:
 
-	std::string jsonText;
-
-	//
-
-	bool match(const std::string token, size_t& index);
-
-	//
-
-	bool decodeWhitespace(size_t& index);
-
-	//
-
-	bool decodeLeftSquareBracket(size_t& index);
-	bool decodeLeftCurlyBracket(size_t& index);
-	bool decodeRightSquareBracket(size_t& index);
-	bool decodeRightCurlyBracket(size_t& index);
-	bool decodeColon(size_t& index);
-	bool decodeComma(size_t& index);
-
-	//
-
-	bool decodePlus(size_t& index, std::string& characters);
-	bool decodeMinus(size_t& index, std::string& characters);
-	bool decodePoint(size_t& index, std::string& characters);
-
-	bool decodeHexadecimalDigit(size_t& index, std::string& characters, std::int32_t& value);
+	std::int32_t maxDepth;
 
-	bool decodeDigit_0(size_t& index, std::string& characters, std::int32_t& value);
-	bool decodeDigit_1_9(size_t& index, std::string& characters, std::int32_t& value);
-	bool decodeDigit(size_t& index, std::string& characters, std::int32_t& value);
+	// Objects and arrays, which are currently decoded.
+	std::int32_t depth;
 
-	bool decodeExponent(size_t& index, std::string& characters);
-
-	bool decodeQuotationMark(size_t& index, std::string& characters);
-	bool decodeReverseSolidus(size_t& index, std::string& characters);
-	bool decodeSolidus(size_t& index, std::string& characters);
-	bool decodeBackspace(size_t& index, std::string& characters);
-	bool decodeFormFeed(size_t& index, std::string& characters);
-	bool decodeLineFeed(size_t& index, std::string& characters);
-	bool decodeCarriageReturn(size_t& index, std::string& characters);
-	bool decodeCharacterTabulation(size_t& index, std::string& characters);
-	bool decodeHexadecimalNumber(size_t& index, std::string& characters);
+	bool decodeObject(JSONtokenizer& tokenizer, JSONobjectSP& jsonObject);
+	bool decodeArray(JSONtokenizer& tokenizer, JSONarraySP& jsonArray);
 
 	//
 
-	bool decodeObject(size_t& index, JSONobjectSP& jsonObject);
-	bool decodeArray(size_t& index, JSONarraySP& jsonArray);
-	bool decodeNumber(size_t& index, JSONnumberSP& jsonNumber);
-	bool decodeString(size_t& index, JSONstringSP& jsonString);
-	bool decodeTrue(size_t& index, JSONtrueSP& jsonTrue);
-	bool decodeFalse(size_t& index, JSONfalseSP& jsonFalse);
-	bool decodeNull(size_t& index, JSONnullSP& jsonNull);
-
-	//
-
-	bool decodeValue(size_t& index, JSONvalueSP& jsonValue);
+	bool decodeValue(JSONtokenizer& tokenizer, const JSONtoken& token, JSONvalueSP& jsonValue);
 
 public:
 
-	JSONdecoder();
+	/**
+	 * Texts with more than maxDepth nested objects and arrays are rejected, which bounds the recursion.
+	 */
+	JSONdecoder(std::int32_t maxDepth = JSON_DECODER_MAX_DEPTH);
 	~JSONdecoder();
 
 	bool decode(const std::string& jsonText, JSONvalueSP& jsonValue);
 
+	/**
+	 * Decodes the text in the range [begin, end). The text does not have to be zero terminated.
+	 */
+	bool decode(const char* begin, const char* end, JSONvalueSP& jsonValue);
+
 };
 
 #endif /* JSONDECODER_H_ */
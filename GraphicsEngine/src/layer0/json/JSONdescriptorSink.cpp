@@ -0,0 +1,60 @@
+/*
+ * JSONdescriptorSink.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <cerrno>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "JSONdescriptorSink.h"
+
+using namespace std;
+
+JSONdescriptorSink::JSONdescriptorSink(int32_t descriptor) :
+	JSONsink(), descriptor(descriptor)
+{
+}
+
+JSONdescriptorSink::~JSONdescriptorSink()
+{
+}
+
+bool JSONdescriptorSink::write(const char* data, size_t length)
+{
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	// Pipes and sockets may take less than requested.
+	while (length > 0)
+	{
+#if defined(_WIN32)
+		int32_t written = _write(descriptor, data, static_cast<uint32_t>(length > 0x40000000 ? 0x40000000 : length));
+#else
+		ssize_t written = ::write(descriptor, data, length);
+#endif
+
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			return false;
+		}
+
+		data += written;
+		length -= static_cast<size_t>(written);
+	}
+
+	return true;
+}
@@ -0,0 +1,32 @@
+/*
+ * JSONdescriptorSink.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONDESCRIPTORSINK_H_
+#define JSONDESCRIPTORSINK_H_
+
+#include "JSONsink.h"
+
+/**
+ * Writes to an open file descriptor, e.g. a pipe or socket. The descriptor is not closed.
+ */
+class JSONdescriptorSink : public JSONsink
+{
+
+private:
+
+	std::int32_t descriptor;
+
+public:
+
+	JSONdescriptorSink(std::int32_t descriptor);
+	virtual ~JSONdescriptorSink();
+
+	virtual bool write(const char* data, size_t length);
+
+};
+
+#endif /* JSONDESCRIPTORSINK_H_ */
@@ -0,0 +1,494 @@
+/*
+ * JSONdocument.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <cstring>
+#include <type_traits>
+
+#include "JSONdocument.h"
+
+using namespace std;
+
+#define JSON_DOCUMENT_KEY_SLOTS 256
+
+// FNV-1a
+static uint32_t hashKey(const char* key, size_t length)
+{
+	uint32_t hash = 2166136261u;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= static_cast<uint8_t>(key[i]);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+JSONdocument::JSONdocument(int32_t maxDepth) :
+	arena(), maxDepth(maxDepth), depth(0), index(), error(false), lazy(false), indexed(false), textBegin(nullptr), root(), allKeySlots(JSON_DOCUMENT_KEY_SLOTS, nullptr), numberKeys(0), allPendingValues(), allPendingMembers(), text()
+{
+}
+
+JSONdocument::~JSONdocument()
+{
+}
+
+const JSONkey* JSONdocument::internKey(const char* key, size_t length)
+{
+	uint32_t hash = hashKey(key, length);
+
+	size_t mask = allKeySlots.size() - 1;
+	size_t index = hash & mask;
+
+	while (allKeySlots[index] != nullptr)
+	{
+		const JSONkey* currentKey = allKeySlots[index];
+
+		if (currentKey->hash == hash && currentKey->length == length && memcmp(currentKey->text, key, length) == 0)
+		{
+			return currentKey;
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	JSONkey* newKey = static_cast<JSONkey*>(arena.allocate(sizeof(JSONkey), alignment_of<JSONkey>::value));
+
+	newKey->text = copyString(key, length);
+	newKey->length = static_cast<uint32_t>(length);
+	newKey->hash = hash;
+
+	allKeySlots[index] = newKey;
+
+	numberKeys++;
+
+	// Keep the load factor below one half.
+	if (static_cast<size_t>(numberKeys) * 2 > allKeySlots.size())
+	{
+		vector<const JSONkey*> allOldKeySlots(allKeySlots.size() * 2, nullptr);
+
+		allOldKeySlots.swap(allKeySlots);
+
+		mask = allKeySlots.size() - 1;
+
+		for (const JSONkey* currentKey : allOldKeySlots)
+		{
+			if (currentKey == nullptr)
+			{
+				continue;
+			}
+
+			index = currentKey->hash & mask;
+
+			while (allKeySlots[index] != nullptr)
+			{
+				index = (index + 1) & mask;
+			}
+
+			allKeySlots[index] = currentKey;
+		}
+	}
+
+	return newKey;
+}
+
+const char* JSONdocument::copyString(const char* begin, size_t length)
+{
+	char* result = static_cast<char*>(arena.allocate(length + 1, 1));
+
+	memcpy(result, begin, length);
+
+	result[length] = '\0';
+
+	return result;
+}
+
+bool JSONdocument::decodeObject(JSONtokenizer& tokenizer, JSONnode& node)
+{
+	size_t start = allPendingMembers.size();
+
+	JSONtoken token;
+
+	if (!tokenizer.next(token))
+	{
+		return false;
+	}
+
+	if (token.type != JSON_TOKEN_RIGHT_CURLY_BRACKET)
+	{
+		bool loop = true;
+
+		while (loop)
+		{
+			if (token.type != JSON_TOKEN_STRING)
+			{
+				return false;
+			}
+
+			PendingMember pendingMember;
+
+			if (token.escaped)
+			{
+				JSONtokenizer::decodeString(text, token);
+
+				pendingMember.member.key = internKey(text.data(), text.length());
+			}
+			else
+			{
+				pendingMember.member.key = internKey(token.begin, static_cast<size_t>(token.end - token.begin));
+			}
+
+			pendingMember.order = static_cast<uint32_t>(allPendingMembers.size() - start);
+
+			if (!tokenizer.next(token) || token.type != JSON_TOKEN_COLON)
+			{
+				return false;
+			}
+
+			if (!tokenizer.next(token) || !decodeValue(tokenizer, token, pendingMember.member.value))
+			{
+				return false;
+			}
+
+			allPendingMembers.push_back(pendingMember);
+
+			if (!tokenizer.next(token))
+			{
+				return false;
+			}
+
+			if (token.type == JSON_TOKEN_COMMA)
+			{
+				if (!tokenizer.next(token))
+				{
+					return false;
+				}
+			}
+			else if (token.type == JSON_TOKEN_RIGHT_CURLY_BRACKET)
+			{
+				loop = false;
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+
+	auto first = allPendingMembers.begin() + start;
+	auto last = allPendingMembers.end();
+
+	sort(first, last, [](const PendingMember& a, const PendingMember& b)
+	{
+		if (a.member.key == b.member.key)
+		{
+			return a.order < b.order;
+		}
+
+		return compareJSONkey(a.member.key->text, a.member.key->length, *b.member.key) < 0;
+	});
+
+	// Interned keys are equal, if the pointers are equal.
+	uint32_t count = 0;
+
+	for (auto walker = first; walker != last; walker++)
+	{
+		if (count > 0 && (first + (count - 1))->member.key == walker->member.key)
+		{
+			*(first + (count - 1)) = *walker;
+		}
+		else
+		{
+			*(first + count) = *walker;
+
+			count++;
+		}
+	}
+
+	JSONmember* members = static_cast<JSONmember*>(arena.allocate(count * sizeof(JSONmember), alignment_of<JSONmember>::value));
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		new (&members[i]) JSONmember((first + i)->member);
+	}
+
+	allPendingMembers.resize(start);
+
+	node.type = JSON_NODE_OBJECT;
+	node.length = count;
+	node.members = members;
+
+	return true;
+}
+
+bool JSONdocument::decodeArray(JSONtokenizer& tokenizer, JSONnode& node)
+{
+	size_t start = allPendingValues.size();
+
+	JSONtoken token;
+
+	if (!tokenizer.next(token))
+	{
+		return false;
+	}
+
+	if (token.type != JSON_TOKEN_RIGHT_SQUARE_BRACKET)
+	{
+		bool loop = true;
+
+		while (loop)
+		{
+			JSONnode value;
+
+			if (!decodeValue(tokenizer, token, value))
+			{
+				return false;
+			}
+
+			allPendingValues.push_back(value);
+
+			if (!tokenizer.next(token))
+			{
+				return false;
+			}
+
+			if (token.type == JSON_TOKEN_COMMA)
+			{
+				if (!tokenizer.next(token))
+				{
+					return false;
+				}
+			}
+			else if (token.type == JSON_TOKEN_RIGHT_SQUARE_BRACKET)
+			{
+				loop = false;
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+
+	uint32_t count = static_cast<uint32_t>(allPendingValues.size() - start);
+
+	JSONnode* values = static_cast<JSONnode*>(arena.allocate(count * sizeof(JSONnode), alignment_of<JSONnode>::value));
+
+	uninitialized_copy(allPendingValues.begin() + start, allPendingValues.end(), values);
+
+	allPendingValues.resize(start);
+
+	node.type = JSON_NODE_ARRAY;
+	node.length = count;
+	node.values = values;
+
+	return true;
+}
+
+bool JSONdocument::decodeValue(JSONtokenizer& tokenizer, const JSONtoken& token, JSONnode& node)
+{
+	switch (token.type)
+	{
+		case JSON_TOKEN_LEFT_CURLY_BRACKET:
+		case JSON_TOKEN_LEFT_SQUARE_BRACKET:
+			return lazy ? decodeLazy(tokenizer, token, node) : decodeContainer(tokenizer, token, node);
+		case JSON_TOKEN_NUMBER:
+			if (token.isFloat)
+			{
+				node.type = JSON_NODE_FLOAT;
+				node.floatValue = JSONtokenizer::decodeFloat(token);
+			}
+			else
+			{
+				node.type = JSON_NODE_INTEGER;
+				node.integerValue = JSONtokenizer::decodeInteger(token);
+			}
+			return true;
+		case JSON_TOKEN_STRING:
+			node.type = JSON_NODE_STRING;
+			if (token.escaped)
+			{
+				JSONtokenizer::decodeString(text, token);
+
+				node.length = static_cast<uint32_t>(text.length());
+				node.stringValue = copyString(text.data(), text.length());
+			}
+			else
+			{
+				node.length = static_cast<uint32_t>(token.end - token.begin);
+				node.stringValue = copyString(token.begin, node.length);
+			}
+			return true;
+		case JSON_TOKEN_TRUE:
+			node.type = JSON_NODE_TRUE;
+			return true;
+		case JSON_TOKEN_FALSE:
+			node.type = JSON_NODE_FALSE;
+			return true;
+		case JSON_TOKEN_NULL:
+			node.type = JSON_NODE_NULL;
+			return true;
+		default:
+			break;
+	}
+
+	return false;
+}
+
+bool JSONdocument::decodeLazy(JSONtokenizer& tokenizer, const JSONtoken& token, JSONnode& node)
+{
+	JSONtoken containerToken = token;
+
+	if (!tokenizer.skipContainer(containerToken, maxDepth - depth))
+	{
+		return false;
+	}
+
+	JSONlazySpan* span = static_cast<JSONlazySpan*>(arena.allocate(sizeof(JSONlazySpan), alignment_of<JSONlazySpan>::value));
+
+	span->document = this;
+	span->depth = depth;
+	span->begin = containerToken.begin;
+	span->end = containerToken.end;
+
+	node.type = token.type == JSON_TOKEN_LEFT_CURLY_BRACKET ? JSON_NODE_OBJECT : JSON_NODE_ARRAY;
+	node.length = JSON_NODE_LAZY;
+	node.span = span;
+
+	return true;
+}
+
+bool JSONdocument::decodeContainer(JSONtokenizer& tokenizer, const JSONtoken& token, JSONnode& node)
+{
+	if (token.type != JSON_TOKEN_LEFT_CURLY_BRACKET && token.type != JSON_TOKEN_LEFT_SQUARE_BRACKET)
+	{
+		return decodeValue(tokenizer, token, node);
+	}
+
+	if (depth >= maxDepth)
+	{
+		return false;
+	}
+
+	depth++;
+
+	bool result = token.type == JSON_TOKEN_LEFT_CURLY_BRACKET ? decodeObject(tokenizer, node) : decodeArray(tokenizer, node);
+
+	depth--;
+
+	return result;
+}
+
+bool JSONdocument::expand(const JSONnode& node)
+{
+	const JSONlazySpan* span = node.span;
+
+	JSONtokenizer tokenizer = indexed ? JSONtokenizer(textBegin, span->end, index, static_cast<size_t>(span->begin - textBegin)) : JSONtokenizer(span->begin, span->end);
+
+	JSONtoken token;
+
+	JSONnode result;
+
+	depth = span->depth;
+
+	if (!tokenizer.next(token) || !decodeContainer(tokenizer, token, result))
+	{
+		allPendingValues.clear();
+		allPendingMembers.clear();
+
+		node.type = JSON_NODE_NULL;
+		node.length = 0;
+		node.values = nullptr;
+
+		error = true;
+
+		return false;
+	}
+
+	node.type = result.type;
+	node.length = result.length;
+
+	if (result.type == JSON_NODE_OBJECT)
+	{
+		node.members = result.members;
+	}
+	else
+	{
+		node.values = result.values;
+	}
+
+	return true;
+}
+
+bool JSONdocument::decode(const char* begin, const char* end, bool lazy)
+{
+	clear();
+
+	this->lazy = lazy;
+	this->textBegin = begin;
+
+	depth = 0;
+
+	// Without an index, the same tokens and errors are found by scanning.
+	indexed = index.build(begin, end);
+
+	JSONtokenizer tokenizer = indexed ? JSONtokenizer(begin, end, index) : JSONtokenizer(begin, end);
+
+	JSONtoken token;
+
+	if (!tokenizer.next(token) || !decodeContainer(tokenizer, token, root))
+	{
+		clear();
+
+		error = true;
+
+		return false;
+	}
+
+	return true;
+}
+
+bool JSONdocument::decode(const string& jsonText, bool lazy)
+{
+	return decode(jsonText.data(), jsonText.data() + jsonText.length(), lazy);
+}
+
+void JSONdocument::clear()
+{
+	arena.clear();
+
+	root = JSONnode();
+
+	fill(allKeySlots.begin(), allKeySlots.end(), nullptr);
+
+	numberKeys = 0;
+
+	allPendingValues.clear();
+	allPendingMembers.clear();
+
+	error = false;
+}
+
+const JSONnode& JSONdocument::getRoot() const
+{
+	return root;
+}
+
+bool JSONdocument::hasError() const
+{
+	return error;
+}
+
+int32_t JSONdocument::getNumberKeys() const
+{
+	return numberKeys;
+}
+
+int32_t JSONdocument::getNumberBlocks() const
+{
+	return arena.getNumberBlocks();
+}
@@ -0,0 +1,123 @@
+/*
+ * JSONdocument.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONDOCUMENT_H_
+#define JSONDOCUMENT_H_
+
+#include "../../UsedLibs.h"
+
+#include "JSONarena.h"
+#include "JSONnode.h"
+#include "JSONtokenizer.h"
+
+#define JSON_DOCUMENT_MAX_DEPTH 256
+
+/**
+ * JSON text decoded into nodes, which are allocated from one arena. Keys are interned and object members are sorted,
+ * so lookups do a binary search without allocating. The whole document is released at once.
+ * Decoded lazily, only the brackets of nested objects and arrays are matched and each of them is decoded on its first
+ * access, so unused parts of large texts cost little more than the structural index.
+ */
+class JSONdocument
+{
+
+	friend class JSONnode;
+
+private:
+
+	struct PendingMember
+	{
+		JSONmember member;
+
+		// Position in the object, so the last of duplicate keys is kept.
+		std::uint32_t order;
+	};
+
+	JSONarena arena;
+
+	std::int32_t maxDepth;
+
+	// Objects and arrays, which are currently decoded.
+	std::int32_t depth;
+
+	// Reused for each decoded text.
+	JSONstructuralIndex index;
+
+	// Set by a failed decode or expansion of a lazy node.
+	bool error;
+
+	// Text and index are kept for decoding the lazy nodes.
+	bool lazy;
+	bool indexed;
+	const char* textBegin;
+
+	JSONnode root;
+
+	// Open addressing hash table of the interned keys.
+	std::vector<const JSONkey*> allKeySlots;
+
+	std::int32_t numberKeys;
+
+	// Reused for the values of the arrays and objects, which are currently decoded.
+	std::vector<JSONnode> allPendingValues;
+	std::vector<PendingMember> allPendingMembers;
+
+	// Reused for decoding escaped strings.
+	std::string text;
+
+	const JSONkey* internKey(const char* key, std::size_t length);
+
+	const char* copyString(const char* begin, std::size_t length);
+
+	bool decodeObject(JSONtokenizer& tokenizer, JSONnode& node);
+	bool decodeArray(JSONtokenizer& tokenizer, JSONnode& node);
+
+	bool decodeValue(JSONtokenizer& tokenizer, const JSONtoken& token, JSONnode& node);
+
+	bool decodeLazy(JSONtokenizer& tokenizer, const JSONtoken& token, JSONnode& node);
+
+	// Objects and arrays are decoded one level deep, even if decoding lazily.
+	bool decodeContainer(JSONtokenizer& tokenizer, const JSONtoken& token, JSONnode& node);
+
+	bool expand(const JSONnode& node);
+
+public:
+
+	/**
+	 * Texts with more than maxDepth nested objects and arrays are rejected, which bounds the recursion.
+	 */
+	JSONdocument(std::int32_t maxDepth = JSON_DOCUMENT_MAX_DEPTH);
+	~JSONdocument();
+
+	/**
+	 * Decodes the text in the range [begin, end). Text after the value is ignored. A previous document is released.
+	 * If lazy, errors in nested objects and arrays are only found on their access, which makes them null and sets the
+	 * error of the document. The text has to stay valid as long as the document.
+	 */
+	bool decode(const char* begin, const char* end, bool lazy = false);
+
+	bool decode(const std::string& jsonText, bool lazy = false);
+
+	/**
+	 * Releases all nodes. Memory is not returned value by value, but block by block.
+	 */
+	void clear();
+
+	const JSONnode& getRoot() const;
+
+	/**
+	 * @return True, if the last decode or the expansion of one of its lazy nodes did fail.
+	 */
+	bool hasError() const;
+
+	std::int32_t getNumberKeys() const;
+
+	std::int32_t getNumberBlocks() const;
+
+};
+
+#endif /* JSONDOCUMENT_H_ */
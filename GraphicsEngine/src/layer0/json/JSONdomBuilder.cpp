@@ -0,0 +1,147 @@
+/*
+ * JSONdomBuilder.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "JSONdomBuilder.h"
+
+using namespace std;
+
+JSONdomBuilder::JSONdomBuilder() :
+	JSONhandler(), root(), allContainers(), currentKey()
+{
+}
+
+JSONdomBuilder::~JSONdomBuilder()
+{
+}
+
+bool JSONdomBuilder::addValue(const JSONvalueSP& value)
+{
+	if (allContainers.empty())
+	{
+		if (root.get())
+		{
+			return false;
+		}
+
+		root = value;
+
+		return true;
+	}
+
+	JSONvalue* container = allContainers.back().get();
+
+	if (container->isJsonObject())
+	{
+		static_cast<JSONobject*>(container)->addKeyValue(currentKey, value);
+	}
+	else
+	{
+		static_cast<JSONarray*>(container)->addValue(value);
+	}
+
+	return true;
+}
+
+void JSONdomBuilder::reset()
+{
+	root = JSONvalueSP();
+
+	allContainers.clear();
+
+	currentKey = JSONstringSP();
+}
+
+bool JSONdomBuilder::isDone() const
+{
+	return root.get() != nullptr && allContainers.empty();
+}
+
+const JSONvalueSP& JSONdomBuilder::getRoot() const
+{
+	return root;
+}
+
+//
+
+bool JSONdomBuilder::beginObject()
+{
+	JSONvalueSP jsonObject = JSONobjectSP(new JSONobject());
+
+	if (!addValue(jsonObject))
+	{
+		return false;
+	}
+
+	allContainers.push_back(jsonObject);
+
+	return true;
+}
+
+bool JSONdomBuilder::key(const string& key)
+{
+	currentKey = JSONstringSP(new JSONstring(key));
+
+	return true;
+}
+
+bool JSONdomBuilder::endObject()
+{
+	allContainers.pop_back();
+
+	return true;
+}
+
+bool JSONdomBuilder::beginArray()
+{
+	JSONvalueSP jsonArray = JSONarraySP(new JSONarray());
+
+	if (!addValue(jsonArray))
+	{
+		return false;
+	}
+
+	allContainers.push_back(jsonArray);
+
+	return true;
+}
+
+bool JSONdomBuilder::endArray()
+{
+	allContainers.pop_back();
+
+	return true;
+}
+
+bool JSONdomBuilder::stringValue(const string& value)
+{
+	return addValue(JSONstringSP(new JSONstring(value)));
+}
+
+bool JSONdomBuilder::floatValue(float value)
+{
+	return addValue(JSONnumberSP(new JSONnumber(value)));
+}
+
+bool JSONdomBuilder::integerValue(int32_t value)
+{
+	return addValue(JSONnumberSP(new JSONnumber(value)));
+}
+
+bool JSONdomBuilder::trueValue()
+{
+	return addValue(JSONtrueSP(new JSONtrue()));
+}
+
+bool JSONdomBuilder::falseValue()
+{
+	return addValue(JSONfalseSP(new JSONfalse()));
+}
+
+bool JSONdomBuilder::nullValue()
+{
+	return addValue(JSONnullSP(new JSONnull()));
+}
@@ -0,0 +1,78 @@
+/*
+ * JSONdomBuilder.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONDOMBUILDER_H_
+#define JSONDOMBUILDER_H_
+
+#include "JSONvalue.h"
+#include "JSONobject.h"
+#include "JSONarray.h"
+#include "JSONnumber.h"
+#include "JSONstring.h"
+#include "JSONtrue.h"
+#include "JSONfalse.h"
+#include "JSONnull.h"
+
+#include "JSONhandler.h"
+
+/**
+ * Builds JSON values out of the events of a JSONreader, e.g. only for parts of a text.
+ */
+class JSONdomBuilder : public JSONhandler
+{
+
+private:
+
+	JSONvalueSP root;
+
+	std::vector<JSONvalueSP> allContainers;
+
+	JSONstringSP currentKey;
+
+	bool addValue(const JSONvalueSP& value);
+
+public:
+
+	JSONdomBuilder();
+	virtual ~JSONdomBuilder();
+
+	void reset();
+
+	/**
+	 * Returns true, if a complete value was built.
+	 */
+	bool isDone() const;
+
+	const JSONvalueSP& getRoot() const;
+
+	//
+
+	virtual bool beginObject();
+
+	virtual bool key(const std::string& key);
+
+	virtual bool endObject();
+
+	virtual bool beginArray();
+
+	virtual bool endArray();
+
+	virtual bool stringValue(const std::string& value);
+
+	virtual bool floatValue(float value);
+
+	virtual bool integerValue(std::int32_t value);
+
+	virtual bool trueValue();
+
+	virtual bool falseValue();
+
+	virtual bool nullValue();
+
+};
+
+#endif /* JSONDOMBUILDER_H_ */
@@ -5,15 +5,12 @@
  *      Author: nopper
  */
 
-#define JSON_TAB_STEP 3
-
-#include "JSONtokens.h"
-
 #include "JSONencoder.h"
+#include "JSONstringSink.h"
 
 using namespace std;
 
-JSONencoder::JSONencoder() : jsonText(""), spaces(0)
+JSONencoder::JSONencoder(bool pretty) : pretty(pretty)
 {
 }
 
@@ -21,264 +18,122 @@ JSONencoder::~JSONencoder()
 {
 }
 
-bool JSONencoder::doLineFeed(int32_t tabs)
-{
-	if (spaces + JSON_TAB_STEP * tabs < 0)
-	{
-		return false;
-	}
-
-	jsonText += JSON_Encode_line_feed;
-
-	spaces += JSON_TAB_STEP * tabs;
-
-	for (int32_t i = 0; i < spaces; i++)
-	{
-		jsonText += JSON_space;
-	}
-
-	return true;
-}
-
 //
 
-bool JSONencoder::encodeObject(const JSONobjectSP jsonObject)
+bool JSONencoder::encodeObject(const JSONobjectSP jsonObject, JSONwriter& writer)
 {
 	if (jsonObject.get() == nullptr)
 	{
 		return false;
 	}
 
-	jsonText += JSON_left_curly_bracket;
-
-	auto allKeys = jsonObject->getAllKeys();
-
-	if (allKeys.size() > 0)
+	if (!writer.beginObject())
 	{
-		doLineFeed(1);
-
-		auto walker = allKeys.begin();
+		return false;
+	}
 
-		while (walker != allKeys.end())
+	for (auto walker = jsonObject->getAllKeys().begin(); walker != jsonObject->getAllKeys().end(); walker++)
+	{
+		if (walker->get() == nullptr)
 		{
-			if (!encodeString(*walker))
-			{
-				return false;
-			}
-
-			jsonText += JSON_space;
-			jsonText += JSON_colon;
-			jsonText += JSON_space;
-
-			if (!encodeValue(jsonObject->getValue(*walker)))
-			{
-				return false;
-			}
-
-			walker++;
-
-			if (walker != allKeys.end())
-			{
-				jsonText += JSON_comma;
+			return false;
+		}
 
-				doLineFeed(0);
-			}
+		if (!writer.key((*walker)->getValue()))
+		{
+			return false;
 		}
 
-		doLineFeed(-1);
+		if (!encodeValue(jsonObject->getValue(*walker), writer))
+		{
+			return false;
+		}
 	}
 
-	jsonText += JSON_right_curly_bracket;
-
-	return true;
+	return writer.endObject();
 }
 
-bool JSONencoder::encodeArray(const JSONarraySP jsonArray)
+bool JSONencoder::encodeArray(const JSONarraySP jsonArray, JSONwriter& writer)
 {
 	if (jsonArray.get() == nullptr)
 	{
 		return false;
 	}
 
-	jsonText += JSON_left_square_bracket;
-
-	auto allValues = jsonArray->getAllValues();
-
-	if (allValues.size() > 0)
+	if (!writer.beginArray())
 	{
-		doLineFeed(1);
-
-		auto walker = allValues.begin();
+		return false;
+	}
 
-		while (walker != allValues.end())
+	for (auto walker = jsonArray->getAllValues().begin(); walker != jsonArray->getAllValues().end(); walker++)
+	{
+		if (!encodeValue(*walker, writer))
 		{
-			if (!encodeValue(*walker))
-			{
-				return false;
-			}
-
-			walker++;
-
-			if (walker != allValues.end())
-			{
-				jsonText += JSON_comma;
-
-				doLineFeed(0);
-			}
+			return false;
 		}
-
-		doLineFeed(-1);
 	}
 
-	jsonText += JSON_right_square_bracket;
-
-	return true;
+	return writer.endArray();
 }
 
-bool JSONencoder::encodeNumber(const JSONnumberSP jsonNumber)
+bool JSONencoder::encodeNumber(const JSONnumberSP jsonNumber, JSONwriter& writer)
 {
 	if (jsonNumber.get() == nullptr)
 	{
 		return false;
 	}
 
-	char buffer[2048];
-
 	if (jsonNumber->isFloatValue())
 	{
-		float dummy;
-
-		float fractpart = fabsf(modff(jsonNumber->getFloatValue(), &dummy));
-
-		if (fabsf(jsonNumber->getFloatValue()) >= 1000000.0f || (fractpart <= 0.0000001f && fractpart > 0.0f))
-		{
-			sprintf(buffer, "%e", jsonNumber->getFloatValue());
-		}
-		else
-		{
-			sprintf(buffer, "%.6f", jsonNumber->getFloatValue());
-		}
-	}
-	else
-	{
-		sprintf(buffer, "%d", jsonNumber->getIntegerValue());
+		return writer.floatValue(jsonNumber->getFloatValue());
 	}
 
-	jsonText += string(buffer);
-
-	return true;
+	return writer.integerValue(jsonNumber->getIntegerValue());
 }
 
-bool JSONencoder::encodeString(const JSONstringSP jsonString)
+bool JSONencoder::encodeString(const JSONstringSP jsonString, JSONwriter& writer)
 {
-	char c;
-
 	if (jsonString.get() == nullptr)
 	{
 		return false;
 	}
 
-	jsonText += JSON_quotation_mark;
-
-	for (size_t i = 0; i < jsonString->getValue().length(); i++)
-	{
-		c = jsonString->getValue()[i];
-
-		if ((c >= JSON_C0_start && c <= JSON_C0_end) || (c >= JSON_C1_start && c <= JSON_C1_end))
-		{
-			return false;
-		}
-
-		if (c == JSON_quotation_mark[0])
-		{
-			jsonText += JSON_reverse_solidus;
-			jsonText += JSON_quotation_mark;
-		}
-		else if (c == JSON_reverse_solidus[0])
-		{
-			jsonText += JSON_reverse_solidus;
-			jsonText += JSON_reverse_solidus;
-		}
-		else if (c == JSON_solidus[0])
-		{
-			jsonText += JSON_reverse_solidus;
-			jsonText += JSON_solidus;
-		}
-		else if (c == JSON_Encode_backspace[0])
-		{
-			jsonText += JSON_reverse_solidus;
-			jsonText += JSON_Decode_backspace;
-		}
-		else if (c == JSON_Encode_form_feed[0])
-		{
-			jsonText += JSON_reverse_solidus;
-			jsonText += JSON_Decode_form_feed;
-		}
-		else if (c == JSON_Encode_line_feed[0])
-		{
-			jsonText += JSON_reverse_solidus;
-			jsonText += JSON_Decode_line_feed;
-		}
-		else if (c == JSON_Encode_carriage_return[0])
-		{
-			jsonText += JSON_reverse_solidus;
-			jsonText += JSON_Decode_carriage_return;
-		}
-		else if (c == JSON_Encode_character_tabulation[0])
-		{
-			jsonText += JSON_reverse_solidus;
-			jsonText += JSON_Decode_character_tabulation;
-		}
-		else
-		{
-			jsonText += jsonString->getValue().substr(i, 1);
-		}
-	}
-
-	jsonText += JSON_quotation_mark;
-
-	return true;
+	return writer.stringValue(jsonString->getValue());
 }
 
-bool JSONencoder::encodeTrue(const JSONtrueSP jsonTrue)
+bool JSONencoder::encodeTrue(const JSONtrueSP jsonTrue, JSONwriter& writer)
 {
 	if (jsonTrue.get() == nullptr)
 	{
 		return false;
 	}
 
-	jsonText += JSON_true;
-
-	return true;
+	return writer.trueValue();
 }
 
-bool JSONencoder::encodeFalse(const JSONfalseSP jsonFalse)
+bool JSONencoder::encodeFalse(const JSONfalseSP jsonFalse, JSONwriter& writer)
 {
 	if (jsonFalse.get() == nullptr)
 	{
 		return false;
 	}
 
-	jsonText += JSON_false;
-
-	return true;
+	return writer.falseValue();
 }
 
-bool JSONencoder::encodeNull(const JSONnullSP jsonNull)
+bool JSONencoder::encodeNull(const JSONnullSP jsonNull, JSONwriter& writer)
 {
 	if (jsonNull.get() == nullptr)
 	{
 		return false;
 	}
 
-	jsonText += JSON_null;
-
-	return true;
+	return writer.nullValue();
 }
 
 //
 
-bool JSONencoder::encodeValue(const JSONvalueSP jsonValue)
+bool JSONencoder::encodeValue(const JSONvalueSP jsonValue, JSONwriter& writer)
 {
 	if (jsonValue.get() == nullptr)
 	{
@@ -289,43 +144,43 @@ bool JSONencoder::encodeValue(const JSONvalueSP jsonValue)
 	{
 		const JSONobjectSP jsonObject = dynamic_pointer_cast<JSONobject>(jsonValue);
 
-		return encodeObject(jsonObject);
+		return encodeObject(jsonObject, writer);
 	}
 	else if (jsonValue->isJsonArray())
 	{
 		const JSONarraySP jsonArray = dynamic_pointer_cast<JSONarray>(jsonValue);
 
-		return encodeArray(jsonArray);
+		return encodeArray(jsonArray, writer);
 	}
 	else if (jsonValue->isJsonNumber())
 	{
 		const JSONnumberSP jsonNumber = dynamic_pointer_cast<JSONnumber>(jsonValue);
 
-		return encodeNumber(jsonNumber);
+		return encodeNumber(jsonNumber, writer);
 	}
 	else if (jsonValue->isJsonString())
 	{
 		const JSONstringSP jsonString = dynamic_pointer_cast<JSONstring>(jsonValue);
 
-		return encodeString(jsonString);
+		return encodeString(jsonString, writer);
 	}
 	else if (jsonValue->isJsonTrue())
 	{
 		const JSONtrueSP jsonTrue = dynamic_pointer_cast<JSONtrue>(jsonValue);
 
-		return encodeTrue(jsonTrue);
+		return encodeTrue(jsonTrue, writer);
 	}
 	else if (jsonValue->isJsonFalse())
 	{
 		const JSONfalseSP jsonFalse = dynamic_pointer_cast<JSONfalse>(jsonValue);
 
-		return encodeFalse(jsonFalse);
+		return encodeFalse(jsonFalse, writer);
 	}
 	else if (jsonValue->isJsonNull())
 	{
 		const JSONnullSP jsonNull = dynamic_pointer_cast<JSONnull>(jsonValue);
 
-		return encodeNull(jsonNull);
+		return encodeNull(jsonNull, writer);
 	}
 
 	return false;
@@ -335,22 +190,33 @@ bool JSONencoder::encodeValue(const JSONvalueSP jsonValue)
 
 bool JSONencoder::encode(const JSONvalueSP jsonValue, string& jsonText)
 {
-	bool result;
+	string encodedText;
 
-	if (jsonValue.get() == nullptr)
+	JSONstringSink sink(encodedText);
+
+	if (!encode(jsonValue, sink))
 	{
 		return false;
 	}
 
-	this->jsonText = "";
-	this->spaces = 0;
+	jsonText.swap(encodedText);
 
-	result = encodeValue(jsonValue);
+	return true;
+}
 
-	if (result)
+bool JSONencoder::encode(const JSONvalueSP jsonValue, JSONsink& sink)
+{
+	if (jsonValue.get() == nullptr)
 	{
-		jsonText = this->jsonText;
+		return false;
+	}
+
+	JSONwriter writer(sink, pretty);
+
+	if (!encodeValue(jsonValue, writer))
+	{
+		return false;
 	}
 
-	return result;
+	return writer.finish();
 }
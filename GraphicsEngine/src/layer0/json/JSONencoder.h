@@ -18,37 +18,40 @@
 #include "JSONtrue.h"
 #include "JSONfalse.h"
 #include "JSONnull.h"
+#include "JSONsink.h"
+#include "JSONwriter.h"
 
 class JSONencoder
 {
 
 private:
 
-	std::string jsonText;
+	bool pretty;
 
-	std::int32_t spaces;
-
-	bool doLineFeed(std::int32_t tabs);
-
-	bool encodeObject(const JSONobjectSP jsonObject);
-	bool encodeArray(const JSONarraySP jsonArray);
-	bool encodeNumber(const JSONnumberSP jsonNumber);
-	bool encodeString(const JSONstringSP jsonString);
-	bool encodeTrue(const JSONtrueSP jsonTrue);
-	bool encodeFalse(const JSONfalseSP jsonFalse);
-	bool encodeNull(const JSONnullSP jsonNull);
+	bool encodeObject(const JSONobjectSP jsonObject, JSONwriter& writer);
+	bool encodeArray(const JSONarraySP jsonArray, JSONwriter& writer);
+	bool encodeNumber(const JSONnumberSP jsonNumber, JSONwriter& writer);
+	bool encodeString(const JSONstringSP jsonString, JSONwriter& writer);
+	bool encodeTrue(const JSONtrueSP jsonTrue, JSONwriter& writer);
+	bool encodeFalse(const JSONfalseSP jsonFalse, JSONwriter& writer);
+	bool encodeNull(const JSONnullSP jsonNull, JSONwriter& writer);
 
 	//
 
-	bool encodeValue(const JSONvalueSP jsonValue);
+	bool encodeValue(const JSONvalueSP jsonValue, JSONwriter& writer);
 
 public:
 
-	JSONencoder();
+	JSONencoder(bool pretty = true);
 	~JSONencoder();
 
 	bool encode(const JSONvalueSP jsonValue, std::string& jsonText);
 
+	/**
+	 * Streams the text to the sink, e.g. a file, without holding it as a whole.
+	 */
+	bool encode(const JSONvalueSP jsonValue, JSONsink& sink);
+
 };
 
 #endif /* JSONENCODER_H_ */
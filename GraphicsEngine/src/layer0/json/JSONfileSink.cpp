@@ -0,0 +1,29 @@
+/*
+ * JSONfileSink.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "JSONfileSink.h"
+
+using namespace std;
+
+JSONfileSink::JSONfileSink(FILE* file) :
+	JSONsink(), file(file)
+{
+}
+
+JSONfileSink::~JSONfileSink()
+{
+}
+
+bool JSONfileSink::write(const char* data, size_t length)
+{
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	return fwrite(data, 1, length, file) == length;
+}
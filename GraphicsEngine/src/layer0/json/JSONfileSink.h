@@ -0,0 +1,34 @@
+/*
+ * JSONfileSink.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONFILESINK_H_
+#define JSONFILESINK_H_
+
+#include <cstdio>
+
+#include "JSONsink.h"
+
+/**
+ * Writes to an open file. The file is not closed.
+ */
+class JSONfileSink : public JSONsink
+{
+
+private:
+
+	FILE* file;
+
+public:
+
+	JSONfileSink(FILE* file);
+	virtual ~JSONfileSink();
+
+	virtual bool write(const char* data, size_t length);
+
+};
+
+#endif /* JSONFILESINK_H_ */
@@ -0,0 +1,33 @@
+/*
+ * JSONfloat.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONFLOAT_H_
+#define JSONFLOAT_H_
+
+#include "../../UsedLibs.h"
+
+// Longest printed number including the terminating zero, e.g. -0.0000012345678901234567.
+#define JSON_FLOAT_MAX_LENGTH 32
+
+/**
+ * Converts a JSON number to the nearest float or double, ties to even. Numbers too large become infinity.
+ * Independent of the locale. Returns false, if the text is not a JSON number.
+ */
+bool jsonParseFloat(const char* begin, const char* end, float& value);
+
+bool jsonParseDouble(const char* begin, const char* end, double& value);
+
+/**
+ * Writes the shortest JSON number, which is parsed back to exactly the value. Integral values get a fraction, so they
+ * are decoded as floats again. Independent of the locale. The buffer needs JSON_FLOAT_MAX_LENGTH characters and is
+ * terminated. Returns the length or -1, if the value is infinite or not a number.
+ */
+std::int32_t jsonPrintFloat(char* buffer, float value);
+
+std::int32_t jsonPrintDouble(char* buffer, double value);
+
+#endif /* JSONFLOAT_H_ */
@@ -0,0 +1,54 @@
+/*
+ * JSONhandler.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONHANDLER_H_
+#define JSONHANDLER_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Receives the events of a JSONreader. Returning false from any event stops reading.
+ * Strings are only valid during the call.
+ */
+class JSONhandler
+{
+
+public:
+
+	JSONhandler()
+	{
+	}
+
+	virtual ~JSONhandler()
+	{
+	}
+
+	virtual bool beginObject() = 0;
+
+	virtual bool key(const std::string& key) = 0;
+
+	virtual bool endObject() = 0;
+
+	virtual bool beginArray() = 0;
+
+	virtual bool endArray() = 0;
+
+	virtual bool stringValue(const std::string& value) = 0;
+
+	virtual bool floatValue(float value) = 0;
+
+	virtual bool integerValue(std::int32_t value) = 0;
+
+	virtual bool trueValue() = 0;
+
+	virtual bool falseValue() = 0;
+
+	virtual bool nullValue() = 0;
+
+};
+
+#endif /* JSONHANDLER_H_ */
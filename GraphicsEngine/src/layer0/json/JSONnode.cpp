@@ -0,0 +1,122 @@
+/*
+ * JSONnode.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <cstring>
+
+#include "JSONdocument.h"
+#include "JSONnode.h"
+
+using namespace std;
+
+int32_t compareJSONkey(const char* key, size_t keyLength, const JSONkey& other)
+{
+	size_t length = keyLength < other.length ? keyLength : other.length;
+
+	int32_t result = memcmp(key, other.text, length);
+
+	if (result != 0)
+	{
+		return result;
+	}
+
+	if (keyLength == other.length)
+	{
+		return 0;
+	}
+
+	return keyLength < other.length ? -1 : 1;
+}
+
+bool JSONnode::expand() const
+{
+	if (length != JSON_NODE_LAZY)
+	{
+		return true;
+	}
+
+	return span->document->expand(*this);
+}
+
+bool JSONnode::expandAll() const
+{
+	if (!expand())
+	{
+		return false;
+	}
+
+	if (type == JSON_NODE_ARRAY)
+	{
+		for (uint32_t i = 0; i < length; i++)
+		{
+			if (!values[i].expandAll())
+			{
+				return false;
+			}
+		}
+	}
+	else if (type == JSON_NODE_OBJECT)
+	{
+		for (uint32_t i = 0; i < length; i++)
+		{
+			if (!members[i].value.expandAll())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+const JSONnode* JSONnode::find(const char* key, size_t keyLength) const
+{
+	if (length == JSON_NODE_LAZY)
+	{
+		expand();
+	}
+
+	if (type != JSON_NODE_OBJECT)
+	{
+		return nullptr;
+	}
+
+	uint32_t low = 0;
+	uint32_t high = length;
+
+	while (low < high)
+	{
+		uint32_t middle = low + (high - low) / 2;
+
+		int32_t result = compareJSONkey(key, keyLength, *members[middle].key);
+
+		if (result == 0)
+		{
+			return &members[middle].value;
+		}
+
+		if (result < 0)
+		{
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
+		}
+	}
+
+	return nullptr;
+}
+
+const JSONnode* JSONnode::find(const char* key) const
+{
+	return find(key, strlen(key));
+}
+
+const JSONnode* JSONnode::find(const string& key) const
+{
+	return find(key.data(), key.length());
+}
@@ -0,0 +1,243 @@
+/*
+ * JSONnode.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONNODE_H_
+#define JSONNODE_H_
+
+#include "../../UsedLibs.h"
+
+enum JSONnodeType
+{
+	JSON_NODE_NULL,
+	JSON_NODE_FALSE,
+	JSON_NODE_TRUE,
+	JSON_NODE_FLOAT,
+	JSON_NODE_INTEGER,
+	JSON_NODE_STRING,
+	JSON_NODE_ARRAY,
+	JSON_NODE_OBJECT
+};
+
+/**
+ * Interned key. Each distinct key is stored once per JSONdocument.
+ */
+struct JSONkey
+{
+	const char* text;
+	std::uint32_t length;
+	std::uint32_t hash;
+};
+
+/**
+ * Orders keys by their bytes. Returns a negative value, zero or a positive value like strcmp.
+ */
+std::int32_t compareJSONkey(const char* key, std::size_t keyLength, const JSONkey& other);
+
+// Length of an object or array, which has not been decoded yet.
+#define JSON_NODE_LAZY 0xFFFFFFFF
+
+struct JSONmember;
+
+class JSONdocument;
+
+/**
+ * Text of an object or array in a lazily decoded JSONdocument.
+ */
+struct JSONlazySpan
+{
+	JSONdocument* document;
+
+	// Objects and arrays around the span.
+	std::int32_t depth;
+
+	const char* begin;
+	const char* end;
+};
+
+/**
+ * Value of a JSONdocument. Nodes live in the arena of the document and are only valid as long as the document.
+ * Strings are zero terminated. Object members are sorted by key.
+ * Objects and arrays of a lazily decoded document are decoded on their first access. This changes the node, so these
+ * must not be accessed by several threads at once.
+ */
+class JSONnode
+{
+
+	friend class JSONdocument;
+
+private:
+
+	mutable JSONnodeType type;
+
+	// Characters of a string, values of an array or members of an object.
+	mutable std::uint32_t length;
+
+	union
+	{
+		float floatValue;
+		std::int32_t integerValue;
+		const char* stringValue;
+		mutable const JSONnode* values;
+		mutable const JSONmember* members;
+		mutable const JSONlazySpan* span;
+	};
+
+public:
+
+	JSONnode() :
+		type(JSON_NODE_NULL), length(0), values(nullptr)
+	{
+	}
+
+	JSONnodeType getType() const
+	{
+		return type;
+	}
+
+	bool isNull() const
+	{
+		return type == JSON_NODE_NULL;
+	}
+
+	bool isBoolean() const
+	{
+		return type == JSON_NODE_FALSE || type == JSON_NODE_TRUE;
+	}
+
+	bool isNumber() const
+	{
+		return type == JSON_NODE_FLOAT || type == JSON_NODE_INTEGER;
+	}
+
+	bool isFloat() const
+	{
+		return type == JSON_NODE_FLOAT;
+	}
+
+	bool isString() const
+	{
+		return type == JSON_NODE_STRING;
+	}
+
+	bool isArray() const
+	{
+		return type == JSON_NODE_ARRAY;
+	}
+
+	bool isObject() const
+	{
+		return type == JSON_NODE_OBJECT;
+	}
+
+	bool getBooleanValue() const
+	{
+		return type == JSON_NODE_TRUE;
+	}
+
+	/**
+	 * Integers are converted.
+	 */
+	float getFloatValue() const
+	{
+		return type == JSON_NODE_INTEGER ? static_cast<float>(integerValue) : floatValue;
+	}
+
+	std::int32_t getIntegerValue() const
+	{
+		return type == JSON_NODE_FLOAT ? static_cast<std::int32_t>(floatValue) : integerValue;
+	}
+
+	const char* getStringValue() const
+	{
+		return stringValue;
+	}
+
+	std::uint32_t getLength() const
+	{
+		if (length == JSON_NODE_LAZY)
+		{
+			expand();
+		}
+
+		return length;
+	}
+
+	/**
+	 * Number of values of an array or members of an object.
+	 */
+	std::uint32_t size() const
+	{
+		if (length == JSON_NODE_LAZY)
+		{
+			expand();
+		}
+
+		return (type == JSON_NODE_ARRAY || type == JSON_NODE_OBJECT) ? length : 0;
+	}
+
+	/**
+	 * True for an object or array, which has not been accessed yet.
+	 */
+	bool isLazy() const
+	{
+		return length == JSON_NODE_LAZY;
+	}
+
+	/**
+	 * Decodes a lazy object or array, which is otherwise done on its first access.
+	 *
+	 * @return False, if its text is invalid. The node becomes null and the document records the error.
+	 */
+	bool expand() const;
+
+	/**
+	 * Decodes this and all nested lazy objects and arrays.
+	 *
+	 * @return False, if one of them is invalid.
+	 */
+	bool expandAll() const;
+
+	const JSONnode& getValueAt(std::uint32_t index) const
+	{
+		if (length == JSON_NODE_LAZY)
+		{
+			expand();
+		}
+
+		return values[index];
+	}
+
+	const JSONmember& getMemberAt(std::uint32_t index) const;
+
+	/**
+	 * Binary search in the members of an object. Returns nullptr, if the key does not exist.
+	 */
+	const JSONnode* find(const char* key, std::size_t keyLength) const;
+
+	const JSONnode* find(const char* key) const;
+
+	const JSONnode* find(const std::string& key) const;
+
+};
+
+struct JSONmember
+{
+	const JSONkey* key;
+	JSONnode value;
+};
+
+inline const JSONmember& JSONnode::getMemberAt(std::uint32_t index) const
+{
+	if (length == JSON_NODE_LAZY)
+	{
+		expand();
+	}
+
+	return members[index];
+}
+
+#endif /* JSONNODE_H_ */
@@ -5,6 +5,7 @@
  *      Author: nopper
  */
 
+#include "JSONfloat.h"
 #include "JSONnumber.h"
 
 using namespace std;
@@ -26,7 +27,9 @@ JSONnumber::JSONnumber(const string& value, bool isFloat) : JSONvalue(), isFloat
 
 	if (isFloat)
 	{
-		this->value.floatValue = static_cast<float>(atof(value.c_str()));
+		this->value.floatValue = 0.0f;
+
+		jsonParseFloat(value.data(), value.data() + value.length(), this->value.floatValue);
 	}
 	else
 	{
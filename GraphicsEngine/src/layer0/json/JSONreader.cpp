@@ -0,0 +1,411 @@
+/*
+ * JSONreader.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "JSONreader.h"
+
+using namespace std;
+
+static bool isWhitespace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Characters, which can continue a number or a literal name.
+static bool isTokenCharacter(char c)
+{
+	return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '.' || c == '+' || c == '-';
+}
+
+JSONreader::JSONreader(JSONhandler& handler, int32_t maxDepth) :
+	handler(handler), maxDepth(maxDepth), state(READER_VALUE), failed(false), allContainers(), pending(), pendingEscape(false), text()
+{
+}
+
+JSONreader::~JSONreader()
+{
+}
+
+bool JSONreader::isIncomplete(const char* begin, const char* end) const
+{
+	while (begin < end && isWhitespace(*begin))
+	{
+		begin++;
+	}
+
+	if (begin == end)
+	{
+		return false;
+	}
+
+	if (*begin == '"')
+	{
+		bool escape = false;
+
+		for (const char* walker = begin + 1; walker < end; walker++)
+		{
+			if (escape)
+			{
+				escape = false;
+			}
+			else if (*walker == '\\')
+			{
+				escape = true;
+			}
+			else if (*walker == '"' || static_cast<unsigned char>(*walker) < 0x20)
+			{
+				// The string is complete or invalid, so the error is real.
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	for (const char* walker = begin; walker < end; walker++)
+	{
+		if (!isTokenCharacter(*walker))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const char* JSONreader::findPendingEnd(const char* begin, const char* end)
+{
+	if (pending[0] == '"')
+	{
+		// Only the new chunk is scanned, otherwise a long string split into many chunks would be quadratic.
+		bool escape = pendingEscape;
+
+		for (const char* walker = begin; walker < end; walker++)
+		{
+			if (escape)
+			{
+				escape = false;
+			}
+			else if (*walker == '\\')
+			{
+				escape = true;
+			}
+			else if (*walker == '"')
+			{
+				return walker + 1;
+			}
+		}
+
+		pendingEscape = escape;
+
+		return nullptr;
+	}
+
+	for (const char* walker = begin; walker < end; walker++)
+	{
+		if (!isTokenCharacter(*walker))
+		{
+			return walker;
+		}
+	}
+
+	return nullptr;
+}
+
+bool JSONreader::processTokens(const char* begin, const char* end, bool last)
+{
+	JSONtokenizer tokenizer(begin, end);
+
+	JSONtoken token;
+
+	while (state != READER_DONE)
+	{
+		size_t offset = tokenizer.getOffset();
+
+		if (!tokenizer.next(token))
+		{
+			if (!last && isIncomplete(begin + offset, end))
+			{
+				while (isWhitespace(begin[offset]))
+				{
+					offset++;
+				}
+
+				pending.assign(begin + offset, end);
+
+				pendingEscape = false;
+
+				for (size_t i = 1; i < pending.length(); i++)
+				{
+					pendingEscape = !pendingEscape && pending[i] == '\\';
+				}
+
+				return true;
+			}
+
+			return false;
+		}
+
+		if (token.type == JSON_TOKEN_END)
+		{
+			return true;
+		}
+
+		// A number or literal name at the end of a chunk could be continued by the next one.
+		if (!last && token.end == end && (token.type == JSON_TOKEN_NUMBER || token.type == JSON_TOKEN_TRUE || token.type == JSON_TOKEN_FALSE || token.type == JSON_TOKEN_NULL))
+		{
+			pending.assign(token.begin, end);
+
+			return true;
+		}
+
+		if (!processToken(token))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool JSONreader::processToken(const JSONtoken& token)
+{
+	switch (state)
+	{
+		case READER_FIRST_VALUE:
+			if (token.type == JSON_TOKEN_RIGHT_SQUARE_BRACKET)
+			{
+				return endContainer(false);
+			}
+
+			return processValue(token);
+		case READER_VALUE:
+			return processValue(token);
+		case READER_FIRST_KEY:
+			if (token.type == JSON_TOKEN_RIGHT_CURLY_BRACKET)
+			{
+				return endContainer(true);
+			}
+
+			// Same as a key.
+		case READER_KEY:
+			if (token.type != JSON_TOKEN_STRING)
+			{
+				return false;
+			}
+
+			JSONtokenizer::decodeString(text, token);
+
+			state = READER_COLON;
+
+			return handler.key(text);
+		case READER_COLON:
+			if (token.type != JSON_TOKEN_COLON)
+			{
+				return false;
+			}
+
+			state = READER_VALUE;
+
+			return true;
+		case READER_COMMA:
+			if (token.type == JSON_TOKEN_COMMA)
+			{
+				state = allContainers.back() ? READER_KEY : READER_VALUE;
+
+				return true;
+			}
+			else if (token.type == JSON_TOKEN_RIGHT_CURLY_BRACKET && allContainers.back())
+			{
+				return endContainer(true);
+			}
+			else if (token.type == JSON_TOKEN_RIGHT_SQUARE_BRACKET && !allContainers.back())
+			{
+				return endContainer(false);
+			}
+
+			return false;
+		case READER_DONE:
+			return true;
+	}
+
+	return false;
+}
+
+bool JSONreader::processValue(const JSONtoken& token)
+{
+	switch (token.type)
+	{
+		case JSON_TOKEN_LEFT_CURLY_BRACKET:
+			if (static_cast<int32_t>(allContainers.size()) >= maxDepth)
+			{
+				return false;
+			}
+
+			allContainers.push_back(true);
+
+			state = READER_FIRST_KEY;
+
+			return handler.beginObject();
+		case JSON_TOKEN_LEFT_SQUARE_BRACKET:
+			if (static_cast<int32_t>(allContainers.size()) >= maxDepth)
+			{
+				return false;
+			}
+
+			allContainers.push_back(false);
+
+			state = READER_FIRST_VALUE;
+
+			return handler.beginArray();
+		case JSON_TOKEN_STRING:
+			JSONtokenizer::decodeString(text, token);
+
+			endValue();
+
+			return handler.stringValue(text);
+		case JSON_TOKEN_NUMBER:
+			endValue();
+
+			if (token.isFloat)
+			{
+				return handler.floatValue(JSONtokenizer::decodeFloat(token));
+			}
+
+			return handler.integerValue(JSONtokenizer::decodeInteger(token));
+		case JSON_TOKEN_TRUE:
+			endValue();
+
+			return handler.trueValue();
+		case JSON_TOKEN_FALSE:
+			endValue();
+
+			return handler.falseValue();
+		case JSON_TOKEN_NULL:
+			endValue();
+
+			return handler.nullValue();
+		default:
+			break;
+	}
+
+	return false;
+}
+
+bool JSONreader::endContainer(bool isObject)
+{
+	allContainers.pop_back();
+
+	endValue();
+
+	if (isObject)
+	{
+		return handler.endObject();
+	}
+
+	return handler.endArray();
+}
+
+void JSONreader::endValue()
+{
+	state = allContainers.empty() ? READER_DONE : READER_COMMA;
+}
+
+void JSONreader::reset()
+{
+	state = READER_VALUE;
+
+	failed = false;
+
+	allContainers.clear();
+
+	pending.clear();
+
+	pendingEscape = false;
+}
+
+bool JSONreader::feed(const char* begin, const char* end)
+{
+	if (failed)
+	{
+		return false;
+	}
+
+	if (state == READER_DONE)
+	{
+		return true;
+	}
+
+	if (!pending.empty())
+	{
+		const char* pendingEnd = findPendingEnd(begin, end);
+
+		if (pendingEnd == nullptr)
+		{
+			pending.append(begin, end);
+
+			return true;
+		}
+
+		pending.append(begin, pendingEnd);
+
+		failed = !processTokens(pending.data(), pending.data() + pending.length(), true);
+
+		pending.clear();
+
+		if (failed)
+		{
+			return false;
+		}
+
+		begin = pendingEnd;
+	}
+
+	failed = !processTokens(begin, end, false);
+
+	return !failed;
+}
+
+bool JSONreader::finish()
+{
+	if (failed)
+	{
+		return false;
+	}
+
+	if (!pending.empty())
+	{
+		failed = !processTokens(pending.data(), pending.data() + pending.length(), true);
+
+		pending.clear();
+
+		if (failed)
+		{
+			return false;
+		}
+	}
+
+	return state == READER_DONE;
+}
+
+bool JSONreader::read(const char* begin, const char* end)
+{
+	reset();
+
+	if (!processTokens(begin, end, true))
+	{
+		failed = true;
+
+		return false;
+	}
+
+	return state == READER_DONE;
+}
+
+bool JSONreader::isDone() const
+{
+	return state == READER_DONE;
+}
@@ -0,0 +1,98 @@
+/*
+ * JSONreader.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONREADER_H_
+#define JSONREADER_H_
+
+#include "../../UsedLibs.h"
+
+#include "JSONhandler.h"
+#include "JSONtokenizer.h"
+
+#define JSON_READER_MAX_DEPTH 256
+
+/**
+ * Event based JSON reader. The text can be passed at once or fed in chunks of any size. Memory is bounded by the nesting depth
+ * and the longest token, as only a token split between two chunks is buffered.
+ */
+class JSONreader
+{
+
+private:
+
+	enum ReaderState
+	{
+		READER_VALUE,
+		READER_FIRST_VALUE,
+		READER_KEY,
+		READER_FIRST_KEY,
+		READER_COLON,
+		READER_COMMA,
+		READER_DONE
+	};
+
+	JSONhandler& handler;
+
+	std::int32_t maxDepth;
+
+	ReaderState state;
+
+	bool failed;
+
+	// True for an object, false for an array.
+	std::vector<bool> allContainers;
+
+	// Token, which was split between two chunks.
+	std::string pending;
+
+	// A pending string ends with an unfinished escape sequence.
+	bool pendingEscape;
+
+	// Reused for decoding keys and strings.
+	std::string text;
+
+	bool isIncomplete(const char* begin, const char* end) const;
+
+	const char* findPendingEnd(const char* begin, const char* end);
+
+	bool processTokens(const char* begin, const char* end, bool last);
+
+	bool processToken(const JSONtoken& token);
+
+	bool processValue(const JSONtoken& token);
+
+	bool endContainer(bool isObject);
+
+	void endValue();
+
+public:
+
+	JSONreader(JSONhandler& handler, std::int32_t maxDepth = JSON_READER_MAX_DEPTH);
+	~JSONreader();
+
+	void reset();
+
+	/**
+	 * Processes the next chunk of the text. Returns false, if the text is invalid or the handler stopped reading.
+	 */
+	bool feed(const char* begin, const char* end);
+
+	/**
+	 * Processes a token left from the last chunk. Returns true, if exactly one complete value was read.
+	 */
+	bool finish();
+
+	/**
+	 * Reads the complete text in the range [begin, end). Text after the value is ignored.
+	 */
+	bool read(const char* begin, const char* end);
+
+	bool isDone() const;
+
+};
+
+#endif /* JSONREADER_H_ */
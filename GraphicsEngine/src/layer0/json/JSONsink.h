@@ -0,0 +1,33 @@
+/*
+ * JSONsink.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONSINK_H_
+#define JSONSINK_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Destination of a JSONwriter. Receives the text in chunks. Returning false stops writing.
+ */
+class JSONsink
+{
+
+public:
+
+	JSONsink()
+	{
+	}
+
+	virtual ~JSONsink()
+	{
+	}
+
+	virtual bool write(const char* data, size_t length) = 0;
+
+};
+
+#endif /* JSONSINK_H_ */
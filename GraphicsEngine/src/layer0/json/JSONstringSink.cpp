@@ -0,0 +1,26 @@
+/*
+ * JSONstringSink.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "JSONstringSink.h"
+
+using namespace std;
+
+JSONstringSink::JSONstringSink(string& jsonText) :
+	JSONsink(), jsonText(jsonText)
+{
+}
+
+JSONstringSink::~JSONstringSink()
+{
+}
+
+bool JSONstringSink::write(const char* data, size_t length)
+{
+	jsonText.append(data, length);
+
+	return true;
+}
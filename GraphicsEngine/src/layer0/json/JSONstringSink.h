@@ -0,0 +1,32 @@
+/*
+ * JSONstringSink.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONSTRINGSINK_H_
+#define JSONSTRINGSINK_H_
+
+#include "JSONsink.h"
+
+/**
+ * Appends to a string in memory.
+ */
+class JSONstringSink : public JSONsink
+{
+
+private:
+
+	std::string& jsonText;
+
+public:
+
+	JSONstringSink(std::string& jsonText);
+	virtual ~JSONstringSink();
+
+	virtual bool write(const char* data, size_t length);
+
+};
+
+#endif /* JSONSTRINGSINK_H_ */
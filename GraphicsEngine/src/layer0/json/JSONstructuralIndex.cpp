@@ -0,0 +1,388 @@
+/*
+ * JSONstructuralIndex.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <cstring>
+
+#include "JSONstructuralIndex.h"
+
+#if !defined(GE_JSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GE_JSON_SSE2
+#include <emmintrin.h>
+#if (defined(_MSC_VER) && _MSC_VER >= 1800) || defined(__GNUC__)
+#define GE_JSON_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(GE_JSON_AVX2) && defined(__GNUC__)
+#define GE_JSON_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GE_JSON_TARGET_AVX2
+#endif
+
+using namespace std;
+
+/**
+ * One bit per byte of a 64 byte block.
+ */
+struct JSONblockMasks
+{
+	uint64_t quote;
+	uint64_t backslash;
+	uint64_t structural;
+	uint64_t whitespace;
+	uint64_t control;
+};
+
+typedef void (*JSONclassifyFunction)(const uint8_t* block, JSONblockMasks& masks);
+
+static void classifyScalar(const uint8_t* block, JSONblockMasks& masks)
+{
+	masks.quote = 0;
+	masks.backslash = 0;
+	masks.structural = 0;
+	masks.whitespace = 0;
+	masks.control = 0;
+
+	for (int32_t i = 0; i < 64; i++)
+	{
+		uint64_t bit = static_cast<uint64_t>(1) << i;
+
+		switch (block[i])
+		{
+			case '"':
+				masks.quote |= bit;
+				break;
+			case '\\':
+				masks.backslash |= bit;
+				break;
+			case '{':
+			case '}':
+			case '[':
+			case ']':
+			case ':':
+			case ',':
+				masks.structural |= bit;
+				break;
+			case ' ':
+				masks.whitespace |= bit;
+				break;
+			case '\t':
+			case '\n':
+			case '\r':
+				masks.whitespace |= bit;
+				masks.control |= bit;
+				break;
+			default:
+				if (block[i] < 0x20)
+				{
+					masks.control |= bit;
+				}
+				break;
+		}
+	}
+}
+
+#if defined(GE_JSON_SSE2)
+
+static void classifySse2(const uint8_t* block, JSONblockMasks& masks)
+{
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i leftCurlyBracket = _mm_set1_epi8('{');
+	const __m128i rightCurlyBracket = _mm_set1_epi8('}');
+	const __m128i leftSquareBracket = _mm_set1_epi8('[');
+	const __m128i rightSquareBracket = _mm_set1_epi8(']');
+	const __m128i colon = _mm_set1_epi8(':');
+	const __m128i comma = _mm_set1_epi8(',');
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i tabulation = _mm_set1_epi8('\t');
+	const __m128i lineFeed = _mm_set1_epi8('\n');
+	const __m128i carriageReturn = _mm_set1_epi8('\r');
+	const __m128i lastControl = _mm_set1_epi8(0x1F);
+
+	masks.quote = 0;
+	masks.backslash = 0;
+	masks.structural = 0;
+	masks.whitespace = 0;
+	masks.control = 0;
+
+	for (int32_t i = 0; i < 4; i++)
+	{
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+
+		__m128i structural = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, leftCurlyBracket), _mm_cmpeq_epi8(chunk, rightCurlyBracket)), _mm_or_si128(_mm_cmpeq_epi8(chunk, leftSquareBracket), _mm_cmpeq_epi8(chunk, rightSquareBracket)));
+		structural = _mm_or_si128(structural, _mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma)));
+
+		__m128i whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tabulation)), _mm_or_si128(_mm_cmpeq_epi8(chunk, lineFeed), _mm_cmpeq_epi8(chunk, carriageReturn)));
+
+		// Unsigned compare by the minimum.
+		__m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, lastControl), chunk);
+
+		int32_t shift = i * 16;
+
+		masks.quote |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)))) << shift;
+		masks.backslash |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)))) << shift;
+		masks.structural |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(structural))) << shift;
+		masks.whitespace |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(whitespace))) << shift;
+		masks.control |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(control))) << shift;
+	}
+}
+
+#endif
+
+#if defined(GE_JSON_AVX2)
+
+GE_JSON_TARGET_AVX2 static void classifyAvx2(const uint8_t* block, JSONblockMasks& masks)
+{
+	const __m256i quote = _mm256_set1_epi8('"');
+	const __m256i backslash = _mm256_set1_epi8('\\');
+	const __m256i leftCurlyBracket = _mm256_set1_epi8('{');
+	const __m256i rightCurlyBracket = _mm256_set1_epi8('}');
+	const __m256i leftSquareBracket = _mm256_set1_epi8('[');
+	const __m256i rightSquareBracket = _mm256_set1_epi8(']');
+	const __m256i colon = _mm256_set1_epi8(':');
+	const __m256i comma = _mm256_set1_epi8(',');
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i tabulation = _mm256_set1_epi8('\t');
+	const __m256i lineFeed = _mm256_set1_epi8('\n');
+	const __m256i carriageReturn = _mm256_set1_epi8('\r');
+	const __m256i lastControl = _mm256_set1_epi8(0x1F);
+
+	masks.quote = 0;
+	masks.backslash = 0;
+	masks.structural = 0;
+	masks.whitespace = 0;
+	masks.control = 0;
+
+	for (int32_t i = 0; i < 2; i++)
+	{
+		__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i * 32));
+
+		__m256i structural = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, leftCurlyBracket), _mm256_cmpeq_epi8(chunk, rightCurlyBracket)), _mm256_or_si256(_mm256_cmpeq_epi8(chunk, leftSquareBracket), _mm256_cmpeq_epi8(chunk, rightSquareBracket)));
+		structural = _mm256_or_si256(structural, _mm256_or_si256(_mm256_cmpeq_epi8(chunk, colon), _mm256_cmpeq_epi8(chunk, comma)));
+
+		__m256i whitespace = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tabulation)), _mm256_or_si256(_mm256_cmpeq_epi8(chunk, lineFeed), _mm256_cmpeq_epi8(chunk, carriageReturn)));
+
+		__m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, lastControl), chunk);
+
+		int32_t shift = i * 32;
+
+		masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quote)))) << shift;
+		masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash)))) << shift;
+		masks.structural |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(structural))) << shift;
+		masks.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(whitespace))) << shift;
+		masks.control |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(control))) << shift;
+	}
+}
+
+#endif
+
+static int32_t countTrailingZeros(uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+
+	_BitScanForward64(&index, value);
+
+	return static_cast<int32_t>(index);
+#elif defined(_MSC_VER)
+	unsigned long index;
+
+	if (_BitScanForward(&index, static_cast<unsigned long>(value)))
+	{
+		return static_cast<int32_t>(index);
+	}
+
+	_BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+
+	return static_cast<int32_t>(index) + 32;
+#else
+	return __builtin_ctzll(value);
+#endif
+}
+
+/**
+ * Each bit is the parity of all bits up to and including it.
+ */
+static uint64_t prefixXor(uint64_t value)
+{
+	value ^= value << 1;
+	value ^= value << 2;
+	value ^= value << 4;
+	value ^= value << 8;
+	value ^= value << 16;
+	value ^= value << 32;
+
+	return value;
+}
+
+JSONstructuralIndex::JSONstructuralIndex() :
+	allPositions()
+{
+}
+
+JSONstructuralIndex::~JSONstructuralIndex()
+{
+}
+
+bool JSONstructuralIndex::build(const char* begin, const char* end)
+{
+	return build(begin, end, getBestKernel());
+}
+
+bool JSONstructuralIndex::build(const char* begin, const char* end, JSONscanKernel kernel)
+{
+	static const uint64_t ODD_BITS = 0xAAAAAAAAAAAAAAAAull;
+
+	allPositions.clear();
+
+	size_t length = static_cast<size_t>(end - begin);
+
+	if (static_cast<uint64_t>(length) > 0xFFFFFFFFull)
+	{
+		return false;
+	}
+
+	JSONclassifyFunction classify = classifyScalar;
+
+#if defined(GE_JSON_SSE2)
+	if (kernel == JSON_SCAN_SSE2)
+	{
+		classify = classifySse2;
+	}
+#endif
+#if defined(GE_JSON_AVX2)
+	if (kernel == JSON_SCAN_AVX2)
+	{
+		classify = classifyAvx2;
+	}
+#endif
+
+	// State, which is carried from one block to the next.
+	uint64_t nextIsEscaped = 0;
+	uint64_t previousInString = 0;
+	uint64_t previousScalar = 0;
+
+	uint64_t error = 0;
+
+	size_t count = 0;
+
+	JSONblockMasks masks;
+
+	uint8_t lastBlock[64];
+
+	for (size_t offset = 0; offset < length; offset += 64)
+	{
+		const uint8_t* block = reinterpret_cast<const uint8_t*>(begin + offset);
+
+		if (length - offset < 64)
+		{
+			// Padded with whitespace.
+			memset(lastBlock, ' ', sizeof(lastBlock));
+			memcpy(lastBlock, block, length - offset);
+
+			block = lastBlock;
+		}
+
+		classify(block, masks);
+
+		// Escaped characters follow an odd number of backslashes.
+		uint64_t potentialEscape = masks.backslash & ~nextIsEscaped;
+		uint64_t escapeAndTerminalCode = (((potentialEscape << 1) | ODD_BITS) - potentialEscape) ^ ODD_BITS;
+		uint64_t escaped = escapeAndTerminalCode ^ (masks.backslash | nextIsEscaped);
+		nextIsEscaped = (escapeAndTerminalCode & masks.backslash) >> 63;
+
+		uint64_t quote = masks.quote & ~escaped;
+
+		// From an opening quotation mark up to the closing one, which is excluded.
+		uint64_t inString = prefixXor(quote) ^ previousInString;
+		previousInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+		error |= masks.control & inString;
+
+		uint64_t scalar = ~(masks.structural | masks.whitespace | quote | inString);
+		uint64_t scalarStart = scalar & ~((scalar << 1) | previousScalar);
+		previousScalar = scalar >> 63;
+
+		uint64_t positions = (masks.structural & ~inString) | quote | scalarStart;
+
+		if (allPositions.size() < count + 64)
+		{
+			allPositions.resize(max(count + 64, allPositions.size() * 2));
+		}
+
+		uint32_t* output = allPositions.data() + count;
+
+		while (positions != 0)
+		{
+			*output++ = static_cast<uint32_t>(offset) + static_cast<uint32_t>(countTrailingZeros(positions));
+
+			positions &= positions - 1;
+		}
+
+		count = static_cast<size_t>(output - allPositions.data());
+	}
+
+	allPositions.resize(count);
+
+	// Padding of the last block is whitespace, so positions are never past the end.
+	return error == 0 && previousInString == 0;
+}
+
+const vector<uint32_t>& JSONstructuralIndex::getPositions() const
+{
+	return allPositions;
+}
+
+static JSONscanKernel detectKernel()
+{
+#if defined(GE_JSON_AVX2)
+#if defined(_MSC_VER)
+	int32_t info[4];
+
+	__cpuid(info, 0);
+
+	if (info[0] >= 7)
+	{
+		__cpuid(info, 1);
+
+		// OSXSAVE and AVX, then the operating system has to save the YMM registers.
+		bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+
+		__cpuidex(info, 7, 0);
+
+		if (avx && (info[1] & (1 << 5)) != 0)
+		{
+			return JSON_SCAN_AVX2;
+		}
+	}
+#else
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return JSON_SCAN_AVX2;
+	}
+#endif
+#endif
+
+#if defined(GE_JSON_SSE2)
+	return JSON_SCAN_SSE2;
+#else
+	return JSON_SCAN_SCALAR;
+#endif
+}
+
+JSONscanKernel JSONstructuralIndex::getBestKernel()
+{
+	static const JSONscanKernel bestKernel = detectKernel();
+
+	return bestKernel;
+}
@@ -0,0 +1,55 @@
+/*
+ * JSONstructuralIndex.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONSTRUCTURALINDEX_H_
+#define JSONSTRUCTURALINDEX_H_
+
+#include "../../UsedLibs.h"
+
+// Define GE_JSON_NO_SIMD to force the scalar classification.
+
+enum JSONscanKernel
+{
+	JSON_SCAN_SCALAR,
+	JSON_SCAN_SSE2,
+	JSON_SCAN_AVX2
+};
+
+/**
+ * First pass over a JSON text. Classifies 64 bytes at a time and records the positions of all structural characters and
+ * quotation marks outside of strings, plus the first character of each number and literal name. Strings are checked for
+ * control characters and termination, everything else is left to the tokenizer.
+ */
+class JSONstructuralIndex
+{
+
+private:
+
+	std::vector<std::uint32_t> allPositions;
+
+public:
+
+	JSONstructuralIndex();
+	~JSONstructuralIndex();
+
+	/**
+	 * Returns false, if a string is not terminated or contains a control character.
+	 */
+	bool build(const char* begin, const char* end);
+
+	bool build(const char* begin, const char* end, JSONscanKernel kernel);
+
+	const std::vector<std::uint32_t>& getPositions() const;
+
+	/**
+	 * Best kernel of the running CPU.
+	 */
+	static JSONscanKernel getBestKernel();
+
+};
+
+#endif /* JSONSTRUCTURALINDEX_H_ */
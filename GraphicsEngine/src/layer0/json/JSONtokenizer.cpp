@@ -0,0 +1,638 @@
+/*
+ * JSONtokenizer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <cstring>
+
+#include "JSONfloat.h"
+#include "JSONtokenizer.h"
+
+using namespace std;
+
+#define JSON_SKIP_LEVELS 1024
+
+static bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static bool isHexadecimalDigit(char c)
+{
+	return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static uint32_t getHexadecimalValue(char c)
+{
+	if (c >= 'a')
+	{
+		return static_cast<uint32_t>(c - 'a' + 10);
+	}
+	if (c >= 'A')
+	{
+		return static_cast<uint32_t>(c - 'A' + 10);
+	}
+
+	return static_cast<uint32_t>(c - '0');
+}
+
+static uint32_t decodeHexadecimalNumber(const char* walker)
+{
+	return (getHexadecimalValue(walker[0]) << 12) | (getHexadecimalValue(walker[1]) << 8) | (getHexadecimalValue(walker[2]) << 4) | getHexadecimalValue(walker[3]);
+}
+
+static void appendUtf8(string& value, uint32_t codePoint)
+{
+	if (codePoint < 0x80)
+	{
+		value += static_cast<char>(codePoint);
+	}
+	else if (codePoint < 0x800)
+	{
+		value += static_cast<char>(0xC0 | (codePoint >> 6));
+		value += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else if (codePoint < 0x10000)
+	{
+		value += static_cast<char>(0xE0 | (codePoint >> 12));
+		value += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		value += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else
+	{
+		value += static_cast<char>(0xF0 | (codePoint >> 18));
+		value += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		value += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		value += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+static bool isDelimiter(char c)
+{
+	switch (c)
+	{
+		case ' ':
+		case '\t':
+		case '\n':
+		case '\r':
+		case '{':
+		case '}':
+		case '[':
+		case ']':
+		case ':':
+		case ',':
+		case '"':
+			return true;
+		default:
+			break;
+	}
+
+	return false;
+}
+
+JSONtokenizer::JSONtokenizer(const char* begin, const char* end) :
+	begin(begin), current(begin), end(end), position(nullptr), positionEnd(nullptr)
+{
+}
+
+JSONtokenizer::JSONtokenizer(const char* begin, const char* end, const JSONstructuralIndex& index) :
+	begin(begin), current(begin), end(end), position(index.getPositions().data()), positionEnd(index.getPositions().data() + index.getPositions().size())
+{
+}
+
+JSONtokenizer::JSONtokenizer(const char* begin, const char* end, const JSONstructuralIndex& index, size_t offset) :
+	begin(begin), current(begin + offset), end(end), position(nullptr), positionEnd(index.getPositions().data() + index.getPositions().size())
+{
+	position = lower_bound(index.getPositions().data(), positionEnd, static_cast<uint32_t>(offset));
+}
+
+JSONtokenizer::~JSONtokenizer()
+{
+}
+
+bool JSONtokenizer::scanString(JSONtoken& token)
+{
+	const char* walker = current + 1;
+
+	token.type = JSON_TOKEN_STRING;
+	token.begin = walker;
+	token.escaped = false;
+
+	while (walker < end)
+	{
+		char c = *walker;
+
+		if (c == '"')
+		{
+			token.end = walker;
+
+			current = walker + 1;
+
+			return true;
+		}
+		else if (c == '\\')
+		{
+			token.escaped = true;
+
+			walker++;
+
+			if (walker >= end)
+			{
+				return false;
+			}
+
+			switch (*walker)
+			{
+				case '"':
+				case '\\':
+				case '/':
+				case 'b':
+				case 'f':
+				case 'n':
+				case 'r':
+				case 't':
+					break;
+				case 'u':
+					if (end - walker < 5 || !isHexadecimalDigit(walker[1]) || !isHexadecimalDigit(walker[2]) || !isHexadecimalDigit(walker[3]) || !isHexadecimalDigit(walker[4]))
+					{
+						return false;
+					}
+
+					walker += 4;
+
+					break;
+				default:
+					return false;
+			}
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			return false;
+		}
+
+		walker++;
+	}
+
+	return false;
+}
+
+bool JSONtokenizer::scanIndexedString(JSONtoken& token)
+{
+	if (position == positionEnd)
+	{
+		return false;
+	}
+
+	const char* closing = begin + *position++;
+
+	token.type = JSON_TOKEN_STRING;
+	token.begin = current + 1;
+	token.end = closing;
+	token.escaped = false;
+
+	// Control characters were already rejected by the index, only escape sequences have to be checked.
+	if (memchr(token.begin, '\\', static_cast<size_t>(closing - token.begin)) != nullptr)
+	{
+		return scanString(token) && token.end == closing;
+	}
+
+	current = closing + 1;
+
+	return true;
+}
+
+bool JSONtokenizer::scanNumber(JSONtoken& token)
+{
+	const char* walker = current;
+
+	token.type = JSON_TOKEN_NUMBER;
+	token.begin = walker;
+	token.isFloat = false;
+
+	if (*walker == '-')
+	{
+		walker++;
+	}
+
+	if (walker >= end || !isDigit(*walker))
+	{
+		return false;
+	}
+
+	if (*walker == '0')
+	{
+		walker++;
+	}
+	else
+	{
+		while (walker < end && isDigit(*walker))
+		{
+			walker++;
+		}
+	}
+
+	if (walker < end && *walker == '.')
+	{
+		token.isFloat = true;
+
+		walker++;
+
+		if (walker >= end || !isDigit(*walker))
+		{
+			return false;
+		}
+
+		while (walker < end && isDigit(*walker))
+		{
+			walker++;
+		}
+	}
+
+	if (walker < end && (*walker == 'e' || *walker == 'E'))
+	{
+		token.isFloat = true;
+
+		walker++;
+
+		if (walker < end && (*walker == '+' || *walker == '-'))
+		{
+			walker++;
+		}
+
+		if (walker >= end || !isDigit(*walker))
+		{
+			return false;
+		}
+
+		while (walker < end && isDigit(*walker))
+		{
+			walker++;
+		}
+	}
+
+	token.end = walker;
+
+	current = walker;
+
+	return true;
+}
+
+bool JSONtokenizer::scanLiteral(JSONtoken& token, const char* literal, size_t length, JSONtokenType type)
+{
+	if (static_cast<size_t>(end - current) < length || memcmp(current, literal, length) != 0)
+	{
+		return false;
+	}
+
+	token.type = type;
+	token.begin = current;
+	token.end = current + length;
+
+	current += length;
+
+	return true;
+}
+
+bool JSONtokenizer::next(JSONtoken& token)
+{
+	if (position != nullptr)
+	{
+		if (position == positionEnd)
+		{
+			current = end;
+		}
+		else
+		{
+			current = begin + *position++;
+		}
+	}
+	else
+	{
+		while (current < end && (*current == ' ' || *current == '\t' || *current == '\n' || *current == '\r'))
+		{
+			current++;
+		}
+	}
+
+	token.begin = current;
+	token.end = current;
+	token.escaped = false;
+	token.isFloat = false;
+
+	if (current >= end)
+	{
+		token.type = JSON_TOKEN_END;
+
+		return true;
+	}
+
+	bool result = true;
+
+	switch (*current)
+	{
+		case '{':
+			token.type = JSON_TOKEN_LEFT_CURLY_BRACKET;
+			token.end = ++current;
+			break;
+		case '}':
+			token.type = JSON_TOKEN_RIGHT_CURLY_BRACKET;
+			token.end = ++current;
+			break;
+		case '[':
+			token.type = JSON_TOKEN_LEFT_SQUARE_BRACKET;
+			token.end = ++current;
+			break;
+		case ']':
+			token.type = JSON_TOKEN_RIGHT_SQUARE_BRACKET;
+			token.end = ++current;
+			break;
+		case ':':
+			token.type = JSON_TOKEN_COLON;
+			token.end = ++current;
+			break;
+		case ',':
+			token.type = JSON_TOKEN_COMMA;
+			token.end = ++current;
+			break;
+		case '"':
+			result = position != nullptr ? scanIndexedString(token) : scanString(token);
+			break;
+		case 't':
+			result = scanLiteral(token, "true", 4, JSON_TOKEN_TRUE);
+			break;
+		case 'f':
+			result = scanLiteral(token, "false", 5, JSON_TOKEN_FALSE);
+			break;
+		case 'n':
+			result = scanLiteral(token, "null", 4, JSON_TOKEN_NULL);
+			break;
+		default:
+			if (*current == '-' || isDigit(*current))
+			{
+				result = scanNumber(token);
+			}
+			else
+			{
+				result = false;
+			}
+			break;
+	}
+
+	// The index only knows where a run of number and name characters starts. If a token ends inside of such a run, the
+	// rest of the text is scanned, so the tokens are the same as without an index.
+	if (result && position != nullptr && (token.type == JSON_TOKEN_NUMBER || token.type == JSON_TOKEN_TRUE || token.type == JSON_TOKEN_FALSE || token.type == JSON_TOKEN_NULL) && current < end && !isDelimiter(*current))
+	{
+		position = nullptr;
+		positionEnd = nullptr;
+	}
+
+	if (!result)
+	{
+		token.type = JSON_TOKEN_ERROR;
+	}
+
+	return result;
+}
+
+bool JSONtokenizer::skipContainer(JSONtoken& token, int32_t maxDepth)
+{
+	if ((token.type != JSON_TOKEN_LEFT_CURLY_BRACKET && token.type != JSON_TOKEN_LEFT_SQUARE_BRACKET) || maxDepth < 1)
+	{
+		return false;
+	}
+
+	// One bit per nesting level is set for an object, so a bracket of the wrong kind is an error. Deeper levels are
+	// only counted.
+	uint64_t allLevels[JSON_SKIP_LEVELS / 64] = {token.type == JSON_TOKEN_LEFT_CURLY_BRACKET ? 1u : 0u};
+
+	int32_t depth = 1;
+
+	const char* walker = current;
+
+	while (true)
+	{
+		if (position != nullptr)
+		{
+			// Brackets inside of strings are not in the index.
+			if (position == positionEnd)
+			{
+				break;
+			}
+
+			walker = begin + *position++;
+		}
+		else
+		{
+			if (walker >= end)
+			{
+				break;
+			}
+
+			if (*walker == '"')
+			{
+				walker++;
+
+				while (walker < end && *walker != '"')
+				{
+					// Skips the escaped character, which may be a quotation mark.
+					if (*walker == '\\' && walker + 1 < end)
+					{
+						walker++;
+					}
+
+					walker++;
+				}
+
+				if (walker >= end)
+				{
+					break;
+				}
+			}
+		}
+
+		if (*walker == '{' || *walker == '[')
+		{
+			if (depth >= maxDepth)
+			{
+				break;
+			}
+
+			if (depth < JSON_SKIP_LEVELS)
+			{
+				if (*walker == '{')
+				{
+					allLevels[depth / 64] |= static_cast<uint64_t>(1) << (depth % 64);
+				}
+				else
+				{
+					allLevels[depth / 64] &= ~(static_cast<uint64_t>(1) << (depth % 64));
+				}
+			}
+
+			depth++;
+		}
+		else if (*walker == '}' || *walker == ']')
+		{
+			depth--;
+
+			if (depth < JSON_SKIP_LEVELS && ((allLevels[depth / 64] >> (depth % 64)) & 1) != (*walker == '}' ? 1u : 0u))
+			{
+				break;
+			}
+
+			if (depth == 0)
+			{
+				current = walker + 1;
+
+				token.end = current;
+
+				return true;
+			}
+		}
+
+		if (position == nullptr)
+		{
+			walker++;
+		}
+	}
+
+	current = end;
+
+	token.type = JSON_TOKEN_ERROR;
+
+	return false;
+}
+
+size_t JSONtokenizer::getOffset() const
+{
+	return static_cast<size_t>(current - begin);
+}
+
+//
+
+void JSONtokenizer::decodeString(string& value, const JSONtoken& token)
+{
+	if (!token.escaped)
+	{
+		value.assign(token.begin, token.end);
+
+		return;
+	}
+
+	value.clear();
+	value.reserve(token.end - token.begin);
+
+	const char* walker = token.begin;
+
+	while (walker < token.end)
+	{
+		if (*walker != '\\')
+		{
+			value += *walker;
+
+			walker++;
+
+			continue;
+		}
+
+		walker++;
+
+		switch (*walker)
+		{
+			case 'b':
+				value += '\b';
+				break;
+			case 'f':
+				value += '\f';
+				break;
+			case 'n':
+				value += '\n';
+				break;
+			case 'r':
+				value += '\r';
+				break;
+			case 't':
+				value += '\t';
+				break;
+			case 'u':
+			{
+				uint32_t codePoint = decodeHexadecimalNumber(walker + 1);
+
+				walker += 4;
+
+				if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+				{
+					// Surrogate pair.
+					if (token.end - walker > 6 && walker[1] == '\\' && walker[2] == 'u')
+					{
+						uint32_t lowSurrogate = decodeHexadecimalNumber(walker + 3);
+
+						if (lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF)
+						{
+							codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+
+							walker += 6;
+						}
+						else
+						{
+							codePoint = 0xFFFD;
+						}
+					}
+					else
+					{
+						codePoint = 0xFFFD;
+					}
+				}
+				else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+				{
+					codePoint = 0xFFFD;
+				}
+
+				appendUtf8(value, codePoint);
+			}
+			break;
+			default:
+				// Quotation mark, reverse solidus and solidus.
+				value += *walker;
+				break;
+		}
+
+		walker++;
+	}
+}
+
+float JSONtokenizer::decodeFloat(const JSONtoken& token)
+{
+	float value = 0.0f;
+
+	jsonParseFloat(token.begin, token.end, value);
+
+	return value;
+}
+
+int32_t JSONtokenizer::decodeInteger(const JSONtoken& token)
+{
+	const char* walker = token.begin;
+
+	bool negative = false;
+
+	if (*walker == '-')
+	{
+		negative = true;
+
+		walker++;
+	}
+
+	uint64_t value = 0;
+
+	while (walker < token.end)
+	{
+		value = value * 10 + static_cast<uint64_t>(*walker - '0');
+
+		walker++;
+	}
+
+	return static_cast<int32_t>(negative ? 0 - value : value);
+}
@@ -0,0 +1,110 @@
+/*
+ * JSONtokenizer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONTOKENIZER_H_
+#define JSONTOKENIZER_H_
+
+#include "../../UsedLibs.h"
+
+#include "JSONstructuralIndex.h"
+
+enum JSONtokenType
+{
+	JSON_TOKEN_ERROR,
+	JSON_TOKEN_END,
+	JSON_TOKEN_LEFT_CURLY_BRACKET,
+	JSON_TOKEN_RIGHT_CURLY_BRACKET,
+	JSON_TOKEN_LEFT_SQUARE_BRACKET,
+	JSON_TOKEN_RIGHT_SQUARE_BRACKET,
+	JSON_TOKEN_COLON,
+	JSON_TOKEN_COMMA,
+	JSON_TOKEN_STRING,
+	JSON_TOKEN_NUMBER,
+	JSON_TOKEN_TRUE,
+	JSON_TOKEN_FALSE,
+	JSON_TOKEN_NULL
+};
+
+/**
+ * Token as a view into the JSON text. Strings are without the quotation marks.
+ */
+struct JSONtoken
+{
+	JSONtokenType type;
+
+	const char* begin;
+	const char* end;
+
+	// String contains escape sequences, which have to be decoded.
+	bool escaped;
+
+	// Number has a fraction or an exponent.
+	bool isFloat;
+};
+
+/**
+ * Scans a JSON text without allocating memory. Tokens are validated against the JSON grammar.
+ * With a structural index, whitespace is skipped and the end of strings is known without scanning.
+ */
+class JSONtokenizer
+{
+
+private:
+
+	const char* begin;
+	const char* current;
+	const char* end;
+
+	// Next and last position of the structural index, if one is used.
+	const std::uint32_t* position;
+	const std::uint32_t* positionEnd;
+
+	bool scanString(JSONtoken& token);
+	bool scanIndexedString(JSONtoken& token);
+	bool scanNumber(JSONtoken& token);
+	bool scanLiteral(JSONtoken& token, const char* literal, std::size_t length, JSONtokenType type);
+
+public:
+
+	JSONtokenizer(const char* begin, const char* end);
+
+	/**
+	 * Index has to be built from the same text and stay valid while tokenizing.
+	 */
+	JSONtokenizer(const char* begin, const char* end, const JSONstructuralIndex& index);
+
+	/**
+	 * Continues at the given offset into the text, which has to be the start of a token found with the same index.
+	 */
+	JSONtokenizer(const char* begin, const char* end, const JSONstructuralIndex& index, std::size_t offset);
+	~JSONtokenizer();
+
+	/**
+	 * Returns false and a token of type JSON_TOKEN_ERROR, if the text is invalid.
+	 */
+	bool next(JSONtoken& token);
+
+	/**
+	 * Skips an object or array, after the token with its opening bracket has been returned. Only the brackets outside of
+	 * strings are matched, the content is not validated. Afterwards, the token spans the whole object or array.
+	 * Fails, if more than maxDepth objects and arrays are nested, counting the skipped one.
+	 */
+	bool skipContainer(JSONtoken& token, std::int32_t maxDepth);
+
+	std::size_t getOffset() const;
+
+	//
+
+	static void decodeString(std::string& value, const JSONtoken& token);
+
+	static float decodeFloat(const JSONtoken& token);
+
+	static std::int32_t decodeInteger(const JSONtoken& token);
+
+};
+
+#endif /* JSONTOKENIZER_H_ */
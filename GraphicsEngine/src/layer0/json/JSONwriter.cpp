@@ -0,0 +1,457 @@
+/*
+ * JSONwriter.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#define JSON_TAB_STEP 3
+
+#include "JSONtokens.h"
+
+#include "JSONwriter.h"
+#include "JSONfloat.h"
+
+using namespace std;
+
+JSONwriter::JSONwriter(JSONsink& sink, bool pretty) :
+	sink(sink), pretty(pretty), buffer(JSON_WRITER_BUFFER_SIZE), used(0), spaces(0), failed(false), allContainers(), first(false), afterKey(false), done(false)
+{
+}
+
+JSONwriter::~JSONwriter()
+{
+	flush();
+}
+
+bool JSONwriter::write(const char* data, size_t length)
+{
+	if (used + length > buffer.size())
+	{
+		if (!flush())
+		{
+			return false;
+		}
+
+		// Large pieces bypass the buffer.
+		if (length >= buffer.size())
+		{
+			if (!sink.write(data, length))
+			{
+				failed = true;
+
+				return false;
+			}
+
+			return true;
+		}
+	}
+
+	memcpy(buffer.data() + used, data, length);
+
+	used += length;
+
+	return true;
+}
+
+bool JSONwriter::write(const string& data)
+{
+	return write(data.data(), data.length());
+}
+
+bool JSONwriter::doLineFeed(int32_t tabs)
+{
+	if (!pretty)
+	{
+		return true;
+	}
+
+	if (spaces + JSON_TAB_STEP * tabs < 0)
+	{
+		return false;
+	}
+
+	spaces += JSON_TAB_STEP * tabs;
+
+	if (!write(JSON_Encode_line_feed))
+	{
+		return false;
+	}
+
+	for (int32_t i = 0; i < spaces; i++)
+	{
+		if (!write(JSON_space))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool JSONwriter::beginValue()
+{
+	if (failed || done)
+	{
+		failed = true;
+
+		return false;
+	}
+
+	if (allContainers.size() == 0)
+	{
+		return true;
+	}
+
+	if (allContainers.back())
+	{
+		// Values of an object need a key.
+		if (!afterKey)
+		{
+			failed = true;
+
+			return false;
+		}
+
+		afterKey = false;
+
+		return true;
+	}
+
+	if (first)
+	{
+		first = false;
+
+		return doLineFeed(1);
+	}
+
+	return write(JSON_comma) && doLineFeed(0);
+}
+
+bool JSONwriter::endContainer(bool isObject)
+{
+	if (failed || allContainers.size() == 0 || allContainers.back() != isObject || afterKey)
+	{
+		failed = true;
+
+		return false;
+	}
+
+	allContainers.pop_back();
+
+	if (!first)
+	{
+		if (!doLineFeed(-1))
+		{
+			return false;
+		}
+	}
+
+	first = false;
+
+	if (allContainers.size() == 0)
+	{
+		done = true;
+	}
+
+	return write(isObject ? JSON_right_curly_bracket : JSON_right_square_bracket);
+}
+
+bool JSONwriter::writeString(const string& value)
+{
+	const char* escape;
+
+	const char* run = value.data();
+	const char* end = value.data() + value.length();
+
+	if (!write(JSON_quotation_mark))
+	{
+		return false;
+	}
+
+	// Characters not needing an escape are written in runs.
+	for (const char* c = run; c != end; c++)
+	{
+		if ((*c >= JSON_C0_start && *c <= JSON_C0_end) || (*c >= JSON_C1_start && *c <= JSON_C1_end))
+		{
+			// Apart from the escaped ones below, control characters are not allowed.
+			if (*c == JSON_Encode_backspace[0])
+			{
+				escape = JSON_Decode_backspace.c_str();
+			}
+			else if (*c == JSON_Encode_form_feed[0])
+			{
+				escape = JSON_Decode_form_feed.c_str();
+			}
+			else if (*c == JSON_Encode_line_feed[0])
+			{
+				escape = JSON_Decode_line_feed.c_str();
+			}
+			else if (*c == JSON_Encode_carriage_return[0])
+			{
+				escape = JSON_Decode_carriage_return.c_str();
+			}
+			else if (*c == JSON_Encode_character_tabulation[0])
+			{
+				escape = JSON_Decode_character_tabulation.c_str();
+			}
+			else
+			{
+				failed = true;
+
+				return false;
+			}
+		}
+		else if (*c == JSON_quotation_mark[0])
+		{
+			escape = JSON_quotation_mark.c_str();
+		}
+		else if (*c == JSON_reverse_solidus[0])
+		{
+			escape = JSON_reverse_solidus.c_str();
+		}
+		else if (*c == JSON_solidus[0])
+		{
+			escape = JSON_solidus.c_str();
+		}
+		else
+		{
+			continue;
+		}
+
+		if (!write(run, c - run) || !write(JSON_reverse_solidus) || !write(escape, 1))
+		{
+			return false;
+		}
+
+		run = c + 1;
+	}
+
+	return write(run, end - run) && write(JSON_quotation_mark);
+}
+
+//
+
+bool JSONwriter::beginObject()
+{
+	if (!beginValue())
+	{
+		return false;
+	}
+
+	allContainers.push_back(true);
+
+	first = true;
+
+	return write(JSON_left_curly_bracket);
+}
+
+bool JSONwriter::key(const string& key)
+{
+	if (failed || allContainers.size() == 0 || !allContainers.back() || afterKey)
+	{
+		failed = true;
+
+		return false;
+	}
+
+	if (first)
+	{
+		first = false;
+
+		if (!doLineFeed(1))
+		{
+			return false;
+		}
+	}
+	else if (!write(JSON_comma) || !doLineFeed(0))
+	{
+		return false;
+	}
+
+	if (!writeString(key))
+	{
+		return false;
+	}
+
+	afterKey = true;
+
+	if (pretty)
+	{
+		return write(JSON_space) && write(JSON_colon) && write(JSON_space);
+	}
+
+	return write(JSON_colon);
+}
+
+bool JSONwriter::endObject()
+{
+	return endContainer(true);
+}
+
+bool JSONwriter::beginArray()
+{
+	if (!beginValue())
+	{
+		return false;
+	}
+
+	allContainers.push_back(false);
+
+	first = true;
+
+	return write(JSON_left_square_bracket);
+}
+
+bool JSONwriter::endArray()
+{
+	return endContainer(false);
+}
+
+bool JSONwriter::stringValue(const string& value)
+{
+	if (!beginValue())
+	{
+		return false;
+	}
+
+	if (allContainers.size() == 0)
+	{
+		done = true;
+	}
+
+	return writeString(value);
+}
+
+bool JSONwriter::floatValue(float value)
+{
+	char text[JSON_FLOAT_MAX_LENGTH];
+
+	if (!beginValue())
+	{
+		return false;
+	}
+
+	int32_t length = jsonPrintFloat(text, value);
+
+	// Infinity and not a number can not be written as JSON.
+	if (length < 0)
+	{
+		failed = true;
+
+		return false;
+	}
+
+	if (allContainers.size() == 0)
+	{
+		done = true;
+	}
+
+	return write(text, static_cast<size_t>(length));
+}
+
+bool JSONwriter::integerValue(int32_t value)
+{
+	char text[16];
+
+	if (!beginValue())
+	{
+		return false;
+	}
+
+	int32_t length = sprintf(text, "%d", value);
+
+	if (allContainers.size() == 0)
+	{
+		done = true;
+	}
+
+	return write(text, static_cast<size_t>(length));
+}
+
+bool JSONwriter::trueValue()
+{
+	if (!beginValue())
+	{
+		return false;
+	}
+
+	if (allContainers.size() == 0)
+	{
+		done = true;
+	}
+
+	return write(JSON_true);
+}
+
+bool JSONwriter::falseValue()
+{
+	if (!beginValue())
+	{
+		return false;
+	}
+
+	if (allContainers.size() == 0)
+	{
+		done = true;
+	}
+
+	return write(JSON_false);
+}
+
+bool JSONwriter::nullValue()
+{
+	if (!beginValue())
+	{
+		return false;
+	}
+
+	if (allContainers.size() == 0)
+	{
+		done = true;
+	}
+
+	return write(JSON_null);
+}
+
+//
+
+bool JSONwriter::flush()
+{
+	if (failed)
+	{
+		return false;
+	}
+
+	if (used > 0)
+	{
+		if (!sink.write(buffer.data(), used))
+		{
+			failed = true;
+
+			return false;
+		}
+
+		used = 0;
+	}
+
+	return true;
+}
+
+bool JSONwriter::finish()
+{
+	if (!done)
+	{
+		failed = true;
+	}
+
+	return flush();
+}
+
+bool JSONwriter::hasFailed() const
+{
+	return failed;
+}
@@ -0,0 +1,114 @@
+/*
+ * JSONwriter.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef JSONWRITER_H_
+#define JSONWRITER_H_
+
+#include "../../UsedLibs.h"
+
+#include "JSONhandler.h"
+#include "JSONsink.h"
+
+#define JSON_WRITER_BUFFER_SIZE 65536
+
+/**
+ * Streaming JSON writer. The text is collected in a buffer of fixed size, which is passed to the sink whenever it is full.
+ * Memory is bounded by the buffer and the nesting depth, so the document is never held as a whole.
+ * As the writer is a JSONhandler, a JSONreader can feed it directly. Any misplaced event or sink error makes all following
+ * calls fail.
+ */
+class JSONwriter : public JSONhandler
+{
+
+private:
+
+	JSONsink& sink;
+
+	bool pretty;
+
+	std::vector<char> buffer;
+
+	size_t used;
+
+	std::int32_t spaces;
+
+	bool failed;
+
+	// True for an object, false for an array.
+	std::vector<bool> allContainers;
+
+	// No value has been written yet into the current container.
+	bool first;
+
+	// A key has been written and the value is missing.
+	bool afterKey;
+
+	bool done;
+
+	bool write(const char* data, size_t length);
+
+	bool write(const std::string& data);
+
+	bool doLineFeed(std::int32_t tabs);
+
+	bool beginValue();
+
+	bool endContainer(bool isObject);
+
+	bool writeString(const std::string& value);
+
+public:
+
+	/**
+	 * Pretty printing breaks lines after each element and indents by three spaces, like the JSONencoder.
+	 */
+	JSONwriter(JSONsink& sink, bool pretty = false);
+	virtual ~JSONwriter();
+
+	virtual bool beginObject();
+
+	virtual bool key(const std::string& key);
+
+	virtual bool endObject();
+
+	virtual bool beginArray();
+
+	virtual bool endArray();
+
+	/**
+	 * Fails for control characters without a short escape sequence.
+	 */
+	virtual bool stringValue(const std::string& value);
+
+	/**
+	 * Fails for infinity and not a number.
+	 */
+	virtual bool floatValue(float value);
+
+	virtual bool integerValue(std::int32_t value);
+
+	virtual bool trueValue();
+
+	virtual bool falseValue();
+
+	virtual bool nullValue();
+
+	/**
+	 * Passes the buffered text to the sink.
+	 */
+	bool flush();
+
+	/**
+	 * Flushes and returns true, if exactly one complete value has been written and nothing failed.
+	 */
+	bool finish();
+
+	bool hasFailed() const;
+
+};
+
+#endif /* JSONWRITER_H_ */
@@ -0,0 +1,295 @@
+/*
+ * CompactQuaternion.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef COMPACTQUATERNION_H_
+#define COMPACTQUATERNION_H_
+
+#include "../../UsedLibs.h"
+
+#include "Matrix3x3.h"
+#include "Matrix4x4.h"
+#include "Point4.h"
+#include "SimdMath.h"
+#include "Vector3.h"
+
+/**
+ * Quaternion as x, y, z, w in 16 bytes. Matrices are not cached but calculated on demand.
+ */
+class CompactQuaternion
+{
+
+	friend class Quaternion;
+
+private:
+
+	GE_ALIGN16 float q[4];
+
+public:
+
+	CompactQuaternion()
+	{
+		q[0] = 0.0f;
+		q[1] = 0.0f;
+		q[2] = 0.0f;
+		q[3] = 1.0f;
+	}
+
+	CompactQuaternion(float x, float y, float z, float w)
+	{
+		q[0] = x;
+		q[1] = y;
+		q[2] = z;
+		q[3] = w;
+	}
+
+	CompactQuaternion(const float other[4])
+	{
+		q[0] = other[0];
+		q[1] = other[1];
+		q[2] = other[2];
+		q[3] = other[3];
+	}
+
+	CompactQuaternion(float angle, const Vector3& axis)
+	{
+		glusQuaternionRotatef(q, angle, axis.getX(), axis.getY(), axis.getZ());
+	}
+
+	explicit CompactQuaternion(const Matrix3x3& matrix)
+	{
+		float angles[3];
+
+		q[0] = 0.0f;
+		q[1] = 0.0f;
+		q[2] = 0.0f;
+		q[3] = 1.0f;
+
+		glusMatrix3x3GetEulerRzRyRxf(angles, matrix.getM());
+
+		glusQuaternionRotateRzRyRxf(q, angles[2], angles[1], angles[0]);
+	}
+
+	bool operator ==(const CompactQuaternion& other) const
+	{
+		return q[0] == other.q[0] && q[1] == other.q[1] && q[2] == other.q[2] && q[3] == other.q[3];
+	}
+
+	bool operator !=(const CompactQuaternion& other) const
+	{
+		return !(*this == other);
+	}
+
+	CompactQuaternion operator *(const CompactQuaternion& other) const
+	{
+		return CompactQuaternion(q[3] * other.q[0] + q[0] * other.q[3] + q[1] * other.q[2] - q[2] * other.q[1],
+								 q[3] * other.q[1] - q[0] * other.q[2] + q[1] * other.q[3] + q[2] * other.q[0],
+								 q[3] * other.q[2] + q[0] * other.q[1] - q[1] * other.q[0] + q[2] * other.q[3],
+								 q[3] * other.q[3] - q[0] * other.q[0] - q[1] * other.q[1] - q[2] * other.q[2]);
+	}
+
+	CompactQuaternion& operator*=(const CompactQuaternion& other)
+	{
+		*this = *this * other;
+
+		return *this;
+	}
+
+	/**
+	 * Rotates the vector by v + 2w(q x v) + 2q x (q x v). Quaternion has to be normalized.
+	 */
+	Vector3 operator *(const Vector3& vector) const
+	{
+		float result[3];
+
+		rotate(result, vector.getV());
+
+		return Vector3(result[0], result[1], result[2]);
+	}
+
+	Point4 operator *(const Point4& point) const
+	{
+		float result[3];
+
+		rotate(result, point.getP());
+
+		return Point4(result[0], result[1], result[2]);
+	}
+
+	CompactQuaternion conjugate() const
+	{
+		return CompactQuaternion(-q[0], -q[1], -q[2], q[3]);
+	}
+
+	float dot(const CompactQuaternion& other) const
+	{
+		return q[0] * other.q[0] + q[1] * other.q[1] + q[2] * other.q[2] + q[3] * other.q[3];
+	}
+
+	void normalize()
+	{
+		float length = sqrtf(dot(*this));
+
+		if (length == 0.0f)
+		{
+			return;
+		}
+
+		for (std::int32_t i = 0; i < 4; i++)
+		{
+			q[i] /= length;
+		}
+	}
+
+	void rotateRzRyRxf(const float anglez, const float angley, const float anglex)
+	{
+		glusQuaternionRotateRzRyRxf(q, anglez, angley, anglex);
+	}
+
+	void rotate(float result[3], const float vector[3]) const
+	{
+		float tx = 2.0f * (q[1] * vector[2] - q[2] * vector[1]);
+		float ty = 2.0f * (q[2] * vector[0] - q[0] * vector[2]);
+		float tz = 2.0f * (q[0] * vector[1] - q[1] * vector[0]);
+
+		float rx = vector[0] + q[3] * tx + (q[1] * tz - q[2] * ty);
+		float ry = vector[1] + q[3] * ty + (q[2] * tx - q[0] * tz);
+		float rz = vector[2] + q[3] * tz + (q[0] * ty - q[1] * tx);
+
+		result[0] = rx;
+		result[1] = ry;
+		result[2] = rz;
+	}
+
+	/**
+	 * Batch rotation. Converts once to a matrix, so it pays off from a few elements on. Result and source may be the same array.
+	 */
+	void rotate(Vector3* result, const Vector3* vectors, std::int32_t count) const
+	{
+		GE_ALIGN16 float matrix[16];
+
+		getRotationMatrix4x4(matrix);
+
+		simdMatrix4x4MultiplyVectors3f(reinterpret_cast<float*>(result), matrix, reinterpret_cast<const float*>(vectors), count);
+	}
+
+	void rotate(Point4* result, const Point4* points, std::int32_t count) const
+	{
+		GE_ALIGN16 float matrix[16];
+
+		getRotationMatrix4x4(matrix);
+
+		simdMatrix4x4MultiplyPoints4f(reinterpret_cast<float*>(result), matrix, reinterpret_cast<const float*>(points), count);
+	}
+
+	void getRotationMatrix4x4(float matrix[16]) const
+	{
+		float x2 = 2.0f * q[0];
+		float y2 = 2.0f * q[1];
+		float z2 = 2.0f * q[2];
+
+		float xx = q[0] * x2;
+		float yy = q[1] * y2;
+		float zz = q[2] * z2;
+		float xy = q[0] * y2;
+		float xz = q[0] * z2;
+		float yz = q[1] * z2;
+		float wx = q[3] * x2;
+		float wy = q[3] * y2;
+		float wz = q[3] * z2;
+
+		matrix[0] = 1.0f - yy - zz;
+		matrix[1] = xy + wz;
+		matrix[2] = xz - wy;
+		matrix[3] = 0.0f;
+
+		matrix[4] = xy - wz;
+		matrix[5] = 1.0f - xx - zz;
+		matrix[6] = yz + wx;
+		matrix[7] = 0.0f;
+
+		matrix[8] = xz + wy;
+		matrix[9] = yz - wx;
+		matrix[10] = 1.0f - xx - yy;
+		matrix[11] = 0.0f;
+
+		matrix[12] = 0.0f;
+		matrix[13] = 0.0f;
+		matrix[14] = 0.0f;
+		matrix[15] = 1.0f;
+	}
+
+	Matrix4x4 getRotationMatrix4x4() const
+	{
+		GE_ALIGN16 float matrix[16];
+
+		getRotationMatrix4x4(matrix);
+
+		return Matrix4x4(matrix);
+	}
+
+	Matrix3x3 getRotationMatrix3x3() const
+	{
+		GE_ALIGN16 float matrix[16];
+
+		getRotationMatrix4x4(matrix);
+
+		float result[9] = {matrix[0], matrix[1], matrix[2], matrix[4], matrix[5], matrix[6], matrix[8], matrix[9], matrix[10]};
+
+		return Matrix3x3(result);
+	}
+
+	/**
+	 * Normalized linear interpolation along the shorter arc.
+	 */
+	CompactQuaternion nlerp(const CompactQuaternion& other, float t) const
+	{
+		float b = dot(other) < 0.0f ? -t : t;
+		float a = 1.0f - t;
+
+		CompactQuaternion result(a * q[0] + b * other.q[0], a * q[1] + b * other.q[1], a * q[2] + b * other.q[2], a * q[3] + b * other.q[3]);
+
+		result.normalize();
+
+		return result;
+	}
+
+	/**
+	 * Spherical linear interpolation along the shorter arc. Falls back to nlerp, if both quaternions are almost equal.
+	 */
+	CompactQuaternion slerp(const CompactQuaternion& other, float t) const
+	{
+		float cosAlpha = dot(other);
+		float sign = 1.0f;
+
+		if (cosAlpha < 0.0f)
+		{
+			cosAlpha = -cosAlpha;
+			sign = -1.0f;
+		}
+
+		if (cosAlpha > 0.9995f)
+		{
+			return nlerp(other, t);
+		}
+
+		float alpha = acosf(cosAlpha);
+		float sinAlpha = sinf(alpha);
+
+		float a = sinf(alpha * (1.0f - t)) / sinAlpha;
+		float b = sign * sinf(alpha * t) / sinAlpha;
+
+		return CompactQuaternion(a * q[0] + b * other.q[0], a * q[1] + b * other.q[1], a * q[2] + b * other.q[2], a * q[3] + b * other.q[3]);
+	}
+
+	const float* getQ() const
+	{
+		return q;
+	}
+
+};
+
+#endif /* COMPACTQUATERNION_H_ */
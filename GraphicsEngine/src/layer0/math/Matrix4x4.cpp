@@ -9,6 +9,9 @@
 
 #include "Matrix4x4.h"
 
+// Relative tolerance, until columns are treated as orthogonal respectively of equal length.
+#define NORMAL_MATRIX_EPSILON 1.0e-4f
+
 Matrix4x4::Matrix4x4()
 {
 	glusMatrix4x4Identityf(m);
@@ -16,12 +19,12 @@ Matrix4x4::Matrix4x4()
 
 Matrix4x4::Matrix4x4(const Matrix4x4& other)
 {
-	glusMatrix4x4Copyf(m, other.m, false);
+	simdMatrix4x4Copyf(m, other.m);
 }
 
 Matrix4x4::Matrix4x4(const float other[16])
 {
-	glusMatrix4x4Copyf(m, other, false);
+	simdMatrix4x4Copyf(m, other);
 }
 
 Matrix4x4::~Matrix4x4()
@@ -40,7 +43,7 @@ Matrix4x4 Matrix4x4::copy(bool rotationOnly) const
 
 Matrix4x4& Matrix4x4::operator=(const Matrix4x4& other)
 {
-	glusMatrix4x4Copyf(m, other.m, GLUS_FALSE);
+	simdMatrix4x4Copyf(m, other.m);
 
 	return *this;
 }
@@ -54,11 +57,93 @@ Matrix3x3 Matrix4x4::extractMatrix3x3() const
 	return result;
 }
 
+NormalMatrixType Matrix4x4::getNormalMatrixType() const
+{
+	float length0 = m[0] * m[0] + m[1] * m[1] + m[2] * m[2];
+	float length1 = m[4] * m[4] + m[5] * m[5] + m[6] * m[6];
+	float length2 = m[8] * m[8] + m[9] * m[9] + m[10] * m[10];
+
+	if (length0 == 0.0f || length1 == 0.0f || length2 == 0.0f)
+	{
+		return NORMAL_MATRIX_SHEAR;
+	}
+
+	float dot01 = m[0] * m[4] + m[1] * m[5] + m[2] * m[6];
+	float dot02 = m[0] * m[8] + m[1] * m[9] + m[2] * m[10];
+	float dot12 = m[4] * m[8] + m[5] * m[9] + m[6] * m[10];
+
+	float epsilonSquared = NORMAL_MATRIX_EPSILON * NORMAL_MATRIX_EPSILON;
+
+	if (dot01 * dot01 > epsilonSquared * length0 * length1 || dot02 * dot02 > epsilonSquared * length0 * length2 || dot12 * dot12 > epsilonSquared * length1 * length2)
+	{
+		return NORMAL_MATRIX_SHEAR;
+	}
+
+	if (fabsf(length0 - length1) > NORMAL_MATRIX_EPSILON * length0 || fabsf(length0 - length2) > NORMAL_MATRIX_EPSILON * length0)
+	{
+		return NORMAL_MATRIX_NON_UNIFORM_SCALE;
+	}
+
+	if (fabsf(length0 - 1.0f) > NORMAL_MATRIX_EPSILON)
+	{
+		return NORMAL_MATRIX_UNIFORM_SCALE;
+	}
+
+	return NORMAL_MATRIX_RIGID;
+}
+
+Matrix3x3 Matrix4x4::extractNormalMatrix3x3(NormalMatrixType normalMatrixType) const
+{
+	Matrix3x3 result;
+
+	if (normalMatrixType == NORMAL_MATRIX_SHEAR)
+	{
+		glusMatrix4x4ExtractMatrix3x3f(result.m, m);
+		glusMatrix3x3Inversef(result.m);
+
+		return result;
+	}
+
+	float inverseLength[3] = {1.0f, 1.0f, 1.0f};
+
+	if (normalMatrixType == NORMAL_MATRIX_UNIFORM_SCALE)
+	{
+		float inverse = 1.0f / (m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+
+		inverseLength[0] = inverse;
+		inverseLength[1] = inverse;
+		inverseLength[2] = inverse;
+	}
+	else if (normalMatrixType == NORMAL_MATRIX_NON_UNIFORM_SCALE)
+	{
+		for (int32_t column = 0; column < 3; column++)
+		{
+			inverseLength[column] = 1.0f / (m[column * 4 + 0] * m[column * 4 + 0] + m[column * 4 + 1] * m[column * 4 + 1] + m[column * 4 + 2] * m[column * 4 + 2]);
+		}
+	}
+
+	// Transposed and each row divided by the squared scale.
+	for (int32_t column = 0; column < 3; column++)
+	{
+		for (int32_t row = 0; row < 3; row++)
+		{
+			result.m[column * 3 + row] = m[row * 4 + column] * inverseLength[row];
+		}
+	}
+
+	return result;
+}
+
+Matrix3x3 Matrix4x4::extractNormalMatrix3x3() const
+{
+	return extractNormalMatrix3x3(getNormalMatrixType());
+}
+
 Vector3 Matrix4x4::operator*(const Vector3& v) const
 {
 	Vector3 result;
 
-	glusMatrix4x4MultiplyVector3f(result.v, m, v.v);
+	simdMatrix4x4MultiplyVector3f(result.v, m, v.v);
 
 	return result;
 }
@@ -67,7 +152,7 @@ Point4 Matrix4x4::operator*(const Point4& p) const
 {
 	Point4 result;
 
-	glusMatrix4x4MultiplyPoint4f(result.p, m, p.p);
+	simdMatrix4x4MultiplyPoint4f(result.p, m, p.p);
 
 	return result;
 }
@@ -81,11 +166,45 @@ Plane Matrix4x4::operator*(const Plane& plane) const
 	return result;
 }
 
+void Matrix4x4::transform(Point4* result, const Point4* points, int32_t count) const
+{
+	static_assert(sizeof(Point4) == 4 * sizeof(float), "Point4 has to be four packed floats");
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	simdMatrix4x4MultiplyPoints4f(result[0].p, m, points[0].p, count);
+}
+
+void Matrix4x4::transform(Vector3* result, const Vector3* vectors, int32_t count) const
+{
+	static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 has to be three packed floats");
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	simdMatrix4x4MultiplyVectors3f(result[0].v, m, vectors[0].v, count);
+}
+
 void Matrix4x4::identity()
 {
 	glusMatrix4x4Identityf(m);
 }
 
+bool Matrix4x4::inverse()
+{
+	return simdMatrix4x4Inversef(m);
+}
+
+bool Matrix4x4::inverseAffine()
+{
+	return simdMatrix4x4InverseAffinef(m);
+}
+
 void Matrix4x4::inverseRigidBody()
 {
 	glusMatrix4x4InverseRigidBodyf(m);
@@ -93,7 +212,7 @@ void Matrix4x4::inverseRigidBody()
 
 void Matrix4x4::transpose()
 {
-	glusMatrix4x4Transposef(m);
+	simdMatrix4x4Transposef(m);
 }
 
 void Matrix4x4::translate(float x, float y, float z)
@@ -118,12 +237,12 @@ void Matrix4x4::scale(float sx, float sy, float sz)
 
 void Matrix4x4::multiply(const Matrix4x4& other)
 {
-	glusMatrix4x4Multiplyf(m, m, other.m);
+	simdMatrix4x4Multiplyf(m, m, other.m);
 }
 
 void Matrix4x4::setM(const float other[16])
 {
-	glusMatrix4x4Copyf(m, other, false);
+	simdMatrix4x4Copyf(m, other);
 }
 
 const float* Matrix4x4::getM() const
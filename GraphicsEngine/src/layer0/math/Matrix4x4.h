@@ -12,10 +12,22 @@
 
 #include "Plane.h"
 #include "Point4.h"
+#include "SimdMath.h"
 #include "Vector3.h"
 
 class Matrix3x3;
 
+/**
+ * Upper 3x3 part of a matrix, which decides how the normal matrix is calculated.
+ */
+enum NormalMatrixType
+{
+	NORMAL_MATRIX_RIGID = 0,
+	NORMAL_MATRIX_UNIFORM_SCALE = 1,
+	NORMAL_MATRIX_NON_UNIFORM_SCALE = 2,
+	NORMAL_MATRIX_SHEAR = 3
+};
+
 class Matrix4x4
 {
 
@@ -24,7 +36,7 @@ class Matrix4x4
 
 protected:
 
-	float m[16];
+	GE_ALIGN16 float m[16];
 
 public:
 
@@ -39,7 +51,7 @@ public:
 
 	Matrix4x4& operator*=(const Matrix4x4& other)
 	{
-		glusMatrix4x4Multiplyf(m, m, other.m);
+		simdMatrix4x4Multiplyf(m, m, other.m);
 
 		return *this;
 	}
@@ -48,21 +60,42 @@ public:
 	{
 		Matrix4x4 result;
 
-		glusMatrix4x4Multiplyf(result.m, m, other.m);
+		simdMatrix4x4Multiplyf(result.m, m, other.m);
 
 		return result;
 	}
 
 	Matrix3x3 extractMatrix3x3() const;
 
+	NormalMatrixType getNormalMatrixType() const;
+
+	/**
+	 * Inverse of the upper 3x3 matrix. Only sheared or singular matrices need the general inverse,
+	 * otherwise the rows of the inverse are the columns divided by their squared length.
+	 */
+	Matrix3x3 extractNormalMatrix3x3(NormalMatrixType normalMatrixType) const;
+
+	Matrix3x3 extractNormalMatrix3x3() const;
+
 	Vector3 operator*(const Vector3& v) const;
 
 	Point4 operator*(const Point4& p) const;
 
 	Plane operator*(const Plane& plane) const;
 
+	/**
+	 * Transforms count points at once. The points are not divided by w.
+	 */
+	void transform(Point4* result, const Point4* points, std::int32_t count) const;
+
+	void transform(Vector3* result, const Vector3* vectors, std::int32_t count) const;
+
 	void identity();
 
+	bool inverse();
+
+	bool inverseAffine();
+
 	void inverseRigidBody();
 
 	void transpose();
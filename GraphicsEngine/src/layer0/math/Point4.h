@@ -10,6 +10,8 @@
 
 #include "../../UsedLibs.h"
 
+#include "Simd.h"
+
 class Line;
 class Plane;
 class Sphere;
@@ -23,7 +25,7 @@ class Point4
 
 private:
 
-	float p[4];
+	GE_ALIGN16 float p[4];
 
 public:
 
@@ -10,54 +10,38 @@
 #include "Quaternion.h"
 
 Quaternion::Quaternion() :
-	dirtyFlag(true)
+	quaternion(), dirtyFlag(true)
 {
-	glusQuaternionIdentityf(q);
 }
 
 Quaternion::Quaternion(float x, float y, float z, float w) :
-	dirtyFlag(true)
+	quaternion(x, y, z, w), dirtyFlag(true)
 {
-	q[0] = x;
-	q[1] = y;
-	q[2] = z;
-	q[3] = w;
 }
 
 Quaternion::Quaternion(const float other[4]) :
-	dirtyFlag(true)
+	quaternion(other), dirtyFlag(true)
 {
-	q[0] = other[0];
-	q[1] = other[1];
-	q[2] = other[2];
-	q[3] = other[3];
 }
 
 Quaternion::Quaternion(const Quaternion& other) :
-	dirtyFlag(true)
+	quaternion(other.quaternion), dirtyFlag(true)
 {
-	q[0] = other.q[0];
-	q[1] = other.q[1];
-	q[2] = other.q[2];
-	q[3] = other.q[3];
 }
 
 Quaternion::Quaternion(float angle, const Vector3& axis) :
-	dirtyFlag(true)
+	quaternion(angle, axis), dirtyFlag(true)
 {
-	glusQuaternionRotatef(q, angle, axis.getX(), axis.getY(), axis.getZ());
 }
 
 Quaternion::Quaternion(const Matrix3x3& matrix) :
-	dirtyFlag(true)
+	quaternion(matrix), dirtyFlag(true)
 {
-	float angles[3];
-
-	glusQuaternionIdentityf(q);
-
-	glusMatrix3x3GetEulerRzRyRxf(angles, matrix.m);
+}
 
-	glusQuaternionRotateRzRyRxf(q, angles[2], angles[1], angles[0]);
+Quaternion::Quaternion(const CompactQuaternion& other) :
+	quaternion(other), dirtyFlag(true)
+{
 }
 
 Quaternion::~Quaternion()
@@ -66,15 +50,7 @@ Quaternion::~Quaternion()
 
 bool Quaternion::operator ==(const Quaternion& other) const
 {
-	for (int32_t i = 0; i < 4; i++)
-	{
-		if (q[i] != other.q[i])
-		{
-			return false;
-		}
-	}
-
-	return true;
+	return quaternion == other.quaternion;
 }
 
 bool Quaternion::operator !=(const Quaternion& other) const
@@ -84,17 +60,16 @@ bool Quaternion::operator !=(const Quaternion& other) const
 
 Quaternion& Quaternion::operator*=(const Quaternion& other)
 {
-	glusQuaternionMultiplyQuaternionf(q, q, other.q);
+	quaternion *= other.quaternion;
+
+	dirtyFlag = true;
 
 	return *this;
 }
 
 Quaternion& Quaternion::operator =(const Quaternion& other)
 {
-	q[0] = other.q[0];
-	q[1] = other.q[1];
-	q[2] = other.q[2];
-	q[3] = other.q[3];
+	quaternion = other.quaternion;
 
 	// Do not copy the matrix. Will be updated when getting it.
 
@@ -105,47 +80,41 @@ Quaternion& Quaternion::operator =(const Quaternion& other)
 
 Quaternion Quaternion::operator *(const Quaternion& other) const
 {
-	Quaternion result;
-
-	glusQuaternionMultiplyQuaternionf(result.q, q, other.q);
-
-	return result;
+	return Quaternion(quaternion * other.quaternion);
 }
 
 Vector3 Quaternion::operator *(const Vector3& vector) const
 {
 	Quaternion result = (*this) * Quaternion(vector.getX(), vector.getY(), vector.getZ(), 0.0f) * conjugate();
 
-	return Vector3(result.q[0], result.q[1], result.q[2]);
+	return Vector3(result.quaternion.q[0], result.quaternion.q[1], result.quaternion.q[2]);
 }
 
 Point4 Quaternion::operator *(const Point4& point) const
 {
 	Quaternion result = (*this) * Quaternion(point.getX(), point.getY(), point.getZ(), 0.0f) * conjugate();
 
-	return Point4(result.q[0], result.q[1], result.q[2]);
+	return Point4(result.quaternion.q[0], result.quaternion.q[1], result.quaternion.q[2]);
 }
 
 Quaternion Quaternion::conjugate() const
 {
-	Quaternion result(*this);
-
-	glusQuaternionConjugatef(result.q);
-
-	return result;
+	return Quaternion(quaternion.conjugate());
 }
 
 void Quaternion::rotateRzRyRxf(const float anglez, const float angley, const float anglex)
 {
-	glusQuaternionRotateRzRyRxf(q, anglez, angley, anglex);
+	quaternion.rotateRzRyRxf(anglez, angley, anglex);
+
+	dirtyFlag = true;
 }
 
 const Matrix4x4& Quaternion::getRotationMatrix4x4() const
 {
 	if (dirtyFlag)
 	{
-		glusQuaternionGetMatrix4x4f(rotationMatrix4x4.m, q);
-		glusQuaternionGetMatrix3x3f(rotationMatrix3x3.m, q);
+		quaternion.getRotationMatrix4x4(rotationMatrix4x4.m);
+		glusQuaternionGetMatrix3x3f(rotationMatrix3x3.m, quaternion.q);
 
 		dirtyFlag = false;
 	}
@@ -157,8 +126,8 @@ const Matrix3x3& Quaternion::getRotationMatrix3x3() const
 {
 	if (dirtyFlag)
 	{
-		glusQuaternionGetMatrix4x4f(rotationMatrix4x4.m, q);
-		glusQuaternionGetMatrix3x3f(rotationMatrix3x3.m, q);
+		quaternion.getRotationMatrix4x4(rotationMatrix4x4.m);
+		glusQuaternionGetMatrix3x3f(rotationMatrix3x3.m, quaternion.q);
 
 		dirtyFlag = false;
 	}
@@ -170,7 +139,12 @@ Quaternion Quaternion::slerp(const Quaternion& other, float t) const
 {
 	Quaternion result;
 
-	glusQuaternionSlerpf(result.q, q, other.q, t);
+	glusQuaternionSlerpf(result.quaternion.q, quaternion.q, other.quaternion.q, t);
 
 	return result;
 }
+
+const CompactQuaternion& Quaternion::getCompactQuaternion() const
+{
+	return quaternion;
+}
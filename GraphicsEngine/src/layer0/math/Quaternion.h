@@ -8,15 +8,19 @@
 #ifndef QUATERNION_H_
 #define QUATERNION_H_
 
+#include "CompactQuaternion.h"
 #include "Matrix3x3.h"
 #include "Matrix4x4.h"
 #include "Vector3.h"
 
+/**
+ * Adapter around CompactQuaternion, which caches the rotation matrices. Use CompactQuaternion for members in large arrays.
+ */
 class Quaternion {
 
 private:
 
-	float q[4];
+	CompactQuaternion quaternion;
 
 	mutable Matrix4x4 rotationMatrix4x4;
 	mutable Matrix3x3 rotationMatrix3x3;
@@ -31,6 +35,7 @@ public:
 	Quaternion(const Quaternion& other);
 	Quaternion(float angle, const Vector3& axis);
 	Quaternion(const Matrix3x3& matrix);
+	Quaternion(const CompactQuaternion& other);
 	~Quaternion();
 
 	bool operator ==(const Quaternion& other) const;
@@ -56,6 +61,8 @@ public:
 
 	Quaternion slerp(const Quaternion& other, float t) const;
 
+	const CompactQuaternion& getCompactQuaternion() const;
+
 };
 
 #endif /* QUATERNION_H_ */
@@ -0,0 +1,130 @@
+/*
+ * Simd.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef SIMD_H_
+#define SIMD_H_
+
+// Define GE_MATH_NO_SIMD to force the scalar fallback.
+
+#if !defined(GE_MATH_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define GE_MATH_SSE
+#include <xmmintrin.h>
+#elif !defined(GE_MATH_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define GE_MATH_NEON
+#include <arm_neon.h>
+#else
+#define GE_MATH_SCALAR
+#endif
+
+#if defined(_MSC_VER)
+#define GE_ALIGN16 __declspec(align(16))
+#else
+#define GE_ALIGN16 __attribute__((aligned(16)))
+#endif
+
+/**
+ * Four float lanes, mapped to SSE, NEON or plain floats.
+ */
+#if defined(GE_MATH_SSE)
+typedef __m128 simd4f;
+#elif defined(GE_MATH_NEON)
+typedef float32x4_t simd4f;
+#else
+struct simd4f
+{
+	float v[4];
+};
+#endif
+
+inline simd4f simd4fLoad(const float* p)
+{
+#if defined(GE_MATH_SSE)
+	return _mm_loadu_ps(p);
+#elif defined(GE_MATH_NEON)
+	return vld1q_f32(p);
+#else
+	simd4f result = {{p[0], p[1], p[2], p[3]}};
+
+	return result;
+#endif
+}
+
+inline void simd4fStore(float* p, const simd4f& a)
+{
+#if defined(GE_MATH_SSE)
+	_mm_storeu_ps(p, a);
+#elif defined(GE_MATH_NEON)
+	vst1q_f32(p, a);
+#else
+	p[0] = a.v[0];
+	p[1] = a.v[1];
+	p[2] = a.v[2];
+	p[3] = a.v[3];
+#endif
+}
+
+inline simd4f simd4fSplat(float s)
+{
+#if defined(GE_MATH_SSE)
+	return _mm_set1_ps(s);
+#elif defined(GE_MATH_NEON)
+	return vdupq_n_f32(s);
+#else
+	simd4f result = {{s, s, s, s}};
+
+	return result;
+#endif
+}
+
+inline simd4f simd4fAdd(const simd4f& a, const simd4f& b)
+{
+#if defined(GE_MATH_SSE)
+	return _mm_add_ps(a, b);
+#elif defined(GE_MATH_NEON)
+	return vaddq_f32(a, b);
+#else
+	simd4f result = {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+
+	return result;
+#endif
+}
+
+inline simd4f simd4fSub(const simd4f& a, const simd4f& b)
+{
+#if defined(GE_MATH_SSE)
+	return _mm_sub_ps(a, b);
+#elif defined(GE_MATH_NEON)
+	return vsubq_f32(a, b);
+#else
+	simd4f result = {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+
+	return result;
+#endif
+}
+
+inline simd4f simd4fMul(const simd4f& a, const simd4f& b)
+{
+#if defined(GE_MATH_SSE)
+	return _mm_mul_ps(a, b);
+#elif defined(GE_MATH_NEON)
+	return vmulq_f32(a, b);
+#else
+	simd4f result = {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+
+	return result;
+#endif
+}
+
+/**
+ * Returns a + b * c. Not fused, so the results are equal to the scalar code.
+ */
+inline simd4f simd4fMulAdd(const simd4f& a, const simd4f& b, const simd4f& c)
+{
+	return simd4fAdd(a, simd4fMul(b, c));
+}
+
+#endif /* SIMD_H_ */
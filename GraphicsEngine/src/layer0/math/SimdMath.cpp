@@ -0,0 +1,354 @@
+/*
+ * SimdMath.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "SimdMath.h"
+
+using namespace std;
+
+#if defined(GE_MATH_SSE)
+
+#define GE_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define GE_SWIZZLE(a, x, y, z, w) GE_SHUFFLE(a, a, x, y, z, w)
+
+// A 2x2 matrix is stored as (m00, m01, m10, m11).
+
+static inline __m128 matrix2x2Multiply(__m128 a, __m128 b)
+{
+	return _mm_add_ps(_mm_mul_ps(a, GE_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(GE_SWIZZLE(a, 1, 0, 3, 2), GE_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// Adjugate of a multiplied by b
+static inline __m128 matrix2x2AdjugateMultiply(__m128 a, __m128 b)
+{
+	return _mm_sub_ps(_mm_mul_ps(GE_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(GE_SWIZZLE(a, 1, 1, 2, 2), GE_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+// a multiplied by adjugate of b
+static inline __m128 matrix2x2MultiplyAdjugate(__m128 a, __m128 b)
+{
+	return _mm_sub_ps(_mm_mul_ps(a, GE_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(GE_SWIZZLE(a, 1, 0, 3, 2), GE_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+#endif
+
+void simdMatrix4x4Transposef(float matrix[16])
+{
+#if defined(GE_MATH_SSE)
+	__m128 column0 = _mm_loadu_ps(&matrix[0]);
+	__m128 column1 = _mm_loadu_ps(&matrix[4]);
+	__m128 column2 = _mm_loadu_ps(&matrix[8]);
+	__m128 column3 = _mm_loadu_ps(&matrix[12]);
+
+	_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+	_mm_storeu_ps(&matrix[0], column0);
+	_mm_storeu_ps(&matrix[4], column1);
+	_mm_storeu_ps(&matrix[8], column2);
+	_mm_storeu_ps(&matrix[12], column3);
+#else
+	for (int32_t column = 0; column < 4; column++)
+	{
+		for (int32_t row = column + 1; row < 4; row++)
+		{
+			swap(matrix[column * 4 + row], matrix[row * 4 + column]);
+		}
+	}
+#endif
+}
+
+/**
+ * Block wise inverse out of 2x2 sub matrices. As inverse(transpose(M)) = transpose(inverse(M)), the
+ * formulas do not care, if the matrix is stored row or column major.
+ */
+bool simdMatrix4x4Inversef(float matrix[16])
+{
+#if defined(GE_MATH_SSE)
+	__m128 column0 = _mm_loadu_ps(&matrix[0]);
+	__m128 column1 = _mm_loadu_ps(&matrix[4]);
+	__m128 column2 = _mm_loadu_ps(&matrix[8]);
+	__m128 column3 = _mm_loadu_ps(&matrix[12]);
+
+	__m128 a = _mm_movelh_ps(column0, column1);
+	__m128 b = _mm_movehl_ps(column1, column0);
+	__m128 c = _mm_movelh_ps(column2, column3);
+	__m128 d = _mm_movehl_ps(column3, column2);
+
+	// Determinants of a, b, c and d
+	__m128 determinants = _mm_sub_ps(_mm_mul_ps(GE_SHUFFLE(column0, column2, 0, 2, 0, 2), GE_SHUFFLE(column1, column3, 1, 3, 1, 3)), _mm_mul_ps(GE_SHUFFLE(column0, column2, 1, 3, 1, 3), GE_SHUFFLE(column1, column3, 0, 2, 0, 2)));
+
+	__m128 determinantA = GE_SWIZZLE(determinants, 0, 0, 0, 0);
+	__m128 determinantB = GE_SWIZZLE(determinants, 1, 1, 1, 1);
+	__m128 determinantC = GE_SWIZZLE(determinants, 2, 2, 2, 2);
+	__m128 determinantD = GE_SWIZZLE(determinants, 3, 3, 3, 3);
+
+	__m128 adjugateDC = matrix2x2AdjugateMultiply(d, c);
+	__m128 adjugateAB = matrix2x2AdjugateMultiply(a, b);
+
+	__m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), matrix2x2Multiply(b, adjugateDC));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), matrix2x2Multiply(c, adjugateAB));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), matrix2x2MultiplyAdjugate(d, adjugateAB));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), matrix2x2MultiplyAdjugate(a, adjugateDC));
+
+	__m128 trace = _mm_mul_ps(adjugateAB, GE_SWIZZLE(adjugateDC, 0, 2, 1, 3));
+	trace = _mm_add_ps(trace, GE_SWIZZLE(trace, 2, 3, 0, 1));
+	trace = _mm_add_ps(trace, GE_SWIZZLE(trace, 1, 0, 3, 2));
+
+	__m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)), trace);
+
+	if (_mm_cvtss_f32(determinant) == 0.0f)
+	{
+		return false;
+	}
+
+	__m128 inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+	x = _mm_mul_ps(x, inverseDeterminant);
+	y = _mm_mul_ps(y, inverseDeterminant);
+	z = _mm_mul_ps(z, inverseDeterminant);
+	w = _mm_mul_ps(w, inverseDeterminant);
+
+	_mm_storeu_ps(&matrix[0], GE_SHUFFLE(x, y, 3, 1, 3, 1));
+	_mm_storeu_ps(&matrix[4], GE_SHUFFLE(x, y, 2, 0, 2, 0));
+	_mm_storeu_ps(&matrix[8], GE_SHUFFLE(z, w, 3, 1, 3, 1));
+	_mm_storeu_ps(&matrix[12], GE_SHUFFLE(z, w, 2, 0, 2, 0));
+
+	return true;
+#else
+	float a00 = matrix[0], a01 = matrix[1], a02 = matrix[2], a03 = matrix[3];
+	float a10 = matrix[4], a11 = matrix[5], a12 = matrix[6], a13 = matrix[7];
+	float a20 = matrix[8], a21 = matrix[9], a22 = matrix[10], a23 = matrix[11];
+	float a30 = matrix[12], a31 = matrix[13], a32 = matrix[14], a33 = matrix[15];
+
+	float b00 = a00 * a11 - a01 * a10;
+	float b01 = a00 * a12 - a02 * a10;
+	float b02 = a00 * a13 - a03 * a10;
+	float b03 = a01 * a12 - a02 * a11;
+	float b04 = a01 * a13 - a03 * a11;
+	float b05 = a02 * a13 - a03 * a12;
+	float b06 = a20 * a31 - a21 * a30;
+	float b07 = a20 * a32 - a22 * a30;
+	float b08 = a20 * a33 - a23 * a30;
+	float b09 = a21 * a32 - a22 * a31;
+	float b10 = a21 * a33 - a23 * a31;
+	float b11 = a22 * a33 - a23 * a32;
+
+	float determinant = b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
+
+	if (determinant == 0.0f)
+	{
+		return false;
+	}
+
+	float inverseDeterminant = 1.0f / determinant;
+
+	matrix[0] = (a11 * b11 - a12 * b10 + a13 * b09) * inverseDeterminant;
+	matrix[1] = (a02 * b10 - a01 * b11 - a03 * b09) * inverseDeterminant;
+	matrix[2] = (a31 * b05 - a32 * b04 + a33 * b03) * inverseDeterminant;
+	matrix[3] = (a22 * b04 - a21 * b05 - a23 * b03) * inverseDeterminant;
+	matrix[4] = (a12 * b08 - a10 * b11 - a13 * b07) * inverseDeterminant;
+	matrix[5] = (a00 * b11 - a02 * b08 + a03 * b07) * inverseDeterminant;
+	matrix[6] = (a32 * b02 - a30 * b05 - a33 * b01) * inverseDeterminant;
+	matrix[7] = (a20 * b05 - a22 * b02 + a23 * b01) * inverseDeterminant;
+	matrix[8] = (a10 * b10 - a11 * b08 + a13 * b06) * inverseDeterminant;
+	matrix[9] = (a01 * b08 - a00 * b10 - a03 * b06) * inverseDeterminant;
+	matrix[10] = (a30 * b04 - a31 * b02 + a33 * b00) * inverseDeterminant;
+	matrix[11] = (a21 * b02 - a20 * b04 - a23 * b00) * inverseDeterminant;
+	matrix[12] = (a11 * b07 - a10 * b09 - a12 * b06) * inverseDeterminant;
+	matrix[13] = (a00 * b09 - a01 * b07 + a02 * b06) * inverseDeterminant;
+	matrix[14] = (a31 * b01 - a30 * b03 - a32 * b00) * inverseDeterminant;
+	matrix[15] = (a20 * b03 - a21 * b01 + a22 * b00) * inverseDeterminant;
+
+	return true;
+#endif
+}
+
+/**
+ * Rows of the inverse 3x3 part are the cross products of its columns, divided by the determinant.
+ */
+bool simdMatrix4x4InverseAffinef(float matrix[16])
+{
+	float row0[3] = {matrix[5] * matrix[10] - matrix[6] * matrix[9], matrix[6] * matrix[8] - matrix[4] * matrix[10], matrix[4] * matrix[9] - matrix[5] * matrix[8]};
+	float row1[3] = {matrix[9] * matrix[2] - matrix[10] * matrix[1], matrix[10] * matrix[0] - matrix[8] * matrix[2], matrix[8] * matrix[1] - matrix[9] * matrix[0]};
+	float row2[3] = {matrix[1] * matrix[6] - matrix[2] * matrix[5], matrix[2] * matrix[4] - matrix[0] * matrix[6], matrix[0] * matrix[5] - matrix[1] * matrix[4]};
+
+	float determinant = matrix[0] * row0[0] + matrix[1] * row0[1] + matrix[2] * row0[2];
+
+	if (determinant == 0.0f)
+	{
+		return false;
+	}
+
+	float inverseDeterminant = 1.0f / determinant;
+
+	float x = matrix[12];
+	float y = matrix[13];
+	float z = matrix[14];
+
+	matrix[0] = row0[0] * inverseDeterminant;
+	matrix[1] = row1[0] * inverseDeterminant;
+	matrix[2] = row2[0] * inverseDeterminant;
+
+	matrix[4] = row0[1] * inverseDeterminant;
+	matrix[5] = row1[1] * inverseDeterminant;
+	matrix[6] = row2[1] * inverseDeterminant;
+
+	matrix[8] = row0[2] * inverseDeterminant;
+	matrix[9] = row1[2] * inverseDeterminant;
+	matrix[10] = row2[2] * inverseDeterminant;
+
+	matrix[12] = -(matrix[0] * x + matrix[4] * y + matrix[8] * z);
+	matrix[13] = -(matrix[1] * x + matrix[5] * y + matrix[9] * z);
+	matrix[14] = -(matrix[2] * x + matrix[6] * y + matrix[10] * z);
+
+	matrix[3] = 0.0f;
+	matrix[7] = 0.0f;
+	matrix[11] = 0.0f;
+	matrix[15] = 1.0f;
+
+	return true;
+}
+
+void simdMatrix4x4MultiplyPoints4f(float* result, const float matrix[16], const float* points, int32_t count)
+{
+	simd4f column0 = simd4fLoad(&matrix[0]);
+	simd4f column1 = simd4fLoad(&matrix[4]);
+	simd4f column2 = simd4fLoad(&matrix[8]);
+	simd4f column3 = simd4fLoad(&matrix[12]);
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		const float* point = &points[i * 4];
+
+		simd4f temp = simd4fMul(column0, simd4fSplat(point[0]));
+		temp = simd4fMulAdd(temp, column1, simd4fSplat(point[1]));
+		temp = simd4fMulAdd(temp, column2, simd4fSplat(point[2]));
+		temp = simd4fMulAdd(temp, column3, simd4fSplat(point[3]));
+
+		simd4fStore(&result[i * 4], temp);
+	}
+}
+
+/**
+ * Four points are transformed at once, each lane holding one point.
+ */
+static void multiplySoA(float* resultX, float* resultY, float* resultZ, const float matrix[16], const float* x, const float* y, const float* z, int32_t count, float w)
+{
+	simd4f m0 = simd4fSplat(matrix[0]);
+	simd4f m1 = simd4fSplat(matrix[1]);
+	simd4f m2 = simd4fSplat(matrix[2]);
+	simd4f m4 = simd4fSplat(matrix[4]);
+	simd4f m5 = simd4fSplat(matrix[5]);
+	simd4f m6 = simd4fSplat(matrix[6]);
+	simd4f m8 = simd4fSplat(matrix[8]);
+	simd4f m9 = simd4fSplat(matrix[9]);
+	simd4f m10 = simd4fSplat(matrix[10]);
+
+	float translateX = matrix[12] * w;
+	float translateY = matrix[13] * w;
+	float translateZ = matrix[14] * w;
+
+	simd4f m12 = simd4fSplat(translateX);
+	simd4f m13 = simd4fSplat(translateY);
+	simd4f m14 = simd4fSplat(translateZ);
+
+	int32_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		simd4f currentX = simd4fLoad(&x[i]);
+		simd4f currentY = simd4fLoad(&y[i]);
+		simd4f currentZ = simd4fLoad(&z[i]);
+
+		simd4f tempX = simd4fAdd(simd4fMulAdd(simd4fMulAdd(simd4fMul(m0, currentX), m4, currentY), m8, currentZ), m12);
+		simd4f tempY = simd4fAdd(simd4fMulAdd(simd4fMulAdd(simd4fMul(m1, currentX), m5, currentY), m9, currentZ), m13);
+		simd4f tempZ = simd4fAdd(simd4fMulAdd(simd4fMulAdd(simd4fMul(m2, currentX), m6, currentY), m10, currentZ), m14);
+
+		simd4fStore(&resultX[i], tempX);
+		simd4fStore(&resultY[i], tempY);
+		simd4fStore(&resultZ[i], tempZ);
+	}
+
+	for (; i < count; i++)
+	{
+		float currentX = x[i];
+		float currentY = y[i];
+		float currentZ = z[i];
+
+		resultX[i] = matrix[0] * currentX + matrix[4] * currentY + matrix[8] * currentZ + translateX;
+		resultY[i] = matrix[1] * currentX + matrix[5] * currentY + matrix[9] * currentZ + translateY;
+		resultZ[i] = matrix[2] * currentX + matrix[6] * currentY + matrix[10] * currentZ + translateZ;
+	}
+}
+
+void simdMatrix4x4MultiplyPoints3f(float* resultX, float* resultY, float* resultZ, const float matrix[16], const float* x, const float* y, const float* z, int32_t count)
+{
+	multiplySoA(resultX, resultY, resultZ, matrix, x, y, z, count, 1.0f);
+}
+
+void simdMatrix4x4MultiplyVectors3f(float* result, const float matrix[16], const float* vectors, int32_t count)
+{
+	simd4f column0 = simd4fLoad(&matrix[0]);
+	simd4f column1 = simd4fLoad(&matrix[4]);
+	simd4f column2 = simd4fLoad(&matrix[8]);
+
+	GE_ALIGN16 float stored[4];
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		const float* vector = &vectors[i * 3];
+
+		simd4f temp = simd4fMul(column0, simd4fSplat(vector[0]));
+		temp = simd4fMulAdd(temp, column1, simd4fSplat(vector[1]));
+		temp = simd4fMulAdd(temp, column2, simd4fSplat(vector[2]));
+
+		simd4fStore(stored, temp);
+
+		result[i * 3 + 0] = stored[0];
+		result[i * 3 + 1] = stored[1];
+		result[i * 3 + 2] = stored[2];
+	}
+}
+
+void simdMatrix4x4MultiplyVectors3f(float* resultX, float* resultY, float* resultZ, const float matrix[16], const float* x, const float* y, const float* z, int32_t count)
+{
+	multiplySoA(resultX, resultY, resultZ, matrix, x, y, z, count, 0.0f);
+}
+
+void simdMatrix4x4MultiplySpheresf(float* result, const float matrix[16], const float* spheres, int32_t count)
+{
+	float scaleX = matrix[0] * matrix[0] + matrix[1] * matrix[1] + matrix[2] * matrix[2];
+	float scaleY = matrix[4] * matrix[4] + matrix[5] * matrix[5] + matrix[6] * matrix[6];
+	float scaleZ = matrix[8] * matrix[8] + matrix[9] * matrix[9] + matrix[10] * matrix[10];
+
+	float maxScale = sqrtf(max(scaleX, max(scaleY, scaleZ)));
+
+	simd4f column0 = simd4fLoad(&matrix[0]);
+	simd4f column1 = simd4fLoad(&matrix[4]);
+	simd4f column2 = simd4fLoad(&matrix[8]);
+	simd4f column3 = simd4fLoad(&matrix[12]);
+
+	GE_ALIGN16 float stored[4];
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		const float* sphere = &spheres[i * 4];
+
+		float radius = sphere[3];
+
+		simd4f temp = simd4fMul(column0, simd4fSplat(sphere[0]));
+		temp = simd4fMulAdd(temp, column1, simd4fSplat(sphere[1]));
+		temp = simd4fMulAdd(temp, column2, simd4fSplat(sphere[2]));
+		temp = simd4fAdd(temp, column3);
+
+		simd4fStore(stored, temp);
+
+		result[i * 4 + 0] = stored[0];
+		result[i * 4 + 1] = stored[1];
+		result[i * 4 + 2] = stored[2];
+		result[i * 4 + 3] = radius * maxScale;
+	}
+}
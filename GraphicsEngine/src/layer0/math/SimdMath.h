@@ -0,0 +1,126 @@
+/*
+ * SimdMath.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef SIMDMATH_H_
+#define SIMDMATH_H_
+
+#include "../../UsedLibs.h"
+
+#include "Simd.h"
+
+/**
+ * SIMD versions of the GLUS matrix functions. Matrices are column major. Results are equal to GLUS within float rounding.
+ * Result and source may be the same array.
+ */
+
+inline void simdMatrix4x4Copyf(float matrix[16], const float source[16])
+{
+	simd4f column0 = simd4fLoad(&source[0]);
+	simd4f column1 = simd4fLoad(&source[4]);
+	simd4f column2 = simd4fLoad(&source[8]);
+	simd4f column3 = simd4fLoad(&source[12]);
+
+	simd4fStore(&matrix[0], column0);
+	simd4fStore(&matrix[4], column1);
+	simd4fStore(&matrix[8], column2);
+	simd4fStore(&matrix[12], column3);
+}
+
+inline void simdMatrix4x4Multiplyf(float matrix[16], const float matrix0[16], const float matrix1[16])
+{
+	simd4f column0 = simd4fLoad(&matrix0[0]);
+	simd4f column1 = simd4fLoad(&matrix0[4]);
+	simd4f column2 = simd4fLoad(&matrix0[8]);
+	simd4f column3 = simd4fLoad(&matrix0[12]);
+
+	simd4f result[4];
+
+	for (std::int32_t i = 0; i < 4; i++)
+	{
+		result[i] = simd4fMul(column0, simd4fSplat(matrix1[i * 4 + 0]));
+		result[i] = simd4fMulAdd(result[i], column1, simd4fSplat(matrix1[i * 4 + 1]));
+		result[i] = simd4fMulAdd(result[i], column2, simd4fSplat(matrix1[i * 4 + 2]));
+		result[i] = simd4fMulAdd(result[i], column3, simd4fSplat(matrix1[i * 4 + 3]));
+	}
+
+	// Stored at the end, as matrix can be matrix0 or matrix1
+	simd4fStore(&matrix[0], result[0]);
+	simd4fStore(&matrix[4], result[1]);
+	simd4fStore(&matrix[8], result[2]);
+	simd4fStore(&matrix[12], result[3]);
+}
+
+inline void simdMatrix4x4MultiplyPoint4f(float result[4], const float matrix[16], const float point[4])
+{
+	simd4f temp = simd4fMul(simd4fLoad(&matrix[0]), simd4fSplat(point[0]));
+	temp = simd4fMulAdd(temp, simd4fLoad(&matrix[4]), simd4fSplat(point[1]));
+	temp = simd4fMulAdd(temp, simd4fLoad(&matrix[8]), simd4fSplat(point[2]));
+	temp = simd4fMulAdd(temp, simd4fLoad(&matrix[12]), simd4fSplat(point[3]));
+
+	simd4fStore(result, temp);
+
+	if (result[3] != 0.0f && result[3] != 1.0f)
+	{
+		float w = result[3];
+
+		for (std::int32_t i = 0; i < 4; i++)
+		{
+			result[i] /= w;
+		}
+	}
+}
+
+inline void simdMatrix4x4MultiplyVector3f(float result[3], const float matrix[16], const float vector[3])
+{
+	simd4f temp = simd4fMul(simd4fLoad(&matrix[0]), simd4fSplat(vector[0]));
+	temp = simd4fMulAdd(temp, simd4fLoad(&matrix[4]), simd4fSplat(vector[1]));
+	temp = simd4fMulAdd(temp, simd4fLoad(&matrix[8]), simd4fSplat(vector[2]));
+
+	GE_ALIGN16 float stored[4];
+
+	simd4fStore(stored, temp);
+
+	result[0] = stored[0];
+	result[1] = stored[1];
+	result[2] = stored[2];
+}
+
+void simdMatrix4x4Transposef(float matrix[16]);
+
+/**
+ * General inverse. Returns false and leaves the matrix unchanged, if it is singular.
+ */
+bool simdMatrix4x4Inversef(float matrix[16]);
+
+/**
+ * Inverse of a matrix, which last row is (0, 0, 0, 1). Returns false and leaves the matrix unchanged, if it is singular.
+ */
+bool simdMatrix4x4InverseAffinef(float matrix[16]);
+
+// Element count for stack buffers, when a batch transform is done in chunks.
+#define GE_SIMD_BATCH_SIZE 256
+
+/**
+ * Batch transforms of count elements. Points are not divided by w. Result and source may be the same array.
+ */
+
+// Points as x, y, z, w.
+void simdMatrix4x4MultiplyPoints4f(float* result, const float matrix[16], const float* points, std::int32_t count);
+
+// Points as separate x, y, z arrays, w is 1.
+void simdMatrix4x4MultiplyPoints3f(float* resultX, float* resultY, float* resultZ, const float matrix[16], const float* x, const float* y, const float* z, std::int32_t count);
+
+// Vectors as x, y, z.
+void simdMatrix4x4MultiplyVectors3f(float* result, const float matrix[16], const float* vectors, std::int32_t count);
+
+// Vectors as separate x, y, z arrays.
+void simdMatrix4x4MultiplyVectors3f(float* resultX, float* resultY, float* resultZ, const float matrix[16], const float* x, const float* y, const float* z, std::int32_t count);
+
+// Spheres as center x, y, z and radius. The radius is scaled by the largest axis scale.
+void simdMatrix4x4MultiplySpheresf(float* result, const float matrix[16], const float* spheres, std::int32_t count);
+
+#endif /* SIMDMATH_H_ */
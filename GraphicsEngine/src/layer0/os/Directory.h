@@ -20,6 +20,12 @@ public:
 
 	static bool create(const std::string& name);
 
+	/**
+	 * Appends the paths of all files below the directory, which end with the extension, e.g. ".gltf". Subdirectories
+	 * are searched as well.
+	 */
+	static bool findFiles(const std::string& name, const std::string& extension, std::vector<std::string>& allFileNames);
+
 };
 
 #endif /* DIRECTORY_H_ */
@@ -5,6 +5,7 @@
  *      Author: nopper
  */
 
+#include <dirent.h>
 #include <sys/stat.h>
 
 #include "Directory.h"
@@ -23,3 +24,47 @@ bool Directory::create(const string& name)
 {
 	return mkdir(name.c_str(), 0777) == 0;
 }
+
+bool Directory::findFiles(const string& name, const string& extension, vector<string>& allFileNames)
+{
+	DIR* directory = opendir(name.c_str());
+
+	if (!directory)
+	{
+		return false;
+	}
+
+	struct dirent* entry;
+
+	while ((entry = readdir(directory)) != nullptr)
+	{
+		string entryName = entry->d_name;
+
+		if (entryName == "." || entryName == "..")
+		{
+			continue;
+		}
+
+		string path = name + "/" + entryName;
+
+		struct stat status;
+
+		if (stat(path.c_str(), &status) != 0)
+		{
+			continue;
+		}
+
+		if (S_ISDIR(status.st_mode))
+		{
+			findFiles(path, extension, allFileNames);
+		}
+		else if (entryName.length() >= extension.length() && entryName.compare(entryName.length() - extension.length(), extension.length(), extension) == 0)
+		{
+			allFileNames.push_back(path);
+		}
+	}
+
+	closedir(directory);
+
+	return true;
+}
@@ -6,6 +6,7 @@
  */
 
 #include <direct.h>
+#include <windows.h>
 
 #include "Directory.h"
 
@@ -23,3 +24,41 @@ bool Directory::create(const string& name)
 {
 	return _mkdir(name.c_str()) == 0;
 }
+
+bool Directory::findFiles(const string& name, const string& extension, vector<string>& allFileNames)
+{
+	WIN32_FIND_DATAA findData;
+
+	HANDLE findHandle = FindFirstFileA((name + "\\*").c_str(), &findData);
+
+	if (findHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	do
+	{
+		string entryName = findData.cFileName;
+
+		if (entryName == "." || entryName == "..")
+		{
+			continue;
+		}
+
+		string path = name + "\\" + entryName;
+
+		if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		{
+			findFiles(path, extension, allFileNames);
+		}
+		else if (entryName.length() >= extension.length() && entryName.compare(entryName.length() - extension.length(), extension.length(), extension) == 0)
+		{
+			allFileNames.push_back(path);
+		}
+	}
+	while (FindNextFileA(findHandle, &findData));
+
+	FindClose(findHandle);
+
+	return true;
+}
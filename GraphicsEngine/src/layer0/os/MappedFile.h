@@ -0,0 +1,62 @@
+/*
+ * MappedFile.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include "../../UsedLibs.h"
+
+enum MappedFileAdvice
+{
+	MAPPED_FILE_NORMAL, MAPPED_FILE_SEQUENTIAL, MAPPED_FILE_RANDOM, MAPPED_FILE_WILL_NEED, MAPPED_FILE_DONT_NEED
+};
+
+/**
+ * Read only mapping of a whole file. Pages are loaded by the operating system on first access and can be dropped
+ * again under memory pressure, as they are backed by the file.
+ */
+class MappedFile
+{
+
+private:
+
+	const std::uint8_t* data;
+
+	std::size_t length;
+
+public:
+
+	MappedFile();
+	virtual ~MappedFile();
+
+	/**
+	 * A copy would unmap the same pages a second time, so the mapping is shared by MappedFileSP instead.
+	 */
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+
+	bool open(const std::string& filename);
+
+	void close();
+
+	bool isOpen() const;
+
+	const std::uint8_t* getData() const;
+
+	std::size_t getLength() const;
+
+	/**
+	 * Hints the expected access of a range, e.g. sequential before a range is uploaded once. The range is extended
+	 * to whole pages. Without support of the platform, nothing is done.
+	 */
+	void advise(std::size_t offset, std::size_t length, MappedFileAdvice advice) const;
+
+};
+
+typedef std::shared_ptr<MappedFile> MappedFileSP;
+
+#endif /* MAPPEDFILE_H_ */
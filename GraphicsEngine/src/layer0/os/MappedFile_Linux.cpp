@@ -0,0 +1,127 @@
+/*
+ * MappedFile_Linux.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+MappedFile::MappedFile() :
+	data(nullptr), length(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const string& filename)
+{
+	close();
+
+	int32_t descriptor = ::open(filename.c_str(), O_RDONLY);
+
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStatus;
+
+	if (fstat(descriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+	{
+		::close(descriptor);
+
+		return false;
+	}
+
+	void* mapping = mmap(nullptr, (size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+	// The mapping stays valid without the descriptor.
+	::close(descriptor);
+
+	if (mapping == MAP_FAILED)
+	{
+		return false;
+	}
+
+	data = (const uint8_t*)mapping;
+	length = (size_t)fileStatus.st_size;
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (data)
+	{
+		munmap((void*)data, length);
+
+		data = nullptr;
+		length = 0;
+	}
+}
+
+bool MappedFile::isOpen() const
+{
+	return data != nullptr;
+}
+
+const uint8_t* MappedFile::getData() const
+{
+	return data;
+}
+
+size_t MappedFile::getLength() const
+{
+	return length;
+}
+
+void MappedFile::advise(size_t offset, size_t length, MappedFileAdvice advice) const
+{
+	if (!data || offset >= this->length)
+	{
+		return;
+	}
+
+	if (length > this->length - offset)
+	{
+		length = this->length - offset;
+	}
+
+	size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+
+	size_t pageOffset = offset - offset % pageSize;
+
+	int32_t hint;
+
+	switch (advice)
+	{
+		case MAPPED_FILE_SEQUENTIAL:
+			hint = MADV_SEQUENTIAL;
+			break;
+		case MAPPED_FILE_RANDOM:
+			hint = MADV_RANDOM;
+			break;
+		case MAPPED_FILE_WILL_NEED:
+			hint = MADV_WILLNEED;
+			break;
+		case MAPPED_FILE_DONT_NEED:
+			hint = MADV_DONTNEED;
+			break;
+		default:
+			hint = MADV_NORMAL;
+			break;
+	}
+
+	madvise((void*)(data + pageOffset), length + offset - pageOffset, hint);
+}
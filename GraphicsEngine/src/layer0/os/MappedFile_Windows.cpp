@@ -0,0 +1,98 @@
+/*
+ * MappedFile_Windows.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <windows.h>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+MappedFile::MappedFile() :
+	data(nullptr), length(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const string& filename)
+{
+	close();
+
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 || (unsigned long long)fileSize.QuadPart > (unsigned long long)SIZE_MAX)
+	{
+		CloseHandle(file);
+
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	CloseHandle(file);
+
+	if (mapping == nullptr)
+	{
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	// The view stays valid without the handles.
+	CloseHandle(mapping);
+
+	if (view == nullptr)
+	{
+		return false;
+	}
+
+	data = (const uint8_t*)view;
+	length = (size_t)fileSize.QuadPart;
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (data)
+	{
+		UnmapViewOfFile(data);
+
+		data = nullptr;
+		length = 0;
+	}
+}
+
+bool MappedFile::isOpen() const
+{
+	return data != nullptr;
+}
+
+const uint8_t* MappedFile::getData() const
+{
+	return data;
+}
+
+size_t MappedFile::getLength() const
+{
+	return length;
+}
+
+void MappedFile::advise(size_t offset, size_t length, MappedFileAdvice advice) const
+{
+	// Windows reads ahead on its own and PrefetchVirtualMemory is not available before Windows 8.
+}
@@ -0,0 +1,81 @@
+/*
+ * StatisticCounter.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "StatisticCounter.h"
+
+using namespace std;
+
+mutex& StatisticCounter::getAllCountersMutex()
+{
+	static mutex allCountersMutex;
+
+	return allCountersMutex;
+}
+
+vector<StatisticCounter*>& StatisticCounter::getAllCounters()
+{
+	static vector<StatisticCounter*> allCounters;
+
+	return allCounters;
+}
+
+StatisticCounter::StatisticCounter() :
+		currentValue(0), lastValue(0)
+{
+	lock_guard<mutex> lock(getAllCountersMutex());
+
+	getAllCounters().push_back(this);
+}
+
+StatisticCounter::~StatisticCounter()
+{
+	lock_guard<mutex> lock(getAllCountersMutex());
+
+	auto walker = find(getAllCounters().begin(), getAllCounters().end(), this);
+
+	if (walker != getAllCounters().end())
+	{
+		getAllCounters().erase(walker);
+	}
+}
+
+void StatisticCounter::increase(int32_t value)
+{
+	currentValue.fetch_add(value, memory_order_relaxed);
+}
+
+int32_t StatisticCounter::getCurrentValue() const
+{
+	return currentValue.load(memory_order_relaxed);
+}
+
+int32_t StatisticCounter::getLastValue() const
+{
+	return lastValue;
+}
+
+void StatisticCounter::nextFrame()
+{
+	lastValue = currentValue.exchange(0, memory_order_relaxed);
+}
+
+void StatisticCounter::reset()
+{
+	currentValue.store(0, memory_order_relaxed);
+
+	lastValue = 0;
+}
+
+void StatisticCounter::nextFrameAll()
+{
+	lock_guard<mutex> lock(getAllCountersMutex());
+
+	for (auto walker = getAllCounters().begin(); walker != getAllCounters().end(); walker++)
+	{
+		(*walker)->nextFrame();
+	}
+}
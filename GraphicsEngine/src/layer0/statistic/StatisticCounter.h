@@ -0,0 +1,57 @@
+/*
+ * StatisticCounter.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef STATISTICCOUNTER_H_
+#define STATISTICCOUNTER_H_
+
+#include <atomic>
+#include <mutex>
+
+#include "../../UsedLibs.h"
+
+/**
+ * Per frame counter, which can be increased from several worker threads.
+ * All counters are registered and advanced by nextFrameAll(), which the engine calls once per frame.
+ */
+class StatisticCounter
+{
+
+private:
+
+	std::atomic<std::int32_t> currentValue;
+
+	std::int32_t lastValue;
+
+	static std::mutex& getAllCountersMutex();
+
+	static std::vector<StatisticCounter*>& getAllCounters();
+
+public:
+	StatisticCounter();
+	virtual ~StatisticCounter();
+
+	void increase(std::int32_t value = 1);
+
+	std::int32_t getCurrentValue() const;
+
+	/**
+	 * @return The value of the last completed frame.
+	 */
+	std::int32_t getLastValue() const;
+
+	void nextFrame();
+
+	void reset();
+
+	/**
+	 * Stores the current value of all registered counters. Call once per frame.
+	 */
+	static void nextFrameAll();
+
+};
+
+#endif /* STATISTICCOUNTER_H_ */
@@ -51,6 +51,8 @@
 #define u_dynamicCubeMapTexture "u_material.dynamicCubeMapTexture"
 
 #define u_hasSkinning "u_hasSkinning"
+#define u_hasOctahedralNormals "u_hasOctahedralNormals"
+#define u_hasOctahedralTangents "u_hasOctahedralTangents"
 #define u_hasDiffuseTexture "u_hasDiffuseTexture"
 #define u_hasSpecularTexture "u_hasSpecularTexture"
 #define u_hasNormalMapTexture "u_hasNormalMapTexture"
@@ -72,6 +74,7 @@
 #define u_inverseBindNormalMatrix "u_inverseBindNormalMatrix"
 #define u_bindMatrix "u_bindMatrix"
 #define u_bindNormalMatrix "u_bindNormalMatrix"
+#define u_skinningPalette "u_skinningPalette"
 
 #define u_fontLeft "u_fontLeft"
 #define u_fontTop "u_fontTop"
@@ -241,6 +241,11 @@ bool TextureFactoryBase::saveTexture2D(const Texture2DSP texture2D, const string
 	return saveImage(path + texture2D->getIdentifier(), texture2D->getPixelData());
 }
 
+bool TextureFactoryBase::encodeTexture2D(const Texture2DSP texture2D, vector<uint8_t>& data, string& mimeType) const
+{
+	return encodeImage(data, mimeType, texture2D->getPixelData());
+}
+
 bool TextureFactoryBase::saveTextureCubeMap(const TextureCubeMapSP textureCubeMap, const string& path) const
 {
 	string postFix;
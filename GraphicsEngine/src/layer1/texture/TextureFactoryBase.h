@@ -38,6 +38,8 @@ protected:
 
 	virtual bool saveImage(const std::string& identifier, const PixelData& pixelData) const = 0;
 
+	virtual bool encodeImage(std::vector<std::uint8_t>& data, std::string& mimeType, const PixelData& pixelData) const = 0;
+
 public:
 
 	TextureFactoryBase();
@@ -119,6 +121,16 @@ public:
 
 	bool saveTextureCubeMap(const TextureCubeMapSP textureCubeMap, const std::string& path) const;
 
+	/**
+	 * Encodes the texture like saveTexture2D, but into memory, e.g. for embedding it into a binary glTF.
+	 */
+	bool encodeTexture2D(const Texture2DSP texture2D, std::vector<std::uint8_t>& data, std::string& mimeType) const;
+
+	/**
+	 * Decodes an image file held in memory. The pixels are converted to RGB or RGBA and to unsigned bytes or floats.
+	 */
+	virtual bool decodeImage(PixelData& pixelData, const std::string& mimeType, const std::uint8_t* data, std::uint32_t length) const = 0;
+
 };
 
 #endif /* TEXTUREFACTORYBASE_H_ */
@@ -374,14 +374,71 @@ TextureCubeMapArraySP TextureFactory::loadTextureCubeMapArray(const string& iden
 	return textureCubeMapArray;
 }
 
+bool TextureFactory::decodeImage(PixelData& pixelData, const string& mimeType, const uint8_t* data, uint32_t length) const
+{
+	ILuint imageName = 0;
+
+	ILenum imageType = IL_TYPE_UNKNOWN;
+
+	if (mimeType == "image/x-tga")
+	{
+		imageType = IL_TGA;
+	}
+	else if (mimeType == "image/vnd.radiance")
+	{
+		imageType = IL_HDR;
+	}
+	else if (mimeType == "image/png")
+	{
+		imageType = IL_PNG;
+	}
+	else if (mimeType == "image/jpeg")
+	{
+		imageType = IL_JPG;
+	}
+
+	ilGenImages(1, &imageName);
+	ilBindImage(imageName);
+
+	ILboolean success = ilLoadL(imageType, data, length);
+
+	if (success)
+	{
+		ILint format = ilGetInteger(IL_IMAGE_FORMAT);
+		ILint type = ilGetInteger(IL_IMAGE_TYPE);
+
+		bool alpha = format == IL_RGBA || format == IL_BGRA || format == IL_LUMINANCE_ALPHA;
+		bool hdr = type == IL_FLOAT || type == IL_HALF || type == IL_DOUBLE;
+
+		success = ilConvertImage(alpha ? IL_RGBA : IL_RGB, hdr ? IL_FLOAT : IL_UNSIGNED_BYTE);
+	}
+
+	if (success)
+	{
+		ILinfo imageInfo;
+
+		iluGetImageInfo(&imageInfo);
+
+		pixelData = PixelData(imageInfo.Width, imageInfo.Height, imageInfo.Format, imageInfo.Type, imageInfo.Data, imageInfo.SizeOfData);
+	}
+	else
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not decode image of type '%s'", mimeType.c_str());
+	}
+
+	ilBindImage(0);
+	ilDeleteImages(1, &imageName);
+
+	return static_cast<bool>(success == IL_TRUE);
+}
+
 //
 // Saving
 //
 
-bool TextureFactory::saveImage(const string& identifier, const PixelData& pixelData) const
+ILuint TextureFactory::createImage(const PixelData& pixelData) const
 {
 	ILuint imageName = 0;
-	ILboolean result;
 	ILubyte numChannels = 1;
 
 	if (pixelData.getFormat() == GL_RGB)
@@ -405,6 +462,14 @@ bool TextureFactory::saveImage(const string& identifier, const PixelData& pixelD
 	// Format and type should match OpenGL
 	ilTexImage(pixelData.getWidth(), pixelData.getHeight(), 0, numChannels, pixelData.getFormat(), pixelData.getType(), pixelData.getPixels());
 
+	return imageName;
+}
+
+bool TextureFactory::saveImage(const string& identifier, const PixelData& pixelData) const
+{
+	ILuint imageName = createImage(pixelData);
+	ILboolean result;
+
 	ilEnable(IL_FILE_OVERWRITE);
 
 	if (pixelData.getType() == GL_FLOAT || pixelData.getType() == GL_HALF_FLOAT)
@@ -429,3 +494,38 @@ bool TextureFactory::saveImage(const string& identifier, const PixelData& pixelD
 
 	return static_cast<bool>(result == IL_TRUE);
 }
+
+bool TextureFactory::encodeImage(vector<uint8_t>& data, string& mimeType, const PixelData& pixelData) const
+{
+	ILuint imageName = createImage(pixelData);
+	ILenum imageType;
+
+	if (pixelData.getType() == GL_FLOAT || pixelData.getType() == GL_HALF_FLOAT)
+	{
+		imageType = IL_HDR;
+
+		mimeType = "image/vnd.radiance";
+	}
+	else
+	{
+		imageType = IL_TGA;
+
+		mimeType = "image/x-tga";
+	}
+
+	ILuint length = ilDetermineSize(imageType);
+
+	data.resize(length);
+
+	if (length > 0)
+	{
+		length = ilSaveL(imageType, &data[0], length);
+
+		data.resize(length);
+	}
+
+	ilBindImage(0);
+	ilDeleteImages(1, &imageName);
+
+	return length > 0;
+}
@@ -492,6 +492,14 @@ TextureCubeMapArraySP TextureFactory::loadTextureCubeMapArray(const string& iden
 	return textureCubeMapArray;
 }
 
+bool TextureFactory::decodeImage(PixelData& pixelData, const string& mimeType, const uint8_t* data, uint32_t length) const
+{
+	// GLUS only loads images from files.
+	glusLogPrint(GLUS_LOG_ERROR, "Decoding images from memory is not supported");
+
+	return false;
+}
+
 //
 // Saving
 //
@@ -535,3 +543,9 @@ bool TextureFactory::saveImage(const string& identifier, const PixelData& pixelD
 
 	return static_cast<bool>(result == GL_TRUE);
 }
+
+bool TextureFactory::encodeImage(vector<uint8_t>& data, string& mimeType, const PixelData& pixelData) const
+{
+	// GLUS only saves images to files.
+	return false;
+}
@@ -33,6 +33,8 @@ protected:
 
 	virtual bool saveImage(const std::string& identifier, const PixelData& pixelData) const;
 
+	virtual bool encodeImage(std::vector<std::uint8_t>& data, std::string& mimeType, const PixelData& pixelData) const;
+
 public:
 
 	TextureFactory();
@@ -60,6 +62,8 @@ public:
 
 	virtual TextureCubeMapArraySP loadTextureCubeMapArray(const std::string& identifier, const std::string filename[], std::int32_t sizeOfArray, bool mipMap = false, GLint minFilter = GL_LINEAR, GLint magFilter = GL_LINEAR, GLint wrapS = GL_CLAMP_TO_EDGE, GLint wrapT = GL_CLAMP_TO_EDGE, float anisotropic = 1.0f) const;
 
+	virtual bool decodeImage(PixelData& pixelData, const std::string& mimeType, const std::uint8_t* data, std::uint32_t length) const;
+
 };
 
 #endif /* TEXTUREFACTORY_GLUS_H_ */
@@ -0,0 +1,265 @@
+/*
+ * InterpolationKernel.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef INTERPOLATIONKERNEL_H_
+#define INTERPOLATIONKERNEL_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Values are equal to the interpolator ids, so a kernel can be selected by Interpolator::getId().
+ */
+enum InterpolationMode {INTERPOLATION_CONSTANT = 0, INTERPOLATION_LINEAR = 1, INTERPOLATION_CUBIC = 2, INTERPOLATION_HERMITE = 3};
+
+/**
+ * Contiguous, ascending sorted keys of one channel. Tangents are only needed for Hermite interpolation.
+ */
+struct KeySpan
+{
+	const float* times;
+	const float* values;
+	const float* tangents;
+
+	std::int32_t numberKeys;
+};
+
+/**
+ * Returns the index of the last key less or equal the given time, or -1 if there is none.
+ */
+inline std::int32_t findKeyIndex(const KeySpan& keySpan, float time)
+{
+	const float* walker = std::upper_bound(keySpan.times, keySpan.times + keySpan.numberKeys, time);
+
+	return static_cast<std::int32_t>(walker - keySpan.times) - 1;
+}
+
+template<InterpolationMode mode>
+struct InterpolationKernel;
+
+template<>
+struct InterpolationKernel<INTERPOLATION_CONSTANT>
+{
+	static float interpolate(const KeySpan& keySpan, float time)
+	{
+		if (keySpan.numberKeys == 0)
+		{
+			return 0.0f;
+		}
+
+		std::int32_t index = findKeyIndex(keySpan, time);
+
+		if (index < 0)
+		{
+			return keySpan.values[0];
+		}
+
+		return keySpan.values[index];
+	}
+};
+
+template<>
+struct InterpolationKernel<INTERPOLATION_LINEAR>
+{
+	static float interpolate(const KeySpan& keySpan, float time)
+	{
+		if (keySpan.numberKeys == 0)
+		{
+			return 0.0f;
+		}
+
+		std::int32_t index = findKeyIndex(keySpan, time);
+
+		if (index < 0)
+		{
+			return keySpan.values[0];
+		}
+
+		if (index + 1 == keySpan.numberKeys)
+		{
+			return keySpan.values[index];
+		}
+
+		float startTime = keySpan.times[index];
+		float startValue = keySpan.values[index];
+
+		float delta = keySpan.times[index + 1] - startTime;
+
+		if (delta == 0.0f)
+		{
+			return startValue;
+		}
+
+		return startValue + (keySpan.values[index + 1] - startValue) * (time - startTime) / delta;
+	}
+};
+
+/**
+ * Same results as CubicInterpolator, see http://paulbourke.net/miscellaneous/interpolation/
+ */
+template<>
+struct InterpolationKernel<INTERPOLATION_CUBIC>
+{
+	static float interpolate(const KeySpan& keySpan, float time)
+	{
+		if (keySpan.numberKeys < 4)
+		{
+			return InterpolationKernel<INTERPOLATION_LINEAR>::interpolate(keySpan, time);
+		}
+
+		std::int32_t index = findKeyIndex(keySpan, time);
+
+		// If nothing was found, return starting value
+		if (index < 0)
+		{
+			return keySpan.values[0];
+		}
+		else if (index == 0 || index + 2 == keySpan.numberKeys)
+		{
+			return InterpolationKernel<INTERPOLATION_LINEAR>::interpolate(keySpan, time);
+		}
+		else if (index + 1 == keySpan.numberKeys)
+		{
+			return keySpan.values[index];
+		}
+
+		float startTime = keySpan.times[index];
+		float startValue = keySpan.values[index];
+
+		float prevStartValue = keySpan.values[index - 1];
+
+		float stopValue = keySpan.values[index + 1];
+
+		float postStopValue = keySpan.values[index + 2];
+
+		float delta = keySpan.times[index + 1] - startTime;
+
+		if (delta == 0.0f)
+		{
+			return startValue;
+		}
+
+		float x = (time - startTime) / delta;
+
+		float a0, a1, a2, a3;
+
+		a0 = postStopValue - stopValue - prevStartValue + startValue;
+		a1 = prevStartValue - startValue - a0;
+		a2 = stopValue - prevStartValue;
+		a3 = startValue;
+
+		return (a0 * x * x * x + a1 * x * x + a2 * x + a3);
+	}
+};
+
+/**
+ * Cubic Hermite spline. The tangents have to be set, e.g. by calculateHermiteTangents().
+ */
+template<>
+struct InterpolationKernel<INTERPOLATION_HERMITE>
+{
+	static float interpolate(const KeySpan& keySpan, float time)
+	{
+		if (keySpan.numberKeys == 0)
+		{
+			return 0.0f;
+		}
+
+		assert(keySpan.tangents);
+
+		std::int32_t index = findKeyIndex(keySpan, time);
+
+		if (index < 0)
+		{
+			return keySpan.values[0];
+		}
+
+		if (index + 1 == keySpan.numberKeys)
+		{
+			return keySpan.values[index];
+		}
+
+		float startTime = keySpan.times[index];
+		float startValue = keySpan.values[index];
+
+		float delta = keySpan.times[index + 1] - startTime;
+
+		if (delta == 0.0f)
+		{
+			return startValue;
+		}
+
+		float x = (time - startTime) / delta;
+		float x2 = x * x;
+		float x3 = x2 * x;
+
+		float h00 = 2.0f * x3 - 3.0f * x2 + 1.0f;
+		float h10 = x3 - 2.0f * x2 + x;
+		float h01 = -2.0f * x3 + 3.0f * x2;
+		float h11 = x3 - x2;
+
+		return h00 * startValue + h10 * delta * keySpan.tangents[index] + h01 * keySpan.values[index + 1] + h11 * delta * keySpan.tangents[index + 1];
+	}
+};
+
+/**
+ * Evaluates many channels at the same time with one interpolation mode.
+ */
+template<InterpolationMode mode>
+void interpolateBatch(float* results, const KeySpan* keySpans, std::int32_t numberKeySpans, float time)
+{
+	for (std::int32_t i = 0; i < numberKeySpans; i++)
+	{
+		results[i] = InterpolationKernel<mode>::interpolate(keySpans[i], time);
+	}
+}
+
+/**
+ * Selects the kernel once for the whole batch.
+ */
+inline void interpolateBatch(float* results, const KeySpan* keySpans, std::int32_t numberKeySpans, float time, InterpolationMode mode)
+{
+	switch (mode)
+	{
+		case INTERPOLATION_CONSTANT:
+			interpolateBatch<INTERPOLATION_CONSTANT>(results, keySpans, numberKeySpans, time);
+		break;
+		case INTERPOLATION_LINEAR:
+			interpolateBatch<INTERPOLATION_LINEAR>(results, keySpans, numberKeySpans, time);
+		break;
+		case INTERPOLATION_CUBIC:
+			interpolateBatch<INTERPOLATION_CUBIC>(results, keySpans, numberKeySpans, time);
+		break;
+		case INTERPOLATION_HERMITE:
+			interpolateBatch<INTERPOLATION_HERMITE>(results, keySpans, numberKeySpans, time);
+		break;
+	}
+}
+
+/**
+ * Catmull-Rom like tangents, one sided at the first and last key.
+ */
+inline void calculateHermiteTangents(float* tangents, const float* times, const float* values, std::int32_t numberKeys)
+{
+	for (std::int32_t i = 0; i < numberKeys; i++)
+	{
+		std::int32_t previous = i > 0 ? i - 1 : i;
+		std::int32_t next = i + 1 < numberKeys ? i + 1 : i;
+
+		float delta = times[next] - times[previous];
+
+		if (delta == 0.0f)
+		{
+			tangents[i] = 0.0f;
+
+			continue;
+		}
+
+		tangents[i] = (values[next] - values[previous]) / delta;
+	}
+}
+
+#endif /* INTERPOLATIONKERNEL_H_ */
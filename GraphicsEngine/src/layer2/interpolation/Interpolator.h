@@ -10,6 +10,8 @@
 
 #include "../../UsedLibs.h"
 
+#include "InterpolationKernel.h"
+
 class Interpolator
 {
 
@@ -35,6 +37,18 @@ public:
 
 	virtual float interpolate(const std::map<float, float>& table, float time) const = 0;
 
+	/**
+	 * Forwards to the kernel with the same id. Prefer the kernels directly in hot loops.
+	 */
+	float interpolateKeySpan(const KeySpan& keySpan, float time) const
+	{
+		float result;
+
+		interpolateBatch(&result, &keySpan, 1, time, static_cast<InterpolationMode>(id));
+
+		return result;
+	}
+
 	const std::string& getName() const
 	{
 		return name;
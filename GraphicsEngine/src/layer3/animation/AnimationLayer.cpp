@@ -5,8 +5,6 @@
  *      Author: nopper
  */
 
-#include "../../layer0/stl/Helper.h"
-
 #include "AnimationLayer.h"
 
 using namespace std;
@@ -62,85 +60,168 @@ void AnimationLayer::addTranslationValue(enum eCHANNELS_XYZ channel, float time,
 {
 	allTranslationValues[channel][time] = value;
 	allTranslationInterpolators[channel][time] = &interpolator;
+
+	addKey(allTranslationKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addRotationValue(enum eCHANNELS_XYZ channel, float time, float value, const Interpolator& interpolator)
 {
 	allRotationValues[channel][time] = value;
 	allRotationInterpolators[channel][time] = &interpolator;
+
+	addKey(allRotationKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addScalingValue(enum eCHANNELS_XYZ channel, float time, float value, const Interpolator& interpolator)
 {
 	allScalingValues[channel][time] = value;
 	allScalingInterpolators[channel][time] = &interpolator;
+
+	addKey(allScalingKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addEmissiveColorValue(enum eCHANNELS_RGBA channel, float time, float value, const Interpolator& interpolator)
 {
 	allEmissiveColorValues[channel][time] = value;
 	allEmissiveColorInterpolators[channel][time] = &interpolator;
+
+	addKey(allEmissiveColorKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addAmbientColorValue(enum eCHANNELS_RGBA channel, float time, float value, const Interpolator& interpolator)
 {
 	allAmbientColorValues[channel][time] = value;
 	allAmbientColorInterpolators[channel][time] = &interpolator;
+
+	addKey(allAmbientColorKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addDiffuseColorValue(enum eCHANNELS_RGBA channel, float time, float value, const Interpolator& interpolator)
 {
 	allDiffuseColorValues[channel][time] = value;
 	allDiffuseColorInterpolators[channel][time] = &interpolator;
+
+	addKey(allDiffuseColorKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addSpecularColorValue(enum eCHANNELS_RGBA channel, float time, float value, const Interpolator& interpolator)
 {
 	allSpecularColorValues[channel][time] = value;
 	allSpecularColorInterpolators[channel][time] = &interpolator;
+
+	addKey(allSpecularColorKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addReflectionColorValue(enum eCHANNELS_RGBA channel, float time, float value, const Interpolator& interpolator)
 {
 	allReflectionColorValues[channel][time] = value;
 	allReflectionColorInterpolators[channel][time] = &interpolator;
+
+	addKey(allReflectionColorKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addRefractionColorValue(enum eCHANNELS_RGBA channel, float time, float value, const Interpolator& interpolator)
 {
 	allRefractionColorValues[channel][time] = value;
 	allRefractionColorInterpolators[channel][time] = &interpolator;
+
+	addKey(allRefractionColorKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addShininessValue(enum eCHANNELS_SCALAR channel, float time, float value, const Interpolator& interpolator)
 {
 	allShininessValues[channel][time] = value;
 	allShininessInterpolators[channel][time] = &interpolator;
+
+	addKey(allShininessKeys[channel], time, value, interpolator);
 }
 
 void AnimationLayer::addTransparencyValue(enum eCHANNELS_SCALAR channel, float time, float value, const Interpolator& interpolator)
 {
 	allTransparencyValues[channel][time] = value;
 	allTransparencyInterpolators[channel][time] = &interpolator;
+
+	addKey(allTransparencyKeys[channel], time, value, interpolator);
 }
 
-float AnimationLayer::getInterpolatedValue(const std::map<float, float>& currentTableValues, const std::map<float, const Interpolator*>& currentTableInterpolators, float time, float defaultValue) const
+void AnimationLayer::addKey(KeyChannel& keyChannel, float time, float value, const Interpolator& interpolator)
 {
-	if (currentTableInterpolators.size() == 0)
+	InterpolationMode mode = static_cast<InterpolationMode>(interpolator.getId());
+
+	// Keys are usually added in ascending order, then only the new key has to be compared with the first one.
+	if (keyChannel.times.size() == 0 || time > keyChannel.times.back())
+	{
+		keyChannel.times.push_back(time);
+		keyChannel.values.push_back(value);
+		keyChannel.modes.push_back(mode);
+
+		if (mode != keyChannel.modes[0])
+		{
+			keyChannel.mixedModes = true;
+		}
+
+		return;
+	}
+
+	auto walker = lower_bound(keyChannel.times.begin(), keyChannel.times.end(), time);
+
+	auto index = walker - keyChannel.times.begin();
+
+	if (*walker == time)
+	{
+		keyChannel.values[index] = value;
+		keyChannel.modes[index] = mode;
+	}
+	else
+	{
+		keyChannel.times.insert(walker, time);
+		keyChannel.values.insert(keyChannel.values.begin() + index, value);
+		keyChannel.modes.insert(keyChannel.modes.begin() + index, mode);
+	}
+
+	// The first key may have changed and an overwrite can make the channel uniform again.
+	keyChannel.mixedModes = false;
+
+	for (size_t i = 1; i < keyChannel.modes.size(); i++)
+	{
+		if (keyChannel.modes[i] != keyChannel.modes[0])
+		{
+			keyChannel.mixedModes = true;
+
+			break;
+		}
+	}
+}
+
+float AnimationLayer::getInterpolatedValue(const KeyChannel& keyChannel, float time, float defaultValue) const
+{
+	if (keyChannel.times.size() == 0)
 	{
 		return defaultValue;
 	}
 
-	auto walker = less_equal_bound<float, const Interpolator*>(currentTableInterpolators, time);
+	KeySpan keySpan = {&keyChannel.times[0], &keyChannel.values[0], nullptr, static_cast<int32_t>(keyChannel.times.size())};
+
+	InterpolationMode mode = keyChannel.modes[0];
 
-	if (walker == currentTableInterpolators.end())
+	if (keyChannel.mixedModes)
 	{
-		return currentTableValues.begin()->second;
+		// The interpolator of the last key before the time is used for the whole channel
+		int32_t index = findKeyIndex(keySpan, time);
+
+		if (index < 0)
+		{
+			return keyChannel.values[0];
+		}
+
+		mode = keyChannel.modes[index];
 	}
 
-	const Interpolator* currentInterpolator = walker->second;
+	float result;
+
+	interpolateBatch(&result, &keySpan, 1, time, mode);
 
-	return currentInterpolator->interpolate(currentTableValues, time);
+	return result;
 }
 
 bool AnimationLayer::hasTranslationValue(enum eCHANNELS_XYZ channel) const
@@ -200,90 +281,76 @@ bool AnimationLayer::hasTransparencyValue(enum eCHANNELS_SCALAR channel) const
 
 float AnimationLayer::getTranslationValue(enum eCHANNELS_XYZ channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allTranslationValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allTranslationInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allTranslationKeys[channel], time);
 }
 
 float AnimationLayer::getRotationValue(enum eCHANNELS_XYZ channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allRotationValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allRotationInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allRotationKeys[channel], time);
 }
 
 float AnimationLayer::getScalingValue(enum eCHANNELS_XYZ channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allScalingValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allScalingInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time, 1.0f);
+	return getInterpolatedValue(allScalingKeys[channel], time, 1.0f);
 }
 
 float AnimationLayer::getEmissiveColorValue(enum eCHANNELS_RGBA channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allEmissiveColorValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allEmissiveColorInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allEmissiveColorKeys[channel], time);
 }
 
 float AnimationLayer::getAmbientColorValue(enum eCHANNELS_RGBA channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allAmbientColorValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allAmbientColorInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allAmbientColorKeys[channel], time);
 }
 
 float AnimationLayer::getDiffuseColorValue(enum eCHANNELS_RGBA channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allDiffuseColorValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allDiffuseColorInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allDiffuseColorKeys[channel], time);
 }
 
 float AnimationLayer::getSpecularColorValue(enum eCHANNELS_RGBA channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allSpecularColorValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allSpecularColorInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allSpecularColorKeys[channel], time);
 }
 
 float AnimationLayer::getReflectionColorValue(enum eCHANNELS_RGBA channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allReflectionColorValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allReflectionColorInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allReflectionColorKeys[channel], time);
 }
 
 float AnimationLayer::getRefractionColorValue(enum eCHANNELS_RGBA channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allRefractionColorValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allRefractionColorInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allRefractionColorKeys[channel], time);
 }
 
 float AnimationLayer::getShininessValue(enum eCHANNELS_SCALAR channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allShininessValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allShininessInterpolators[channel];
-
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+	return getInterpolatedValue(allShininessKeys[channel], time);
 }
 
 float AnimationLayer::getTransparencyValue(enum eCHANNELS_SCALAR channel, float time) const
 {
-	const std::map<float, float>& currentTableValues = allTransparencyValues[channel];
-	const std::map<float, const Interpolator*>& currentTableInterpolators = allTransparencyInterpolators[channel];
+	return getInterpolatedValue(allTransparencyKeys[channel], time);
+}
 
-	return getInterpolatedValue(currentTableValues, currentTableInterpolators, time);
+void AnimationLayer::getTransformValues(float* translation, float* rotation, float* scaling, float time) const
+{
+	for (enum eCHANNELS_XYZ i = X; i <= Z; i = static_cast<enum eCHANNELS_XYZ>(i + 1))
+	{
+		if (translation && allTranslationKeys[i].times.size() > 0)
+		{
+			translation[i] = getInterpolatedValue(allTranslationKeys[i], time);
+		}
+		if (rotation && allRotationKeys[i].times.size() > 0)
+		{
+			rotation[i] = getInterpolatedValue(allRotationKeys[i], time);
+		}
+		if (scaling && allScalingKeys[i].times.size() > 0)
+		{
+			scaling[i] = getInterpolatedValue(allScalingKeys[i], time, 1.0f);
+		}
+	}
 }
 
 const map<float, float>& AnimationLayer::getAllTranslationValues(enum eCHANNELS_XYZ channel) const
@@ -10,6 +10,7 @@
 
 #include "../../UsedLibs.h"
 
+#include "../../layer2/interpolation/InterpolationKernel.h"
 #include "../../layer2/interpolation/Interpolator.h"
 
 class AnimationLayer
@@ -23,40 +24,73 @@ public:
 
 private:
 
+	/**
+	 * Contiguous keys of one channel, which are sampled by the interpolation kernels.
+	 */
+	struct KeyChannel
+	{
+		std::vector<float> times;
+		std::vector<float> values;
+		std::vector<InterpolationMode> modes;
+
+		/**
+		 * If false, all keys have the mode of the first key and the key search for the mode is skipped.
+		 */
+		bool mixedModes;
+
+		KeyChannel() :
+				times(), values(), modes(), mixedModes(false)
+		{
+		}
+	};
+
 	std::map<float, float> allTranslationValues[3];
 	std::map<float, const Interpolator*> allTranslationInterpolators[3];
+	KeyChannel allTranslationKeys[3];
 
 	std::map<float, float> allRotationValues[3];
 	std::map<float, const Interpolator*> allRotationInterpolators[3];
+	KeyChannel allRotationKeys[3];
 
 	std::map<float, float> allScalingValues[3];
 	std::map<float, const Interpolator*> allScalingInterpolators[3];
+	KeyChannel allScalingKeys[3];
 
 	std::map<float, float> allEmissiveColorValues[4];
 	std::map<float, const Interpolator*> allEmissiveColorInterpolators[4];
+	KeyChannel allEmissiveColorKeys[4];
 
 	std::map<float, float> allAmbientColorValues[4];
 	std::map<float, const Interpolator*> allAmbientColorInterpolators[4];
+	KeyChannel allAmbientColorKeys[4];
 
 	std::map<float, float> allDiffuseColorValues[4];
 	std::map<float, const Interpolator*> allDiffuseColorInterpolators[4];
+	KeyChannel allDiffuseColorKeys[4];
 
 	std::map<float, float> allSpecularColorValues[4];
 	std::map<float, const Interpolator*> allSpecularColorInterpolators[4];
+	KeyChannel allSpecularColorKeys[4];
 
 	std::map<float, float> allReflectionColorValues[4];
 	std::map<float, const Interpolator*> allReflectionColorInterpolators[4];
+	KeyChannel allReflectionColorKeys[4];
 
 	std::map<float, float> allRefractionColorValues[4];
 	std::map<float, const Interpolator*> allRefractionColorInterpolators[4];
+	KeyChannel allRefractionColorKeys[4];
 
 	std::map<float, float> allShininessValues[1];
 	std::map<float, const Interpolator*> allShininessInterpolators[1];
+	KeyChannel allShininessKeys[1];
 
 	std::map<float, float> allTransparencyValues[1];
 	std::map<float, const Interpolator*> allTransparencyInterpolators[1];
+	KeyChannel allTransparencyKeys[1];
+
+	static void addKey(KeyChannel& keyChannel, float time, float value, const Interpolator& interpolator);
 
-	float getInterpolatedValue(const std::map<float, float>& currentTableValues, const std::map<float, const Interpolator*>& currentTableInterpolators, float time, float defaultValue = 0.0f) const;
+	float getInterpolatedValue(const KeyChannel& keyChannel, float time, float defaultValue = 0.0f) const;
 
 public:
 
@@ -99,6 +133,11 @@ public:
 	float getShininessValue(enum eCHANNELS_SCALAR channel, float time) const;
 	float getTransparencyValue(enum eCHANNELS_SCALAR channel, float time) const;
 
+	/**
+	 * Samples all translation, rotation and scaling channels with keys. Values of channels without keys are not changed.
+	 */
+	void getTransformValues(float* translation, float* rotation, float* scaling, float time) const;
+
 	const std::map<float, float>& getAllTranslationValues(enum eCHANNELS_XYZ channel) const;
 	const std::map<float, float>& getAllRotationValues(enum eCHANNELS_XYZ channel) const;
 	const std::map<float, float>& getAllScalingValues(enum eCHANNELS_XYZ channel) const;
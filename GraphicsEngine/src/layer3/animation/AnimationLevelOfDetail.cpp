@@ -0,0 +1,84 @@
+/*
+ * AnimationLevelOfDetail.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "AnimationLevelOfDetail.h"
+
+using namespace std;
+
+AnimationLevelOfDetail::AnimationLevelOfDetail() :
+		reducedRateDistance(0.0f), reducedUpdateInterval(1), skipLeafJointsDistance(0.0f), freezeDistance(0.0f)
+{
+}
+
+AnimationLevelOfDetail::AnimationLevelOfDetail(float reducedRateDistance, int32_t reducedUpdateInterval, float skipLeafJointsDistance, float freezeDistance) :
+		reducedRateDistance(reducedRateDistance), reducedUpdateInterval(reducedUpdateInterval > 1 ? reducedUpdateInterval : 1), skipLeafJointsDistance(skipLeafJointsDistance), freezeDistance(freezeDistance)
+{
+}
+
+AnimationLevelOfDetail::~AnimationLevelOfDetail()
+{
+}
+
+float AnimationLevelOfDetail::getReducedRateDistance() const
+{
+	return reducedRateDistance;
+}
+
+void AnimationLevelOfDetail::setReducedRateDistance(float reducedRateDistance)
+{
+	this->reducedRateDistance = reducedRateDistance;
+}
+
+int32_t AnimationLevelOfDetail::getReducedUpdateInterval() const
+{
+	return reducedUpdateInterval;
+}
+
+void AnimationLevelOfDetail::setReducedUpdateInterval(int32_t reducedUpdateInterval)
+{
+	this->reducedUpdateInterval = reducedUpdateInterval > 1 ? reducedUpdateInterval : 1;
+}
+
+float AnimationLevelOfDetail::getSkipLeafJointsDistance() const
+{
+	return skipLeafJointsDistance;
+}
+
+void AnimationLevelOfDetail::setSkipLeafJointsDistance(float skipLeafJointsDistance)
+{
+	this->skipLeafJointsDistance = skipLeafJointsDistance;
+}
+
+float AnimationLevelOfDetail::getFreezeDistance() const
+{
+	return freezeDistance;
+}
+
+void AnimationLevelOfDetail::setFreezeDistance(float freezeDistance)
+{
+	this->freezeDistance = freezeDistance;
+}
+
+int32_t AnimationLevelOfDetail::getUpdateInterval(float distanceToCamera) const
+{
+	if (freezeDistance > 0.0f && distanceToCamera >= freezeDistance)
+	{
+		return 0;
+	}
+
+	if (reducedRateDistance > 0.0f && distanceToCamera >= reducedRateDistance)
+	{
+		return reducedUpdateInterval;
+	}
+
+	return 1;
+}
+
+bool AnimationLevelOfDetail::isSkipLeafJoints(float distanceToCamera) const
+{
+	return skipLeafJointsDistance > 0.0f && distanceToCamera >= skipLeafJointsDistance;
+}
@@ -0,0 +1,56 @@
+/*
+ * AnimationLevelOfDetail.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef ANIMATIONLEVELOFDETAIL_H_
+#define ANIMATIONLEVELOFDETAIL_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Distance based thresholds for reducing the animation work of far away entities.
+ * A distance less or equal zero disables the corresponding reduction.
+ */
+class AnimationLevelOfDetail
+{
+
+private:
+
+	float reducedRateDistance;
+	std::int32_t reducedUpdateInterval;
+
+	float skipLeafJointsDistance;
+
+	float freezeDistance;
+
+public:
+
+	AnimationLevelOfDetail();
+	AnimationLevelOfDetail(float reducedRateDistance, std::int32_t reducedUpdateInterval, float skipLeafJointsDistance, float freezeDistance);
+	virtual ~AnimationLevelOfDetail();
+
+	float getReducedRateDistance() const;
+	void setReducedRateDistance(float reducedRateDistance);
+
+	std::int32_t getReducedUpdateInterval() const;
+	void setReducedUpdateInterval(std::int32_t reducedUpdateInterval);
+
+	float getSkipLeafJointsDistance() const;
+	void setSkipLeafJointsDistance(float skipLeafJointsDistance);
+
+	float getFreezeDistance() const;
+	void setFreezeDistance(float freezeDistance);
+
+	/**
+	 * @return Every how many frames the animation has to be updated. Zero, if the pose is frozen.
+	 */
+	std::int32_t getUpdateInterval(float distanceToCamera) const;
+
+	bool isSkipLeafJoints(float distanceToCamera) const;
+
+};
+
+#endif /* ANIMATIONLEVELOFDETAIL_H_ */
@@ -95,17 +95,23 @@ void OrthographicCamera::adjustToFrustum(const ViewFrustum& viewFrustum, int32_t
 	Vector3 lightRight = lightRotation * Vector3(0.0f, 0.0f, -1.0f);
 	Vector3 lightUp = lightRotation * Vector3(0.0f, -1.0f, 0.0f);
 
+	// Rows are the light axes, so the transformed points are in light space.
+	Matrix4x4 lightMatrix;
+	for (int32_t k = 0; k < 3; k++)
+	{
+		lightMatrix.setM(lightRight.getV(k), k * 4 + 0);
+		lightMatrix.setM(lightUp.getV(k), k * 4 + 1);
+		lightMatrix.setM(lightForward.getV(k), k * 4 + 2);
+	}
+
+	Point4 lightSpacePoints[8];
+	lightMatrix.transform(lightSpacePoints, &frustumPoints[section * 4], 8);
+
 	Vector3 min;
 	Vector3 max;
 	for (int32_t i = section * 4; i < section * 4 + 8; i++)
 	{
-		Vector3 v = frustumPoints[i] - Point4(0.0, 0.0, 0.0);
-
-		Vector3 temp;
-
-		temp[0] = lightRight.dot(v);
-		temp[1] = lightUp.dot(v);
-		temp[2] = lightForward.dot(v);
+		const float* temp = lightSpacePoints[i - section * 4].getP();
 
 		if (i == section * 4)
 		{
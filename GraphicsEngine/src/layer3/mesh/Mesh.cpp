@@ -13,8 +13,13 @@
 using namespace std;
 
 Mesh::Mesh(const string& name, uint32_t numberVertices, float* vertices, float* normals, float* bitangents, float* tangents, float* texCoords, uint32_t numberIndices, uint32_t* indices, const map<int32_t, SubMeshSP>& subMeshes, const map<int32_t, SurfaceMaterialSP>& surfaceMaterials) :
-	name(name), numberVertices(numberVertices), vertices(vertices), normals(normals), bitangents(bitangents), tangents(tangents), texCoords(texCoords), numberIndices(numberIndices), indices(indices), vboVertices(0),
-			vboNormals(0), vboTexCoords(0), vboIndices(0), boneIndices0(0), boneIndices1(0), boneWeights0(0), boneWeights1(0), boneCounters(0), subMeshes(subMeshes), surfaceMaterials(surfaceMaterials)
+	Mesh(name, numberVertices, vertices, VertexFormat(4), normals, VertexFormat(3), bitangents, VertexFormat(3), tangents, VertexFormat(3), texCoords, VertexFormat(2), numberIndices, indices, subMeshes, surfaceMaterials, vector<shared_ptr<const void> >())
+{
+}
+
+Mesh::Mesh(const string& name, uint32_t numberVertices, const void* vertices, const VertexFormat& vertexFormat, const void* normals, const VertexFormat& normalFormat, const void* bitangents, const VertexFormat& bitangentFormat, const void* tangents, const VertexFormat& tangentFormat, const void* texCoords, const VertexFormat& texCoordFormat, uint32_t numberIndices, const uint32_t* indices, const map<int32_t, SubMeshSP>& subMeshes, const map<int32_t, SurfaceMaterialSP>& surfaceMaterials, const vector<shared_ptr<const void> >& allCpuDataOwners) :
+	name(name), numberVertices(numberVertices), vertices(const_cast<void*>(vertices)), normals(const_cast<void*>(normals)), bitangents(const_cast<void*>(bitangents)), tangents(const_cast<void*>(tangents)), texCoords(const_cast<void*>(texCoords)), vertexFormat(vertexFormat), normalFormat(normalFormat), bitangentFormat(bitangentFormat), tangentFormat(tangentFormat), texCoordFormat(texCoordFormat), numberIndices(numberIndices), indices(const_cast<uint32_t*>(indices)), vboVertices(0),
+			vboNormals(0), vboBitangents(0), vboTangents(0), vboTexCoords(0), vboIndices(0), boneIndices0(0), boneIndices1(0), boneWeights0(0), boneWeights1(0), boneCounters(0), subMeshes(subMeshes), surfaceMaterials(surfaceMaterials), allCpuDataOwners(allCpuDataOwners)
 {
 	vboBoneIndices[0] = 0;
 	vboBoneIndices[1] = 0;
@@ -22,36 +27,37 @@ Mesh::Mesh(const string& name, uint32_t numberVertices, float* vertices, float*
 	vboBoneWeights[1] = 0;
 	vboBoneCounters = 0;
 
+	// Packed attributes are uploaded as they are, including the padding between the elements.
 	glGenBuffers(1, &vboVertices);
 	glBindBuffer(GL_ARRAY_BUFFER, vboVertices);
-	glBufferData(GL_ARRAY_BUFFER, numberVertices * 4 * sizeof(GLfloat), (GLfloat*) vertices, GL_STATIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, vertexFormat.getByteSize(numberVertices), vertices, GL_STATIC_DRAW);
 
 	if (normals)
 	{
 		glGenBuffers(1, &vboNormals);
 		glBindBuffer(GL_ARRAY_BUFFER, vboNormals);
-		glBufferData(GL_ARRAY_BUFFER, numberVertices * 3 * sizeof(GLfloat), (GLfloat*) normals, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, normalFormat.getByteSize(numberVertices), normals, GL_STATIC_DRAW);
 	}
 
 	if (bitangents)
 	{
 		glGenBuffers(1, &vboBitangents);
 		glBindBuffer(GL_ARRAY_BUFFER, vboBitangents);
-		glBufferData(GL_ARRAY_BUFFER, numberVertices * 3 * sizeof(GLfloat), (GLfloat*) bitangents, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, bitangentFormat.getByteSize(numberVertices), bitangents, GL_STATIC_DRAW);
 	}
 
 	if (tangents)
 	{
 		glGenBuffers(1, &vboTangents);
 		glBindBuffer(GL_ARRAY_BUFFER, vboTangents);
-		glBufferData(GL_ARRAY_BUFFER, numberVertices * 3 * sizeof(GLfloat), (GLfloat*) tangents, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, tangentFormat.getByteSize(numberVertices), tangents, GL_STATIC_DRAW);
 	}
 
 	if (texCoords)
 	{
 		glGenBuffers(1, &vboTexCoords);
 		glBindBuffer(GL_ARRAY_BUFFER, vboTexCoords);
-		glBufferData(GL_ARRAY_BUFFER, numberVertices * 2 * sizeof(GLfloat), (GLfloat*) texCoords, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, texCoordFormat.getByteSize(numberVertices), texCoords, GL_STATIC_DRAW);
 	}
 
 	glGenBuffers(1, &vboIndices);
@@ -61,6 +67,19 @@ Mesh::Mesh(const string& name, uint32_t numberVertices, float* vertices, float*
 	updateVAO();
 }
 
+Mesh::Mesh(const string& name, const MeshSP& bufferOwner, const map<int32_t, SubMeshSP>& subMeshes, const map<int32_t, SurfaceMaterialSP>& surfaceMaterials) :
+	name(name), numberVertices(bufferOwner->numberVertices), vertices(bufferOwner->vertices), normals(bufferOwner->normals), bitangents(bufferOwner->bitangents), tangents(bufferOwner->tangents), texCoords(bufferOwner->texCoords), vertexFormat(bufferOwner->vertexFormat), normalFormat(bufferOwner->normalFormat), bitangentFormat(bufferOwner->bitangentFormat), tangentFormat(bufferOwner->tangentFormat), texCoordFormat(bufferOwner->texCoordFormat), numberIndices(bufferOwner->numberIndices), indices(bufferOwner->indices), vboVertices(bufferOwner->vboVertices),
+			vboNormals(bufferOwner->vboNormals), vboBitangents(bufferOwner->vboBitangents), vboTangents(bufferOwner->vboTangents), vboTexCoords(bufferOwner->vboTexCoords), vboIndices(bufferOwner->vboIndices), boneIndices0(bufferOwner->boneIndices0), boneIndices1(bufferOwner->boneIndices1), boneWeights0(bufferOwner->boneWeights0), boneWeights1(bufferOwner->boneWeights1), boneCounters(bufferOwner->boneCounters), subMeshes(subMeshes), surfaceMaterials(surfaceMaterials), allCpuDataOwners(bufferOwner->allCpuDataOwners), bufferOwner(bufferOwner)
+{
+	vboBoneIndices[0] = bufferOwner->vboBoneIndices[0];
+	vboBoneIndices[1] = bufferOwner->vboBoneIndices[1];
+	vboBoneWeights[0] = bufferOwner->vboBoneWeights[0];
+	vboBoneWeights[1] = bufferOwner->vboBoneWeights[1];
+	vboBoneCounters = bufferOwner->vboBoneCounters;
+
+	updateVAO();
+}
+
 Mesh::~Mesh()
 {
 	map<int32_t, SubMeshSP>::iterator walkerSubMeshes = subMeshes.begin();
@@ -81,6 +100,13 @@ Mesh::~Mesh()
 
 	cleanCpuData();
 
+	if (bufferOwner.get())
+	{
+		bufferOwner.reset();
+
+		return;
+	}
+
 	glDeleteBuffers(1, &vboVertices);
 	glDeleteBuffers(1, &vboNormals);
 	glDeleteBuffers(1, &vboBitangents);
@@ -126,29 +152,50 @@ void Mesh::updateVAO()
 
 void Mesh::cleanCpuData()
 {
+	if (allCpuDataOwners.size() > 0 || bufferOwner.get())
+	{
+		vertices = 0;
+		normals = 0;
+		bitangents = 0;
+		tangents = 0;
+		texCoords = 0;
+
+		indices = 0;
+
+		boneIndices0 = 0;
+		boneIndices1 = 0;
+		boneWeights0 = 0;
+		boneWeights1 = 0;
+		boneCounters = 0;
+
+		allCpuDataOwners.clear();
+
+		return;
+	}
+
 	if (vertices)
 	{
-		delete[] vertices;
+		delete[] static_cast<float*>(vertices);
 		vertices = 0;
 	}
 	if (normals)
 	{
-		delete[] normals;
+		delete[] static_cast<float*>(normals);
 		normals = 0;
 	}
 	if (bitangents)
 	{
-		delete[] bitangents;
+		delete[] static_cast<float*>(bitangents);
 		bitangents = 0;
 	}
 	if (tangents)
 	{
-		delete[] tangents;
+		delete[] static_cast<float*>(tangents);
 		tangents = 0;
 	}
 	if (texCoords)
 	{
-		delete[] texCoords;
+		delete[] static_cast<float*>(texCoords);
 		texCoords = 0;
 	}
 
@@ -205,30 +252,80 @@ uint32_t Mesh::getNumberIndices() const
 }
 
 const float* Mesh::getVertices() const
+{
+	return vertexFormat.isFloat() ? static_cast<const float*>(vertices) : nullptr;
+}
+
+const void* Mesh::getVertexData() const
 {
 	return vertices;
 }
 
+const VertexFormat& Mesh::getVertexFormat() const
+{
+	return vertexFormat;
+}
+
 const float* Mesh::getNormals() const
+{
+	return normalFormat.isFloat() ? static_cast<const float*>(normals) : nullptr;
+}
+
+const void* Mesh::getNormalData() const
 {
 	return normals;
 }
 
+const VertexFormat& Mesh::getNormalFormat() const
+{
+	return normalFormat;
+}
+
 const float* Mesh::getBitangents() const
+{
+	return bitangentFormat.isFloat() ? static_cast<const float*>(bitangents) : nullptr;
+}
+
+const void* Mesh::getBitangentData() const
 {
 	return bitangents;
 }
 
+const VertexFormat& Mesh::getBitangentFormat() const
+{
+	return bitangentFormat;
+}
+
 const float* Mesh::getTangents() const
+{
+	return tangentFormat.isFloat() ? static_cast<const float*>(tangents) : nullptr;
+}
+
+const void* Mesh::getTangentData() const
 {
 	return tangents;
 }
 
+const VertexFormat& Mesh::getTangentFormat() const
+{
+	return tangentFormat;
+}
+
 const float* Mesh::getTexCoords() const
+{
+	return texCoordFormat.isFloat() ? static_cast<const float*>(texCoords) : nullptr;
+}
+
+const void* Mesh::getTexCoordData() const
 {
 	return texCoords;
 }
 
+const VertexFormat& Mesh::getTexCoordFormat() const
+{
+	return texCoordFormat;
+}
+
 const uint32_t* Mesh::getIndices() const
 {
 	return indices;
@@ -353,6 +450,11 @@ void Mesh::addSkinningData(float* boneIndices0, float* boneIndices1, float* bone
 	updateVAO();
 }
 
+void Mesh::setCpuDataOwners(const vector<shared_ptr<const void> >& allCpuDataOwners)
+{
+	this->allCpuDataOwners = allCpuDataOwners;
+}
+
 bool Mesh::hasSkinning() const
 {
 	return vboBoneIndices[0] != 0 && vboBoneIndices[1] != 0;
@@ -14,6 +14,7 @@
 
 #include "../../layer2/material/SurfaceMaterial.h"
 #include "SubMesh.h"
+#include "VertexFormat.h"
 
 class Mesh
 {
@@ -24,11 +25,18 @@ private:
 
 	std::uint32_t numberVertices;
 
-	float* vertices;
-	float* normals;
-	float* bitangents;
-	float* tangents;
-	float* texCoords;
+	// Floats, if not given otherwise by the formats.
+	void* vertices;
+	void* normals;
+	void* bitangents;
+	void* tangents;
+	void* texCoords;
+
+	VertexFormat vertexFormat;
+	VertexFormat normalFormat;
+	VertexFormat bitangentFormat;
+	VertexFormat tangentFormat;
+	VertexFormat texCoordFormat;
 
 	std::uint32_t numberIndices;
 
@@ -56,11 +64,29 @@ private:
 
 	std::map<std::int32_t, SurfaceMaterialSP> surfaceMaterials;
 
+	// If not empty, the CPU data is not owned by the mesh but kept alive by these, e.g. as it points into a mapped file.
+	std::vector<std::shared_ptr<const void> > allCpuDataOwners;
+
+	// If set, the buffers belong to this mesh and are only used.
+	std::shared_ptr<Mesh> bufferOwner;
+
 	void updateVAO();
 
 public:
 
 	Mesh(const std::string& name, std::uint32_t numberVertices, float* vertices, float* normals, float* bitangents, float* tangents, float* texCoords, std::uint32_t numberIndices, std::uint32_t* indices, const std::map<std::int32_t, SubMeshSP>& subMeshes, const std::map<std::int32_t, SurfaceMaterialSP>& surfaceMaterials);
+
+	/**
+	 * Mesh with attributes in the given formats, e.g. quantized. Packed data is uploaded as it is and not owned by the
+	 * mesh, so it has to be kept alive by the owners.
+	 */
+	Mesh(const std::string& name, std::uint32_t numberVertices, const void* vertices, const VertexFormat& vertexFormat, const void* normals, const VertexFormat& normalFormat, const void* bitangents, const VertexFormat& bitangentFormat, const void* tangents, const VertexFormat& tangentFormat, const void* texCoords, const VertexFormat& texCoordFormat, std::uint32_t numberIndices, const std::uint32_t* indices, const std::map<std::int32_t, SubMeshSP>& subMeshes, const std::map<std::int32_t, SurfaceMaterialSP>& surfaceMaterials, const std::vector<std::shared_ptr<const void> >& allCpuDataOwners);
+
+	/**
+	 * Mesh drawing other sub meshes of the buffers of the given mesh. Nothing is uploaded again, the sub meshes index
+	 * into the indices of the owner.
+	 */
+	Mesh(const std::string& name, const std::shared_ptr<Mesh>& bufferOwner, const std::map<std::int32_t, SubMeshSP>& subMeshes, const std::map<std::int32_t, SurfaceMaterialSP>& surfaceMaterials);
 	virtual ~Mesh();
 
 	void cleanCpuData();
@@ -68,20 +94,32 @@ public:
 	const std::string& getName() const;
 
 	std::uint32_t getNumberVertices() const;
+
+    // The float getters return null, if the attribute is packed. Then the data has to be read by its format.
     GLuint getVboVertices() const;
     const float* getVertices() const;
+    const void* getVertexData() const;
+    const VertexFormat& getVertexFormat() const;
 
     GLuint getVboNormals() const;
     const float* getNormals() const;
+    const void* getNormalData() const;
+    const VertexFormat& getNormalFormat() const;
 
     GLuint getVboBitangents() const;
     const float* getBitangents() const;
+    const void* getBitangentData() const;
+    const VertexFormat& getBitangentFormat() const;
 
     GLuint getVboTangents() const;
     const float* getTangents() const;
+    const void* getTangentData() const;
+    const VertexFormat& getTangentFormat() const;
 
     GLuint getVboTexCoords() const;
     const float* getTexCoords() const;
+    const void* getTexCoordData() const;
+    const VertexFormat& getTexCoordFormat() const;
 
     std::uint32_t getNumberIndices() const;
     GLuint getVboIndices() const;
@@ -103,6 +141,11 @@ public:
 
 	void addSkinningData(float* boneIndices0, float* boneIndices1, float* boneWeights0, float* boneWeights1, float* boneCounters);
 
+	/**
+	 * Hands the ownership of all CPU data to the given owners. The data is not deleted by the mesh anymore.
+	 */
+	void setCpuDataOwners(const std::vector<std::shared_ptr<const void> >& allCpuDataOwners);
+
 	bool hasSkinning() const;
 
 	bool hasTexCoords() const;
@@ -26,28 +26,28 @@ SubMeshVAO::~SubMeshVAO()
 void SubMeshVAO::update(const Mesh& mesh) const
 {
 	glBindBuffer(GL_ARRAY_BUFFER, mesh.getVboVertices());
-	glVertexAttribPointer(program->getAttribLocation(a_vertex), 4, GL_FLOAT, GL_FALSE, 0, 0);
+	glVertexAttribPointer(program->getAttribLocation(a_vertex), mesh.getVertexFormat().getSize(), mesh.getVertexFormat().getType(), mesh.getVertexFormat().isNormalized(), mesh.getVertexFormat().getStride(), 0);
 	glEnableVertexAttribArray(program->getAttribLocation(a_vertex));
 
 	glBindBuffer(GL_ARRAY_BUFFER, mesh.getVboNormals());
-	glVertexAttribPointer(program->getAttribLocation(a_normal), 3, GL_FLOAT, GL_FALSE, 0, 0);
+	glVertexAttribPointer(program->getAttribLocation(a_normal), mesh.getNormalFormat().getSize(), mesh.getNormalFormat().getType(), mesh.getNormalFormat().isNormalized(), mesh.getNormalFormat().getStride(), 0);
 	glEnableVertexAttribArray(program->getAttribLocation(a_normal));
 
 	if (mesh.hasTangents())
 	{
 		glBindBuffer(GL_ARRAY_BUFFER, mesh.getVboBitangents());
-		glVertexAttribPointer(program->getAttribLocation(a_bitangent), 3, GL_FLOAT, GL_FALSE, 0, 0);
+		glVertexAttribPointer(program->getAttribLocation(a_bitangent), mesh.getBitangentFormat().getSize(), mesh.getBitangentFormat().getType(), mesh.getBitangentFormat().isNormalized(), mesh.getBitangentFormat().getStride(), 0);
 		glEnableVertexAttribArray(program->getAttribLocation(a_bitangent));
 
 		glBindBuffer(GL_ARRAY_BUFFER, mesh.getVboTangents());
-		glVertexAttribPointer(program->getAttribLocation(a_tangent), 3, GL_FLOAT, GL_FALSE, 0, 0);
+		glVertexAttribPointer(program->getAttribLocation(a_tangent), mesh.getTangentFormat().getSize(), mesh.getTangentFormat().getType(), mesh.getTangentFormat().isNormalized(), mesh.getTangentFormat().getStride(), 0);
 		glEnableVertexAttribArray(program->getAttribLocation(a_tangent));
 	}
 
 	if (mesh.hasTexCoords())
 	{
 		glBindBuffer(GL_ARRAY_BUFFER, mesh.getVboTexCoords());
-		glVertexAttribPointer(program->getAttribLocation(a_texCoord), 2, GL_FLOAT, GL_FALSE, 0, 0);
+		glVertexAttribPointer(program->getAttribLocation(a_texCoord), mesh.getTexCoordFormat().getSize(), mesh.getTexCoordFormat().getType(), mesh.getTexCoordFormat().isNormalized(), mesh.getTexCoordFormat().getStride(), 0);
 		glEnableVertexAttribArray(program->getAttribLocation(a_texCoord));
 	}
 
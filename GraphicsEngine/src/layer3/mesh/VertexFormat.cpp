@@ -0,0 +1,263 @@
+/*
+ * VertexFormat.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "VertexFormat.h"
+
+using namespace std;
+
+VertexFormat::VertexFormat(int32_t size) :
+	type(GL_FLOAT), size(size), normalized(GL_FALSE), octahedral(false), stride(0)
+{
+}
+
+VertexFormat::VertexFormat(GLenum type, int32_t size, GLboolean normalized, bool octahedral, int32_t stride) :
+	type(type), size(size), normalized(normalized), octahedral(octahedral), stride(stride)
+{
+}
+
+VertexFormat::~VertexFormat()
+{
+}
+
+GLenum VertexFormat::getType() const
+{
+	return type;
+}
+
+int32_t VertexFormat::getSize() const
+{
+	return size;
+}
+
+GLboolean VertexFormat::isNormalized() const
+{
+	return normalized;
+}
+
+bool VertexFormat::isOctahedral() const
+{
+	return octahedral;
+}
+
+int32_t VertexFormat::getStride() const
+{
+	return stride;
+}
+
+bool VertexFormat::isFloat() const
+{
+	return type == GL_FLOAT && !octahedral && (stride == 0 || stride == getElementSize());
+}
+
+int32_t VertexFormat::getComponentSize() const
+{
+	switch (type)
+	{
+		case GL_BYTE:
+		case GL_UNSIGNED_BYTE:
+			return 1;
+		case GL_SHORT:
+		case GL_UNSIGNED_SHORT:
+			return 2;
+	}
+
+	return 4;
+}
+
+int32_t VertexFormat::getElementSize() const
+{
+	return getComponentSize() * size;
+}
+
+int32_t VertexFormat::getElementStride() const
+{
+	return stride != 0 ? stride : getElementSize();
+}
+
+size_t VertexFormat::getByteSize(uint32_t count) const
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	return (size_t)(count - 1) * (size_t)getElementStride() + (size_t)getElementSize();
+}
+
+static float unpackComponent(const uint8_t* component, GLenum type, GLboolean normalized)
+{
+	switch (type)
+	{
+		case GL_BYTE:
+		{
+			int8_t value = *(const int8_t*)component;
+
+			return normalized ? max((float)value / 127.0f, -1.0f) : (float)value;
+		}
+		case GL_UNSIGNED_BYTE:
+		{
+			uint8_t value = *component;
+
+			return normalized ? (float)value / 255.0f : (float)value;
+		}
+		case GL_SHORT:
+		{
+			int16_t value;
+			memcpy(&value, component, sizeof(int16_t));
+
+			return normalized ? max((float)value / 32767.0f, -1.0f) : (float)value;
+		}
+		case GL_UNSIGNED_SHORT:
+		{
+			uint16_t value;
+			memcpy(&value, component, sizeof(uint16_t));
+
+			return normalized ? (float)value / 65535.0f : (float)value;
+		}
+		case GL_UNSIGNED_INT:
+		{
+			uint32_t value;
+			memcpy(&value, component, sizeof(uint32_t));
+
+			return (float)value;
+		}
+	}
+
+	float value;
+	memcpy(&value, component, sizeof(float));
+
+	return value;
+}
+
+void VertexFormat::unpack(float* target, int32_t targetComponents, const void* source, uint32_t count) const
+{
+	const uint8_t* data = (const uint8_t*)source;
+
+	int32_t elementStride = getElementStride();
+	int32_t componentSize = getComponentSize();
+
+	float element[4];
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const uint8_t* currentElement = data + (size_t)i * (size_t)elementStride;
+
+		element[0] = 0.0f;
+		element[1] = 0.0f;
+		element[2] = 0.0f;
+		element[3] = 1.0f;
+
+		if (octahedral)
+		{
+			unpackOctahedral(element, unpackComponent(currentElement, type, normalized), unpackComponent(currentElement + componentSize, type, normalized));
+		}
+		else
+		{
+			for (int32_t k = 0; k < size && k < 4; k++)
+			{
+				element[k] = unpackComponent(currentElement + k * componentSize, type, normalized);
+			}
+		}
+
+		for (int32_t k = 0; k < targetComponents; k++)
+		{
+			target[(size_t)i * (size_t)targetComponents + k] = element[k];
+		}
+	}
+}
+
+int16_t VertexFormat::packSnorm16(float value)
+{
+	value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+
+	return (int16_t)roundf(value * 32767.0f);
+}
+
+uint16_t VertexFormat::packUnorm16(float value)
+{
+	value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+
+	return (uint16_t)roundf(value * 65535.0f);
+}
+
+int8_t VertexFormat::packSnorm8(float value)
+{
+	value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+
+	return (int8_t)roundf(value * 127.0f);
+}
+
+static void encodeOctahedral(float& x, float& y, const float* direction)
+{
+	float length = fabsf(direction[0]) + fabsf(direction[1]) + fabsf(direction[2]);
+
+	if (length == 0.0f)
+	{
+		x = 0.0f;
+		y = 0.0f;
+
+		return;
+	}
+
+	x = direction[0] / length;
+	y = direction[1] / length;
+
+	// The lower hemisphere is folded over the diagonals.
+	if (direction[2] < 0.0f)
+	{
+		float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+		x = foldedX;
+		y = foldedY;
+	}
+}
+
+void VertexFormat::packOctahedral16(int16_t* target, const float* direction)
+{
+	float x;
+	float y;
+
+	encodeOctahedral(x, y, direction);
+
+	target[0] = packSnorm16(x);
+	target[1] = packSnorm16(y);
+}
+
+void VertexFormat::packOctahedral8(int8_t* target, const float* direction)
+{
+	float x;
+	float y;
+
+	encodeOctahedral(x, y, direction);
+
+	target[0] = packSnorm8(x);
+	target[1] = packSnorm8(y);
+}
+
+void VertexFormat::unpackOctahedral(float* direction, float x, float y)
+{
+	// Same as decodeOctahedral in the shaders.
+	direction[0] = x;
+	direction[1] = y;
+	direction[2] = 1.0f - fabsf(x) - fabsf(y);
+
+	if (direction[2] < 0.0f)
+	{
+		direction[0] = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		direction[1] = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	float length = sqrtf(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+
+	if (length > 0.0f)
+	{
+		direction[0] /= length;
+		direction[1] /= length;
+		direction[2] /= length;
+	}
+}
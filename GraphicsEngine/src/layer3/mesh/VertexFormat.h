@@ -0,0 +1,92 @@
+/*
+ * VertexFormat.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef VERTEXFORMAT_H_
+#define VERTEXFORMAT_H_
+
+#include "../../UsedLibs.h"
+
+/**
+ * Layout of a vertex attribute in memory and in its VBO. Besides floats, quantized integers are supported, which are
+ * normalized to [-1, 1] or [0, 1] by OpenGL. Octahedral directions have two components and are decoded by the shader.
+ */
+class VertexFormat
+{
+
+private:
+
+	GLenum type;
+	std::int32_t size;
+	GLboolean normalized;
+	bool octahedral;
+
+	// Zero, if the elements are tightly packed.
+	std::int32_t stride;
+
+public:
+
+	/**
+	 * Tightly packed floats.
+	 */
+	VertexFormat(std::int32_t size);
+
+	VertexFormat(GLenum type, std::int32_t size, GLboolean normalized, bool octahedral, std::int32_t stride);
+
+	virtual ~VertexFormat();
+
+	GLenum getType() const;
+
+	std::int32_t getSize() const;
+
+	GLboolean isNormalized() const;
+
+	bool isOctahedral() const;
+
+	std::int32_t getStride() const;
+
+	/**
+	 * True, if the data can be accessed as tightly packed floats.
+	 */
+	bool isFloat() const;
+
+	std::int32_t getComponentSize() const;
+
+	std::int32_t getElementSize() const;
+
+	std::int32_t getElementStride() const;
+
+	/**
+	 * Bytes of the given number of elements. The padding after the last element is not included.
+	 */
+	std::size_t getByteSize(std::uint32_t count) const;
+
+	/**
+	 * Converts to tightly packed floats with the given number of components, the same way as OpenGL does. Missing
+	 * components are zero, but w is one. Octahedral directions are decoded to three components.
+	 */
+	void unpack(float* target, std::int32_t targetComponents, const void* source, std::uint32_t count) const;
+
+	//
+
+	static std::int16_t packSnorm16(float value);
+
+	static std::uint16_t packUnorm16(float value);
+
+	static std::int8_t packSnorm8(float value);
+
+	/**
+	 * Encodes a unit direction into two signed normalized components.
+	 */
+	static void packOctahedral16(std::int16_t* target, const float* direction);
+
+	static void packOctahedral8(std::int8_t* target, const float* direction);
+
+	static void unpackOctahedral(float* direction, float x, float y);
+
+};
+
+#endif /* VERTEXFORMAT_H_ */
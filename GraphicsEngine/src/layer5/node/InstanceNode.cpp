@@ -12,7 +12,7 @@
 using namespace std;
 
 InstanceNode::InstanceNode(const Node* node) :
-	node(node), visible(true), visibleActive(false), transparent(false), transparentActive(false), modelMatrix(), normalModelMatrix(), position(), rotation(), allChilds()
+	node(node), visible(true), visibleActive(false), transparent(false), transparentActive(false), dirty(true), animated(false), animatedSubtree(false), nodeMatrix(), modelMatrix(), normalModelMatrix(), normalMatrixType(NORMAL_MATRIX_RIGID), position(), rotation(), allChilds()
 {
 	name = node->getName();
 }
@@ -81,6 +81,8 @@ void InstanceNode::setVisible(bool visible, bool visibleActive)
 {
 		this->visible = visible;
 		this->visibleActive = visibleActive;
+
+		this->dirty = true;
 }
 
 void InstanceNode::setVisibleRecursive(bool visible, bool visibleActive)
@@ -88,6 +90,8 @@ void InstanceNode::setVisibleRecursive(bool visible, bool visibleActive)
 		this->visible = visible;
 		this->visibleActive = visibleActive;
 
+		this->dirty = true;
+
 		auto walkerNode = allChilds.begin();
 
 		while (walkerNode != allChilds.end())
@@ -139,12 +143,17 @@ const Matrix3x3& InstanceNode::getNormalModelMatrix() const
 	return normalModelMatrix;
 }
 
+NormalMatrixType InstanceNode::getNormalMatrixType() const
+{
+	return normalMatrixType;
+}
+
 const Point4& InstanceNode::getPosition() const
 {
 	return position;
 }
 
-const Quaternion& InstanceNode::getRotation() const
+Quaternion InstanceNode::getRotation() const
 {
 	return rotation;
 }
@@ -154,3 +163,23 @@ const Node* InstanceNode::getNode() const
 	return node;
 }
 
+bool InstanceNode::updateAnimatedRecursive(int32_t animStackIndex, int32_t animLayerIndex)
+{
+	animated = node->hasTransformAnimation(animStackIndex, animLayerIndex);
+
+	animatedSubtree = animated;
+
+	auto walkerNode = allChilds.begin();
+
+	while (walkerNode != allChilds.end())
+	{
+		if ((*walkerNode)->updateAnimatedRecursive(animStackIndex, animLayerIndex))
+		{
+			animatedSubtree = true;
+		}
+
+		walkerNode++;
+	}
+
+	return animatedSubtree;
+}
@@ -32,13 +32,25 @@ private:
 	bool transparent;
 	bool transparentActive;
 
+	bool dirty;
+
+	bool animated;
+	bool animatedSubtree;
+
+	/**
+	 * Matrix without the geometric transform, which is the parent matrix of the childs.
+	 */
+	Matrix4x4 nodeMatrix;
+
 	Matrix4x4 modelMatrix;
 
 	Matrix3x3 normalModelMatrix;
 
+	NormalMatrixType normalMatrixType;
+
 	Point4 position;
 
-	Quaternion rotation;
+	CompactQuaternion rotation;
 
 	std::vector<std::shared_ptr<InstanceNode> > allChilds;
 
@@ -72,11 +84,20 @@ public:
 	const Matrix4x4& getModelMatrix() const;
 	const Matrix3x3& getNormalModelMatrix() const;
 
+	NormalMatrixType getNormalMatrixType() const;
+
 	const Point4& getPosition() const;
-	const Quaternion& getRotation() const;
+	Quaternion getRotation() const;
 
 	const Node* getNode() const;
 
+	/**
+	 * Updates, which instance nodes are animated by the given animation.
+	 *
+	 * @return True, if this node or one of its childs is animated.
+	 */
+	bool updateAnimatedRecursive(std::int32_t animStackIndex, std::int32_t animLayerIndex);
+
 };
 
 typedef std::shared_ptr<InstanceNode> InstanceNodeSP;
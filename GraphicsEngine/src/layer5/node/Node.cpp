@@ -20,8 +20,10 @@
 
 using namespace std;
 
+StatisticCounter Node::recalculatedNodes;
+
 Node::Node(const string& name, const shared_ptr<Node>& parent, const float LclTranslation[3], const float RotationOffset[3], const float RotationPivot[3], const float PreRotation[3], const float LclRotation[3], const float PostRotation[3], const float ScalingOffset[3], const float ScalingPivot[3], const float LclScaling[3], const float GeometricTranslation[3], const float GeometricRotation[3], const float GeometricScaling[3], const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const vector<AnimationStackSP>& allAnimStacks) :
-	name(name), parentNode(parent), postTranslationMatrix(), postRotationMatrix(), postScalingMatrix(), geometricTransformMatrix(), mesh(mesh), camera(camera), light(light), visible(true), transparent(false), joint(false), jointIndex(-1), inverseBindMatrix(), allAnimStacks(allAnimStacks), allChilds()
+	name(name), parentNode(parent), postTranslationMatrix(), postRotationMatrix(), postScalingMatrix(), geometricTransformMatrix(), mesh(mesh), camera(camera), light(light), visible(true), transparent(false), joint(false), jointIndex(-1), leafJoint(false), inverseBindMatrix(), allAnimStacks(allAnimStacks), allChilds()
 {
 	this->LclTranslation[0] = LclTranslation[0];
 	this->LclTranslation[1] = LclTranslation[1];
@@ -74,7 +76,7 @@ Node::Node(const string& name, const shared_ptr<Node>& parent, const float LclTr
 }
 
 Node::Node(const string& name, const shared_ptr<Node>& parent, const float LclTranslation[3], const Matrix4x4& postTranslation, const float LclRotation[3], const Matrix4x4& postRotation, const float LclScaling[3], const Matrix4x4& postScaling, const Matrix4x4& geometricTransform, const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const std::vector<AnimationStackSP>& allAnimStacks) :
-		name(name), parentNode(parent), postTranslationMatrix(postTranslation), postRotationMatrix(postRotation), postScalingMatrix(postScaling), geometricTransformMatrix(geometricTransform), mesh(mesh), camera(camera), light(light), visible(true), transparent(false), joint(false), jointIndex(-1), inverseBindMatrix(), allAnimStacks(allAnimStacks), allChilds()
+		name(name), parentNode(parent), postTranslationMatrix(postTranslation), postRotationMatrix(postRotation), postScalingMatrix(postScaling), geometricTransformMatrix(geometricTransform), mesh(mesh), camera(camera), light(light), visible(true), transparent(false), joint(false), jointIndex(-1), leafJoint(false), inverseBindMatrix(), allAnimStacks(allAnimStacks), allChilds()
 {
 	this->LclTranslation[0] = LclTranslation[0];
 	this->LclTranslation[1] = LclTranslation[1];
@@ -142,6 +144,8 @@ int32_t Node::createJointIndex(int32_t index)
 		this->jointIndex = -1;
 	}
 
+	int32_t childStartIndex = index;
+
 	vector<NodeSP>::iterator walker = allChilds.begin();
 
 	while (walker != allChilds.end())
@@ -151,6 +155,9 @@ int32_t Node::createJointIndex(int32_t index)
 		walker++;
 	}
 
+	// No joint below this joint
+	leafJoint = joint && index == childStartIndex;
+
 	return index;
 }
 
@@ -173,54 +180,14 @@ int32_t Node::countJointIndex(int32_t index)
 	return index;
 }
 
-int32_t Node::getJointIndexRecursive(const string& name) const
-{
-	if (this->name.compare(name) == 0)
-	{
-		return jointIndex;
-	}
-
-	vector<NodeSP>::const_iterator walker = allChilds.begin();
-
-	int32_t childIndex;
-
-	while (walker != allChilds.end())
-	{
-		childIndex = (*walker)->getJointIndexRecursive(name);
-
-		if (childIndex != -1)
-		{
-			return childIndex;
-		}
-
-		walker++;
-	}
-
-	return -1;
-}
-
-void Node::setInverseBindMatrix(const std::string& jointName, const Matrix4x4& inverseBindMatrix)
+const MeshSP& Node::getMesh() const
 {
-	if (jointName.compare(name) == 0)
-	{
-		this->inverseBindMatrix = inverseBindMatrix;
-	}
-	else
-	{
-		vector<NodeSP>::iterator walker = allChilds.begin();
-
-		while (walker != allChilds.end())
-		{
-			(*walker)->setInverseBindMatrix(jointName, inverseBindMatrix);
-
-			walker++;
-		}
-	}
+	return mesh;
 }
 
-const MeshSP& Node::getMesh() const
+void Node::setMesh(const MeshSP& mesh)
 {
-	return mesh;
+	this->mesh = mesh;
 }
 
 const CameraSP& Node::getCamera() const
@@ -291,25 +258,6 @@ NodeSP Node::findChildRecursive(const string& name) const
 	return NodeSP();
 }
 
-void Node::setJoint(const std::string& jointName)
-{
-	if (jointName.compare(name) == 0)
-	{
-		joint = true;
-	}
-	else
-	{
-		vector<NodeSP>::iterator walker = allChilds.begin();
-
-		while (walker != allChilds.end())
-		{
-			(*walker)->setJoint(jointName);
-
-			walker++;
-		}
-	}
-}
-
 const NodeSP& Node::getParentNode() const
 {
 	return parentNode;
@@ -320,6 +268,16 @@ int32_t Node::getJointIndex() const
 	return jointIndex;
 }
 
+const Matrix4x4& Node::getInverseBindMatrix() const
+{
+	return inverseBindMatrix;
+}
+
+bool Node::isLeafJoint() const
+{
+	return leafJoint;
+}
+
 const std::string& Node::getName() const
 {
 	return name;
@@ -330,6 +288,24 @@ bool Node::isAnimated() const
 	return allAnimStacks.size() != 0;
 }
 
+bool Node::hasTransformAnimation(int32_t animStackIndex, int32_t animLayerIndex) const
+{
+	if (animStackIndex >= 0 && animLayerIndex >= 0 && static_cast<decltype(allAnimStacks.size())>(animStackIndex) < allAnimStacks.size() && animLayerIndex < allAnimStacks[animStackIndex]->getAnimationLayersCount())
+	{
+		const AnimationLayerSP& animLayer = allAnimStacks[animStackIndex]->getAnimationLayer(animLayerIndex);
+
+		for (enum AnimationLayer::eCHANNELS_XYZ i = AnimationLayer::X; i <= AnimationLayer::Z; i = static_cast<enum AnimationLayer::eCHANNELS_XYZ>(i + 1))
+		{
+			if (animLayer->hasTranslationValue(i) || animLayer->hasRotationValue(i) || animLayer->hasScalingValue(i))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 int32_t Node::getRootJointIndex() const
 {
 	if (joint)
@@ -416,8 +392,7 @@ void Node::updateInverseBindMatrix(Matrix4x4* allInverseBindMatrices, Matrix3x3*
 	{
 		allInverseBindMatrices[jointIndex] = inverseBindMatrix * geometricTransformMatrix;
 
-		allInverseBindNormalMatrices[jointIndex] = allInverseBindMatrices[jointIndex].extractMatrix3x3();
-		allInverseBindNormalMatrices[jointIndex].inverse();
+		allInverseBindNormalMatrices[jointIndex] = allInverseBindMatrices[jointIndex].extractNormalMatrix3x3();
 	}
 
 	vector<NodeSP>::const_iterator walker = allChilds.begin();
@@ -430,30 +405,42 @@ void Node::updateInverseBindMatrix(Matrix4x4* allInverseBindMatrices, Matrix3x3*
 	}
 }
 
-void Node::updateBindMatrix(Matrix4x4* allBindMatrices, Matrix3x3* allBindNormalMatrices, const Matrix4x4& parentMatrix, float time, int32_t animStackIndex, int32_t animLayerIndex) const
+int32_t Node::updateBindMatrix(Matrix4x4* allBindMatrices, Matrix3x3* allBindNormalMatrices, const Matrix4x4& parentMatrix, float time, int32_t animStackIndex, int32_t animLayerIndex, bool skipLeafJoints) const
 {
 	assert(allBindMatrices);
 	assert(allBindNormalMatrices);
 
-	Matrix4x4 newParentMatrix = parentMatrix;
+	int32_t animatedJoints = 0;
 
-	float currentTranslate[3] = {0.0f, 0.0f, 0.0f};
-	float currentRotate[3] = {0.0f, 0.0f, 0.0f};
-	float currentScale[3] = {1.0f, 1.0f, 1.0f};
-
-	calculateAnimation(currentTranslate, currentRotate, currentScale, time, animStackIndex, animLayerIndex);
+	Matrix4x4 newParentMatrix = parentMatrix;
 
 	Matrix4x4 jointLocalMatrix;
 
-	if (joint)
+	if (joint && leafJoint && skipLeafJoints)
 	{
-		calculateLocalMatrix(jointLocalMatrix, currentTranslate, currentRotate, currentScale);
+		// Keep the local transform and just follow the parent joint
+		calculateLocalMatrix(jointLocalMatrix);
 	}
 	else
 	{
-		jointLocalMatrix.translate(currentTranslate[0], currentTranslate[1], currentTranslate[2]);
-		jointLocalMatrix.rotateRzRyRx(currentRotate[2], currentRotate[1], currentRotate[0]);
-		jointLocalMatrix.scale(currentScale[0], currentScale[1], currentScale[2]);
+		float currentTranslate[3] = {0.0f, 0.0f, 0.0f};
+		float currentRotate[3] = {0.0f, 0.0f, 0.0f};
+		float currentScale[3] = {1.0f, 1.0f, 1.0f};
+
+		calculateAnimation(currentTranslate, currentRotate, currentScale, time, animStackIndex, animLayerIndex);
+
+		if (joint)
+		{
+			calculateLocalMatrix(jointLocalMatrix, currentTranslate, currentRotate, currentScale);
+
+			animatedJoints++;
+		}
+		else
+		{
+			jointLocalMatrix.translate(currentTranslate[0], currentTranslate[1], currentTranslate[2]);
+			jointLocalMatrix.rotateRzRyRx(currentRotate[2], currentRotate[1], currentRotate[0]);
+			jointLocalMatrix.scale(currentScale[0], currentScale[1], currentScale[2]);
+		}
 	}
 
 	newParentMatrix = parentMatrix * jointLocalMatrix;
@@ -462,48 +449,66 @@ void Node::updateBindMatrix(Matrix4x4* allBindMatrices, Matrix3x3* allBindNormal
 	{
 		allBindMatrices[jointIndex] = newParentMatrix * geometricTransformMatrix;
 
-		allBindNormalMatrices[jointIndex] = allBindMatrices[jointIndex].extractMatrix3x3();
-		allBindNormalMatrices[jointIndex].inverse();
+		allBindNormalMatrices[jointIndex] = allBindMatrices[jointIndex].extractNormalMatrix3x3();
 	}
 
 	vector<NodeSP>::const_iterator walker = allChilds.begin();
 
 	while (walker != allChilds.end())
 	{
-		(*walker)->updateBindMatrix(allBindMatrices, allBindNormalMatrices, newParentMatrix, time, animStackIndex, animLayerIndex);
+		animatedJoints += (*walker)->updateBindMatrix(allBindMatrices, allBindNormalMatrices, newParentMatrix, time, animStackIndex, animLayerIndex, skipLeafJoints);
 
 		walker++;
 	}
+
+	return animatedJoints;
 }
 
-void Node::updateRenderMatrix(const NodeOwner& nodeOwner, InstanceNode& instanceNode, const Matrix4x4& parentMatrix, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex) const
+void Node::updateRenderMatrix(const NodeOwner& nodeOwner, InstanceNode& instanceNode, const Matrix4x4& parentMatrix, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex, bool parentDirty) const
 {
 	if (joint || (instanceNode.isVisibleActive() && !instanceNode.isVisible()) || (!instanceNode.isVisibleActive() && !visible))
 	{
+		// Not updated while invisible, so recalculate as soon as visible again
+		instanceNode.dirty = true;
+
 		return;
 	}
 
-	float currentTranslate[3] = {0.0f, 0.0f, 0.0f};
-	float currentRotate[3] = {0.0f, 0.0f, 0.0f};
-	float currentScale[3] = {1.0f, 1.0f, 1.0f};
+	bool recalculate = parentDirty || instanceNode.dirty || instanceNode.animated;
 
-	calculateAnimation(currentTranslate, currentRotate, currentScale, time, animStackIndex, animLayerIndex);
+	if (!recalculate && !instanceNode.animatedSubtree)
+	{
+		return;
+	}
 
-	Matrix4x4 localMatrix;
+	if (recalculate)
+	{
+		float currentTranslate[3] = {0.0f, 0.0f, 0.0f};
+		float currentRotate[3] = {0.0f, 0.0f, 0.0f};
+		float currentScale[3] = {1.0f, 1.0f, 1.0f};
 
-	calculateLocalMatrix(localMatrix, currentTranslate, currentRotate, currentScale);
+		calculateAnimation(currentTranslate, currentRotate, currentScale, time, animStackIndex, animLayerIndex);
 
-	Matrix4x4 newParentMatrix = parentMatrix * localMatrix;
+		Matrix4x4 localMatrix;
 
-	instanceNode.modelMatrix = newParentMatrix * geometricTransformMatrix;
+		calculateLocalMatrix(localMatrix, currentTranslate, currentRotate, currentScale);
 
-	instanceNode.normalModelMatrix = instanceNode.modelMatrix.extractMatrix3x3();
-	instanceNode.normalModelMatrix.inverse();
+		instanceNode.nodeMatrix = parentMatrix * localMatrix;
 
-	//
+		instanceNode.modelMatrix = instanceNode.nodeMatrix * geometricTransformMatrix;
+
+		instanceNode.normalMatrixType = instanceNode.modelMatrix.getNormalMatrixType();
+		instanceNode.normalModelMatrix = instanceNode.modelMatrix.extractNormalMatrix3x3(instanceNode.normalMatrixType);
+
+		//
 
-	instanceNode.position = instanceNode.modelMatrix * Point4();
-	instanceNode.rotation = instanceNode.modelMatrix.extractMatrix3x3();
+		instanceNode.position = instanceNode.modelMatrix * Point4();
+		instanceNode.rotation = CompactQuaternion(instanceNode.modelMatrix.extractMatrix3x3());
+
+		instanceNode.dirty = false;
+
+		recalculatedNodes.increase();
+	}
 
 	//
 
@@ -512,7 +517,7 @@ void Node::updateRenderMatrix(const NodeOwner& nodeOwner, InstanceNode& instance
 	int32_t i = 0;
 	while (walker != allChilds.end())
 	{
-		(*walker)->updateRenderMatrix(nodeOwner, *instanceNode.getChild(i), newParentMatrix, time, animStackIndex, animLayerIndex);
+		(*walker)->updateRenderMatrix(nodeOwner, *instanceNode.getChild(i), instanceNode.nodeMatrix, time, animStackIndex, animLayerIndex, recalculate);
 
 		walker++;
 		i++;
@@ -585,23 +590,7 @@ void Node::calculateAnimation(float* currentTranslation, float* currentRotation,
 	if (animStackIndex >= 0 && animLayerIndex >= 0 && static_cast<decltype(allAnimStacks.size())>(animStackIndex) < allAnimStacks.size() && animLayerIndex < allAnimStacks[animStackIndex]->getAnimationLayersCount())
 	{
 		// Animate values depending on time
-		const AnimationLayerSP& animLayer = allAnimStacks[animStackIndex]->getAnimationLayer(animLayerIndex);
-
-		for (enum AnimationLayer::eCHANNELS_XYZ i = AnimationLayer::X; i <= AnimationLayer::Z; i = static_cast<enum AnimationLayer::eCHANNELS_XYZ>(i + 1))
-		{
-			if (currentTranslation && animLayer->hasTranslationValue(i))
-			{
-				currentTranslation[i] = animLayer->getTranslationValue(i, time);
-			}
-			if (currentRotation && animLayer->hasRotationValue(i))
-			{
-				currentRotation[i] = animLayer->getRotationValue(i, time);
-			}
-			if (currentScaling && animLayer->hasScalingValue(i))
-			{
-				currentScaling[i] = animLayer->getScalingValue(i, time);
-			}
-		}
+		allAnimStacks[animStackIndex]->getAnimationLayer(animLayerIndex)->getTransformValues(currentTranslation, currentRotation, currentScaling, time);
 	}
 }
 
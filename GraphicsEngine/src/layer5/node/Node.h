@@ -12,6 +12,7 @@
 
 #include "../../layer0/math/Matrix3x3.h"
 #include "../../layer0/math/Matrix4x4.h"
+#include "../../layer0/statistic/StatisticCounter.h"
 #include "../../layer3/animation/AnimationStack.h"
 #include "../../layer3/camera/Camera.h"
 #include "../../layer3/light/Light.h"
@@ -66,6 +67,8 @@ private:
 
 	std::int32_t jointIndex;
 
+	bool leafJoint;
+
 	Matrix4x4 inverseBindMatrix;
 
 	//
@@ -78,25 +81,27 @@ private:
 
 	//
 
-	void setJoint(const std::string& jointName);
-
 	std::int32_t createJointIndex(std::int32_t index);
 
 	std::int32_t countJointIndex(std::int32_t index);
 
-	void setInverseBindMatrix(const std::string& jointName, const Matrix4x4& inverseBindMatrix);
-
 	//
 
 	void addChild(const std::shared_ptr<Node>& child);
 
 public:
 
+	/**
+	 * Number of instance nodes, which have been recalculated per frame.
+	 */
+	static StatisticCounter recalculatedNodes;
+
 	Node(const std::string& name, const std::shared_ptr<Node>& parent, const float LclTranslation[3], const float RotationOffset[3], const float RotationPivot[3], const float PreRotation[3], const float LclRotation[3], const float PostRotation[3], const float ScalingOffset[3], const float ScalingPivot[3], const float LclScaling[3], const float GeometricTranslation[3], const float GeometricRotation[3], const float GeometricScaling[3], const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const std::vector<AnimationStackSP>& allAnimStacks);
 	Node(const std::string& name, const std::shared_ptr<Node>& parent, const float LclTranslation[3], const Matrix4x4& postTranslation, const float LclRotation[3], const Matrix4x4& postRotation, const float LclScaling[3], const Matrix4x4& postScaling, const Matrix4x4& geometricTransform, const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const std::vector<AnimationStackSP>& allAnimStacks);
 	virtual ~Node();
 
 	const MeshSP& getMesh() const;
+	void setMesh(const MeshSP& mesh);
 
 	const CameraSP& getCamera() const;
 
@@ -111,21 +116,38 @@ public:
 	const std::shared_ptr<Node>& getParentNode() const;
 
 	std::int32_t getJointIndex() const;
-	std::int32_t getJointIndexRecursive(const std::string& name) const;
+	bool isLeafJoint() const;
+
+	/**
+	 * The inverse bind matrix as set by the factory, without the geometric transform.
+	 */
+	const Matrix4x4& getInverseBindMatrix() const;
 
 	const std::string& getName() const;
 
 	bool isAnimated() const;
 
+	/**
+	 * @return True, if the translation, rotation or scaling of this node has keys in the given animation.
+	 */
+	bool hasTransformAnimation(std::int32_t animStackIndex, std::int32_t animLayerIndex) const;
+
 	std::int32_t getRootJointIndex() const;
 
 	bool updateBoundingSphereMatrix(Matrix4x4& matrix, const Matrix4x4& parentMatrix, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex) const;
 
 	void updateInverseBindMatrix(Matrix4x4* allInverseBindMatrices, Matrix3x3* allInverseBindNormalMatrices) const;
 
-	void updateBindMatrix(Matrix4x4* allBindMatrices, Matrix3x3* allBindNormalMatrices, const Matrix4x4& parentMatrix, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex) const;
+	/**
+	 * @param skipLeafJoints If true, joints without child joints are not animated.
+	 * @return Number of joints, which have been animated.
+	 */
+	std::int32_t updateBindMatrix(Matrix4x4* allBindMatrices, Matrix3x3* allBindNormalMatrices, const Matrix4x4& parentMatrix, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex, bool skipLeafJoints = false) const;
 
-	void updateRenderMatrix(const NodeOwner& nodeOwner, InstanceNode& instanceNode, const Matrix4x4& parentMatrix, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex) const;
+	/**
+	 * @param parentDirty If false, only animated or dirty instance nodes and their children are recalculated.
+	 */
+	void updateRenderMatrix(const NodeOwner& nodeOwner, InstanceNode& instanceNode, const Matrix4x4& parentMatrix, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex, bool parentDirty = true) const;
 
 	void render(const NodeOwner& nodeOwner, const InstanceNode& instanceNode, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex) const;
 
@@ -9,7 +9,7 @@
 
 using namespace std;
 
-NodeTreeFactory::NodeTreeFactory() : rootNode()
+NodeTreeFactory::NodeTreeFactory() : rootNode(), allNodesByName()
 {
 }
 
@@ -17,32 +17,13 @@ NodeTreeFactory::~NodeTreeFactory()
 {
 }
 
-NodeSP NodeTreeFactory::findNode(const string& name, const NodeSP& node) const
+NodeSP NodeTreeFactory::findNode(const string& name) const
 {
-	if (!node.get())
-	{
-		return NodeSP();
-	}
+	auto result = allNodesByName.find(name);
 
-	if (name.compare(node->getName()) == 0)
-	{
-		return node;
-	}
-	else
+	if (result != allNodesByName.end())
 	{
-		auto walker = node->allChilds.begin();
-
-		while (walker != node->allChilds.end())
-		{
-			NodeSP foundNode = findNode(name, *walker);
-
-			if (foundNode.get())
-			{
-				return foundNode;
-			}
-
-			walker++;
-		}
+		return result->second;
 	}
 
 	return NodeSP();
@@ -50,6 +31,8 @@ NodeSP NodeTreeFactory::findNode(const string& name, const NodeSP& node) const
 
 void NodeTreeFactory::reset()
 {
+	allNodesByName.clear();
+
 	if (rootNode.get())
 	{
 		rootNode.reset();
@@ -61,6 +44,11 @@ NodeSP NodeTreeFactory::getRootNode() const
 	return rootNode;
 }
 
+NodeSP NodeTreeFactory::getNode(const string& name) const
+{
+	return findNode(name);
+}
+
 NodeSP NodeTreeFactory::createNode(const string& nodeName, const string& parentNodeName, const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const vector<AnimationStackSP>& allAnimStacks)
 {
 	float translate[3] = {0.0f, 0.0f, 0.0f};
@@ -81,7 +69,7 @@ NodeSP NodeTreeFactory::createNode(const string& nodeName, const string& parentN
 
 NodeSP NodeTreeFactory::createNode(const string& nodeName, const string& parentNodeName, const float translate[3], const float rotateOffset[3], const float rotatePivot[3], const float preRotate[3], const float rotate[3], const float postRotate[3], const float scaleOffset[3], const float scalePivot[3], const float scale[3], const float geoTranslate[3], const float geoRotate[3], const float geoScale[3], const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const vector<AnimationStackSP>& allAnimStacks)
 {
-	NodeSP parentNode = findNode(parentNodeName, rootNode);
+	NodeSP parentNode = findNode(parentNodeName);
 
 	NodeSP node = NodeSP(new Node(nodeName, parentNode, translate, rotateOffset, rotatePivot, preRotate, rotate, postRotate, scaleOffset, scalePivot, scale, geoTranslate, geoRotate, geoScale, mesh, camera, light, allAnimStacks));
 
@@ -94,12 +82,14 @@ NodeSP NodeTreeFactory::createNode(const string& nodeName, const string& parentN
 		rootNode = node;
 	}
 
+	allNodesByName.insert(make_pair(nodeName, node));
+
 	return node;
 }
 
 NodeSP NodeTreeFactory::createNode(const string& nodeName, const string& parentNodeName, const float translate[3], const Matrix4x4& postTranslation, const float rotate[3], const Matrix4x4& postRotation, const float scale[3], const Matrix4x4& postScaling, const Matrix4x4& geometricTransform, const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const vector<AnimationStackSP>& allAnimStacks)
 {
-	NodeSP parentNode = findNode(parentNodeName, rootNode);
+	NodeSP parentNode = findNode(parentNodeName);
 
 	NodeSP node = NodeSP(new Node(nodeName, parentNode, translate, postTranslation, rotate, postRotation, scale, postScaling, geometricTransform, mesh, camera, light, allAnimStacks));
 
@@ -112,6 +102,8 @@ NodeSP NodeTreeFactory::createNode(const string& nodeName, const string& parentN
 		rootNode = node;
 	}
 
+	allNodesByName.insert(make_pair(nodeName, node));
+
 	return node;
 }
 
@@ -127,24 +119,26 @@ int32_t NodeTreeFactory::createIndex() const
 
 int32_t NodeTreeFactory::getIndex(const string& name) const
 {
-	if (rootNode.get())
+	NodeSP node = findNode(name);
+
+	if (!node.get())
 	{
-		return rootNode->getJointIndexRecursive(name);
+		return -1;
 	}
 
-	return -1;
+	return node->jointIndex;
 }
 
 bool NodeTreeFactory::setInverseBindMatrix(const string& jointName, const Matrix4x4& inverseBindMatrix) const
 {
-	NodeSP node = findNode(jointName, rootNode);
+	NodeSP node = findNode(jointName);
 
 	if (!node.get())
 	{
 		return false;
 	}
 
-	node->setInverseBindMatrix(jointName, inverseBindMatrix);
+	node->inverseBindMatrix = inverseBindMatrix;
 
 	return true;
 }
@@ -163,14 +157,14 @@ bool NodeTreeFactory::addChild(const NodeSP& parentNode, const NodeSP& child) co
 
 bool NodeTreeFactory::setJoint(const string& jointName) const
 {
-	NodeSP node = findNode(jointName, rootNode);
+	NodeSP node = findNode(jointName);
 
 	if (!node.get())
 	{
 		return false;
 	}
 
-	node->setJoint(jointName);
+	node->joint = true;
 
 	return true;
 }
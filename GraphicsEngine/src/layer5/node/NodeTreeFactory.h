@@ -8,6 +8,8 @@
 #ifndef NODETREEFACTORY_H_
 #define NODETREEFACTORY_H_
 
+#include <unordered_map>
+
 #include "../../UsedLibs.h"
 
 #include "../../layer3/animation/AnimationStack.h"
@@ -23,7 +25,12 @@ private:
 
 	NodeSP rootNode;
 
-	NodeSP findNode(const std::string& name, const NodeSP& node) const;
+	/**
+	 * Name index of all created nodes. If names are not unique, the first created node is used.
+	 */
+	std::unordered_map<std::string, NodeSP> allNodesByName;
+
+	NodeSP findNode(const std::string& name) const;
 
 	bool addChild(const std::shared_ptr<Node>& parentNode, const std::shared_ptr<Node>& child) const;
 
@@ -35,6 +42,8 @@ public:
 
 	NodeSP getRootNode() const;
 
+	NodeSP getNode(const std::string& name) const;
+
 	NodeSP createNode(const std::string& nodeName, const std::string& parentNodeName, const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const std::vector<AnimationStackSP>& allAnimStacks);
 
 	NodeSP createNode(const std::string& nodeName, const std::string& parentNodeName, const float translate[3], const float rotateOffset[3], const float rotatePivot[3], const float preRotate[3], const float rotate[3], const float postRotate[3], const float scaleOffset[3], const float scalePivot[3], const float scale[3], const float geoTranslate[3], const float geoRotate[3], const float geoScale[3], const MeshSP& mesh, const CameraSP& camera, const LightSP& light, const std::vector<AnimationStackSP>& allAnimStacks);
@@ -10,13 +10,15 @@
 using namespace std;
 
 Model::Model(const BoundingSphere& boundingSphere, const NodeSP& node, int32_t numberJoints, bool animationData, bool skinned) :
-	boundingSphere(boundingSphere), rootNode(node), numberJoints(numberJoints), animated(animationData), skinned(skinned), allNodesByName(), allSurfaceMaterialsByName()
+	boundingSphere(boundingSphere), rootNode(node), numberJoints(numberJoints), animated(animationData), skinned(skinned), animationLevelOfDetail(), poseCache(), allNodesByName(), allSurfaceMaterialsByName()
 {
 	updateSurfaceMaterialsRecursive(rootNode);
 }
 
 Model::~Model()
 {
+	poseCache.clear();
+
 	allNodesByName.clear();
 	allSurfaceMaterialsByName.clear();
 
@@ -48,6 +50,21 @@ bool Model::isSkinned() const
 	return skinned;
 }
 
+const AnimationLevelOfDetail& Model::getAnimationLevelOfDetail() const
+{
+	return animationLevelOfDetail;
+}
+
+void Model::setAnimationLevelOfDetail(const AnimationLevelOfDetail& animationLevelOfDetail)
+{
+	this->animationLevelOfDetail = animationLevelOfDetail;
+}
+
+PoseCache& Model::getPoseCache()
+{
+	return poseCache;
+}
+
 void Model::updateSurfaceMaterialsRecursive(const NodeSP& node)
 {
 	if (node.get())
@@ -90,6 +107,30 @@ SurfaceMaterialSP Model::findSurfaceMaterial(const string& name) const
 	return SurfaceMaterialSP();
 }
 
+NodeSP Model::findNode(const string& name) const
+{
+	auto result = allNodesByName.find(name);
+
+	if (result != allNodesByName.end())
+	{
+		return result->second;
+	}
+
+	return NodeSP();
+}
+
+int32_t Model::getJointIndex(const string& name) const
+{
+	auto result = allNodesByName.find(name);
+
+	if (result != allNodesByName.end())
+	{
+		return result->second->getJointIndex();
+	}
+
+	return -1;
+}
+
 int32_t Model::getNodeCount() const
 {
 	return static_cast<int32_t>(allNodesByName.size());
@@ -14,7 +14,9 @@
 #include "../../layer0/math/Matrix3x3.h"
 #include "../../layer1/collision/BoundingSphere.h"
 #include "../../layer2/material/SurfaceMaterial.h"
+#include "../../layer3/animation/AnimationLevelOfDetail.h"
 #include "../../layer5/node/Node.h"
+#include "PoseCache.h"
 
 class Model
 {
@@ -28,6 +30,10 @@ private:
 	bool animated;
 	bool skinned;
 
+	AnimationLevelOfDetail animationLevelOfDetail;
+
+	PoseCache poseCache;
+
 	std::map<std::string, NodeSP> allNodesByName;
 	std::map<std::string, SurfaceMaterialSP> allSurfaceMaterialsByName;
 
@@ -48,8 +54,24 @@ public:
 
 	bool isSkinned() const;
 
+	const AnimationLevelOfDetail& getAnimationLevelOfDetail() const;
+
+	void setAnimationLevelOfDetail(const AnimationLevelOfDetail& animationLevelOfDetail);
+
+	PoseCache& getPoseCache();
+
 	SurfaceMaterialSP findSurfaceMaterial(const std::string& name) const;
 
+	/**
+	 * Looks up the node by the name index of the model instead of traversing the node tree.
+	 */
+	NodeSP findNode(const std::string& name) const;
+
+	/**
+	 * @return The joint index of the node or -1, if the node is not a joint.
+	 */
+	std::int32_t getJointIndex(const std::string& name) const;
+
 	std::int32_t getNodeCount() const;
 
 	NodeSP getNodeAt(std::int32_t index) const;
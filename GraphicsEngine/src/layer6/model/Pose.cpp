@@ -0,0 +1,39 @@
+/*
+ * Pose.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "Pose.h"
+
+using namespace std;
+
+Pose::Pose(int32_t numberJoints) :
+		bindMatrices(numberJoints > 0 ? numberJoints : 1), bindNormalMatrices(numberJoints > 0 ? numberJoints : 1), skinningPalette(), calculated()
+{
+}
+
+Pose::~Pose()
+{
+}
+
+int32_t Pose::getNumberJoints() const
+{
+	return static_cast<int32_t>(bindMatrices.size());
+}
+
+const Matrix4x4* Pose::getBindMatrices() const
+{
+	return &bindMatrices[0];
+}
+
+const Matrix3x3* Pose::getBindNormalMatrices() const
+{
+	return &bindNormalMatrices[0];
+}
+
+const SkinningPalette& Pose::getSkinningPalette() const
+{
+	return skinningPalette;
+}
@@ -0,0 +1,51 @@
+/*
+ * Pose.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef POSE_H_
+#define POSE_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix3x3.h"
+#include "../../layer0/math/Matrix4x4.h"
+#include "SkinningPalette.h"
+
+/**
+ * Skinning palette of a model at one point in time.
+ */
+class Pose
+{
+
+	friend class PoseCache;
+
+private:
+
+	std::vector<Matrix4x4> bindMatrices;
+	std::vector<Matrix3x3> bindNormalMatrices;
+
+	SkinningPalette skinningPalette;
+
+	std::once_flag calculated;
+
+public:
+
+	Pose(std::int32_t numberJoints);
+	virtual ~Pose();
+
+	std::int32_t getNumberJoints() const;
+
+	const Matrix4x4* getBindMatrices() const;
+
+	const Matrix3x3* getBindNormalMatrices() const;
+
+	const SkinningPalette& getSkinningPalette() const;
+
+};
+
+typedef std::shared_ptr<Pose> PoseSP;
+
+#endif /* POSE_H_ */
@@ -0,0 +1,110 @@
+/*
+ * PoseCache.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "PoseCache.h"
+
+using namespace std;
+
+StatisticCounter PoseCache::hits;
+StatisticCounter PoseCache::misses;
+
+float PoseCache::getLastHitRate()
+{
+	int32_t lookups = hits.getLastValue() + misses.getLastValue();
+
+	if (lookups == 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(hits.getLastValue()) / static_cast<float>(lookups);
+}
+
+PoseCache::PoseCache() :
+		timeStep(0.0f), allPoses(), cacheMutex()
+{
+}
+
+PoseCache::~PoseCache()
+{
+	clear();
+}
+
+bool PoseCache::isEnabled() const
+{
+	return timeStep > 0.0f;
+}
+
+float PoseCache::getTimeStep() const
+{
+	return timeStep;
+}
+
+void PoseCache::setTimeStep(float timeStep)
+{
+	clear();
+
+	this->timeStep = timeStep;
+}
+
+PoseSP PoseCache::getPose(const Node& rootNode, const Matrix4x4* inverseBindMatrices, const Matrix3x3* inverseBindNormalMatrices, int32_t numberJoints, float time, int32_t animStackIndex, int32_t animLayerIndex, int32_t& animatedJoints)
+{
+	assert(isEnabled());
+
+	animatedJoints = 0;
+
+	int32_t timeIndex = static_cast<int32_t>(floorf(time / timeStep));
+
+	auto key = make_tuple(animStackIndex, animLayerIndex, timeIndex);
+
+	PoseSP pose;
+
+	{
+		lock_guard<mutex> cacheLock(cacheMutex);
+
+		auto result = allPoses.find(key);
+
+		if (result != allPoses.end())
+		{
+			pose = result->second;
+
+			hits.increase();
+		}
+		else
+		{
+			pose = PoseSP(new Pose(numberJoints));
+
+			allPoses[key] = pose;
+
+			misses.increase();
+		}
+	}
+
+	// Calculate outside of the cache lock, so different poses can be calculated in parallel
+	call_once(pose->calculated, [&]()
+	{
+		animatedJoints = rootNode.updateBindMatrix(&pose->bindMatrices[0], &pose->bindNormalMatrices[0], Matrix4x4(), static_cast<float>(timeIndex) * timeStep, animStackIndex, animLayerIndex);
+
+		pose->skinningPalette.build(&pose->bindMatrices[0], &pose->bindNormalMatrices[0], inverseBindMatrices, inverseBindNormalMatrices, numberJoints);
+	});
+
+	return pose;
+}
+
+int32_t PoseCache::getPoseCount()
+{
+	lock_guard<mutex> cacheLock(cacheMutex);
+
+	return static_cast<int32_t>(allPoses.size());
+}
+
+void PoseCache::clear()
+{
+	lock_guard<mutex> cacheLock(cacheMutex);
+
+	allPoses.clear();
+}
@@ -0,0 +1,72 @@
+/*
+ * PoseCache.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef POSECACHE_H_
+#define POSECACHE_H_
+
+#include <tuple>
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/statistic/StatisticCounter.h"
+#include "../../layer5/node/Node.h"
+#include "Pose.h"
+
+/**
+ * Shares the skinning palettes of all instances of a model, which play the same animation at the same quantised time.
+ * A pose only depends on the animation stack, layer and time, so the poses stay valid until the cache is cleared.
+ */
+class PoseCache
+{
+
+private:
+
+	float timeStep;
+
+	std::map<std::tuple<std::int32_t, std::int32_t, std::int32_t>, PoseSP> allPoses;
+
+	std::mutex cacheMutex;
+
+public:
+
+	static StatisticCounter hits;
+	static StatisticCounter misses;
+
+	/**
+	 * @return Hits divided by all lookups of the last frame.
+	 */
+	static float getLastHitRate();
+
+	PoseCache();
+	virtual ~PoseCache();
+
+	/**
+	 * @return True, if the time step is greater than zero.
+	 */
+	bool isEnabled() const;
+
+	float getTimeStep() const;
+
+	/**
+	 * Setting a new time step clears the cache. Zero disables the cache.
+	 */
+	void setTimeStep(float timeStep);
+
+	/**
+	 * Thread safe. The first caller for a key calculates the pose and its skinning palette, all others wait for it.
+	 *
+	 * @param animatedJoints Number of joints, which have been animated by this call.
+	 */
+	PoseSP getPose(const Node& rootNode, const Matrix4x4* inverseBindMatrices, const Matrix3x3* inverseBindNormalMatrices, std::int32_t numberJoints, float time, std::int32_t animStackIndex, std::int32_t animLayerIndex, std::int32_t& animatedJoints);
+
+	std::int32_t getPoseCount();
+
+	void clear();
+
+};
+
+#endif /* POSECACHE_H_ */
@@ -0,0 +1,142 @@
+/*
+ * SkinningPalette.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "../../layer0/math/SimdMath.h"
+
+#include "SkinningPalette.h"
+
+using namespace std;
+
+SkinningPalette::SkinningPalette() :
+		data(), numberJoints(0), bufferName(0), textureName(0), bufferJoints(0), uploaded(false)
+{
+}
+
+SkinningPalette::~SkinningPalette()
+{
+	if (textureName)
+	{
+		glDeleteTextures(1, &textureName);
+
+		textureName = 0;
+	}
+
+	if (bufferName)
+	{
+		glDeleteBuffers(1, &bufferName);
+
+		bufferName = 0;
+	}
+}
+
+void SkinningPalette::build(const Matrix4x4* bindMatrices, const Matrix3x3* bindNormalMatrices, const Matrix4x4* inverseBindMatrices, const Matrix3x3* inverseBindNormalMatrices, int32_t numberJoints)
+{
+	assert(bindMatrices);
+	assert(bindNormalMatrices);
+	assert(inverseBindMatrices);
+	assert(inverseBindNormalMatrices);
+
+	this->numberJoints = numberJoints > 0 ? numberJoints : 0;
+
+	data.resize(this->numberJoints * FLOATS_PER_JOINT);
+
+	for (int32_t jointIndex = 0; jointIndex < this->numberJoints; jointIndex++)
+	{
+		float* currentData = &data[jointIndex * FLOATS_PER_JOINT];
+
+		simdMatrix4x4Multiplyf(currentData, bindMatrices[jointIndex].getM(), inverseBindMatrices[jointIndex].getM());
+
+		// Both normal matrices are the inverse, so the transposed product of the inverse bind and bind one is needed
+		Matrix3x3 normalMatrix = inverseBindNormalMatrices[jointIndex] * bindNormalMatrices[jointIndex];
+		normalMatrix.transpose();
+
+		for (int32_t column = 0; column < 3; column++)
+		{
+			currentData[16 + column * 4 + 0] = normalMatrix.getM(column * 3 + 0);
+			currentData[16 + column * 4 + 1] = normalMatrix.getM(column * 3 + 1);
+			currentData[16 + column * 4 + 2] = normalMatrix.getM(column * 3 + 2);
+			currentData[16 + column * 4 + 3] = 0.0f;
+		}
+	}
+
+	uploaded = false;
+}
+
+void SkinningPalette::upload() const
+{
+	if (uploaded || numberJoints == 0)
+	{
+		return;
+	}
+
+	if (!bufferName)
+	{
+		glGenBuffers(1, &bufferName);
+		glGenTextures(1, &textureName);
+	}
+
+	glBindBuffer(GL_TEXTURE_BUFFER, bufferName);
+
+	if (numberJoints > bufferJoints)
+	{
+		glBufferData(GL_TEXTURE_BUFFER, getByteSize(), &data[0], GL_STREAM_DRAW);
+
+		bufferJoints = numberJoints;
+
+		glBindTexture(GL_TEXTURE_BUFFER, textureName);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, bufferName);
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+	}
+	else
+	{
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, getByteSize(), &data[0]);
+	}
+
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	uploaded = true;
+}
+
+int32_t SkinningPalette::getNumberJoints() const
+{
+	return numberJoints;
+}
+
+int32_t SkinningPalette::getTexelOffset(int32_t jointIndex)
+{
+	return jointIndex * TEXELS_PER_JOINT;
+}
+
+GLsizeiptr SkinningPalette::getByteSize() const
+{
+	return static_cast<GLsizeiptr>(numberJoints) * FLOATS_PER_JOINT * sizeof(float);
+}
+
+const float* SkinningPalette::getData() const
+{
+	if (data.size() == 0)
+	{
+		return nullptr;
+	}
+
+	return &data[0];
+}
+
+bool SkinningPalette::isUploaded() const
+{
+	return uploaded;
+}
+
+GLuint SkinningPalette::getBufferName() const
+{
+	return bufferName;
+}
+
+GLuint SkinningPalette::getTextureName() const
+{
+	return textureName;
+}
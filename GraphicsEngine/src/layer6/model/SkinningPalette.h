@@ -0,0 +1,80 @@
+/*
+ * SkinningPalette.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef SKINNINGPALETTE_H_
+#define SKINNINGPALETTE_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/math/Matrix3x3.h"
+#include "../../layer0/math/Matrix4x4.h"
+
+/**
+ * Contiguous skinning matrices of all joints, stored in a texture buffer.
+ * Each joint uses seven RGBA32F texels: The four columns of bind matrix times inverse bind matrix
+ * and the three columns of the matching normal matrix.
+ * There is no limit of the number of joints.
+ */
+class SkinningPalette
+{
+
+public:
+
+	static const std::int32_t TEXELS_PER_JOINT = 7;
+	static const std::int32_t FLOATS_PER_JOINT = TEXELS_PER_JOINT * 4;
+
+private:
+
+	std::vector<float> data;
+
+	std::int32_t numberJoints;
+
+	mutable GLuint bufferName;
+	mutable GLuint textureName;
+
+	mutable std::int32_t bufferJoints;
+
+	mutable bool uploaded;
+
+public:
+
+	SkinningPalette();
+	virtual ~SkinningPalette();
+
+	/**
+	 * Calculates the palette on the CPU. Does not call OpenGL, so it can be executed by a worker.
+	 */
+	void build(const Matrix4x4* bindMatrices, const Matrix3x3* bindNormalMatrices, const Matrix4x4* inverseBindMatrices, const Matrix3x3* inverseBindNormalMatrices, std::int32_t numberJoints);
+
+	/**
+	 * Uploads the palette, if it did change since the last upload. Has to be called from the OpenGL thread.
+	 */
+	void upload() const;
+
+	std::int32_t getNumberJoints() const;
+
+	/**
+	 * @return The first texel of the given joint, as fetched by the shader.
+	 */
+	static std::int32_t getTexelOffset(std::int32_t jointIndex);
+
+	/**
+	 * @return The number of bytes, which are uploaded to the texture buffer.
+	 */
+	GLsizeiptr getByteSize() const;
+
+	const float* getData() const;
+
+	bool isUploaded() const;
+
+	GLuint getBufferName() const;
+
+	GLuint getTextureName() const;
+
+};
+
+#endif /* SKINNINGPALETTE_H_ */
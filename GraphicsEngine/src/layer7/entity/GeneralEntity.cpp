@@ -20,7 +20,7 @@ void GeneralEntity::setCurrentValues(const string& currentProgramType, const Cam
 }
 
 GeneralEntity::GeneralEntity(const string& name, float scaleX, float scaleY, float scaleZ) : OctreeEntity(),
-		position(), rotation(), scaleX(scaleX), scaleY(scaleY), scaleZ(scaleZ), modelMatrix(), normalModelMatrix(), updateNormalModelMatrix(true), wireframe(false), debug(false), debugAsMesh(false), boundingSphere(), usePositionAsBoundingSphereCenter(false), updateable(false), name(name), writeBrightColor(false), brightColorLimit(1.0f), refractiveIndex(RI_AIR)
+		position(), rotation(), scaleX(scaleX), scaleY(scaleY), scaleZ(scaleZ), modelMatrix(), normalModelMatrix(), normalMatrixType(NORMAL_MATRIX_RIGID), updateNormalModelMatrix(true), wireframe(false), debug(false), debugAsMesh(false), boundingSphere(), usePositionAsBoundingSphereCenter(false), updateable(false), name(name), writeBrightColor(false), brightColorLimit(1.0f), refractiveIndex(RI_AIR)
 {
 }
 
@@ -37,8 +37,25 @@ void GeneralEntity::updateMetrics()
 
 	if (updateNormalModelMatrix)
 	{
-		normalModelMatrix = modelMatrix.extractMatrix3x3();
-		normalModelMatrix.inverse();
+		// The model matrix is built from translation, rotation and scale, so it is never sheared.
+		if (scaleX == 0.0f || scaleY == 0.0f || scaleZ == 0.0f)
+		{
+			normalMatrixType = NORMAL_MATRIX_SHEAR;
+		}
+		else if (scaleX != scaleY || scaleX != scaleZ)
+		{
+			normalMatrixType = NORMAL_MATRIX_NON_UNIFORM_SCALE;
+		}
+		else if (scaleX != 1.0f)
+		{
+			normalMatrixType = NORMAL_MATRIX_UNIFORM_SCALE;
+		}
+		else
+		{
+			normalMatrixType = NORMAL_MATRIX_RIGID;
+		}
+
+		normalModelMatrix = modelMatrix.extractNormalMatrix3x3(normalMatrixType);
 
 		updateNormalModelMatrix = false;
 	}
@@ -87,7 +104,7 @@ void GeneralEntity::setPosition(const Point4& position)
 
 void GeneralEntity::setRotation(float angleX, float angleY, float angleZ)
 {
-	Quaternion rotation;
+	CompactQuaternion rotation;
 	rotation.rotateRzRyRxf(angleZ, angleY, angleX);
 
 	this->rotation = rotation;
@@ -127,7 +144,7 @@ float GeneralEntity::getScaleZ() const
 
 void GeneralEntity::setRotation(const Quaternion& rotation)
 {
-	this->rotation = rotation;
+	this->rotation = rotation.getCompactQuaternion();
 
 	this->updateNormalModelMatrix = true;
 
@@ -154,6 +171,11 @@ const Matrix3x3& GeneralEntity::getNormalModelMatrix() const
 	return normalModelMatrix;
 }
 
+NormalMatrixType GeneralEntity::getNormalMatrixType() const
+{
+	return normalMatrixType;
+}
+
 bool GeneralEntity::isWireframe() const
 {
 	return wireframe;
@@ -204,7 +226,7 @@ const string& GeneralEntity::getName() const
 void GeneralEntity::setPositionRotation(const Point4& position, const Quaternion& rotation)
 {
 	this->position = position;
-	this->rotation = rotation;
+	this->rotation = rotation.getCompactQuaternion();
 
 	this->updateNormalModelMatrix = true;
 
@@ -12,6 +12,7 @@
 
 #include "../../layer0/math/Point4.h"
 #include "../../layer0/math/Matrix3x3.h"
+#include "../../layer0/math/Quaternion.h"
 #include "../../layer1/collision/BoundingSphere.h"
 #include "../../layer2/material/RefractiveIndices.h"
 #include "../../layer6/octree/OctreeEntity.h"
@@ -23,7 +24,7 @@ private:
 
 		Point4 position;
 
-		Quaternion rotation;
+		CompactQuaternion rotation;
 
 		float scaleX;
 		float scaleY;
@@ -31,6 +32,7 @@ private:
 
 		Matrix4x4 modelMatrix;
 		Matrix3x3 normalModelMatrix;
+		NormalMatrixType normalMatrixType;
 		bool updateNormalModelMatrix;
 
 		bool wireframe;
@@ -93,6 +95,8 @@ public:
 
 	const Matrix3x3& getNormalModelMatrix() const;
 
+	NormalMatrixType getNormalMatrixType() const;
+
 	bool isWireframe() const;
 
 	void setWireframe(bool wireframe);
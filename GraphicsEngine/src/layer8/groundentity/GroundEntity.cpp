@@ -222,11 +222,10 @@ void GroundEntity::render() const
 	// No Skinning
 	glUniform1i(currentProgram->getUniformLocation(u_hasSkinning), 0);
 
-	glUniformMatrix4fv(currentProgram->getUniformLocation(u_bindMatrix), 0, GL_FALSE, Matrix4x4().getM());
-	glUniformMatrix3fv(currentProgram->getUniformLocation(u_bindNormalMatrix), 0, GL_TRUE, Matrix3x3().getM());
-
-	glUniformMatrix4fv(currentProgram->getUniformLocation(u_inverseBindMatrix), 0, GL_FALSE, Matrix4x4().getM());
-	glUniformMatrix3fv(currentProgram->getUniformLocation(u_inverseBindNormalMatrix), 0, GL_TRUE, Matrix3x3().getM());
+	glActiveTexture(GL_TEXTURE9);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	glUniform1i(currentProgram->getUniformLocation(u_skinningPalette), 9);
+	glActiveTexture(GL_TEXTURE0);
 
 	// Write bright color
 	glUniform1i(currentProgram->getUniformLocation(u_writeBrightColor), writeBrightColor);
@@ -19,6 +19,40 @@
 
 using namespace std;
 
+int32_t ModelEntity::nextAnimationFrameOffset = 0;
+
+StatisticCounter ModelEntity::animatedJoints;
+
+const Matrix4x4* ModelEntity::getCurrentBindMatrices() const
+{
+	if (sharedPose.get())
+	{
+		return sharedPose->getBindMatrices();
+	}
+
+	return &bindMatrices[0];
+}
+
+const Matrix3x3* ModelEntity::getCurrentBindNormalMatrices() const
+{
+	if (sharedPose.get())
+	{
+		return sharedPose->getBindNormalMatrices();
+	}
+
+	return &bindNormalMatrices[0];
+}
+
+const SkinningPalette& ModelEntity::getCurrentSkinningPalette() const
+{
+	if (sharedPose.get())
+	{
+		return sharedPose->getSkinningPalette();
+	}
+
+	return skinningPalette;
+}
+
 const string& ModelEntity::getCurrentProgramType() const
 {
 	return GeneralEntity::currentProgramType;
@@ -30,7 +64,7 @@ int32_t ModelEntity::getNumberJoints() const
 }
 
 ModelEntity::ModelEntity(const string& name, const ModelSP& model, float scaleX, float scaleY, float scaleZ) :
-		GeneralEntity(name, scaleX, scaleY, scaleZ), NodeOwner(), model(model), time(0.0f), animStackIndex(-1), animLayerIndex(-1), rootInstanceNode(), jointIndex(-1), dirty(true), ambientLightColor()
+		GeneralEntity(name, scaleX, scaleY, scaleZ), NodeOwner(), model(model), time(0.0f), animationFrame(0), animationFrameOffset(nextAnimationFrameOffset++), inverseBindMatrices(max(model->getNumberJoints(), 1)), inverseBindNormalMatrices(max(model->getNumberJoints(), 1)), bindMatrices(max(model->getNumberJoints(), 1)), bindNormalMatrices(max(model->getNumberJoints(), 1)), skinningPalette(), sharedPose(), animStackIndex(-1), animLayerIndex(-1), rootInstanceNode(), jointIndex(-1), dirty(true), ambientLightColor()
 {
 	float maxScale = glusMathMaxf(scaleX, scaleY);
 	maxScale = glusMathMaxf(maxScale, scaleZ);
@@ -43,11 +77,14 @@ ModelEntity::ModelEntity(const string& name, const ModelSP& model, float scaleX,
 	{
 		jointIndex = model->getRootNode()->getRootJointIndex();
 
-		model->getRootNode()->updateInverseBindMatrix(inverseBindMatrices, inverseBindNormalMatrices);
-		model->getRootNode()->updateBindMatrix(bindMatrices, bindNormalMatrices, Matrix4x4(), 0.0f, animStackIndex, animLayerIndex);
+		model->getRootNode()->updateInverseBindMatrix(&inverseBindMatrices[0], &inverseBindNormalMatrices[0]);
+		model->getRootNode()->updateBindMatrix(&bindMatrices[0], &bindNormalMatrices[0], Matrix4x4(), 0.0f, animStackIndex, animLayerIndex);
+
+		skinningPalette.build(&bindMatrices[0], &bindNormalMatrices[0], &inverseBindMatrices[0], &inverseBindNormalMatrices[0], model->getNumberJoints());
 	}
 	rootInstanceNode = InstanceNodeSP(new InstanceNode(model->getRootNode().get()));
 	model->getRootNode()->updateInstanceNode(*this, rootInstanceNode);
+	rootInstanceNode->updateAnimatedRecursive(animStackIndex, animLayerIndex);
 
 	updateBoundingSphereCenter(true);
 }
@@ -60,6 +97,10 @@ void ModelEntity::setAnimation(int32_t animStackIndex, int32_t animLayerIndex)
 {
 	this->animStackIndex = animStackIndex;
 	this->animLayerIndex = animLayerIndex;
+
+	rootInstanceNode->updateAnimatedRecursive(animStackIndex, animLayerIndex);
+
+	dirty = true;
 }
 
 void ModelEntity::updateBoundingSphereCenter(bool force)
@@ -76,13 +117,13 @@ void ModelEntity::updateBoundingSphereCenter(bool force)
 		Matrix4x4 skinningMatrix;
 		if (model->isSkinned())
 		{
-			skinningMatrix = bindMatrices[jointIndex] * inverseBindMatrices[jointIndex];
+			skinningMatrix = getCurrentBindMatrices()[jointIndex] * inverseBindMatrices[jointIndex];
 		}
 
 		Matrix4x4 renderingMatrix;
 		model->getRootNode()->updateBoundingSphereMatrix(renderingMatrix, getModelMatrix(), time, animStackIndex, animLayerIndex);
 
-		Point4 center = renderingMatrix * skinningMatrix * Point4();
+		Point4 center = renderingMatrix * (skinningMatrix * Point4());
 
 		setBoundingSphereCenter(center);
 	}
@@ -90,6 +131,8 @@ void ModelEntity::updateBoundingSphereCenter(bool force)
 
 void ModelEntity::update()
 {
+	bool animationUpdate = false;
+
 	if (model->isAnimated())
 	{
 		time += ModelEntity::currentDeltaTime;
@@ -100,18 +143,45 @@ void ModelEntity::update()
 			time -= stopTime;
 		}
 
-		// Calculate skinning and pass later to shader
-		if (model->isSkinned() && animStackIndex >= 0 && animLayerIndex >= 0)
+		// Far away entities are updated less frequently. The offset spreads the updates of the instances over the frames.
+		const AnimationLevelOfDetail& animationLevelOfDetail = model->getAnimationLevelOfDetail();
+
+		int32_t updateInterval = animationLevelOfDetail.getUpdateInterval(getDistanceToCamera());
+
+		animationFrame++;
+
+		animationUpdate = updateInterval > 0 && (animationFrame + animationFrameOffset) % updateInterval == 0;
+
+		if (animationUpdate)
 		{
-			model->getRootNode()->updateBindMatrix(bindMatrices, bindNormalMatrices, Matrix4x4(), time, animStackIndex, animLayerIndex);
-		}
+			// Calculate skinning and pass later to shader
+			if (model->isSkinned() && animStackIndex >= 0 && animLayerIndex >= 0)
+			{
+				if (model->getPoseCache().isEnabled())
+				{
+					// Instances at the same quantised time share one pose
+					int32_t poseAnimatedJoints = 0;
+
+					sharedPose = model->getPoseCache().getPose(*model->getRootNode(), &inverseBindMatrices[0], &inverseBindNormalMatrices[0], model->getNumberJoints(), time, animStackIndex, animLayerIndex, poseAnimatedJoints);
 
-		dirty = true;
+					animatedJoints.increase(poseAnimatedJoints);
+				}
+				else
+				{
+					sharedPose.reset();
+
+					animatedJoints.increase(model->getRootNode()->updateBindMatrix(&bindMatrices[0], &bindNormalMatrices[0], Matrix4x4(), time, animStackIndex, animLayerIndex, animationLevelOfDetail.isSkipLeafJoints(getDistanceToCamera())));
+
+					skinningPalette.build(&bindMatrices[0], &bindNormalMatrices[0], &inverseBindMatrices[0], &inverseBindNormalMatrices[0], model->getNumberJoints());
+				}
+			}
+		}
 	}
 
-	if (dirty)
+	// If only the animation did advance, just the animated nodes and their childs are recalculated
+	if (dirty || animationUpdate)
 	{
-		model->getRootNode()->updateRenderMatrix(*this, *rootInstanceNode, getModelMatrix(), time, animStackIndex, animLayerIndex);
+		model->getRootNode()->updateRenderMatrix(*this, *rootInstanceNode, getModelMatrix(), time, animStackIndex, animLayerIndex, dirty);
 
 		dirty = false;
 	}
@@ -127,6 +197,41 @@ void ModelEntity::render() const
 	}
 }
 
+void ModelEntity::setPosition(const Point4& position)
+{
+	GeneralEntity::setPosition(position);
+
+	dirty = true;
+}
+
+void ModelEntity::setRotation(float angleX, float angleY, float angleZ)
+{
+	GeneralEntity::setRotation(angleX, angleY, angleZ);
+
+	dirty = true;
+}
+
+void ModelEntity::setRotation(const Quaternion& rotation)
+{
+	GeneralEntity::setRotation(rotation);
+
+	dirty = true;
+}
+
+void ModelEntity::setPositionRotation(const Point4& position, const Quaternion& rotation)
+{
+	GeneralEntity::setPositionRotation(position, rotation);
+
+	dirty = true;
+}
+
+void ModelEntity::setScale(float scaleX, float scaleY, float scaleZ)
+{
+	GeneralEntity::setScale(scaleX, scaleY, scaleZ);
+
+	dirty = true;
+}
+
 const ModelSP& ModelEntity::getModel() const
 {
 	return model;
@@ -399,26 +504,32 @@ void ModelEntity::renderNode(const Node& node, const InstanceNode& instanceNode,
 				glUniformMatrix4fv(currentProgram->getUniformLocation(u_cubeMapProjectionMatrix), 1, GL_FALSE, Entity::getCubeMapProjectionMatrix().getM());
 			}
 
+			// Quantized directions
+			glUniform1i(currentProgram->getUniformLocation(u_hasOctahedralNormals), node.getMesh()->getNormalFormat().isOctahedral());
+			glUniform1i(currentProgram->getUniformLocation(u_hasOctahedralTangents), node.getMesh()->getTangentFormat().isOctahedral());
+
 			// Skinning
 			if (node.getMesh()->hasSkinning())
 			{
 				glUniform1i(currentProgram->getUniformLocation(u_hasSkinning), 1);
 
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_bindMatrix), model->getNumberJoints(), GL_FALSE, bindMatrices[0].getM());
-				glUniformMatrix3fv(currentProgram->getUniformLocation(u_bindNormalMatrix), model->getNumberJoints(), GL_TRUE, bindNormalMatrices[0].getM());
+				// Uploaded only once, even if used by several sub meshes
+				const SkinningPalette& currentSkinningPalette = getCurrentSkinningPalette();
+				currentSkinningPalette.upload();
 
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_inverseBindMatrix), model->getNumberJoints(), GL_FALSE, inverseBindMatrices[0].getM());
-				glUniformMatrix3fv(currentProgram->getUniformLocation(u_inverseBindNormalMatrix), model->getNumberJoints(), GL_TRUE, inverseBindNormalMatrices[0].getM());
+				glActiveTexture(GL_TEXTURE9);
+				glBindTexture(GL_TEXTURE_BUFFER, currentSkinningPalette.getTextureName());
+				glUniform1i(currentProgram->getUniformLocation(u_skinningPalette), 9);
+				glActiveTexture(GL_TEXTURE0);
 			}
 			else
 			{
 				glUniform1i(currentProgram->getUniformLocation(u_hasSkinning), 0);
 
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_bindMatrix), model->getNumberJoints(), GL_FALSE, Matrix4x4().getM());
-				glUniformMatrix3fv(currentProgram->getUniformLocation(u_bindNormalMatrix), model->getNumberJoints(), GL_TRUE, Matrix3x3().getM());
-
-				glUniformMatrix4fv(currentProgram->getUniformLocation(u_inverseBindMatrix), model->getNumberJoints(), GL_FALSE, Matrix4x4().getM());
-				glUniformMatrix3fv(currentProgram->getUniformLocation(u_inverseBindNormalMatrix), model->getNumberJoints(), GL_TRUE, Matrix3x3().getM());
+				glActiveTexture(GL_TEXTURE9);
+				glBindTexture(GL_TEXTURE_BUFFER, 0);
+				glUniform1i(currentProgram->getUniformLocation(u_skinningPalette), 9);
+				glActiveTexture(GL_TEXTURE0);
 			}
 
 			// Write bright color
@@ -8,16 +8,16 @@
 #ifndef MODELENTITY_H_
 #define MODELENTITY_H_
 
-#define MAX_MATRICES 64
-
 #include "../../UsedLibs.h"
 
+#include "../../layer0/statistic/StatisticCounter.h"
 #include "../../layer4/shadow/OrthographicCameraCascadedShadowMap2D.h"
 #include "../../layer4/shadow/OrthographicCameraShadowMap2D.h"
 #include "../../layer5/environment/DynamicEnvironment.h"
 #include "../../layer5/node/InstanceNode.h"
 #include "../../layer5/node/NodeOwner.h"
 #include "../../layer6/model/Model.h"
+#include "../../layer6/model/SkinningPalette.h"
 #include "../../layer7/entity/GeneralEntity.h"
 
 class ModelEntity : public GeneralEntity, public NodeOwner
@@ -25,14 +25,23 @@ class ModelEntity : public GeneralEntity, public NodeOwner
 
 private:
 
+	static std::int32_t nextAnimationFrameOffset;
+
 	ModelSP model;
 
 	float time;
 
-	Matrix4x4 inverseBindMatrices[MAX_MATRICES];
-	Matrix3x3 inverseBindNormalMatrices[MAX_MATRICES];
-	Matrix4x4 bindMatrices[MAX_MATRICES];
-	Matrix3x3 bindNormalMatrices[MAX_MATRICES];
+	std::int32_t animationFrame;
+	std::int32_t animationFrameOffset;
+
+	std::vector<Matrix4x4> inverseBindMatrices;
+	std::vector<Matrix3x3> inverseBindNormalMatrices;
+	std::vector<Matrix4x4> bindMatrices;
+	std::vector<Matrix3x3> bindNormalMatrices;
+
+	SkinningPalette skinningPalette;
+
+	PoseSP sharedPose;
 
 	std::int32_t animStackIndex;
 	std::int32_t animLayerIndex;
@@ -48,8 +57,19 @@ private:
 
 	Color ambientLightColor;
 
+	const Matrix4x4* getCurrentBindMatrices() const;
+
+	const Matrix3x3* getCurrentBindNormalMatrices() const;
+
+	const SkinningPalette& getCurrentSkinningPalette() const;
+
 public:
 
+	/**
+	 * Number of joints, which have been animated per frame.
+	 */
+	static StatisticCounter animatedJoints;
+
     virtual const std::string& getCurrentProgramType() const;
 
     virtual std::int32_t getNumberJoints() const;
@@ -61,6 +81,15 @@ public:
     virtual void update();
     virtual void render() const;
 
+    virtual void setPosition(const Point4& position);
+
+    virtual void setRotation(float angleX, float angleY, float angleZ);
+    virtual void setRotation(const Quaternion& rotation);
+
+	virtual void setPositionRotation(const Point4& position, const Quaternion& rotation);
+
+	virtual void setScale(float scaleX, float scaleY, float scaleZ);
+
 	void setAnimation(std::int32_t animStackIndex, std::int32_t animLayerIndex);
 
     const ModelSP& getModel() const;
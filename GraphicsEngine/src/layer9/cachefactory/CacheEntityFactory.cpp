@@ -0,0 +1,1364 @@
+/*
+ * CacheEntityFactory.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include <cstdio>
+
+#include "../../layer1/texture/Texture2DManager.h"
+#include "../../layer2/interpolation/ConstantInterpolator.h"
+#include "../../layer2/interpolation/CubicInterpolator.h"
+#include "../../layer2/interpolation/LinearInterpolator.h"
+#ifndef GE_NO_FBX
+#include "../fbxfactory/FbxEntityFactory.h"
+#endif
+#include "../gltffactory/GlTfEntityDecoderFactory.h"
+
+#include "CacheEntityFactory.h"
+
+using namespace std;
+
+// Textures of a surface material in the order they are cached.
+#define GE_CACHE_MATERIAL_TEXTURES 13
+
+static uint32_t getImporterVersion(CacheImporter importer)
+{
+#ifndef GE_NO_FBX
+	if (importer == CACHE_IMPORTER_FBX)
+	{
+		return FBX_IMPORTER_VERSION;
+	}
+#endif
+
+	return GLTF_IMPORTER_VERSION;
+}
+
+/**
+ * Appends the data to the blobs and only its offset and length to the structure.
+ */
+static void addBlob(BinaryWriter& structure, BinaryWriter& blobs, const void* data, size_t length)
+{
+	blobs.addPadding(GE_CACHE_ALIGNMENT);
+
+	structure.addValue((uint64_t)blobs.getLength());
+	structure.addValue((uint64_t)length);
+
+	blobs.addData(data, length);
+}
+
+static void getAllTextures2D(Texture2DSP allTextures2D[GE_CACHE_MATERIAL_TEXTURES], const SurfaceMaterialSP& surfaceMaterial)
+{
+	allTextures2D[0] = surfaceMaterial->getReflectionCoefficientTexture();
+	allTextures2D[1] = surfaceMaterial->getRoughnessTexture();
+	allTextures2D[2] = surfaceMaterial->getEmissiveTexture();
+	allTextures2D[3] = surfaceMaterial->getDiffuseTexture();
+	allTextures2D[4] = surfaceMaterial->getAmbientTexture();
+	allTextures2D[5] = surfaceMaterial->getSpecularTexture();
+	allTextures2D[6] = surfaceMaterial->getShininessTexture();
+	allTextures2D[7] = surfaceMaterial->getReflectionTexture();
+	allTextures2D[8] = surfaceMaterial->getRefractionTexture();
+	allTextures2D[9] = surfaceMaterial->getRefractiveIndexTexture();
+	allTextures2D[10] = surfaceMaterial->getTransparencyTexture();
+	allTextures2D[11] = surfaceMaterial->getNormalMapTexture();
+	allTextures2D[12] = surfaceMaterial->getDisplacementMapTexture();
+}
+
+static void setTexture2D(const SurfaceMaterialSP& surfaceMaterial, int32_t index, const Texture2DSP& texture)
+{
+	switch (index)
+	{
+		case 0:
+			surfaceMaterial->setReflectionCoefficientTexture(texture);
+			break;
+		case 1:
+			surfaceMaterial->setRoughnessTexture(texture);
+			break;
+		case 2:
+			surfaceMaterial->setEmissiveTexture(texture);
+			break;
+		case 3:
+			surfaceMaterial->setDiffuseTexture(texture);
+			break;
+		case 4:
+			surfaceMaterial->setAmbientTexture(texture);
+			break;
+		case 5:
+			surfaceMaterial->setSpecularTexture(texture);
+			break;
+		case 6:
+			surfaceMaterial->setShininessTexture(texture);
+			break;
+		case 7:
+			surfaceMaterial->setReflectionTexture(texture);
+			break;
+		case 8:
+			surfaceMaterial->setRefractionTexture(texture);
+			break;
+		case 9:
+			surfaceMaterial->setRefractiveIndexTexture(texture);
+			break;
+		case 10:
+			surfaceMaterial->setTransparencyTexture(texture);
+			break;
+		case 11:
+			surfaceMaterial->setNormalMapTexture(texture);
+			break;
+		case 12:
+			surfaceMaterial->setDisplacementMapTexture(texture);
+			break;
+	}
+}
+
+/**
+ * Writes the attribute tightly packed, even if it is interleaved in memory.
+ */
+static void addAttribute(BinaryWriter& structure, BinaryWriter& blobs, const void* data, const VertexFormat& format, uint32_t numberVertices)
+{
+	structure.addValue((uint32_t)format.getType());
+	structure.addValue((int32_t)format.getSize());
+	structure.addValue((uint8_t)(format.isNormalized() ? 1 : 0));
+	structure.addValue((uint8_t)(format.isOctahedral() ? 1 : 0));
+
+	if (!data || numberVertices == 0)
+	{
+		addBlob(structure, blobs, nullptr, 0);
+
+		return;
+	}
+
+	size_t elementSize = (size_t)format.getElementSize();
+	size_t elementStride = (size_t)format.getElementStride();
+
+	if (elementSize == elementStride)
+	{
+		addBlob(structure, blobs, data, format.getByteSize(numberVertices));
+
+		return;
+	}
+
+	vector<uint8_t> packed(elementSize * numberVertices);
+
+	for (uint32_t i = 0; i < numberVertices; i++)
+	{
+		memcpy(&packed[i * elementSize], (const uint8_t*)data + i * elementStride, elementSize);
+	}
+
+	addBlob(structure, blobs, &packed[0], packed.size());
+}
+
+/**
+ * Null, if the attribute is not cached. Then the format is floats with the default size.
+ */
+static const void* readAttribute(CacheReader& reader, VertexFormat& format, uint32_t numberVertices, int32_t defaultSize)
+{
+	GLenum type = (GLenum)reader.read<uint32_t>();
+	int32_t size = reader.read<int32_t>();
+	GLboolean normalized = reader.read<uint8_t>() ? GL_TRUE : GL_FALSE;
+	bool octahedral = reader.read<uint8_t>() != 0;
+
+	size_t byteLength;
+	const void* data = reader.readBlob(byteLength);
+
+	format = VertexFormat(defaultSize);
+
+	if (!data)
+	{
+		return nullptr;
+	}
+
+	if (type != GL_FLOAT && type != GL_BYTE && type != GL_UNSIGNED_BYTE && type != GL_SHORT && type != GL_UNSIGNED_SHORT)
+	{
+		reader.invalidate();
+
+		return nullptr;
+	}
+
+	if (size < 1 || size > 4)
+	{
+		reader.invalidate();
+
+		return nullptr;
+	}
+
+	format = VertexFormat(type, size, normalized, octahedral, 0);
+
+	if (byteLength != format.getByteSize(numberVertices) || (uintptr_t)data % format.getComponentSize() != 0)
+	{
+		reader.invalidate();
+
+		return nullptr;
+	}
+
+	return data;
+}
+
+static const float* readFloatBlob(CacheReader& reader, size_t count)
+{
+	size_t byteLength;
+	const void* data = reader.readBlob(byteLength);
+
+	if (!data || byteLength != count * sizeof(float) || (uintptr_t)data % sizeof(float) != 0)
+	{
+		reader.invalidate();
+
+		return nullptr;
+	}
+
+	return (const float*)data;
+}
+
+static void addAnimationValues(BinaryWriter& structure, const map<float, float>& timeValues, const map<float, const Interpolator*>& timeInterpolators)
+{
+	structure.addValue((uint32_t)timeValues.size());
+
+	for (auto& currentTimeValue : timeValues)
+	{
+		auto currentTimeInterpolator = timeInterpolators.find(currentTimeValue.first);
+
+		int32_t interpolatorId = currentTimeInterpolator != timeInterpolators.end() ? currentTimeInterpolator->second->getId() : LinearInterpolator::interpolator.getId();
+
+		structure.addValue(currentTimeValue.first);
+		structure.addValue(currentTimeValue.second);
+		structure.addValue(interpolatorId);
+	}
+}
+
+/**
+ * Reads the keys of one channel. The transform is 0 for translation, 1 for rotation and 2 for scaling.
+ */
+static bool readAnimationValues(CacheReader& reader, const AnimationLayerSP& animationLayer, int32_t transform, AnimationLayer::eCHANNELS_XYZ channel)
+{
+	uint32_t numberValues = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < numberValues && reader.isValid(); i++)
+	{
+		float time = reader.read<float>();
+		float value = reader.read<float>();
+		int32_t interpolatorId = reader.read<int32_t>();
+
+		const Interpolator* interpolator;
+		switch (interpolatorId)
+		{
+			case INTERPOLATION_CONSTANT:
+				interpolator = &ConstantInterpolator::interpolator;
+				break;
+			case INTERPOLATION_LINEAR:
+				interpolator = &LinearInterpolator::interpolator;
+				break;
+			case INTERPOLATION_CUBIC:
+				interpolator = &CubicInterpolator::interpolator;
+				break;
+			default:
+				return false;
+		}
+
+		switch (transform)
+		{
+			case 0:
+				animationLayer->addTranslationValue(channel, time, value, *interpolator);
+				break;
+			case 1:
+				animationLayer->addRotationValue(channel, time, value, *interpolator);
+				break;
+			default:
+				animationLayer->addScalingValue(channel, time, value, *interpolator);
+				break;
+		}
+	}
+
+	return reader.isValid();
+}
+
+CacheEntityFactory::CacheEntityFactory() :
+	allNodes(), allMeshes(), allSurfaceMaterials(), allTextures2D(), allNodeIndices(), allMeshIndices(), allSurfaceMaterialIndices(), allTexture2DIndices(), allTexture2DDescriptions(), allSurfaceMaterialTextures2D(), allMeshDescriptions(), allNodeMeshIndices(), nodeTreeFactory()
+{
+}
+
+CacheEntityFactory::~CacheEntityFactory()
+{
+	cleanUp();
+}
+
+bool CacheEntityFactory::collectNode(const NodeSP& node)
+{
+	if (node->getCamera().get() || node->getLight().get())
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Node '%s' with a camera or light can not be cached", node->getName().c_str());
+
+		return false;
+	}
+
+	allNodeIndices[node.get()] = (int32_t)allNodes.size();
+	allNodes.push_back(node);
+
+	const MeshSP& mesh = node->getMesh();
+
+	if (mesh.get() && allMeshIndices.find(mesh.get()) == allMeshIndices.end())
+	{
+		allMeshIndices[mesh.get()] = (int32_t)allMeshes.size();
+		allMeshes.push_back(mesh);
+
+		for (uint32_t i = 0; i < mesh->getSurfaceMaterialsCount(); i++)
+		{
+			if (mesh->containsSurfaceMaterialAt((int32_t)i))
+			{
+				collectSurfaceMaterial(mesh->getSurfaceMaterialAt((int32_t)i));
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < node->getChildCount(); i++)
+	{
+		if (!collectNode(node->getChild((int32_t)i)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void CacheEntityFactory::collectSurfaceMaterial(const SurfaceMaterialSP& surfaceMaterial)
+{
+	if (!surfaceMaterial.get() || allSurfaceMaterialIndices.find(surfaceMaterial.get()) != allSurfaceMaterialIndices.end())
+	{
+		return;
+	}
+
+	allSurfaceMaterialIndices[surfaceMaterial.get()] = (int32_t)allSurfaceMaterials.size();
+	allSurfaceMaterials.push_back(surfaceMaterial);
+
+	Texture2DSP allMaterialTextures2D[GE_CACHE_MATERIAL_TEXTURES];
+
+	getAllTextures2D(allMaterialTextures2D, surfaceMaterial);
+
+	for (int32_t i = 0; i < GE_CACHE_MATERIAL_TEXTURES; i++)
+	{
+		collectTexture2D(allMaterialTextures2D[i]);
+	}
+}
+
+void CacheEntityFactory::collectTexture2D(const Texture2DSP& texture)
+{
+	if (!texture.get() || allTexture2DIndices.find(texture.get()) != allTexture2DIndices.end())
+	{
+		return;
+	}
+
+	allTexture2DIndices[texture.get()] = (int32_t)allTextures2D.size();
+	allTextures2D.push_back(texture);
+}
+
+int32_t CacheEntityFactory::getTexture2DIndex(const Texture2DSP& texture) const
+{
+	auto walker = allTexture2DIndices.find(texture.get());
+
+	return walker != allTexture2DIndices.end() ? walker->second : -1;
+}
+
+bool CacheEntityFactory::addTexture2D(BinaryWriter& structure, BinaryWriter& blobs, const Texture2DSP& texture) const
+{
+	const PixelData& pixelData = texture->getPixelData();
+
+	if (!pixelData.getPixels() || pixelData.getSizeOfData() == 0)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Texture '%s' without pixels can not be cached", texture->getIdentifier().c_str());
+
+		return false;
+	}
+
+	structure.addString(texture->getIdentifier());
+
+	structure.addValue((int32_t)texture->getInternalFormat());
+	structure.addValue((int32_t)texture->getWidth());
+	structure.addValue((int32_t)texture->getHeight());
+	structure.addValue((uint32_t)texture->getFormat());
+	structure.addValue((uint32_t)texture->getType());
+	structure.addValue((uint8_t)(texture->isMipMap() ? 1 : 0));
+	structure.addValue((int32_t)texture->getMinFilter());
+	structure.addValue((int32_t)texture->getMagFilter());
+	structure.addValue((int32_t)texture->getWrapS());
+	structure.addValue((int32_t)texture->getWrapT());
+	structure.addValue(texture->getAnisotropic());
+
+	addBlob(structure, blobs, pixelData.getPixels(), pixelData.getSizeOfData());
+
+	return true;
+}
+
+void CacheEntityFactory::addSurfaceMaterial(BinaryWriter& structure, const SurfaceMaterialSP& surfaceMaterial) const
+{
+	structure.addString(surfaceMaterial->getName());
+
+	structure.addValue((uint8_t)(surfaceMaterial->isConvertDirectX() ? 1 : 0));
+
+	structure.addValue(surfaceMaterial->getReflectionCoefficient());
+	structure.addValue(surfaceMaterial->getRoughness());
+
+	structure.addFloats(surfaceMaterial->getEmissive().getRGBA(), 4);
+	structure.addFloats(surfaceMaterial->getDiffuse().getRGBA(), 4);
+	structure.addFloats(surfaceMaterial->getAmbient().getRGBA(), 4);
+	structure.addFloats(surfaceMaterial->getSpecular().getRGBA(), 4);
+	structure.addFloats(surfaceMaterial->getReflection().getRGBA(), 4);
+	structure.addFloats(surfaceMaterial->getRefraction().getRGBA(), 4);
+
+	structure.addValue(surfaceMaterial->getShininess());
+	structure.addValue(surfaceMaterial->getRefractiveIndex());
+	structure.addValue(surfaceMaterial->getTransparency());
+
+	Texture2DSP allMaterialTextures2D[GE_CACHE_MATERIAL_TEXTURES];
+
+	getAllTextures2D(allMaterialTextures2D, surfaceMaterial);
+
+	for (int32_t i = 0; i < GE_CACHE_MATERIAL_TEXTURES; i++)
+	{
+		structure.addValue(getTexture2DIndex(allMaterialTextures2D[i]));
+	}
+}
+
+bool CacheEntityFactory::addMesh(BinaryWriter& structure, BinaryWriter& blobs, const MeshSP& mesh) const
+{
+	if (!mesh->getVertexData() || (mesh->getNumberIndices() > 0 && !mesh->getIndices()))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Mesh '%s' without data in memory can not be cached", mesh->getName().c_str());
+
+		return false;
+	}
+
+	uint32_t numberVertices = mesh->getNumberVertices();
+
+	structure.addString(mesh->getName());
+
+	structure.addValue(numberVertices);
+
+	addAttribute(structure, blobs, mesh->getVertexData(), mesh->getVertexFormat(), numberVertices);
+	addAttribute(structure, blobs, mesh->getNormalData(), mesh->getNormalFormat(), numberVertices);
+	addAttribute(structure, blobs, mesh->getBitangentData(), mesh->getBitangentFormat(), numberVertices);
+	addAttribute(structure, blobs, mesh->getTangentData(), mesh->getTangentFormat(), numberVertices);
+	addAttribute(structure, blobs, mesh->getTexCoordData(), mesh->getTexCoordFormat(), numberVertices);
+
+	structure.addValue(mesh->getNumberIndices());
+	addBlob(structure, blobs, mesh->getIndices(), mesh->getNumberIndices() * sizeof(uint32_t));
+
+	structure.addValue(mesh->getSubMeshesCount());
+
+	for (uint32_t i = 0; i < mesh->getSubMeshesCount(); i++)
+	{
+		if (!mesh->containsSubMeshAt((int32_t)i))
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Mesh '%s' with sparse sub meshes can not be cached", mesh->getName().c_str());
+
+			return false;
+		}
+
+		const SubMeshSP& subMesh = mesh->getSubMeshAt((int32_t)i);
+
+		structure.addValue(subMesh->getIndicesOffset());
+		structure.addValue(subMesh->getTriangleCount());
+
+		int32_t surfaceMaterialIndex = -1;
+
+		if (mesh->containsSurfaceMaterialAt((int32_t)i))
+		{
+			auto walker = allSurfaceMaterialIndices.find(mesh->getSurfaceMaterialAt((int32_t)i).get());
+
+			if (walker != allSurfaceMaterialIndices.end())
+			{
+				surfaceMaterialIndex = walker->second;
+			}
+		}
+
+		structure.addValue(surfaceMaterialIndex);
+	}
+
+	bool skinning = mesh->hasSkinning() && mesh->getBoneIndices0() && mesh->getBoneIndices1() && mesh->getBoneWeights0() && mesh->getBoneWeights1() && mesh->getBoneCounters();
+
+	structure.addValue((uint8_t)(skinning ? 1 : 0));
+
+	if (skinning)
+	{
+		addBlob(structure, blobs, mesh->getBoneIndices0(), numberVertices * 4 * sizeof(float));
+		addBlob(structure, blobs, mesh->getBoneIndices1(), numberVertices * 4 * sizeof(float));
+		addBlob(structure, blobs, mesh->getBoneWeights0(), numberVertices * 4 * sizeof(float));
+		addBlob(structure, blobs, mesh->getBoneWeights1(), numberVertices * 4 * sizeof(float));
+		addBlob(structure, blobs, mesh->getBoneCounters(), numberVertices * sizeof(float));
+	}
+
+	return true;
+}
+
+void CacheEntityFactory::addAnimationStack(BinaryWriter& structure, const AnimationStackSP& animationStack) const
+{
+	structure.addString(animationStack->getName());
+
+	structure.addValue(animationStack->getStartTime());
+	structure.addValue(animationStack->getStopTime());
+
+	structure.addValue(animationStack->getAnimationLayersCount());
+
+	for (int32_t i = 0; i < animationStack->getAnimationLayersCount(); i++)
+	{
+		const AnimationLayerSP& animationLayer = animationStack->getAnimationLayer(i);
+
+		for (int32_t channel = AnimationLayer::X; channel <= AnimationLayer::Z; channel++)
+		{
+			addAnimationValues(structure, animationLayer->getAllTranslationValues((AnimationLayer::eCHANNELS_XYZ)channel), animationLayer->getAllTranslationInterpolators((AnimationLayer::eCHANNELS_XYZ)channel));
+			addAnimationValues(structure, animationLayer->getAllRotationValues((AnimationLayer::eCHANNELS_XYZ)channel), animationLayer->getAllRotationInterpolators((AnimationLayer::eCHANNELS_XYZ)channel));
+			addAnimationValues(structure, animationLayer->getAllScalingValues((AnimationLayer::eCHANNELS_XYZ)channel), animationLayer->getAllScalingInterpolators((AnimationLayer::eCHANNELS_XYZ)channel));
+		}
+	}
+}
+
+void CacheEntityFactory::addNode(BinaryWriter& structure, const NodeSP& node) const
+{
+	structure.addString(node->getName());
+
+	int32_t parentIndex = -1;
+
+	if (node->getParentNode().get())
+	{
+		auto walker = allNodeIndices.find(node->getParentNode().get());
+
+		if (walker != allNodeIndices.end())
+		{
+			parentIndex = walker->second;
+		}
+	}
+
+	structure.addValue(parentIndex);
+
+	structure.addFloats(node->getLclTranslation(), 3);
+	structure.addFloats(node->getLclRotation(), 3);
+	structure.addFloats(node->getLclScaling(), 3);
+
+	structure.addFloats(node->getPostTranslationMatrix().getM(), 16);
+	structure.addFloats(node->getPostRotationMatrix().getM(), 16);
+	structure.addFloats(node->getPostScalingMatrix().getM(), 16);
+	structure.addFloats(node->getGeometricTransformMatrix().getM(), 16);
+
+	int32_t meshIndex = -1;
+
+	if (node->getMesh().get())
+	{
+		meshIndex = allMeshIndices.find(node->getMesh().get())->second;
+	}
+
+	structure.addValue(meshIndex);
+
+	bool joint = node->getJointIndex() >= 0;
+
+	structure.addValue((uint8_t)(joint ? 1 : 0));
+
+	if (joint)
+	{
+		structure.addFloats(node->getInverseBindMatrix().getM(), 16);
+	}
+
+	structure.addValue((uint8_t)(node->isVisible() ? 1 : 0));
+	structure.addValue((uint8_t)(node->isTransparent() ? 1 : 0));
+
+	structure.addValue((uint32_t)node->getAllAnimStacks().size());
+
+	for (auto& currentAnimationStack : node->getAllAnimStacks())
+	{
+		addAnimationStack(structure, currentAnimationStack);
+	}
+}
+
+bool CacheEntityFactory::readSources(CacheReader& reader, const string& folderName) const
+{
+	uint32_t numberSources = reader.read<uint32_t>();
+
+	if (numberSources == 0)
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < numberSources && reader.isValid(); i++)
+	{
+		string sourceFileName = reader.readString();
+		uint64_t sourceLength = reader.read<uint64_t>();
+		uint64_t sourceHash = reader.read<uint64_t>();
+
+		if (!reader.isValid())
+		{
+			return false;
+		}
+
+		MappedFile mappedFile;
+
+		if (!mappedFile.open(folderName + sourceFileName) || (uint64_t)mappedFile.getLength() != sourceLength)
+		{
+			return false;
+		}
+
+		mappedFile.advise(0, mappedFile.getLength(), MAPPED_FILE_SEQUENTIAL);
+
+		if (hashData(mappedFile.getData(), mappedFile.getLength()) != sourceHash)
+		{
+			return false;
+		}
+	}
+
+	return reader.isValid();
+}
+
+bool CacheEntityFactory::readTexture2D(CacheReader& reader, CacheTexture2DDescription& texture2DDescription) const
+{
+	texture2DDescription.identifier = reader.readString();
+
+	texture2DDescription.internalFormat = (GLint)reader.read<int32_t>();
+	texture2DDescription.width = reader.read<int32_t>();
+	texture2DDescription.height = reader.read<int32_t>();
+	texture2DDescription.format = (GLenum)reader.read<uint32_t>();
+	texture2DDescription.type = (GLenum)reader.read<uint32_t>();
+	texture2DDescription.mipMap = reader.read<uint8_t>() != 0;
+	texture2DDescription.minFilter = (GLint)reader.read<int32_t>();
+	texture2DDescription.magFilter = (GLint)reader.read<int32_t>();
+	texture2DDescription.wrapS = (GLint)reader.read<int32_t>();
+	texture2DDescription.wrapT = (GLint)reader.read<int32_t>();
+	texture2DDescription.anisotropic = reader.read<float>();
+
+	size_t sizeOfData;
+	texture2DDescription.pixels = (const uint8_t*)reader.readBlob(sizeOfData);
+	texture2DDescription.sizeOfData = (uint32_t)sizeOfData;
+
+	return reader.isValid() && texture2DDescription.pixels && texture2DDescription.width > 0 && texture2DDescription.height > 0 && sizeOfData <= (size_t)UINT32_MAX;
+}
+
+SurfaceMaterialSP CacheEntityFactory::readSurfaceMaterial(CacheReader& reader)
+{
+	SurfaceMaterialSP surfaceMaterial = SurfaceMaterialSP(new SurfaceMaterial(reader.readString()));
+
+	surfaceMaterial->setConvertDirectX(reader.read<uint8_t>() != 0);
+
+	surfaceMaterial->setReflectionCoefficient(reader.read<float>());
+	surfaceMaterial->setRoughness(reader.read<float>());
+
+	float rgba[4];
+
+	reader.readFloats(rgba, 4);
+	surfaceMaterial->setEmissive(Color(rgba));
+	reader.readFloats(rgba, 4);
+	surfaceMaterial->setDiffuse(Color(rgba));
+	reader.readFloats(rgba, 4);
+	surfaceMaterial->setAmbient(Color(rgba));
+	reader.readFloats(rgba, 4);
+	surfaceMaterial->setSpecular(Color(rgba));
+	reader.readFloats(rgba, 4);
+	surfaceMaterial->setReflection(Color(rgba));
+	reader.readFloats(rgba, 4);
+	surfaceMaterial->setRefraction(Color(rgba));
+
+	surfaceMaterial->setShininess(reader.read<float>());
+	surfaceMaterial->setRefractiveIndex(reader.read<float>());
+	surfaceMaterial->setTransparency(reader.read<float>());
+
+	for (int32_t i = 0; i < GE_CACHE_MATERIAL_TEXTURES; i++)
+	{
+		int32_t textureIndex = reader.read<int32_t>();
+
+		if (textureIndex < -1 || textureIndex >= (int32_t)allTexture2DDescriptions.size())
+		{
+			reader.invalidate();
+		}
+
+		if (!reader.isValid())
+		{
+			return SurfaceMaterialSP();
+		}
+
+		if (textureIndex >= 0)
+		{
+			CacheSurfaceMaterialTexture2D surfaceMaterialTexture2D;
+
+			surfaceMaterialTexture2D.surfaceMaterial = surfaceMaterial;
+			surfaceMaterialTexture2D.slot = i;
+			surfaceMaterialTexture2D.texture2DIndex = textureIndex;
+
+			allSurfaceMaterialTextures2D.push_back(surfaceMaterialTexture2D);
+		}
+	}
+
+	return surfaceMaterial;
+}
+
+bool CacheEntityFactory::readMesh(CacheReader& reader, CacheMeshDescription& meshDescription) const
+{
+	meshDescription.name = reader.readString();
+
+	uint32_t numberVertices = reader.read<uint32_t>();
+
+	meshDescription.numberVertices = numberVertices;
+
+	meshDescription.vertices = readAttribute(reader, meshDescription.vertexFormat, numberVertices, 4);
+	meshDescription.normals = readAttribute(reader, meshDescription.normalFormat, numberVertices, 3);
+	meshDescription.bitangents = readAttribute(reader, meshDescription.bitangentFormat, numberVertices, 3);
+	meshDescription.tangents = readAttribute(reader, meshDescription.tangentFormat, numberVertices, 3);
+	meshDescription.texCoords = readAttribute(reader, meshDescription.texCoordFormat, numberVertices, 2);
+
+	uint32_t numberIndices = reader.read<uint32_t>();
+
+	size_t indicesLength;
+	const uint32_t* indices = (const uint32_t*)reader.readBlob(indicesLength);
+
+	if (!meshDescription.vertices || indicesLength != (size_t)numberIndices * sizeof(uint32_t) || (uintptr_t)indices % sizeof(uint32_t) != 0)
+	{
+		reader.invalidate();
+
+		return false;
+	}
+
+	meshDescription.numberIndices = numberIndices;
+	meshDescription.indices = indices;
+
+	uint32_t numberSubMeshes = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < numberSubMeshes && reader.isValid(); i++)
+	{
+		uint32_t indicesOffset = reader.read<uint32_t>();
+		uint32_t triangleCount = reader.read<uint32_t>();
+		int32_t surfaceMaterialIndex = reader.read<int32_t>();
+
+		if ((uint64_t)indicesOffset + (uint64_t)triangleCount * 3 > (uint64_t)numberIndices || surfaceMaterialIndex < -1 || surfaceMaterialIndex >= (int32_t)allSurfaceMaterials.size())
+		{
+			reader.invalidate();
+
+			break;
+		}
+
+		meshDescription.subMeshes[(int32_t)i] = SubMeshSP(new SubMesh(indicesOffset, triangleCount));
+
+		if (surfaceMaterialIndex >= 0)
+		{
+			meshDescription.surfaceMaterials[(int32_t)i] = allSurfaceMaterials[surfaceMaterialIndex];
+		}
+	}
+
+	meshDescription.skinning = reader.read<uint8_t>() != 0;
+
+	meshDescription.boneIndices0 = nullptr;
+	meshDescription.boneIndices1 = nullptr;
+	meshDescription.boneWeights0 = nullptr;
+	meshDescription.boneWeights1 = nullptr;
+	meshDescription.boneCounters = nullptr;
+
+	if (meshDescription.skinning)
+	{
+		meshDescription.boneIndices0 = readFloatBlob(reader, (size_t)numberVertices * 4);
+		meshDescription.boneIndices1 = readFloatBlob(reader, (size_t)numberVertices * 4);
+		meshDescription.boneWeights0 = readFloatBlob(reader, (size_t)numberVertices * 4);
+		meshDescription.boneWeights1 = readFloatBlob(reader, (size_t)numberVertices * 4);
+		meshDescription.boneCounters = readFloatBlob(reader, (size_t)numberVertices);
+	}
+
+	return reader.isValid();
+}
+
+AnimationStackSP CacheEntityFactory::readAnimationStack(CacheReader& reader) const
+{
+	string name = reader.readString();
+
+	float startTime = reader.read<float>();
+	float stopTime = reader.read<float>();
+
+	AnimationStackSP animationStack = AnimationStackSP(new AnimationStack(name, startTime, stopTime));
+
+	int32_t numberAnimationLayers = reader.read<int32_t>();
+
+	for (int32_t i = 0; i < numberAnimationLayers && reader.isValid(); i++)
+	{
+		AnimationLayerSP animationLayer = AnimationLayerSP(new AnimationLayer());
+
+		for (int32_t channel = AnimationLayer::X; channel <= AnimationLayer::Z; channel++)
+		{
+			for (int32_t transform = 0; transform < 3; transform++)
+			{
+				if (!readAnimationValues(reader, animationLayer, transform, (AnimationLayer::eCHANNELS_XYZ)channel))
+				{
+					reader.invalidate();
+
+					return AnimationStackSP();
+				}
+			}
+		}
+
+		animationStack->addAnimationLayer(animationLayer);
+	}
+
+	if (!reader.isValid())
+	{
+		return AnimationStackSP();
+	}
+
+	return animationStack;
+}
+
+NodeSP CacheEntityFactory::readNode(CacheReader& reader, vector<pair<string, Matrix4x4> >& allInverseBindMatrices)
+{
+	string name = reader.readString();
+
+	int32_t parentIndex = reader.read<int32_t>();
+
+	// Only the first node is the root and parents are written before their children.
+	if ((allNodes.size() == 0) != (parentIndex == -1) || parentIndex >= (int32_t)allNodes.size() || parentIndex < -1)
+	{
+		reader.invalidate();
+
+		return NodeSP();
+	}
+
+	float translation[3];
+	float rotation[3];
+	float scaling[3];
+
+	reader.readFloats(translation, 3);
+	reader.readFloats(rotation, 3);
+	reader.readFloats(scaling, 3);
+
+	float matrix[16];
+
+	reader.readFloats(matrix, 16);
+	Matrix4x4 postTranslation(matrix);
+	reader.readFloats(matrix, 16);
+	Matrix4x4 postRotation(matrix);
+	reader.readFloats(matrix, 16);
+	Matrix4x4 postScaling(matrix);
+	reader.readFloats(matrix, 16);
+	Matrix4x4 geometricTransform(matrix);
+
+	int32_t meshIndex = reader.read<int32_t>();
+
+	if (meshIndex < -1 || meshIndex >= (int32_t)allMeshDescriptions.size())
+	{
+		reader.invalidate();
+
+		return NodeSP();
+	}
+
+	bool joint = reader.read<uint8_t>() != 0;
+
+	if (joint)
+	{
+		reader.readFloats(matrix, 16);
+
+		allInverseBindMatrices.push_back(make_pair(name, Matrix4x4(matrix)));
+	}
+
+	bool visible = reader.read<uint8_t>() != 0;
+	bool transparent = reader.read<uint8_t>() != 0;
+
+	vector<AnimationStackSP> allAnimStacks;
+
+	uint32_t numberAnimStacks = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < numberAnimStacks && reader.isValid(); i++)
+	{
+		AnimationStackSP animationStack = readAnimationStack(reader);
+
+		if (!animationStack.get())
+		{
+			return NodeSP();
+		}
+
+		allAnimStacks.push_back(animationStack);
+	}
+
+	if (!reader.isValid())
+	{
+		return NodeSP();
+	}
+
+	string parentNodeName = parentIndex >= 0 ? allNodes[parentIndex]->getName() : "[NULL]";
+
+	// The mesh is attached, after the whole cache has been read.
+	NodeSP node = nodeTreeFactory.createNode(name, parentNodeName, translation, postTranslation, rotation, postRotation, scaling, postScaling, geometricTransform, MeshSP(), CameraSP(), LightSP(), allAnimStacks);
+
+	node->setVisible(visible);
+	node->setTransparent(transparent);
+
+	if (joint)
+	{
+		nodeTreeFactory.setJoint(name);
+	}
+
+	allNodes.push_back(node);
+	allNodeMeshIndices.push_back(meshIndex);
+
+	return node;
+}
+
+void CacheEntityFactory::cleanUp()
+{
+	allNodes.clear();
+	allMeshes.clear();
+	allSurfaceMaterials.clear();
+	allTextures2D.clear();
+
+	allNodeIndices.clear();
+	allMeshIndices.clear();
+	allSurfaceMaterialIndices.clear();
+	allTexture2DIndices.clear();
+
+	allTexture2DDescriptions.clear();
+	allSurfaceMaterialTextures2D.clear();
+	allMeshDescriptions.clear();
+
+	allNodeMeshIndices.clear();
+
+	nodeTreeFactory.reset();
+}
+
+uint64_t CacheEntityFactory::hashData(const uint8_t* data, size_t length)
+{
+	uint64_t hash = 14695981039346656037ULL;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= (uint64_t)data[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+ModelEntitySP CacheEntityFactory::loadGlTfModelFile(const string& identifier, const string& fileName, const string& folderName, float scale)
+{
+	string cacheFileName = getCacheFileName(fileName);
+
+	ModelEntitySP result = loadCacheFile(identifier, cacheFileName, folderName, scale);
+
+	if (result.get())
+	{
+		return result;
+	}
+
+	GlTfEntityDecoderFactory glTfEntityDecoderFactory;
+
+	result = glTfEntityDecoderFactory.loadGlTfModelFile(identifier, fileName, folderName, scale);
+
+	if (!result.get())
+	{
+		return result;
+	}
+
+	// Without a cache, the next load is just not faster.
+	saveCacheFile(result, glTfEntityDecoderFactory.getAllSourceFileNames(), cacheFileName, folderName);
+
+	return result;
+}
+
+#ifndef GE_NO_FBX
+ModelEntitySP CacheEntityFactory::loadFbxModelFile(const string& identifier, const string& fileName, const string& folderName, float scale)
+{
+	string cacheFileName = getCacheFileName(fileName);
+
+	ModelEntitySP result = loadCacheFile(identifier, cacheFileName, folderName, scale, CACHE_IMPORTER_FBX);
+
+	if (result.get())
+	{
+		return result;
+	}
+
+	FbxEntityFactory fbxEntityFactory;
+
+	result = fbxEntityFactory.loadFbxModelFile(identifier, folderName + fileName, scale);
+
+	if (!result.get())
+	{
+		return result;
+	}
+
+	vector<string> allSourceFileNames;
+	allSourceFileNames.push_back(fileName);
+
+	// Without a cache, the next load is just not faster.
+	saveCacheFile(result, allSourceFileNames, cacheFileName, folderName, CACHE_IMPORTER_FBX);
+
+	return result;
+}
+#endif
+
+ModelEntitySP CacheEntityFactory::loadCacheFile(const string& identifier, const string& cacheFileName, const string& folderName, float scale, CacheImporter importer)
+{
+	ModelEntitySP result;
+
+	string completeFilename = folderName + cacheFileName;
+
+	MappedFileSP mappedFile = MappedFileSP(new MappedFile());
+
+	if (!mappedFile->open(completeFilename))
+	{
+		glusLogPrint(GLUS_LOG_INFO, "No cache '%s'", completeFilename.c_str());
+
+		return result;
+	}
+
+	const uint8_t* data = mappedFile->getData();
+	size_t length = mappedFile->getLength();
+
+	if (length < GE_CACHE_MAGIC_LENGTH || memcmp(data, GE_CACHE_MAGIC, GE_CACHE_MAGIC_LENGTH) != 0)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "'%s' is not a cache", completeFilename.c_str());
+
+		return result;
+	}
+
+	CacheReader headerReader(data + GE_CACHE_MAGIC_LENGTH, length - GE_CACHE_MAGIC_LENGTH, nullptr, 0);
+
+	uint32_t version = headerReader.read<uint32_t>();
+	uint32_t byteOrder = headerReader.read<uint32_t>();
+	uint32_t importerVersion = headerReader.read<uint32_t>();
+	uint32_t cacheImporter = headerReader.read<uint32_t>();
+	uint64_t structureLength = headerReader.read<uint64_t>();
+	uint64_t blobsOffset = headerReader.read<uint64_t>();
+	uint64_t blobsLength = headerReader.read<uint64_t>();
+
+	if (!headerReader.isValid() || version != GE_CACHE_VERSION || byteOrder != GE_CACHE_BYTE_ORDER || cacheImporter != (uint32_t)importer || importerVersion != getImporterVersion(importer))
+	{
+		glusLogPrint(GLUS_LOG_INFO, "Cache '%s' is of another importer or version", completeFilename.c_str());
+
+		return result;
+	}
+
+	uint64_t structureOffset = (uint64_t)(GE_CACHE_MAGIC_LENGTH + headerReader.getOffset());
+
+	if (structureLength > (uint64_t)length - structureOffset || blobsOffset < structureOffset + structureLength || blobsOffset > (uint64_t)length || blobsLength > (uint64_t)length - blobsOffset || blobsOffset % GE_CACHE_ALIGNMENT != 0)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Cache '%s' is corrupt", completeFilename.c_str());
+
+		return result;
+	}
+
+	CacheReader reader(data + structureOffset, (size_t)structureLength, data + blobsOffset, (size_t)blobsLength);
+
+	if (!readSources(reader, folderName))
+	{
+		glusLogPrint(GLUS_LOG_INFO, "Cache '%s' is outdated", completeFilename.c_str());
+
+		return result;
+	}
+
+	// Attributes, indices and pixels are read once for the upload.
+	mappedFile->advise((size_t)blobsOffset, (size_t)blobsLength, MAPPED_FILE_SEQUENTIAL);
+
+	//
+
+	cleanUp();
+
+	float center[3];
+	reader.readFloats(center, 3);
+	float radius = reader.read<float>();
+
+	reader.read<int32_t>();
+	bool animated = reader.read<uint8_t>() != 0;
+	bool skinned = reader.read<uint8_t>() != 0;
+
+	uint32_t numberTextures2D = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < numberTextures2D && reader.isValid(); i++)
+	{
+		CacheTexture2DDescription texture2DDescription;
+
+		if (!readTexture2D(reader, texture2DDescription))
+		{
+			reader.invalidate();
+
+			break;
+		}
+
+		allTexture2DDescriptions.push_back(texture2DDescription);
+	}
+
+	uint32_t numberSurfaceMaterials = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < numberSurfaceMaterials && reader.isValid(); i++)
+	{
+		SurfaceMaterialSP surfaceMaterial = readSurfaceMaterial(reader);
+
+		if (!surfaceMaterial.get())
+		{
+			reader.invalidate();
+
+			break;
+		}
+
+		allSurfaceMaterials.push_back(surfaceMaterial);
+	}
+
+	uint32_t numberMeshes = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < numberMeshes && reader.isValid(); i++)
+	{
+		CacheMeshDescription meshDescription;
+
+		if (!readMesh(reader, meshDescription))
+		{
+			reader.invalidate();
+
+			break;
+		}
+
+		allMeshDescriptions.push_back(meshDescription);
+	}
+
+	vector<pair<string, Matrix4x4> > allInverseBindMatrices;
+
+	uint32_t numberNodes = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < numberNodes && reader.isValid(); i++)
+	{
+		if (!readNode(reader, allInverseBindMatrices).get())
+		{
+			reader.invalidate();
+		}
+	}
+
+	if (!reader.isValid() || allNodes.size() == 0)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Cache '%s' is corrupt", completeFilename.c_str());
+
+		cleanUp();
+
+		return result;
+	}
+
+	for (auto& currentTexture2DDescription : allTexture2DDescriptions)
+	{
+		// If the texture is already known, e.g. from a previous load, it is shared.
+		Texture2DSP texture = Texture2DManager::getInstance()->createTexture(currentTexture2DDescription.identifier, currentTexture2DDescription.internalFormat, currentTexture2DDescription.width, currentTexture2DDescription.height, currentTexture2DDescription.format, currentTexture2DDescription.type, currentTexture2DDescription.pixels, currentTexture2DDescription.sizeOfData, currentTexture2DDescription.mipMap, currentTexture2DDescription.minFilter, currentTexture2DDescription.magFilter, currentTexture2DDescription.wrapS, currentTexture2DDescription.wrapT, currentTexture2DDescription.anisotropic);
+
+		if (!texture.get())
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not create texture '%s' of cache '%s'", currentTexture2DDescription.identifier.c_str(), completeFilename.c_str());
+
+			cleanUp();
+
+			return result;
+		}
+
+		allTextures2D.push_back(texture);
+	}
+
+	for (auto& currentSurfaceMaterialTexture2D : allSurfaceMaterialTextures2D)
+	{
+		setTexture2D(currentSurfaceMaterialTexture2D.surfaceMaterial, currentSurfaceMaterialTexture2D.slot, allTextures2D[currentSurfaceMaterialTexture2D.texture2DIndex]);
+	}
+
+	// The data stays in the mapped cache, so only the upload is done here.
+	vector<shared_ptr<const void> > allOwners;
+	allOwners.push_back(mappedFile);
+
+	for (auto& currentMeshDescription : allMeshDescriptions)
+	{
+		MeshSP mesh = MeshSP(new Mesh(currentMeshDescription.name, currentMeshDescription.numberVertices, currentMeshDescription.vertices, currentMeshDescription.vertexFormat, currentMeshDescription.normals, currentMeshDescription.normalFormat, currentMeshDescription.bitangents, currentMeshDescription.bitangentFormat, currentMeshDescription.tangents, currentMeshDescription.tangentFormat, currentMeshDescription.texCoords, currentMeshDescription.texCoordFormat, currentMeshDescription.numberIndices, currentMeshDescription.indices, currentMeshDescription.subMeshes, currentMeshDescription.surfaceMaterials, allOwners));
+
+		if (currentMeshDescription.skinning)
+		{
+			mesh->addSkinningData(const_cast<float*>(currentMeshDescription.boneIndices0), const_cast<float*>(currentMeshDescription.boneIndices1), const_cast<float*>(currentMeshDescription.boneWeights0), const_cast<float*>(currentMeshDescription.boneWeights1), const_cast<float*>(currentMeshDescription.boneCounters));
+		}
+
+		allMeshes.push_back(mesh);
+	}
+
+	for (uint32_t i = 0; i < allNodes.size(); i++)
+	{
+		if (allNodeMeshIndices[i] >= 0)
+		{
+			allNodes[i]->setMesh(allMeshes[allNodeMeshIndices[i]]);
+		}
+	}
+
+	int32_t numberJoints = nodeTreeFactory.createIndex();
+
+	for (auto& currentInverseBindMatrix : allInverseBindMatrices)
+	{
+		nodeTreeFactory.setInverseBindMatrix(currentInverseBindMatrix.first, currentInverseBindMatrix.second);
+	}
+
+	BoundingSphere boundingSphere(Point4(center[0], center[1], center[2]), radius);
+
+	ModelSP model = ModelSP(new Model(boundingSphere, allNodes[0], numberJoints, animated, skinned));
+
+	result = ModelEntitySP(new ModelEntity(identifier, model, scale, scale, scale));
+
+	glusLogPrint(GLUS_LOG_INFO, "Loaded cache '%s'", completeFilename.c_str());
+
+	cleanUp();
+
+	return result;
+}
+
+bool CacheEntityFactory::saveCacheFile(const ModelEntitySP& modelEntity, const vector<string>& allSourceFileNames, const string& cacheFileName, const string& folderName, CacheImporter importer)
+{
+	string completeFilename = folderName + cacheFileName;
+
+	const ModelSP& model = modelEntity->getModel();
+
+	cleanUp();
+
+	if (allSourceFileNames.size() == 0 || !collectNode(model->getRootNode()))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not cache '%s'", completeFilename.c_str());
+
+		cleanUp();
+
+		return false;
+	}
+
+	BinaryWriter structure;
+	BinaryWriter blobs;
+
+	// Sources
+
+	structure.addValue((uint32_t)allSourceFileNames.size());
+
+	for (auto& currentSourceFileName : allSourceFileNames)
+	{
+		MappedFile mappedFile;
+
+		if (!mappedFile.open(folderName + currentSourceFileName))
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not hash '%s'", (folderName + currentSourceFileName).c_str());
+
+			cleanUp();
+
+			return false;
+		}
+
+		structure.addString(currentSourceFileName);
+		structure.addValue((uint64_t)mappedFile.getLength());
+		structure.addValue(hashData(mappedFile.getData(), mappedFile.getLength()));
+	}
+
+	// Model
+
+	structure.addFloats(model->getBoundingSphere().getCenter().getP(), 3);
+	structure.addValue(model->getBoundingSphere().getRadius());
+
+	structure.addValue(model->getNumberJoints());
+	structure.addValue((uint8_t)(model->isAnimated() ? 1 : 0));
+	structure.addValue((uint8_t)(model->isSkinned() ? 1 : 0));
+
+	// Textures, materials and meshes are written before they are referenced by their index.
+
+	bool result = true;
+
+	structure.addValue((uint32_t)allTextures2D.size());
+
+	for (auto& currentTexture2D : allTextures2D)
+	{
+		result = result && addTexture2D(structure, blobs, currentTexture2D);
+	}
+
+	structure.addValue((uint32_t)allSurfaceMaterials.size());
+
+	for (auto& currentSurfaceMaterial : allSurfaceMaterials)
+	{
+		addSurfaceMaterial(structure, currentSurfaceMaterial);
+	}
+
+	structure.addValue((uint32_t)allMeshes.size());
+
+	for (auto& currentMesh : allMeshes)
+	{
+		result = result && addMesh(structure, blobs, currentMesh);
+	}
+
+	structure.addValue((uint32_t)allNodes.size());
+
+	for (auto& currentNode : allNodes)
+	{
+		addNode(structure, currentNode);
+	}
+
+	cleanUp();
+
+	if (!result)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not cache '%s'", completeFilename.c_str());
+
+		return false;
+	}
+
+	// Header
+
+	BinaryWriter header;
+
+	header.addData(GE_CACHE_MAGIC, GE_CACHE_MAGIC_LENGTH);
+	header.addValue((uint32_t)GE_CACHE_VERSION);
+	header.addValue((uint32_t)GE_CACHE_BYTE_ORDER);
+	header.addValue(getImporterVersion(importer));
+	header.addValue((uint32_t)importer);
+
+	size_t structureOffset = header.getLength() + 3 * sizeof(uint64_t);
+
+	size_t blobsOffset = structureOffset + structure.getLength();
+
+	blobsOffset = (blobsOffset + GE_CACHE_ALIGNMENT - 1) / GE_CACHE_ALIGNMENT * GE_CACHE_ALIGNMENT;
+
+	header.addValue((uint64_t)structure.getLength());
+	header.addValue((uint64_t)blobsOffset);
+	header.addValue((uint64_t)blobs.getLength());
+
+	BinaryWriter padding;
+
+	for (size_t i = structureOffset + structure.getLength(); i < blobsOffset; i++)
+	{
+		padding.addValue((uint8_t)0);
+	}
+
+	// Written beside and then renamed, as a previous cache may still be mapped.
+	string temporaryFilename = completeFilename + ".tmp";
+
+	FILE* file = glusFileOpen(temporaryFilename.c_str(), "wb");
+
+	if (!file)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not open '%s'", temporaryFilename.c_str());
+
+		return false;
+	}
+
+	result = header.save(file) && structure.save(file) && padding.save(file) && blobs.save(file);
+
+	if (glusFileClose(file) != 0)
+	{
+		result = false;
+	}
+
+	if (result)
+	{
+		remove(completeFilename.c_str());
+
+		result = rename(temporaryFilename.c_str(), completeFilename.c_str()) == 0;
+	}
+
+	if (!result)
+	{
+		remove(temporaryFilename.c_str());
+
+		glusLogPrint(GLUS_LOG_ERROR, "Could not save cache '%s'", completeFilename.c_str());
+
+		return false;
+	}
+
+	glusLogPrint(GLUS_LOG_INFO, "Saved cache '%s'", completeFilename.c_str());
+
+	return true;
+}
+
+string CacheEntityFactory::getCacheFileName(const string& fileName)
+{
+	size_t extension = fileName.find_last_of('.');
+	size_t folder = fileName.find_last_of("/\\");
+
+	if (extension == string::npos || (folder != string::npos && extension < folder))
+	{
+		return fileName + GE_CACHE_EXTENSION;
+	}
+
+	return fileName.substr(0, extension) + GE_CACHE_EXTENSION;
+}
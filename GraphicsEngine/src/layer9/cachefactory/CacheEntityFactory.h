@@ -0,0 +1,214 @@
+/*
+ * CacheEntityFactory.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef CACHEENTITYFACTORY_H_
+#define CACHEENTITYFACTORY_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/binary/BinaryWriter.h"
+#include "../../layer0/os/MappedFile.h"
+#include "../../layer5/node/NodeTreeFactory.h"
+#include "../../layer8/modelentity/ModelEntity.h"
+
+#include "CacheReader.h"
+
+#define GE_CACHE_MAGIC "GECACHE"
+#define GE_CACHE_MAGIC_LENGTH 8
+
+// Increase, if the layout of the cache changes.
+#define GE_CACHE_VERSION 1
+
+// Written in the byte order of the machine. A cache of another byte order is not used.
+#define GE_CACHE_BYTE_ORDER 0x01020304
+
+// Blobs are aligned, so attributes, indices and pixels can be used in place.
+#define GE_CACHE_ALIGNMENT 16
+
+#define GE_CACHE_EXTENSION ".gecache"
+
+// Importer of the cached model. Together with the version of the importer, it has to match.
+enum CacheImporter
+{
+	CACHE_IMPORTER_GLTF, CACHE_IMPORTER_FBX
+};
+
+// The pixels point into the mapped cache.
+struct CacheTexture2DDescription
+{
+	std::string identifier;
+	GLint internalFormat;
+	std::int32_t width;
+	std::int32_t height;
+	GLenum format;
+	GLenum type;
+	const std::uint8_t* pixels;
+	std::uint32_t sizeOfData;
+	bool mipMap;
+	GLint minFilter;
+	GLint magFilter;
+	GLint wrapS;
+	GLint wrapT;
+	float anisotropic;
+};
+
+struct CacheSurfaceMaterialTexture2D
+{
+	SurfaceMaterialSP surfaceMaterial;
+	std::int32_t slot;
+	std::int32_t texture2DIndex;
+};
+
+// The attributes and indices point into the mapped cache.
+struct CacheMeshDescription
+{
+	CacheMeshDescription() :
+		vertexFormat(4), normalFormat(3), bitangentFormat(3), tangentFormat(3), texCoordFormat(2)
+	{
+	}
+
+	std::string name;
+
+	std::uint32_t numberVertices;
+
+	const void* vertices;
+	const void* normals;
+	const void* bitangents;
+	const void* tangents;
+	const void* texCoords;
+
+	VertexFormat vertexFormat;
+	VertexFormat normalFormat;
+	VertexFormat bitangentFormat;
+	VertexFormat tangentFormat;
+	VertexFormat texCoordFormat;
+
+	std::uint32_t numberIndices;
+	const std::uint32_t* indices;
+
+	std::map<std::int32_t, SubMeshSP> subMeshes;
+	std::map<std::int32_t, SurfaceMaterialSP> surfaceMaterials;
+
+	bool skinning;
+
+	const float* boneIndices0;
+	const float* boneIndices1;
+	const float* boneWeights0;
+	const float* boneWeights1;
+	const float* boneCounters;
+};
+
+/**
+ * Binary cache of an imported model: node tree, meshes, materials with their textures, animations and the bounding sphere.
+ * The cache is keyed by the content hash of all source files, the importer and its version. It is mapped and the
+ * attribute, index and pixel blobs are used without copying them.
+ */
+class CacheEntityFactory
+{
+
+private:
+
+	// Written in this order, parents before their children.
+	std::vector<NodeSP> allNodes;
+	std::vector<MeshSP> allMeshes;
+	std::vector<SurfaceMaterialSP> allSurfaceMaterials;
+	std::vector<Texture2DSP> allTextures2D;
+
+	std::map<const Node*, std::int32_t> allNodeIndices;
+	std::map<const Mesh*, std::int32_t> allMeshIndices;
+	std::map<const SurfaceMaterial*, std::int32_t> allSurfaceMaterialIndices;
+	std::map<const Texture2D*, std::int32_t> allTexture2DIndices;
+
+	// Textures are registered in the texture manager and meshes are uploaded only after the whole cache has been read.
+	std::vector<CacheTexture2DDescription> allTexture2DDescriptions;
+	std::vector<CacheSurfaceMaterialTexture2D> allSurfaceMaterialTextures2D;
+	std::vector<CacheMeshDescription> allMeshDescriptions;
+
+	// Mesh of each read node, -1 if it has none.
+	std::vector<std::int32_t> allNodeMeshIndices;
+
+	NodeTreeFactory nodeTreeFactory;
+
+	bool collectNode(const NodeSP& node);
+
+	void collectSurfaceMaterial(const SurfaceMaterialSP& surfaceMaterial);
+
+	void collectTexture2D(const Texture2DSP& texture);
+
+	std::int32_t getTexture2DIndex(const Texture2DSP& texture) const;
+
+	//
+
+	bool addTexture2D(BinaryWriter& structure, BinaryWriter& blobs, const Texture2DSP& texture) const;
+
+	void addSurfaceMaterial(BinaryWriter& structure, const SurfaceMaterialSP& surfaceMaterial) const;
+
+	bool addMesh(BinaryWriter& structure, BinaryWriter& blobs, const MeshSP& mesh) const;
+
+	void addAnimationStack(BinaryWriter& structure, const AnimationStackSP& animationStack) const;
+
+	void addNode(BinaryWriter& structure, const NodeSP& node) const;
+
+	//
+
+	bool readSources(CacheReader& reader, const std::string& folderName) const;
+
+	bool readTexture2D(CacheReader& reader, CacheTexture2DDescription& texture2DDescription) const;
+
+	SurfaceMaterialSP readSurfaceMaterial(CacheReader& reader);
+
+	bool readMesh(CacheReader& reader, CacheMeshDescription& meshDescription) const;
+
+	AnimationStackSP readAnimationStack(CacheReader& reader) const;
+
+	NodeSP readNode(CacheReader& reader, std::vector<std::pair<std::string, Matrix4x4> >& allInverseBindMatrices);
+
+	//
+
+	void cleanUp();
+
+public:
+
+	CacheEntityFactory();
+	virtual ~CacheEntityFactory();
+
+	/**
+	 * FNV-1a with 64 bits.
+	 */
+	static std::uint64_t hashData(const std::uint8_t* data, std::size_t length);
+
+	/**
+	 * Loads the model from the cache next to the glTF file. If the cache is missing or outdated, the glTF file is imported
+	 * and the cache is written for the next time.
+	 */
+	ModelEntitySP loadGlTfModelFile(const std::string& identifier, const std::string& fileName, const std::string& folderName, float scale);
+
+#ifndef GE_NO_FBX
+	/**
+	 * Same as for glTF, but the cache is keyed by the content hash of the FBX file only. The FBX file names its textures
+	 * with paths of the machine it was exported on, so changed textures do not invalidate the cache.
+	 */
+	ModelEntitySP loadFbxModelFile(const std::string& identifier, const std::string& fileName, const std::string& folderName, float scale);
+#endif
+
+	/**
+	 * Returns nothing, if the cache is missing, of another version or if one of its source files has changed. Textures
+	 * and meshes are only created, if the whole cache is valid.
+	 */
+	ModelEntitySP loadCacheFile(const std::string& identifier, const std::string& cacheFileName, const std::string& folderName, float scale, CacheImporter importer = CACHE_IMPORTER_GLTF);
+
+	/**
+	 * Writes the model with the hashes of the source files, which are relative to the folder. Models with cameras, lights
+	 * or textures without pixels in memory can not be cached.
+	 */
+	bool saveCacheFile(const ModelEntitySP& modelEntity, const std::vector<std::string>& allSourceFileNames, const std::string& cacheFileName, const std::string& folderName, CacheImporter importer = CACHE_IMPORTER_GLTF);
+
+	static std::string getCacheFileName(const std::string& fileName);
+
+};
+
+#endif /* CACHEENTITYFACTORY_H_ */
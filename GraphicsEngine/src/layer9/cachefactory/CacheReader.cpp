@@ -0,0 +1,104 @@
+/*
+ * CacheReader.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "CacheReader.h"
+
+using namespace std;
+
+CacheReader::CacheReader(const uint8_t* data, size_t length, const uint8_t* blobs, size_t blobsLength) :
+	data(data), length(length), offset(0), blobs(blobs), blobsLength(blobsLength), valid(data != nullptr)
+{
+}
+
+CacheReader::~CacheReader()
+{
+}
+
+const uint8_t* CacheReader::readBytes(size_t byteLength)
+{
+	if (!valid || byteLength > length - offset)
+	{
+		valid = false;
+
+		return nullptr;
+	}
+
+	const uint8_t* result = data + offset;
+
+	offset += byteLength;
+
+	return result;
+}
+
+void CacheReader::readFloats(float* target, size_t count)
+{
+	const uint8_t* bytes = (count <= length / sizeof(float)) ? readBytes(count * sizeof(float)) : nullptr;
+
+	if (bytes)
+	{
+		memcpy(target, bytes, count * sizeof(float));
+	}
+	else
+	{
+		valid = false;
+
+		memset(target, 0, count * sizeof(float));
+	}
+}
+
+string CacheReader::readString()
+{
+	uint32_t stringLength = read<uint32_t>();
+
+	const uint8_t* bytes = readBytes(stringLength);
+
+	if (!bytes)
+	{
+		return string();
+	}
+
+	return string((const char*)bytes, stringLength);
+}
+
+const void* CacheReader::readBlob(size_t& byteLength)
+{
+	uint64_t blobOffset = read<uint64_t>();
+	uint64_t blobLength = read<uint64_t>();
+
+	byteLength = 0;
+
+	if (!valid || blobLength == 0)
+	{
+		return nullptr;
+	}
+
+	if (blobOffset > (uint64_t)blobsLength || blobLength > (uint64_t)blobsLength - blobOffset)
+	{
+		valid = false;
+
+		return nullptr;
+	}
+
+	byteLength = (size_t)blobLength;
+
+	return blobs + (size_t)blobOffset;
+}
+
+void CacheReader::invalidate()
+{
+	valid = false;
+}
+
+bool CacheReader::isValid() const
+{
+	return valid;
+}
+
+size_t CacheReader::getOffset() const
+{
+	return offset;
+}
@@ -0,0 +1,77 @@
+/*
+ * CacheReader.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef CACHEREADER_H_
+#define CACHEREADER_H_
+
+#include <cstring>
+
+#include "../../UsedLibs.h"
+
+/**
+ * Reads the structure of a cache in the order it was written. Every read is checked against the end of the data. After a
+ * failed read, the reader stays invalid and only returns zeros.
+ */
+class CacheReader
+{
+
+private:
+
+	const std::uint8_t* data;
+	std::size_t length;
+
+	std::size_t offset;
+
+	const std::uint8_t* blobs;
+	std::size_t blobsLength;
+
+	bool valid;
+
+	const std::uint8_t* readBytes(std::size_t byteLength);
+
+public:
+
+	CacheReader(const std::uint8_t* data, std::size_t length, const std::uint8_t* blobs, std::size_t blobsLength);
+	virtual ~CacheReader();
+
+	template<typename T>
+	T read()
+	{
+		T value = T();
+
+		const std::uint8_t* bytes = readBytes(sizeof(T));
+
+		if (bytes)
+		{
+			memcpy(&value, bytes, sizeof(T));
+		}
+
+		return value;
+	}
+
+	void readFloats(float* target, std::size_t count);
+
+	std::string readString();
+
+	/**
+	 * Reads the offset and length of a blob and returns its address in the blobs, i.e. the pointer is fixed up to the
+	 * mapped file and nothing is copied. Null for an empty blob.
+	 */
+	const void* readBlob(std::size_t& byteLength);
+
+	/**
+	 * Marks the data as invalid, e.g. if a read value is out of range.
+	 */
+	void invalidate();
+
+	bool isValid() const;
+
+	std::size_t getOffset() const;
+
+};
+
+#endif /* CACHEREADER_H_ */
@@ -230,74 +230,6 @@ bool FbxEntityFactory::traverseScene(FbxScene* scene)
 			preTraverseIndexCreation(node, nodeTreeFactory.getRootNode());
 
 			currentNumberJoints = nodeTreeFactory.createIndex();
-
-			if (currentNumberJoints >= MAX_MATRICES)
-			{
-				glusLogPrint(GLUS_LOG_ERROR, "Too many joints: %d", currentNumberJoints);
-
-				nodeTreeFactory.reset();
-				currentNumberJoints = 0;
-
-				FbxArrayDelete(animStackNameArray);
-
-				auto walker = currentSurfaceMaterials.begin();
-				while (walker != currentSurfaceMaterials.end())
-				{
-					walker->second.reset();
-
-					walker++;
-				}
-				currentSurfaceMaterials.clear();
-
-				auto walkerAll = allSurfaceMaterials.begin();
-				while (walkerAll != allSurfaceMaterials.end())
-				{
-					walkerAll->reset();
-
-					walkerAll++;
-				}
-				allSurfaceMaterials.clear();
-
-				auto walkerAnimationStack = allAnimationStacks.begin();
-				while (walkerAnimationStack != allAnimationStacks.end())
-				{
-					walkerAnimationStack->reset();
-
-					walkerAnimationStack++;
-				}
-				allAnimationStacks.clear();
-
-				auto walkerMesh = allMeshes.begin();
-				while (walkerMesh != allMeshes.end())
-				{
-					walkerMesh->reset();
-
-					walkerMesh++;
-				}
-				allMeshes.clear();
-
-				auto walkerCamera = allCameras.begin();
-				while (walkerCamera != allCameras.end())
-				{
-					walkerCamera->reset();
-
-					walkerCamera++;
-				}
-				allCameras.clear();
-
-				auto walkerLight = allLights.begin();
-				while (walkerLight != allLights.end())
-				{
-					walkerLight->reset();
-
-					walkerLight++;
-				}
-				allLights.clear();
-
-				traverseDeleteUserPointer(node);
-
-				return false;
-			}
 		}
 
 		postTraverseNode(node, nodeTreeFactory.getRootNode(), Matrix4x4());
@@ -1699,49 +1631,56 @@ void FbxEntityFactory::postTraverseNode(FbxNode* node, const NodeSP& nodeGE, con
 
 void FbxEntityFactory::processMinMax(const float* vertices, int32_t numberVertices, const Matrix4x4& matrix)
 {
-	GLfloat vertex[4];
+	GLfloat transformedVertices[4 * GE_SIMD_BATCH_SIZE];
 
-	// Calculate bounding sphere from existing vertices in mesh
-	for (int32_t i = 0; i < numberVertices; i++)
+	// Calculate bounding sphere from existing vertices in mesh. Transformed in batches, to use the SIMD path without a big buffer.
+	for (int32_t offset = 0; offset < numberVertices; offset += GE_SIMD_BATCH_SIZE)
 	{
-		glusMatrix4x4MultiplyPoint4f(vertex, matrix.getM(), &vertices[i * 4]);
+		int32_t batchSize = min(numberVertices - offset, GE_SIMD_BATCH_SIZE);
 
-		if (doReset)
-		{
-			minX = vertex[0];
-			maxX = vertex[0];
-			minY = vertex[1];
-			maxY = vertex[1];
-			minZ = vertex[2];
-			maxZ = vertex[2];
-
-			doReset = false;
-		}
-		else
+		simdMatrix4x4MultiplyPoints4f(transformedVertices, matrix.getM(), &vertices[offset * 4], batchSize);
+
+		for (int32_t i = 0; i < batchSize; i++)
 		{
-			if (vertex[0] < minX)
+			const GLfloat* vertex = &transformedVertices[i * 4];
+
+			if (doReset)
 			{
 				minX = vertex[0];
-			}
-			if (vertex[0] > maxX)
-			{
 				maxX = vertex[0];
-			}
-			if (vertex[1] < minY)
-			{
 				minY = vertex[1];
-			}
-			if (vertex[1] > maxY)
-			{
 				maxY = vertex[1];
-			}
-			if (vertex[2] < minZ)
-			{
 				minZ = vertex[2];
+				maxZ = vertex[2];
+
+				doReset = false;
 			}
-			if (vertex[2] > maxZ)
+			else
 			{
-				maxZ = vertex[2];
+				if (vertex[0] < minX)
+				{
+					minX = vertex[0];
+				}
+				if (vertex[0] > maxX)
+				{
+					maxX = vertex[0];
+				}
+				if (vertex[1] < minY)
+				{
+					minY = vertex[1];
+				}
+				if (vertex[1] > maxY)
+				{
+					maxY = vertex[1];
+				}
+				if (vertex[2] < minZ)
+				{
+					minZ = vertex[2];
+				}
+				if (vertex[2] > maxZ)
+				{
+					maxZ = vertex[2];
+				}
 			}
 		}
 	}
@@ -22,6 +22,9 @@
 #include "../../layer5/node/NodeTreeFactory.h"
 #include "../../layer8/modelentity/ModelEntity.h"
 
+// Increase, if the imported model changes for the same FBX file, so caches of older imports are not used anymore.
+#define FBX_IMPORTER_VERSION 1
+
 class FbxEntityFactory
 {
 
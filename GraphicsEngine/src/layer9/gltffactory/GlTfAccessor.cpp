@@ -9,8 +9,8 @@
 
 using namespace std;
 
-GlTfAccessor::GlTfAccessor(GlTfBufferViewSP bufferView, int32_t byteOffset, int32_t byteStride, GLenum componentType, int32_t count, string type) :
-		bufferView(bufferView), byteOffset(byteOffset), byteStride(byteStride), componentType(componentType), count(count), type(type)
+GlTfAccessor::GlTfAccessor(GlTfBufferViewSP bufferView, int32_t byteOffset, int32_t byteStride, GLenum componentType, int32_t count, string type, bool normalized) :
+		bufferView(bufferView), byteOffset(byteOffset), byteStride(byteStride), componentType(componentType), count(count), type(type), normalized(normalized)
 {
 }
 
@@ -48,6 +48,11 @@ const string& GlTfAccessor::getType() const
 	return type;
 }
 
+bool GlTfAccessor::isNormalized() const
+{
+	return normalized;
+}
+
 int32_t GlTfAccessor::getNumberComponents() const
 {
 	if (type == "SCALAR")
@@ -82,6 +87,44 @@ int32_t GlTfAccessor::getNumberComponents() const
 	return 0;
 }
 
+int32_t GlTfAccessor::getComponentSize() const
+{
+	switch (componentType)
+	{
+		case GL_BYTE:
+		case GL_UNSIGNED_BYTE:
+			return 1;
+		case GL_SHORT:
+		case GL_UNSIGNED_SHORT:
+			return 2;
+		case GL_UNSIGNED_INT:
+		case GL_FLOAT:
+			return 4;
+	}
+
+	return 0;
+}
+
+int32_t GlTfAccessor::getElementStride() const
+{
+	if (byteStride > 0)
+	{
+		return byteStride;
+	}
+
+	return getNumberComponents() * getComponentSize();
+}
+
+int64_t GlTfAccessor::getByteLength() const
+{
+	if (count <= 0)
+	{
+		return 0;
+	}
+
+	return (int64_t)getElementStride() * (int64_t)(count - 1) + (int64_t)(getNumberComponents() * getComponentSize());
+}
+
 const uint8_t* GlTfAccessor::getData() const
 {
 	if (bufferView.get() == nullptr)
@@ -23,10 +23,11 @@ private:
 	GLenum componentType;
 	std::int32_t count;
 	std::string type;
+	bool normalized;
 
 public:
 
-	GlTfAccessor(GlTfBufferViewSP bufferView, std::int32_t byteOffset, std::int32_t byteStride, GLenum componentType, std::int32_t count, std::string type);
+	GlTfAccessor(GlTfBufferViewSP bufferView, std::int32_t byteOffset, std::int32_t byteStride, GLenum componentType, std::int32_t count, std::string type, bool normalized);
 	virtual ~GlTfAccessor();
 
 	const GlTfBufferViewSP& getBufferView() const;
@@ -35,9 +36,22 @@ public:
 	GLenum getComponentType() const;
 	std::int32_t getCount() const;
 	const std::string& getType() const;
+	bool isNormalized() const;
 
 	std::int32_t getNumberComponents() const;
 
+	std::int32_t getComponentSize() const;
+
+	/**
+	 * Distance of two elements in bytes, which is the element size for a tightly packed accessor.
+	 */
+	std::int32_t getElementStride() const;
+
+	/**
+	 * Bytes from the first to the end of the last element.
+	 */
+	std::int64_t getByteLength() const;
+
 	const std::uint8_t* getData() const;
 
 };
@@ -19,14 +19,19 @@ GlTfBin::~GlTfBin()
 
 void GlTfBin::addData(const std::uint8_t* data, const size_t length)
 {
-	for (size_t i = 0; i < length; i++)
-	{
-		this->data.push_back(data[i]);
-	}
+	this->data.insert(this->data.end(), data, data + length);
 
 	counter++;
 }
 
+void GlTfBin::addPadding(const size_t alignment)
+{
+	while (data.size() % alignment != 0)
+	{
+		data.push_back(0);
+	}
+}
+
 size_t GlTfBin::getLength() const
 {
 	return data.size();
@@ -26,6 +26,11 @@ public:
 
 	void addData(const std::uint8_t* data, const size_t length);
 
+	/**
+	 * Appends zeros until the length is a multiple of the alignment.
+	 */
+	void addPadding(const size_t alignment);
+
 	size_t getLength() const;
 
 	size_t getCounter() const;
@@ -9,8 +9,8 @@
 
 using namespace std;
 
-GlTfBufferView::GlTfBufferView(const uint8_t* buffer, int32_t byteOffset, int32_t byteLength, GLenum target) :
-		buffer(buffer), byteOffset(byteOffset), byteLength(byteLength), target(target)
+GlTfBufferView::GlTfBufferView(const MappedFileSP& mappedFile, const uint8_t* buffer, int32_t byteOffset, int32_t byteLength, GLenum target) :
+		mappedFile(mappedFile), buffer(buffer), byteOffset(byteOffset), byteLength(byteLength), target(target)
 {
 }
 
@@ -23,6 +23,11 @@ const uint8_t* GlTfBufferView::getData() const
 	return &buffer[byteOffset];
 }
 
+const MappedFileSP& GlTfBufferView::getMappedFile() const
+{
+	return mappedFile;
+}
+
 const uint8_t* GlTfBufferView::getBuffer() const
 {
 	return buffer;
@@ -10,11 +10,16 @@
 
 #include "../../UsedLibs.h"
 
+#include "../../layer0/os/MappedFile.h"
+
 class GlTfBufferView
 {
 
 private:
 
+	// Keeps the buffer alive.
+	MappedFileSP mappedFile;
+
 	const std::uint8_t* buffer;
 
 	std::int32_t byteOffset;
@@ -25,12 +30,13 @@ private:
 
 public:
 
-	GlTfBufferView(const std::uint8_t* buffer, std::int32_t byteOffset, std::int32_t byteLength, GLenum target);
+	GlTfBufferView(const MappedFileSP& mappedFile, const std::uint8_t* buffer, std::int32_t byteOffset, std::int32_t byteLength, GLenum target);
 
 	virtual ~GlTfBufferView();
 
 	const std::uint8_t* getData() const;
 
+	const MappedFileSP& getMappedFile() const;
 	const std::uint8_t* getBuffer() const;
 	std::int32_t getByteLength() const;
 	std::int32_t getByteOffset() const;
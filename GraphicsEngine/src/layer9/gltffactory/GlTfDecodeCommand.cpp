@@ -0,0 +1,41 @@
+/*
+ * GlTfDecodeCommand.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "GlTfDecodeCommand.h"
+
+using namespace std;
+
+GlTfDecodeCommand::GlTfDecodeCommand(const ThreadSafeCounterSP& taskCounter, const function<bool()>& task, bool* result) : Command(), taskCounter(taskCounter), task(task), result(result)
+{
+	assert(this->taskCounter.get() != nullptr);
+	assert(this->result != nullptr);
+
+	taskCounter->increment();
+}
+
+GlTfDecodeCommand::~GlTfDecodeCommand()
+{
+}
+
+bool GlTfDecodeCommand::execute()
+{
+	*result = task();
+
+	// Nothing of the factory is accessed anymore, after the counter is decremented.
+	task = function<bool()>();
+	result = nullptr;
+
+	taskCounter->decrement();
+
+	return true;
+}
+
+void GlTfDecodeCommand::recycle()
+{
+	// Not reused, as the factory may already be gone.
+	delete this;
+}
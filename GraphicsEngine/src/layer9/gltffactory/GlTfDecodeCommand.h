@@ -0,0 +1,44 @@
+/*
+ * GlTfDecodeCommand.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef GLTFDECODECOMMAND_H_
+#define GLTFDECODECOMMAND_H_
+
+#include <functional>
+
+#include "../../layer0/concurrency/ThreadSafeCounter.h"
+#include "../../layer1/command/Command.h"
+
+/**
+ * Decodes one independent part of a glTF, e.g. an image, on a worker thread.
+ */
+class GlTfDecodeCommand: public Command
+{
+
+	friend class GlTfEntityDecoderFactory;
+
+private:
+
+	ThreadSafeCounterSP taskCounter;
+
+	std::function<bool()> task;
+
+	bool* result;
+
+	GlTfDecodeCommand(const ThreadSafeCounterSP& taskCounter, const std::function<bool()>& task, bool* result);
+
+	virtual ~GlTfDecodeCommand();
+
+public:
+
+	virtual bool execute();
+
+	virtual void recycle();
+
+};
+
+#endif /* GLTFDECODECOMMAND_H_ */
@@ -5,327 +5,293 @@
  *      Author: nopper
  */
 
-#include "../../layer0/json/JSONdecoder.h"
+#include "../../layer0/json/JSONreader.h"
+#include "../../layer1/command/WorkerManager.h"
 #include "../../layer2/interpolation/ConstantInterpolator.h"
 #include "../../layer2/interpolation/CubicInterpolator.h"
 #include "../../layer2/interpolation/LinearInterpolator.h"
 #include "../../layer1/texture/Texture2DManager.h"
+#include "../../layer1/texture/TextureFactory.h"
 #include "../../layer3/mesh/Mesh.h"
 
+#include "GlTfGlb.h"
+
 #include "GlTfEntityDecoderFactory.h"
 
 using namespace std;
 
-GlTfEntityDecoderFactory::GlTfEntityDecoderFactory() :
-		doReset(true), minX(0.0f), maxX(0.0f), minY(0.0f), maxY(0.0f), minZ(0.0f), maxZ(0.0f), nodeTreeFactory(), animated(false), skinned(false)
+/**
+ * Buffer, which is mapped on a worker thread.
+ */
+struct GlTfBufferTask
 {
-}
+	string name;
+	string fileName;
+	int32_t byteLength;
 
-GlTfEntityDecoderFactory::~GlTfEntityDecoderFactory()
-{
-}
+	MappedFileSP mappedFile;
+
+	bool result;
+};
 
-bool GlTfEntityDecoderFactory::decodeBuffers(const JSONobjectSP& jsonGlTf, const string& folderName)
+/**
+ * Image, which is loaded from a file or decoded from a buffer view on a worker thread.
+ */
+struct GlTfImageTask
 {
-	JSONstringSP buffersString = JSONstringSP(new JSONstring("buffers"));
+	string name;
+	string fileName;
 
-	if (!jsonGlTf->hasKey(buffersString))
-	{
-		return true;
-	}
+	GlTfBufferViewSP bufferView;
+	string mimeType;
 
-	JSONvalueSP value = jsonGlTf->getValue(buffersString);
+	bool hdr;
+	GLUStgaimage tgaImage;
+	GLUShdrimage hdrImage;
 
-	if (!value->isJsonObject())
-	{
-		return false;
-	}
+	bool result;
+};
 
-	JSONobjectSP buffersObject = dynamic_pointer_cast<JSONobject>(value);
+// DevIL has one global state, so images are decoded from memory one after another.
+static mutex decodeImageMutex;
 
-	JSONstringSP uriString = JSONstringSP(new JSONstring("uri"));
-	JSONstringSP byteLengthString = JSONstringSP(new JSONstring("byteLength"));
+static bool mapBuffer(GlTfBufferTask& bufferTask)
+{
+	glusLogPrint(GLUS_LOG_INFO, "Mapping buffer '%s'", bufferTask.fileName.c_str());
 
-	GLUSbinaryfile binaryfile;
+	// Mapped instead of loaded, so only the accessed pages are read and no copy is needed.
+	bufferTask.mappedFile = MappedFileSP(new MappedFile());
 
-	for (auto& currentKey : buffersObject->getAllKeys())
+	if (!bufferTask.mappedFile->open(bufferTask.fileName))
 	{
-		JSONvalueSP currentValue = buffersObject->getValue(currentKey);
-
-		if (!currentValue->isJsonObject())
-		{
-			return false;
-		}
-
-		JSONobjectSP currentBuffer = dynamic_pointer_cast<JSONobject>(currentValue);
-
-		//
-
-		currentValue = currentBuffer->getValue(uriString);
-		if (!currentValue->isJsonString())
-		{
-			return false;
-		}
-
-		JSONstringSP currentUri = dynamic_pointer_cast<JSONstring>(currentValue);
-
-		//
-
-		glusLogPrint(GLUS_LOG_INFO, "Loading buffer '%s'", (folderName + currentUri->getValue()).c_str());
-
-		if (!glusFileLoadBinary((GLUSchar*)(folderName + currentUri->getValue()).c_str(), &binaryfile))
-		{
-			return false;
-		}
-
-		allBuffers[currentKey->getValue()] = binaryfile;
-
-		//
-
-		currentValue = currentBuffer->getValue(byteLengthString);
-		if (!currentValue->isJsonNumber())
-		{
-			return false;
-		}
+		glusLogPrint(GLUS_LOG_ERROR, "Could not map buffer '%s'", bufferTask.fileName.c_str());
 
-		JSONnumberSP currentByteLength = dynamic_pointer_cast<JSONnumber>(currentValue);
+		return false;
+	}
 
-		if (currentByteLength->getIntegerValue() != (int32_t)binaryfile.length)
-		{
-			return false;
-		}
+	if (bufferTask.byteLength < 0 || (size_t)bufferTask.byteLength != bufferTask.mappedFile->getLength())
+	{
+		return false;
 	}
 
+	// Accessors are mostly read once from front to back for the upload.
+	bufferTask.mappedFile->advise(0, bufferTask.mappedFile->getLength(), MAPPED_FILE_SEQUENTIAL);
+
 	return true;
 }
 
-bool GlTfEntityDecoderFactory::decodeBufferViews(const JSONobjectSP& jsonGlTf)
+static bool loadImage(GlTfImageTask& imageTask)
 {
-	JSONstringSP bufferViewsString = JSONstringSP(new JSONstring("bufferViews"));
+	glusLogPrint(GLUS_LOG_INFO, "Loading image '%s'", imageTask.fileName.c_str());
 
-	if (!jsonGlTf->hasKey(bufferViewsString))
+	if (imageTask.hdr)
 	{
-		return true;
+		return glusImageLoadHdr((const GLUSchar*)imageTask.fileName.c_str(), &imageTask.hdrImage) == GLUS_TRUE;
 	}
 
-	JSONvalueSP value = jsonGlTf->getValue(bufferViewsString);
-
-	if (!value->isJsonObject())
-	{
-		return false;
-	}
+	return glusImageLoadTga((const GLUSchar*)imageTask.fileName.c_str(), &imageTask.tgaImage) == GLUS_TRUE;
+}
 
-	JSONobjectSP bufferViewsObject = dynamic_pointer_cast<JSONobject>(value);
+static bool decodeImage(GlTfImageTask& imageTask)
+{
+	glusLogPrint(GLUS_LOG_INFO, "Decoding image '%s' of type '%s'", imageTask.name.c_str(), imageTask.mimeType.c_str());
 
-	JSONstringSP bufferString = JSONstringSP(new JSONstring("buffer"));
-	JSONstringSP byteOffestString = JSONstringSP(new JSONstring("byteOffset"));
-	JSONstringSP byteLengthString = JSONstringSP(new JSONstring("byteLength"));
-	JSONstringSP targetString = JSONstringSP(new JSONstring("target"));
+	PixelData pixelData;
 
-	for (auto& currentKey : bufferViewsObject->getAllKeys())
 	{
-		JSONvalueSP currentValue = bufferViewsObject->getValue(currentKey);
-
-		if (!currentValue->isJsonObject())
-		{
-			return false;
-		}
+		lock_guard<mutex> decodeImageLock(decodeImageMutex);
 
-		JSONobjectSP currentBufferView = dynamic_pointer_cast<JSONobject>(currentValue);
-
-		//
+		TextureFactory textureFactory;
 
-		currentValue = currentBufferView->getValue(bufferString);
-		if (!currentValue->isJsonString())
+		if (!textureFactory.decodeImage(pixelData, imageTask.mimeType, imageTask.bufferView->getData(), (uint32_t)imageTask.bufferView->getByteLength()))
 		{
 			return false;
 		}
+	}
 
-		JSONstringSP currentBufferString = dynamic_pointer_cast<JSONstring>(currentValue);
-
-		//
+	if (pixelData.getFormat() != GL_RGB && pixelData.getFormat() != GL_RGBA)
+	{
+		return false;
+	}
 
-		auto currentBuffer = allBuffers.find(currentBufferString->getValue());
+	size_t numberPixels = (size_t)pixelData.getWidth() * (size_t)pixelData.getHeight() * (pixelData.getFormat() == GL_RGB ? 3 : 4);
 
-		if (currentBuffer == allBuffers.end())
+	// Stored like a loaded image, so textures are created the same way.
+	if (pixelData.getType() == GL_FLOAT)
+	{
+		if (pixelData.getSizeOfData() != numberPixels * sizeof(float) || !glusImageCreateHdr(&imageTask.hdrImage, pixelData.getWidth(), pixelData.getHeight(), 1, pixelData.getFormat()))
 		{
 			return false;
 		}
 
-		//
+		memcpy(imageTask.hdrImage.data, pixelData.getPixels(), pixelData.getSizeOfData());
 
-		currentValue = currentBufferView->getValue(byteOffestString);
-		if (!currentValue->isJsonNumber())
+		imageTask.hdr = true;
+	}
+	else if (pixelData.getType() == GL_UNSIGNED_BYTE)
+	{
+		if (pixelData.getSizeOfData() != numberPixels || !glusImageCreateTga(&imageTask.tgaImage, pixelData.getWidth(), pixelData.getHeight(), 1, pixelData.getFormat()))
 		{
 			return false;
 		}
 
-		JSONnumberSP currentByteOffset = dynamic_pointer_cast<JSONnumber>(currentValue);
-
-		if (currentByteOffset->getIntegerValue() >= currentBuffer->second.length)
-		{
-			return false;
-		}
+		memcpy(imageTask.tgaImage.data, pixelData.getPixels(), pixelData.getSizeOfData());
 
-		//
+		imageTask.hdr = false;
+	}
+	else
+	{
+		return false;
+	}
 
-		currentValue = currentBufferView->getValue(byteLengthString);
-		if (!currentValue->isJsonNumber())
-		{
-			return false;
-		}
+	return true;
+}
 
-		JSONnumberSP currentByteLength = dynamic_pointer_cast<JSONnumber>(currentValue);
+GlTfEntityDecoderFactory::GlTfEntityDecoderFactory() :
+		doReset(true), minX(0.0f), maxX(0.0f), minY(0.0f), maxY(0.0f), minZ(0.0f), maxZ(0.0f), nodeTreeFactory(), animated(false), skinned(false), decodeTaskCounter(new ThreadSafeCounter())
+{
+}
 
-		if (currentByteOffset->getIntegerValue() + currentByteLength->getIntegerValue() > currentBuffer->second.length)
-		{
-			return false;
-		}
+GlTfEntityDecoderFactory::~GlTfEntityDecoderFactory()
+{
+}
 
-		//
+bool GlTfEntityDecoderFactory::decodeBuffers(const GlTfJsonHandler& jsonHandler, const string& folderName, const GlTfBufferViewSP& binaryChunk)
+{
+	vector<GlTfBufferTask> allBufferTasks;
 
-		GLenum target = 0;
+	for (auto& currentPair : jsonHandler.getAllBufferDescriptions())
+	{
+		const GlTfBufferDescription& currentBuffer = currentPair.second;
 
-		if (currentBufferView->hasKey(targetString))
+		// The body of a binary glTF.
+		if (currentPair.first == GLTF_GLB_BUFFER)
 		{
-			currentValue = currentBufferView->getValue(targetString);
-			if (!currentValue->isJsonNumber())
+			if (!binaryChunk.get() || currentBuffer.byteLength < 0 || currentBuffer.byteLength > binaryChunk->getByteLength())
 			{
 				return false;
 			}
 
-			JSONnumberSP currentTarget = dynamic_pointer_cast<JSONnumber>(currentValue);
+			allBuffers[currentPair.first] = binaryChunk;
 
-			target = (GLenum)currentTarget->getIntegerValue();
+			continue;
 		}
 
-		//
-
-		GlTfBufferViewSP currentGlTfBufferView = GlTfBufferViewSP(new GlTfBufferView((const uint8_t*)currentBuffer->second.binary, currentByteOffset->getIntegerValue(), currentByteLength->getIntegerValue(), target));
+		GlTfBufferTask currentBufferTask;
 
-		allBufferViews[currentKey->getValue()] = currentGlTfBufferView;
-	}
-
-	return true;
-}
+		currentBufferTask.name = currentPair.first;
+		currentBufferTask.fileName = folderName + currentBuffer.uri;
+		currentBufferTask.byteLength = currentBuffer.byteLength;
+		currentBufferTask.result = false;
 
-bool GlTfEntityDecoderFactory::decodeAccessors(const JSONobjectSP& jsonGlTf)
-{
-	JSONstringSP accessorsString = JSONstringSP(new JSONstring("accessors"));
+		allBufferTasks.push_back(currentBufferTask);
 
-	if (!jsonGlTf->hasKey(accessorsString))
-	{
-		return true;
+		allSourceFileNames.push_back(currentBuffer.uri);
 	}
 
-	JSONvalueSP value = jsonGlTf->getValue(accessorsString);
+	//
 
-	if (!value->isJsonObject())
+	for (auto& currentBufferTask : allBufferTasks)
 	{
-		return false;
-	}
+		GlTfBufferTask* bufferTask = &currentBufferTask;
 
-	JSONobjectSP accessorsObject = dynamic_pointer_cast<JSONobject>(value);
+		publishDecodeCommand([bufferTask]() { return mapBuffer(*bufferTask); }, bufferTask->result);
+	}
 
-	JSONstringSP bufferViewString = JSONstringSP(new JSONstring("bufferView"));
-	JSONstringSP byteOffestString = JSONstringSP(new JSONstring("byteOffset"));
-	JSONstringSP byteStrideString = JSONstringSP(new JSONstring("byteStride"));
-	JSONstringSP componentTypeString = JSONstringSP(new JSONstring("componentType"));
-	JSONstringSP countString = JSONstringSP(new JSONstring("count"));
-	JSONstringSP typeString = JSONstringSP(new JSONstring("type"));
+	waitDecodeAllFinished();
 
-	for (auto& currentKey : accessorsObject->getAllKeys())
+	for (auto& currentBufferTask : allBufferTasks)
 	{
-		JSONvalueSP currentValue = accessorsObject->getValue(currentKey);
-
-		if (!currentValue->isJsonObject())
+		if (!currentBufferTask.result)
 		{
 			return false;
 		}
 
-		JSONobjectSP currentAccessor = dynamic_pointer_cast<JSONobject>(currentValue);
-
-		//
+		allBuffers[currentBufferTask.name] = GlTfBufferViewSP(new GlTfBufferView(currentBufferTask.mappedFile, currentBufferTask.mappedFile->getData(), 0, currentBufferTask.byteLength, 0));
+	}
 
-		currentValue = currentAccessor->getValue(bufferViewString);
-		if (!currentValue->isJsonString())
-		{
-			return false;
-		}
+	return true;
+}
 
-		JSONstringSP bufferViewString = dynamic_pointer_cast<JSONstring>(currentValue);
+bool GlTfEntityDecoderFactory::decodeBufferViews(const GlTfJsonHandler& jsonHandler)
+{
+	for (auto& currentPair : jsonHandler.getAllBufferViewDescriptions())
+	{
+		const GlTfBufferViewDescription& currentBufferView = currentPair.second;
 
 		//
 
-		auto currentBufferView = allBufferViews.find(bufferViewString->getValue());
+		auto currentBuffer = allBuffers.find(currentBufferView.buffer);
 
-		if (currentBufferView == allBufferViews.end())
+		if (currentBuffer == allBuffers.end())
 		{
 			return false;
 		}
 
 		//
 
-		currentValue = currentAccessor->getValue(byteOffestString);
-		if (!currentValue->isJsonNumber())
+		if (currentBufferView.byteOffset < 0 || currentBufferView.byteOffset >= currentBuffer->second->getByteLength())
 		{
 			return false;
 		}
 
-		JSONnumberSP currentByteOffset = dynamic_pointer_cast<JSONnumber>(currentValue);
+		//
 
-		if (currentByteOffset->getIntegerValue() >= currentBufferView->second->getByteLength())
+		if (currentBufferView.byteLength < 0 || (int64_t)currentBufferView.byteOffset + (int64_t)currentBufferView.byteLength > (int64_t)currentBuffer->second->getByteLength())
 		{
 			return false;
 		}
 
 		//
 
-		currentValue = currentAccessor->getValue(byteStrideString);
-		if (!currentValue->isJsonNumber())
-		{
-			return false;
-		}
+		GlTfBufferViewSP currentGlTfBufferView = GlTfBufferViewSP(new GlTfBufferView(currentBuffer->second->getMappedFile(), currentBuffer->second->getData(), currentBufferView.byteOffset, currentBufferView.byteLength, currentBufferView.target));
+
+		allBufferViews[currentPair.first] = currentGlTfBufferView;
+	}
+
+	return true;
+}
 
-		JSONnumberSP currentByteStride = dynamic_pointer_cast<JSONnumber>(currentValue);
+bool GlTfEntityDecoderFactory::decodeAccessors(const GlTfJsonHandler& jsonHandler)
+{
+	for (auto& currentPair : jsonHandler.getAllAccessorDescriptions())
+	{
+		const GlTfAccessorDescription& currentAccessor = currentPair.second;
 
 		//
 
-		currentValue = currentAccessor->getValue(componentTypeString);
-		if (!currentValue->isJsonNumber())
+		auto currentBufferView = allBufferViews.find(currentAccessor.bufferView);
+
+		if (currentBufferView == allBufferViews.end())
 		{
 			return false;
 		}
 
-		JSONnumberSP currentComponentType = dynamic_pointer_cast<JSONnumber>(currentValue);
-
-		GLenum componentType = (GLenum)currentComponentType->getIntegerValue();
-
 		//
 
-		currentValue = currentAccessor->getValue(countString);
-		if (!currentValue->isJsonNumber())
+		if (currentAccessor.byteOffset < 0 || currentAccessor.byteOffset >= currentBufferView->second->getByteLength())
 		{
 			return false;
 		}
 
-		JSONnumberSP currentCount = dynamic_pointer_cast<JSONnumber>(currentValue);
-
 		//
 
-		currentValue = currentAccessor->getValue(typeString);
-		if (!currentValue->isJsonString())
+		if (currentAccessor.byteStride < 0 || currentAccessor.componentType == 0 || currentAccessor.count < 0 || currentAccessor.type == "")
 		{
 			return false;
 		}
 
-		JSONstringSP currentType = dynamic_pointer_cast<JSONstring>(currentValue);
-
 		//
 
-		GlTfAccessorSP currentGlTfAccessor = GlTfAccessorSP(new GlTfAccessor(currentBufferView->second, currentByteOffset->getIntegerValue(), currentByteStride->getIntegerValue(), componentType, currentCount->getIntegerValue(), currentType->getValue()));
+		GlTfAccessorSP currentGlTfAccessor = GlTfAccessorSP(new GlTfAccessor(currentBufferView->second, currentAccessor.byteOffset, currentAccessor.byteStride, currentAccessor.componentType, currentAccessor.count, currentAccessor.type, currentAccessor.normalized));
+
+		// All elements have to be inside the buffer view, as the data is accessed directly.
+		if (currentGlTfAccessor->getNumberComponents() == 0 || currentGlTfAccessor->getComponentSize() == 0 || (int64_t)currentAccessor.byteOffset + currentGlTfAccessor->getByteLength() > (int64_t)currentBufferView->second->getByteLength())
+		{
+			return false;
+		}
 
-		allAccessors[currentKey->getValue()] = currentGlTfAccessor;
+		allAccessors[currentPair.first] = currentGlTfAccessor;
 	}
 
 	return true;
@@ -350,14 +316,30 @@ bool GlTfEntityDecoderFactory::decodeImages(const JSONobjectSP& jsonGlTf, const
 	JSONobjectSP imagesObject = dynamic_pointer_cast<JSONobject>(value);
 
 	JSONstringSP uriString = JSONstringSP(new JSONstring("uri"));
-
-	GLUStgaimage tgaimage;
-	GLUShdrimage hdrimage;
+	JSONstringSP bufferViewString = JSONstringSP(new JSONstring("bufferView"));
+	JSONstringSP mimeTypeString = JSONstringSP(new JSONstring("mimeType"));
+	JSONstringSP extensionsString = JSONstringSP(new JSONstring("extensions"));
+	JSONstringSP binaryGlTFString = JSONstringSP(new JSONstring(GLTF_GLB_EXTENSION));
 
 	string extension;
 
+	// All images are collected first, as they are decoded at the same time.
+	vector<GlTfImageTask> allImageTasks(imagesObject->getAllKeys().size());
+
+	size_t index = 0;
+
 	for (auto& currentKey : imagesObject->getAllKeys())
 	{
+		GlTfImageTask& currentImageTask = allImageTasks[index];
+
+		index++;
+
+		currentImageTask.name = currentKey->getValue();
+		currentImageTask.hdr = false;
+		currentImageTask.result = false;
+
+		//
+
 		JSONvalueSP currentValue = imagesObject->getValue(currentKey);
 
 		if (!currentValue->isJsonObject())
@@ -367,6 +349,49 @@ bool GlTfEntityDecoderFactory::decodeImages(const JSONobjectSP& jsonGlTf, const
 
 		JSONobjectSP currentImage = dynamic_pointer_cast<JSONobject>(currentValue);
 
+		// Image embedded in the body of a binary glTF.
+		JSONobjectSP extensionsObject;
+
+		if (currentImage->hasKey(extensionsString))
+		{
+			currentValue = currentImage->getValue(extensionsString);
+			if (!currentValue->isJsonObject())
+			{
+				return false;
+			}
+
+			extensionsObject = dynamic_pointer_cast<JSONobject>(currentValue);
+		}
+
+		if (extensionsObject.get() && extensionsObject->hasKey(binaryGlTFString))
+		{
+			currentValue = extensionsObject->getValue(binaryGlTFString);
+			if (!currentValue->isJsonObject())
+			{
+				return false;
+			}
+
+			JSONobjectSP binaryGlTFObject = dynamic_pointer_cast<JSONobject>(currentValue);
+
+			string bufferViewValue;
+
+			if (!decodeString(bufferViewValue, binaryGlTFObject->getValue(bufferViewString)) || !decodeString(currentImageTask.mimeType, binaryGlTFObject->getValue(mimeTypeString)))
+			{
+				return false;
+			}
+
+			auto bufferView = allBufferViews.find(bufferViewValue);
+
+			if (bufferView == allBufferViews.end())
+			{
+				return false;
+			}
+
+			currentImageTask.bufferView = bufferView->second;
+
+			continue;
+		}
+
 		//
 
 		currentValue = currentImage->getValue(uriString);
@@ -390,33 +415,55 @@ bool GlTfEntityDecoderFactory::decodeImages(const JSONobjectSP& jsonGlTf, const
 
 		if (extension == "tga")
 		{
-			glusLogPrint(GLUS_LOG_INFO, "Loading image '%s'", (folderName + currentUri->getValue()).c_str());
-
-			if (!glusImageLoadTga((GLUSchar*)(folderName + currentUri->getValue()).c_str(), &tgaimage))
-			{
-				return false;
-			}
-
-			allTgaImages[currentKey->getValue()] = tgaimage;
+			currentImageTask.hdr = false;
 		}
 		else if (extension == "hdr")
 		{
-			glusLogPrint(GLUS_LOG_INFO, "Loading image '%s'", (folderName + currentUri->getValue()).c_str());
+			currentImageTask.hdr = true;
+		}
+		else
+		{
+			return false;
+		}
 
-			if (!glusImageLoadHdr((GLUSchar*)(folderName + currentUri->getValue()).c_str(), &hdrimage))
-			{
-				return false;
-			}
+		currentImageTask.fileName = folderName + currentUri->getValue();
+
+		allSourceFileNames.push_back(currentUri->getValue());
+	}
+
+	//
+
+	for (auto& currentImageTask : allImageTasks)
+	{
+		GlTfImageTask* imageTask = &currentImageTask;
+
+		publishDecodeCommand([imageTask]() { return imageTask->bufferView.get() ? decodeImage(*imageTask) : loadImage(*imageTask); }, imageTask->result);
+	}
+
+	waitDecodeAllFinished();
 
-			allHdrImages[currentKey->getValue()] = hdrimage;
+	// Also the successfully loaded images are stored in case of an error, so they are released.
+	bool result = true;
+
+	for (auto& currentImageTask : allImageTasks)
+	{
+		if (!currentImageTask.result)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not load image '%s'", currentImageTask.name.c_str());
+
+			result = false;
+		}
+		else if (currentImageTask.hdr)
+		{
+			allHdrImages[currentImageTask.name] = currentImageTask.hdrImage;
 		}
 		else
 		{
-			return false;
+			allTgaImages[currentImageTask.name] = currentImageTask.tgaImage;
 		}
 	}
 
-	return true;
+	return result;
 }
 
 bool GlTfEntityDecoderFactory::decodeSamplers(const JSONobjectSP& jsonGlTf)
@@ -2012,39 +2059,66 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 {
 	ModelEntitySP result;
 
-	GLUStextfile textfile;
-
 	string completeFilename = folderName + fileName;
 
-	if (!glusFileLoadText((const GLUSchar*)completeFilename.c_str(), &textfile))
+	allSourceFileNames.clear();
+	allSourceFileNames.push_back(fileName);
+
+	MappedFileSP mappedFile = MappedFileSP(new MappedFile());
+
+	if (!mappedFile->open(completeFilename))
 	{
 		glusLogPrint(GLUS_LOG_ERROR, "Could not load '%s'", completeFilename.c_str());
 
 		return result;
 	}
 
-	JSONdecoder decoder;
+	const char* jsonBegin = (const char*)mappedFile->getData();
+	const char* jsonEnd = (const char*)mappedFile->getData() + mappedFile->getLength();
 
-	string jsonText((char*)textfile.text);
+	// Binary glTF: the JSON content is parsed and the body is used in place.
+	GlTfBufferViewSP binaryChunk;
 
-	JSONvalueSP jsonResult;
-
-	if (!decoder.decode(jsonText, jsonResult))
+	if (GlTfGlb::isGlb(mappedFile->getData(), mappedFile->getLength()))
 	{
-		glusFileDestroyText(&textfile);
+		GlTfGlb glb;
 
-		glusLogPrint(GLUS_LOG_ERROR, "Could not load '%s'", completeFilename.c_str());
+		if (!glb.decode(mappedFile->getData(), mappedFile->getLength()) || glb.getBinaryLength() > (size_t)INT32_MAX)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not decode binary glTF '%s'", completeFilename.c_str());
 
-		return result;
-	}
+			return result;
+		}
 
-	glusFileDestroyText(&textfile);
+		jsonBegin = glb.getJsonBegin();
+		jsonEnd = glb.getJsonEnd();
 
-	//
+		if (glb.getBinary())
+		{
+			binaryChunk = GlTfBufferViewSP(new GlTfBufferView(mappedFile, glb.getBinary(), 0, (int32_t)glb.getBinaryLength(), 0));
 
-	glusLogPrint(GLUS_LOG_INFO, "Decoded '%s'", completeFilename.c_str());
+			mappedFile->advise(glb.getBinary() - mappedFile->getData(), glb.getBinaryLength(), MAPPED_FILE_SEQUENTIAL);
+		}
+	}
 
-	nodeTreeFactory.reset();
+	// Buffers, buffer views and accessors are decoded directly, only the remaining properties are built as JSON values.
+
+	GlTfJsonHandler jsonHandler;
+
+	JSONreader reader(jsonHandler);
+
+	if (!reader.read(jsonBegin, jsonEnd))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not load '%s'", completeFilename.c_str());
+
+		return result;
+	}
+
+	//
+
+	glusLogPrint(GLUS_LOG_INFO, "Decoded '%s'", completeFilename.c_str());
+
+	nodeTreeFactory.reset();
 
 	doReset = true;
 
@@ -2054,14 +2128,7 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 
 	//
 
-	if (!jsonResult->isJsonObject())
-	{
-		glusLogPrint(GLUS_LOG_ERROR, "glTF not found");
-
-		return result;
-	}
-
-	JSONobjectSP jsonGlTf = dynamic_pointer_cast<JSONobject>(jsonResult);
+	const JSONobjectSP& jsonGlTf = jsonHandler.getJsonGlTf();
 
 	//
 
@@ -2146,7 +2213,7 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 
 	// Decode Buffers etc.
 
-	if (!decodeBuffers(jsonGlTf, folderName))
+	if (!decodeBuffers(jsonHandler, folderName, binaryChunk))
 	{
 		glusLogPrint(GLUS_LOG_ERROR, "Could not decode buffers");
 
@@ -2155,7 +2222,7 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 		return result;
 	}
 
-	if (!decodeBufferViews(jsonGlTf))
+	if (!decodeBufferViews(jsonHandler))
 	{
 		glusLogPrint(GLUS_LOG_ERROR, "Could not decode buffer views");
 
@@ -2164,7 +2231,7 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 		return result;
 	}
 
-	if (!decodeAccessors(jsonGlTf))
+	if (!decodeAccessors(jsonHandler))
 	{
 		glusLogPrint(GLUS_LOG_ERROR, "Could not decode accessors");
 
@@ -2224,6 +2291,8 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 		return result;
 	}
 
+	decodeMeshArrays();
+
 	//
 
 	if (!decodeSkins(jsonGlTf))
@@ -2331,194 +2400,667 @@ ModelEntitySP GlTfEntityDecoderFactory::loadGlTfModelFile(const string& identifi
 	return result;
 }
 
-void GlTfEntityDecoderFactory::processMinMax(const float* vertices, int32_t numberVertices, const Matrix4x4& matrix)
+const float* GlTfEntityDecoderFactory::mapFloats(const GlTfAccessorSP& accessor, int32_t numberComponents, uint32_t count, vector<shared_ptr<const void> >& allOwners) const
+{
+	if (accessor->getCount() < 0 || (uint32_t)accessor->getCount() < count)
+	{
+		return nullptr;
+	}
+
+	const MappedFileSP& mappedFile = accessor->getBufferView()->getMappedFile();
+
+	const uint8_t* data = accessor->getData();
+
+	int32_t stride = accessor->getElementStride();
+
+	mappedFile->advise((size_t)(data - mappedFile->getData()), (size_t)stride * (size_t)count, MAPPED_FILE_WILL_NEED);
+
+	if (accessor->getComponentType() == GL_FLOAT && accessor->getNumberComponents() == numberComponents && stride == numberComponents * (int32_t)sizeof(float) && (uintptr_t)data % sizeof(float) == 0)
+	{
+		allOwners.push_back(mappedFile);
+
+		return (const float*)data;
+	}
+
+	float* converted = new float[numberComponents * count];
+
+	allOwners.push_back(shared_ptr<const void>(converted, default_delete<float[]>()));
+
+	// A direction with two components is octahedral encoded. Missing w is one, e.g. for positions with three components.
+	bool octahedral = numberComponents == 3 && accessor->getNumberComponents() == 2;
+
+	VertexFormat format(accessor->getComponentType(), accessor->getNumberComponents(), accessor->isNormalized() ? GL_TRUE : GL_FALSE, octahedral, stride);
+
+	format.unpack(converted, numberComponents, data, count);
+
+	return converted;
+}
+
+const void* GlTfEntityDecoderFactory::mapPacked(const GlTfAccessorSP& accessor, int32_t numberComponents, bool direction, uint32_t count, VertexFormat& format, vector<shared_ptr<const void> >& allOwners) const
 {
-	GLfloat vertex[4];
+	if (accessor->getCount() < 0 || (uint32_t)accessor->getCount() < count)
+	{
+		return nullptr;
+	}
 
-	// Calculate bounding sphere from existing vertices in mesh
-	for (int32_t i = 0; i < numberVertices; i++)
+	GLenum componentType = accessor->getComponentType();
+
+	if (componentType != GL_BYTE && componentType != GL_UNSIGNED_BYTE && componentType != GL_SHORT && componentType != GL_UNSIGNED_SHORT)
 	{
-		glusMatrix4x4MultiplyPoint4f(vertex, matrix.getM(), &vertices[i * 4]);
+		return nullptr;
+	}
 
-		if (doReset)
-		{
-			minX = vertex[0];
-			maxX = vertex[0];
-			minY = vertex[1];
-			maxY = vertex[1];
-			minZ = vertex[2];
-			maxZ = vertex[2];
+	const uint8_t* data = accessor->getData();
+
+	int32_t stride = accessor->getElementStride();
+
+	int32_t componentSize = accessor->getComponentSize();
+
+	if (stride % componentSize != 0 || (uintptr_t)data % componentSize != 0)
+	{
+		return nullptr;
+	}
+
+	int32_t size = accessor->getNumberComponents();
 
-			doReset = false;
+	bool octahedral = false;
+
+	if (direction)
+	{
+		// Directions have to be normalized, either with three or four components or octahedral encoded in two.
+		if (!accessor->isNormalized())
+		{
+			return nullptr;
 		}
-		else
+
+		if (size == 2)
 		{
-			if (vertex[0] < minX)
-			{
-				minX = vertex[0];
-			}
-			if (vertex[0] > maxX)
-			{
-				maxX = vertex[0];
-			}
-			if (vertex[1] < minY)
+			if (componentType != GL_BYTE && componentType != GL_SHORT)
 			{
-				minY = vertex[1];
+				return nullptr;
 			}
-			if (vertex[1] > maxY)
+
+			octahedral = true;
+		}
+		else if (size >= numberComponents)
+		{
+			// E.g. the handedness in w of a tangent is not used.
+			size = numberComponents;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+	else if (size != numberComponents && !(numberComponents == 4 && size == 3))
+	{
+		// Only positions may have less components, as w is one by default.
+		return nullptr;
+	}
+
+	format = VertexFormat(componentType, size, accessor->isNormalized() ? GL_TRUE : GL_FALSE, octahedral, stride);
+
+	const MappedFileSP& mappedFile = accessor->getBufferView()->getMappedFile();
+
+	mappedFile->advise((size_t)(data - mappedFile->getData()), format.getByteSize(count), MAPPED_FILE_WILL_NEED);
+
+	allOwners.push_back(mappedFile);
+
+	return data;
+}
+
+const void* GlTfEntityDecoderFactory::mapAttribute(const GlTfAccessorSP& accessor, int32_t numberComponents, bool direction, uint32_t count, VertexFormat& format, vector<shared_ptr<const void> >& allOwners) const
+{
+	const void* data = mapPacked(accessor, numberComponents, direction, count, format, allOwners);
+
+	if (data != nullptr)
+	{
+		return data;
+	}
+
+	format = VertexFormat(numberComponents);
+
+	return mapFloats(accessor, numberComponents, count, allOwners);
+}
+
+const uint32_t* GlTfEntityDecoderFactory::mapIndices(const vector<GlTfPrimitiveSP>& allPrimitives, vector<uint32_t>& allIndicesOffsets, uint32_t& numberIndices, vector<shared_ptr<const void> >& allOwners) const
+{
+	allIndicesOffsets.clear();
+
+	numberIndices = 0;
+
+	if (allPrimitives.size() == 0)
+	{
+		return nullptr;
+	}
+
+	const GlTfBufferViewSP& bufferView = allPrimitives[0]->getIndices()->getBufferView();
+
+	const uint8_t* begin = nullptr;
+	const uint8_t* end = nullptr;
+
+	uint64_t totalLength = 0;
+
+	bool inPlace = true;
+
+	for (auto& currentPrimitive : allPrimitives)
+	{
+		const GlTfAccessorSP& accessor = currentPrimitive->getIndices();
+
+		if (accessor->getNumberComponents() != 1 || accessor->getCount() < 0)
+		{
+			return nullptr;
+		}
+
+		if (accessor->getComponentType() != GL_UNSIGNED_BYTE && accessor->getComponentType() != GL_UNSIGNED_SHORT && accessor->getComponentType() != GL_UNSIGNED_INT)
+		{
+			return nullptr;
+		}
+
+		const uint8_t* data = accessor->getData();
+
+		numberIndices += (uint32_t)accessor->getCount();
+
+		totalLength += (uint64_t)accessor->getCount() * sizeof(uint32_t);
+
+		if (accessor->getBufferView() != bufferView || accessor->getComponentType() != GL_UNSIGNED_INT || accessor->getElementStride() != (int32_t)sizeof(uint32_t) || (uintptr_t)data % sizeof(uint32_t) != 0)
+		{
+			inPlace = false;
+
+			continue;
+		}
+
+		if (begin == nullptr || data < begin)
+		{
+			begin = data;
+		}
+
+		if (end == nullptr || data + (size_t)accessor->getCount() * sizeof(uint32_t) > end)
+		{
+			end = data + (size_t)accessor->getCount() * sizeof(uint32_t);
+		}
+	}
+
+	// The primitives usually cover one range of a buffer view. If there is other data in between, it is not uploaded.
+	if (inPlace && (uint64_t)(end - begin) <= totalLength)
+	{
+		const MappedFileSP& mappedFile = bufferView->getMappedFile();
+
+		mappedFile->advise((size_t)(begin - mappedFile->getData()), (size_t)(end - begin), MAPPED_FILE_WILL_NEED);
+
+		for (auto& currentPrimitive : allPrimitives)
+		{
+			allIndicesOffsets.push_back((uint32_t)((currentPrimitive->getIndices()->getData() - begin) / sizeof(uint32_t)));
+		}
+
+		numberIndices = (uint32_t)((end - begin) / sizeof(uint32_t));
+
+		allOwners.push_back(mappedFile);
+
+		return (const uint32_t*)begin;
+	}
+
+	uint32_t* converted = new uint32_t[numberIndices];
+
+	allOwners.push_back(shared_ptr<const void>(converted, default_delete<uint32_t[]>()));
+
+	uint32_t offset = 0;
+
+	for (auto& currentPrimitive : allPrimitives)
+	{
+		const GlTfAccessorSP& accessor = currentPrimitive->getIndices();
+
+		const MappedFileSP& mappedFile = accessor->getBufferView()->getMappedFile();
+
+		const uint8_t* data = accessor->getData();
+
+		int32_t stride = accessor->getElementStride();
+
+		uint32_t count = (uint32_t)accessor->getCount();
+
+		mappedFile->advise((size_t)(data - mappedFile->getData()), (size_t)stride * (size_t)count, MAPPED_FILE_WILL_NEED);
+
+		allIndicesOffsets.push_back(offset);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const uint8_t* element = data + (size_t)i * (size_t)stride;
+
+			if (accessor->getComponentType() == GL_UNSIGNED_BYTE)
 			{
-				maxY = vertex[1];
+				converted[offset + i] = *element;
 			}
-			if (vertex[2] < minZ)
+			else if (accessor->getComponentType() == GL_UNSIGNED_SHORT)
 			{
-				minZ = vertex[2];
+				uint16_t value;
+				memcpy(&value, element, sizeof(uint16_t));
+				converted[offset + i] = value;
 			}
-			if (vertex[2] > maxZ)
+			else
 			{
-				maxZ = vertex[2];
+				memcpy(&converted[offset + i], element, sizeof(uint32_t));
 			}
 		}
+
+		offset += count;
 	}
+
+	return converted;
 }
 
-NodeSP GlTfEntityDecoderFactory::buildNode(const NodeSP& parentNode, const GlTfNodeSP& node, const Matrix4x4& parentMatrix)
+bool GlTfEntityDecoderFactory::mapMeshArrays(GlTfMeshArrays& meshArrays) const
 {
-	Matrix4x4 newParentMatrix(parentMatrix);
+	meshArrays.numberVertices = 0;
 
-	if (node.get() == nullptr)
+	meshArrays.vertices = nullptr;
+	meshArrays.normals = nullptr;
+	meshArrays.bitangents = nullptr;
+	meshArrays.tangents = nullptr;
+	meshArrays.texCoords = nullptr;
+
+	meshArrays.boneIndices0 = nullptr;
+	meshArrays.boneIndices1 = nullptr;
+	meshArrays.boneWeights0 = nullptr;
+	meshArrays.boneWeights1 = nullptr;
+	meshArrays.boneCounters = nullptr;
+
+	meshArrays.numberIndices = 0;
+	meshArrays.indices = nullptr;
+
+	if (meshArrays.allPrimitives.size() == 0)
 	{
-		return NodeSP();
+		return false;
 	}
 
-	MeshSP mesh;
-	CameraSP camera;
-	LightSP light;
-	vector<AnimationStackSP> allAnimStacks;
+	// All primitives use the same accessors, so they are taken from the first one.
+	const GlTfPrimitiveSP& primitive = meshArrays.allPrimitives[0];
+
+	vector<shared_ptr<const void> >& allOwners = meshArrays.allOwners;
+
+	uint32_t numberVertices = static_cast<uint32_t>(primitive->getPosition()->getCount());
+
+	meshArrays.numberVertices = numberVertices;
+
+	meshArrays.vertices = mapAttribute(primitive->getPosition(), 4, false, numberVertices, meshArrays.vertexFormat, allOwners);
+
+	if (primitive->getNormal().get() != nullptr)
+	{
+		meshArrays.normals = mapAttribute(primitive->getNormal(), 3, true, numberVertices, meshArrays.normalFormat, allOwners);
+	}
+
+	if (primitive->getBitangent().get() != nullptr)
+	{
+		meshArrays.bitangents = mapAttribute(primitive->getBitangent(), 3, true, numberVertices, meshArrays.bitangentFormat, allOwners);
+	}
+
+	if (primitive->getTangent().get() != nullptr)
+	{
+		meshArrays.tangents = mapAttribute(primitive->getTangent(), 3, true, numberVertices, meshArrays.tangentFormat, allOwners);
+	}
+
+	// The shader decodes tangents and bitangents the same way.
+	if (meshArrays.bitangents && meshArrays.tangents && meshArrays.bitangentFormat.isOctahedral() != meshArrays.tangentFormat.isOctahedral())
+	{
+		meshArrays.bitangentFormat = VertexFormat(3);
+		meshArrays.bitangents = mapFloats(primitive->getBitangent(), 3, numberVertices, allOwners);
+
+		meshArrays.tangentFormat = VertexFormat(3);
+		meshArrays.tangents = mapFloats(primitive->getTangent(), 3, numberVertices, allOwners);
+	}
+
+	if (primitive->getTexcoord().get() != nullptr)
+	{
+		meshArrays.texCoords = mapAttribute(primitive->getTexcoord(), 2, false, numberVertices, meshArrays.texCoordFormat, allOwners);
+	}
 
 	//
 
-	for (auto& currentMesh : node->getAllMeshes())
+	if (primitive->getBoneIndices0().get() != nullptr)
+	{
+		meshArrays.boneIndices0 = mapFloats(primitive->getBoneIndices0(), 4, numberVertices, allOwners);
+	}
+
+	if (primitive->getBoneIndices1().get() != nullptr)
+	{
+		meshArrays.boneIndices1 = mapFloats(primitive->getBoneIndices1(), 4, numberVertices, allOwners);
+	}
+
+	if (primitive->getBoneWeights0().get() != nullptr)
+	{
+		meshArrays.boneWeights0 = mapFloats(primitive->getBoneWeights0(), 4, numberVertices, allOwners);
+	}
+
+	if (primitive->getBoneWeights1().get() != nullptr)
 	{
-		string name;
-		uint32_t numberVertices;
+		meshArrays.boneWeights1 = mapFloats(primitive->getBoneWeights1(), 4, numberVertices, allOwners);
+	}
+
+	if (primitive->getBoneCounters().get() != nullptr)
+	{
+		meshArrays.boneCounters = mapFloats(primitive->getBoneCounters(), 1, numberVertices, allOwners);
+	}
+
+	//
+
+	meshArrays.indices = mapIndices(meshArrays.allPrimitives, meshArrays.allIndicesOffsets, meshArrays.numberIndices, allOwners);
+
+	return meshArrays.vertices != nullptr && meshArrays.indices != nullptr;
+}
+
+/**
+ * Identifies the data of an accessor, so accessors with different names but the same data are treated as one.
+ */
+static void appendAccessorKey(vector<uintptr_t>& key, const GlTfAccessorSP& accessor)
+{
+	if (accessor.get() == nullptr)
+	{
+		key.push_back(0);
+
+		return;
+	}
+
+	key.push_back((uintptr_t)accessor->getData());
+	key.push_back((uintptr_t)accessor->getElementStride());
+	key.push_back((uintptr_t)accessor->getComponentType());
+	key.push_back((uintptr_t)accessor->getNumberComponents());
+	key.push_back((uintptr_t)accessor->getCount());
+}
+
+bool GlTfEntityDecoderFactory::assignMeshArrays(GlTfDecodedMesh& decodedMesh, const GlTfMeshSP& mesh)
+{
+	if (mesh->getAllPrimitives().size() == 0)
+	{
+		return false;
+	}
+
+	// Primitives with the same attributes share the arrays, also over meshes, so the vertex data is uploaded once.
+	for (auto& currentPrimitive : mesh->getAllPrimitives())
+	{
+		vector<uintptr_t> key;
+
+		appendAccessorKey(key, currentPrimitive->getPosition());
+		appendAccessorKey(key, currentPrimitive->getNormal());
+		appendAccessorKey(key, currentPrimitive->getBitangent());
+		appendAccessorKey(key, currentPrimitive->getTangent());
+		appendAccessorKey(key, currentPrimitive->getTexcoord());
+
+		appendAccessorKey(key, currentPrimitive->getBoneIndices0());
+		appendAccessorKey(key, currentPrimitive->getBoneIndices1());
+		appendAccessorKey(key, currentPrimitive->getBoneWeights0());
+		appendAccessorKey(key, currentPrimitive->getBoneWeights1());
+		appendAccessorKey(key, currentPrimitive->getBoneCounters());
+
+		auto walker = allMeshArraysKeys.find(key);
+
+		if (walker == allMeshArraysKeys.end())
+		{
+			// In order of the first primitive, so the result does not depend on the pointers.
+			walker = allMeshArraysKeys.insert(make_pair(key, allMeshArrays.size())).first;
+
+			allMeshArrays.push_back(GlTfMeshArrays());
+
+			allMeshArrays.back().ownerName = mesh->getName();
+			allMeshArrays.back().valid = false;
+		}
+
+		GlTfMeshArrays& meshArrays = allMeshArrays[walker->second];
+
+		uint32_t index = 0;
+
+		while (index < decodedMesh.allMeshArraysIndices.size() && decodedMesh.allMeshArraysIndices[index] != walker->second)
+		{
+			index++;
+		}
+
+		if (index == decodedMesh.allMeshArraysIndices.size())
+		{
+			decodedMesh.allMeshArraysIndices.push_back(walker->second);
+			decodedMesh.allPrimitivesIndices.push_back(vector<uint32_t>());
+		}
+
+		decodedMesh.allPrimitivesIndices[index].push_back((uint32_t)meshArrays.allPrimitives.size());
+
+		meshArrays.allPrimitives.push_back(currentPrimitive);
+	}
+
+	return true;
+}
+
+bool GlTfEntityDecoderFactory::buildMeshes(GlTfDecodedMesh& decodedMesh, const string& name)
+{
+	if (!decodedMesh.valid)
+	{
+		return false;
+	}
+
+	// Already built for another node.
+	if (decodedMesh.allBuiltMeshes.size() > 0)
+	{
+		return true;
+	}
+
+	char buffer[128];
 
-		float* vertices = nullptr;
-		float* normals = nullptr;
-		float* bitangents = nullptr;
-		float* tangents = nullptr;
-		float* texCoords = nullptr;
+	for (uint32_t i = 0; i < decodedMesh.allMeshArraysIndices.size(); i++)
+	{
+		GlTfMeshArrays& arrays = allMeshArrays[decodedMesh.allMeshArraysIndices[i]];
 
-		float* boneIndices0 = nullptr;
-		float* boneIndices1 = nullptr;
-		float* boneWeights0 = nullptr;
-		float* boneWeights1 = nullptr;
-		float* boneCounters = nullptr;
+		// The buffers are uploaded by the owner, even if it is not used by a node. Only if the owner is invalid, this mesh uploads them.
+		if (arrays.ownerName != name && !arrays.ownerMesh.get())
+		{
+			buildMeshes(allDecodedMeshes[arrays.ownerName], arrays.ownerName);
+		}
 
-		uint32_t numberIndices;
-		uint32_t* indices = nullptr;
 		map<int32_t, SubMeshSP> subMeshes;
 		map<int32_t, SurfaceMaterialSP> surfaceMaterials;
 
-		name = currentMesh->getName();
+		for (uint32_t k = 0; k < decodedMesh.allPrimitivesIndices[i].size(); k++)
+		{
+			uint32_t primitiveIndex = decodedMesh.allPrimitivesIndices[i][k];
+
+			const GlTfPrimitiveSP& currentPrimitive = arrays.allPrimitives[primitiveIndex];
+
+			subMeshes[(int32_t)k] = SubMeshSP(new SubMesh(arrays.allIndicesOffsets[primitiveIndex], (uint32_t)currentPrimitive->getIndices()->getCount() / 3));
+
+			surfaceMaterials[(int32_t)k] = currentPrimitive->getSurfaceMaterial();
+		}
+
+		// Further meshes need an unique name, e.g. for saving.
+		string meshName = name;
 
-		int32_t index = 0;
+		if (i > 0)
+		{
+			sprintf(buffer, "_%03u", i);
+
+			meshName += buffer;
+		}
+
+		MeshSP mesh;
+
+		if (arrays.ownerMesh.get())
+		{
+			mesh = MeshSP(new Mesh(meshName, arrays.ownerMesh, subMeshes, surfaceMaterials));
 
-		for (auto& currentPrimitive : currentMesh->getAllPrimitives())
+			skinned = skinned || mesh->hasSkinning();
+		}
+		else
 		{
-			// Only shared attributes supported
-			if (index == 0)
+			// The arrays are ready, so only the upload is done here. The mesh must not delete the mapped data.
+			mesh = MeshSP(new Mesh(meshName, arrays.numberVertices, arrays.vertices, arrays.vertexFormat, arrays.normals, arrays.normalFormat, arrays.bitangents, arrays.bitangentFormat, arrays.tangents, arrays.tangentFormat, arrays.texCoords, arrays.texCoordFormat, arrays.numberIndices, arrays.indices, subMeshes, surfaceMaterials, arrays.allOwners));
+
+			if (arrays.boneIndices0 && arrays.boneIndices1 && arrays.boneWeights0 && arrays.boneWeights1 && arrays.boneCounters)
 			{
-				numberVertices = static_cast<uint32_t>(currentPrimitive->getPosition()->getCount());
+				mesh->addSkinningData(const_cast<float*>(arrays.boneIndices0), const_cast<float*>(arrays.boneIndices1), const_cast<float*>(arrays.boneWeights0), const_cast<float*>(arrays.boneWeights1), const_cast<float*>(arrays.boneCounters));
 
-				vertices = new float[4 * numberVertices];
-				memcpy(vertices, currentPrimitive->getPosition()->getData(), 4 * sizeof(float) * numberVertices);
+				skinned = true;
+			}
 
-				if (currentPrimitive->getNormal().get() != nullptr)
-				{
-					normals = new float[3 * numberVertices];
-					memcpy(normals, currentPrimitive->getNormal()->getData(), 3 * sizeof(float) * numberVertices);
-				}
+			arrays.ownerMesh = mesh;
+		}
 
-				if (currentPrimitive->getBitangent().get() != nullptr)
-				{
-					bitangents = new float[3 * numberVertices];
-					memcpy(bitangents, currentPrimitive->getBitangent()->getData(), 3 * sizeof(float) * numberVertices);
-				}
+		decodedMesh.allBuiltMeshes.push_back(mesh);
+	}
 
-				if (currentPrimitive->getTangent().get() != nullptr)
-				{
-					tangents = new float[3 * numberVertices];
-					memcpy(tangents, currentPrimitive->getTangent()->getData(), 3 * sizeof(float) * numberVertices);
-				}
+	return true;
+}
 
-				if (currentPrimitive->getTexcoord().get() != nullptr)
-				{
-					texCoords = new float[2 * numberVertices];
-					memcpy(texCoords, currentPrimitive->getTexcoord()->getData(), 2 * sizeof(float) * numberVertices);
-				}
+void GlTfEntityDecoderFactory::decodeMeshArrays()
+{
+	// The arrays are assigned on this thread, so the workers do not change the containers and the owners are always the
+	// same. Invalid meshes only fail, if they are used.
+	for (auto& currentMeshPair : allMeshes)
+	{
+		GlTfDecodedMesh& decodedMesh = allDecodedMeshes[currentMeshPair.first];
+
+		decodedMesh.valid = assignMeshArrays(decodedMesh, currentMeshPair.second);
+	}
+
+	for (auto& currentMeshArrays : allMeshArrays)
+	{
+		GlTfMeshArrays* meshArrays = &currentMeshArrays;
+
+		publishDecodeCommand([this, meshArrays]() { return mapMeshArrays(*meshArrays); }, meshArrays->valid);
+	}
 
-				//
+	waitDecodeAllFinished();
 
-				if (currentPrimitive->getBoneIndices0().get() != nullptr)
+	for (auto& currentDecodedMeshPair : allDecodedMeshes)
+	{
+		GlTfDecodedMesh& decodedMesh = currentDecodedMeshPair.second;
+
+		for (auto currentMeshArraysIndex : decodedMesh.allMeshArraysIndices)
+		{
+			decodedMesh.valid = decodedMesh.valid && allMeshArrays[currentMeshArraysIndex].valid;
+		}
+	}
+}
+
+void GlTfEntityDecoderFactory::publishDecodeCommand(const function<bool()>& task, bool& result)
+{
+	if (WorkerManager::getInstance()->getNumberWorkers() == 0)
+	{
+		result = task();
+
+		return;
+	}
+
+	WorkerManager::getInstance()->sendCommand(new GlTfDecodeCommand(decodeTaskCounter, task, &result));
+}
+
+void GlTfEntityDecoderFactory::waitDecodeAllFinished() const
+{
+	decodeTaskCounter->waitUntilZero();
+}
+
+void GlTfEntityDecoderFactory::processMinMax(const MeshSP& mesh, const Matrix4x4& matrix)
+{
+	if (mesh->getVertices())
+	{
+		processMinMax(mesh->getVertices(), mesh->getNumberVertices(), matrix);
+
+		return;
+	}
+
+	// The bounds are calculated from the dequantized vertices.
+	vector<float> vertices((size_t)mesh->getNumberVertices() * 4);
+
+	mesh->getVertexFormat().unpack(vertices.data(), 4, mesh->getVertexData(), mesh->getNumberVertices());
+
+	processMinMax(vertices.data(), mesh->getNumberVertices(), matrix);
+}
+
+void GlTfEntityDecoderFactory::processMinMax(const float* vertices, int32_t numberVertices, const Matrix4x4& matrix)
+{
+	GLfloat transformedVertices[4 * GE_SIMD_BATCH_SIZE];
+
+	// Calculate bounding sphere from existing vertices in mesh. Transformed in batches, to use the SIMD path without a big buffer.
+	for (int32_t offset = 0; offset < numberVertices; offset += GE_SIMD_BATCH_SIZE)
+	{
+		int32_t batchSize = min(numberVertices - offset, GE_SIMD_BATCH_SIZE);
+
+		simdMatrix4x4MultiplyPoints4f(transformedVertices, matrix.getM(), &vertices[offset * 4], batchSize);
+
+		for (int32_t i = 0; i < batchSize; i++)
+		{
+			const GLfloat* vertex = &transformedVertices[i * 4];
+
+			if (doReset)
+			{
+				minX = vertex[0];
+				maxX = vertex[0];
+				minY = vertex[1];
+				maxY = vertex[1];
+				minZ = vertex[2];
+				maxZ = vertex[2];
+
+				doReset = false;
+			}
+			else
+			{
+				if (vertex[0] < minX)
 				{
-					boneIndices0 = new float[4 * numberVertices];
-					memcpy(boneIndices0, currentPrimitive->getBoneIndices0()->getData(), 4 * sizeof(float) * numberVertices);
+					minX = vertex[0];
 				}
-
-				if (currentPrimitive->getBoneIndices1().get() != nullptr)
+				if (vertex[0] > maxX)
 				{
-					boneIndices1 = new float[4 * numberVertices];
-					memcpy(boneIndices1, currentPrimitive->getBoneIndices1()->getData(), 4 * sizeof(float) * numberVertices);
+					maxX = vertex[0];
 				}
-
-				if (currentPrimitive->getBoneWeights0().get() != nullptr)
+				if (vertex[1] < minY)
 				{
-					boneWeights0 = new float[4 * numberVertices];
-					memcpy(boneWeights0, currentPrimitive->getBoneWeights0()->getData(), 4 * sizeof(float) * numberVertices);
+					minY = vertex[1];
 				}
-
-				if (currentPrimitive->getBoneWeights1().get() != nullptr)
+				if (vertex[1] > maxY)
 				{
-					boneWeights1 = new float[4 * numberVertices];
-					memcpy(boneWeights1, currentPrimitive->getBoneWeights1()->getData(), 4 * sizeof(float) * numberVertices);
+					maxY = vertex[1];
 				}
-
-				if (currentPrimitive->getBoneCounters().get() != nullptr)
+				if (vertex[2] < minZ)
 				{
-					boneCounters = new float[numberVertices];
-					memcpy(boneCounters, currentPrimitive->getBoneCounters()->getData(), sizeof(float) * numberVertices);
+					minZ = vertex[2];
+				}
+				if (vertex[2] > maxZ)
+				{
+					maxZ = vertex[2];
 				}
-
-				//
-
-				numberIndices = static_cast<uint32_t>(currentPrimitive->getIndices()->getCount());
-
-				indices = new uint32_t[numberIndices];
-				memcpy(indices, currentPrimitive->getIndices()->getData(), sizeof(uint32_t) * numberIndices);
 			}
+		}
+	}
+}
 
-			SubMeshSP currentSubMesh = SubMeshSP(new SubMesh(currentPrimitive->getIndices()->getByteOffset(), currentPrimitive->getIndices()->getCount()));
+NodeSP GlTfEntityDecoderFactory::buildNode(const NodeSP& parentNode, const GlTfNodeSP& node, const Matrix4x4& parentMatrix)
+{
+	Matrix4x4 newParentMatrix(parentMatrix);
 
-			subMeshes[index] = currentSubMesh;
+	if (node.get() == nullptr)
+	{
+		return NodeSP();
+	}
 
-			surfaceMaterials[index] = currentPrimitive->getSurfaceMaterial();
+	MeshSP mesh;
+	CameraSP camera;
+	LightSP light;
+	vector<AnimationStackSP> allAnimStacks;
 
-			index++;
-		}
+	//
 
-		mesh = MeshSP(new Mesh(name, numberVertices, vertices, normals, bitangents, tangents, texCoords, numberIndices, indices, subMeshes, surfaceMaterials));
+	// Every set of attributes is a separate mesh. The first one is attached to the node, the others to child nodes.
+	vector<MeshSP> allNodeMeshes;
 
-		if (boneIndices0 && boneIndices1 && boneWeights0 && boneWeights1 && boneCounters)
-		{
-			mesh->addSkinningData(boneIndices0, boneIndices1, boneWeights0, boneWeights1, boneCounters);
+	for (auto& currentMesh : node->getAllMeshes())
+	{
+		auto decodedMesh = allDecodedMeshes.find(currentMesh->getName());
 
-			skinned = true;
+		if (decodedMesh == allDecodedMeshes.end() || !buildMeshes(decodedMesh->second, currentMesh->getName()))
+		{
+			return NodeSP();
 		}
 
-		// Only one mesh supported.
-		break;
+		allNodeMeshes.insert(allNodeMeshes.end(), decodedMesh->second.allBuiltMeshes.begin(), decodedMesh->second.allBuiltMeshes.end());
 	}
 
+	if (allNodeMeshes.size() > 0)
+	{
+		mesh = allNodeMeshes[0];
+	}
 
 	// Add animations.
 
@@ -2633,7 +3175,29 @@ NodeSP GlTfEntityDecoderFactory::buildNode(const NodeSP& parentNode, const GlTfN
 		matrix = newParentMatrix * result->getGeometricTransformMatrix();
 
 		// Update the min max for the final bounding sphere
-		processMinMax(result->getMesh()->getVertices(), result->getMesh()->getNumberVertices(), matrix);
+		processMinMax(result->getMesh(), matrix);
+
+		// The child nodes of the further meshes do not move, so they only need the geometric transform.
+		const float identityTranslation[3] = {0.0f, 0.0f, 0.0f};
+		const float identityRotation[3] = {0.0f, 0.0f, 0.0f};
+		const float identityScale[3] = {1.0f, 1.0f, 1.0f};
+
+		for (uint32_t i = 1; i < allNodeMeshes.size(); i++)
+		{
+			const MeshSP& currentMesh = allNodeMeshes[i];
+
+			// The name must neither be used by an already created node nor by a glTF node, which is created later.
+			string meshNodeName = node->getName() + "_" + currentMesh->getName();
+
+			for (int32_t suffix = 1; nodeTreeFactory.getNode(meshNodeName).get() != nullptr || allNodes.find(meshNodeName) != allNodes.end(); suffix++)
+			{
+				meshNodeName = node->getName() + "_" + currentMesh->getName() + "_" + to_string(suffix);
+			}
+
+			nodeTreeFactory.createNode(meshNodeName, node->getName(), identityTranslation, Matrix4x4(), identityRotation, Matrix4x4(), identityScale, Matrix4x4(), node->getGeometricTransform(), currentMesh, CameraSP(), LightSP(), vector<AnimationStackSP>());
+
+			processMinMax(currentMesh, matrix);
+		}
 	}
 
 	//
@@ -2651,12 +3215,14 @@ NodeSP GlTfEntityDecoderFactory::buildNode(const NodeSP& parentNode, const GlTfN
 	return result;
 }
 
+const vector<string>& GlTfEntityDecoderFactory::getAllSourceFileNames() const
+{
+	return allSourceFileNames;
+}
+
 void GlTfEntityDecoderFactory::cleanUp()
 {
-	for (auto& currentBuffer : allBuffers)
-	{
-		glusFileDestroyBinary(&currentBuffer.second);
-	}
+	// Mappings still used by meshes are kept alive by them.
 	allBuffers.clear();
 
 	allBufferViews.clear();
@@ -2686,6 +3252,12 @@ void GlTfEntityDecoderFactory::cleanUp()
 
 	allMeshes.clear();
 
+	allDecodedMeshes.clear();
+
+	allMeshArraysKeys.clear();
+
+	allMeshArrays.clear();
+
 
 	allSkins.clear();
 
@@ -11,6 +11,7 @@
 #include "../../UsedLibs.h"
 
 #include "../../layer0/color/Color.h"
+#include "../../layer0/concurrency/ThreadSafeCounter.h"
 #include "../../layer0/json/JSONarray.h"
 #include "../../layer0/json/JSONobject.h"
 #include "../../layer0/json/JSONnumber.h"
@@ -18,18 +19,87 @@
 #include "../../layer0/json/JSONvalue.h"
 #include "../../layer0/math/Matrix3x3.h"
 #include "../../layer0/math/Matrix4x4.h"
+#include "../../layer0/os/MappedFile.h"
 #include "../../layer5/node/NodeTreeFactory.h"
 #include "../../layer2/material/SurfaceMaterial.h"
+#include "../../layer3/mesh/VertexFormat.h"
 #include "../../layer8/modelentity/ModelEntity.h"
 
 #include "GlTfAccessor.h"
 #include "GlTfAnimation.h"
 #include "GlTfBufferView.h"
+#include "GlTfDecodeCommand.h"
+#include "GlTfJsonHandler.h"
 #include "GlTfMesh.h"
 #include "GlTfNode.h"
 #include "GlTfSampler.h"
 #include "GlTfSkin.h"
 
+// Increase, if the imported model changes for the same glTF file, so caches of older imports are not used anymore.
+#define GLTF_IMPORTER_VERSION 1
+
+/**
+ * Attribute arrays of the primitives, which use the same accessors. They point into the mapped buffers or into converted
+ * arrays, which are kept by the owners. Quantized attributes stay packed in their format. The arrays are shared by all
+ * meshes of a file, so the vertex data is uploaded once.
+ */
+struct GlTfMeshArrays
+{
+	GlTfMeshArrays() :
+		vertexFormat(4), normalFormat(3), bitangentFormat(3), tangentFormat(3), texCoordFormat(2)
+	{
+	}
+
+	std::uint32_t numberVertices;
+
+	const void* vertices;
+	const void* normals;
+	const void* bitangents;
+	const void* tangents;
+	const void* texCoords;
+
+	VertexFormat vertexFormat;
+	VertexFormat normalFormat;
+	VertexFormat bitangentFormat;
+	VertexFormat tangentFormat;
+	VertexFormat texCoordFormat;
+
+	const float* boneIndices0;
+	const float* boneIndices1;
+	const float* boneWeights0;
+	const float* boneWeights1;
+	const float* boneCounters;
+
+	std::uint32_t numberIndices;
+	const std::uint32_t* indices;
+
+	// Primitives of all meshes drawn from these arrays and where their indices start, counted in indices.
+	std::vector<GlTfPrimitiveSP> allPrimitives;
+	std::vector<std::uint32_t> allIndicesOffsets;
+
+	std::vector<std::shared_ptr<const void> > allOwners;
+
+	// The first mesh using the arrays uploads them. The meshes of the others draw from its buffers.
+	std::string ownerName;
+	MeshSP ownerMesh;
+
+	bool valid;
+};
+
+/**
+ * A glTF mesh, split into one mesh per set of attributes. The meshes are created once and shared by all nodes.
+ */
+struct GlTfDecodedMesh
+{
+	// Arrays of the factory used by this mesh and the indices of its primitives in them.
+	std::vector<std::size_t> allMeshArraysIndices;
+	std::vector<std::vector<std::uint32_t> > allPrimitivesIndices;
+
+	std::vector<MeshSP> allBuiltMeshes;
+
+	bool valid;
+};
+
 class GlTfEntityDecoderFactory
 {
 
@@ -45,7 +115,11 @@ private:
 
 	bool skinned;
 
-	std::map<std::string, GLUSbinaryfile> allBuffers;
+	// Independent parts are decoded on the worker threads. Only the creation of textures and meshes stays on this thread.
+	ThreadSafeCounterSP decodeTaskCounter;
+
+	// A buffer is either a whole mapped file or the body of a binary glTF.
+	std::map<std::string, GlTfBufferViewSP> allBuffers;
 	std::map<std::string, GlTfBufferViewSP> allBufferViews;
 	std::map<std::string, GlTfAccessorSP> allAccessors;
 
@@ -57,6 +131,11 @@ private:
 	std::map<std::string, SurfaceMaterialSP> allSurfaceMaterials;
 
 	std::map<std::string, GlTfMeshSP> allMeshes;
+	std::map<std::string, GlTfDecodedMesh> allDecodedMeshes;
+
+	// Accessors of the primitives to the index of their arrays, over all meshes.
+	std::map<std::vector<std::uintptr_t>, std::size_t> allMeshArraysKeys;
+	std::vector<GlTfMeshArrays> allMeshArrays;
 
 	std::map<std::string, GlTfSkinSP> allSkins;
 
@@ -64,9 +143,12 @@ private:
 
 	std::map<std::string, GlTfAnimationSP> allAnimations;
 
-	bool decodeBuffers(const JSONobjectSP& jsonGlTf, const std::string& folderName);
-	bool decodeBufferViews(const JSONobjectSP& jsonGlTf);
-	bool decodeAccessors(const JSONobjectSP& jsonGlTf);
+	// Files read by the last load, relative to its folder.
+	std::vector<std::string> allSourceFileNames;
+
+	bool decodeBuffers(const GlTfJsonHandler& jsonHandler, const std::string& folderName, const GlTfBufferViewSP& binaryChunk);
+	bool decodeBufferViews(const GlTfJsonHandler& jsonHandler);
+	bool decodeAccessors(const GlTfJsonHandler& jsonHandler);
 
 	bool decodeImages(const JSONobjectSP& jsonGlTf, const std::string& folderName);
 	bool decodeSamplers(const JSONobjectSP& jsonGlTf);
@@ -75,6 +157,7 @@ private:
 	bool decodeMaterials(const JSONobjectSP& jsonGlTf);
 
 	bool decodeMeshes(const JSONobjectSP& jsonGlTf);
+	void decodeMeshArrays();
 
 	bool decodeSkins(const JSONobjectSP& jsonGlTf);
 
@@ -105,12 +188,52 @@ private:
 
 	//
 
+	/**
+	 * Returns the elements as tightly packed floats. The result points into the mapped buffer, if the layout already
+	 * matches. Otherwise the elements are converted into a new array. Either way, the data is kept alive by the owners.
+	 */
+	const float* mapFloats(const GlTfAccessorSP& accessor, std::int32_t numberComponents, std::uint32_t count, std::vector<std::shared_ptr<const void> >& allOwners) const;
+
+	/**
+	 * Maps quantized integers in place and describes them by the format, see KHR_mesh_quantization. Directions with two
+	 * components are octahedral encoded. Returns null, if the accessor is not quantized or not supported by OpenGL.
+	 */
+	const void* mapPacked(const GlTfAccessorSP& accessor, std::int32_t numberComponents, bool direction, std::uint32_t count, VertexFormat& format, std::vector<std::shared_ptr<const void> >& allOwners) const;
+
+	/**
+	 * Maps the attribute packed if possible, otherwise as floats.
+	 */
+	const void* mapAttribute(const GlTfAccessorSP& accessor, std::int32_t numberComponents, bool direction, std::uint32_t count, VertexFormat& format, std::vector<std::shared_ptr<const void> >& allOwners) const;
+
+	/**
+	 * Returns the indices of all primitives in one array. If they are already stored as one range of unsigned integers,
+	 * the result points into the mapped buffer.
+	 */
+	const std::uint32_t* mapIndices(const std::vector<GlTfPrimitiveSP>& allPrimitives, std::vector<std::uint32_t>& allIndicesOffsets, std::uint32_t& numberIndices, std::vector<std::shared_ptr<const void> >& allOwners) const;
+
+	bool mapMeshArrays(GlTfMeshArrays& meshArrays) const;
+
+	bool assignMeshArrays(GlTfDecodedMesh& decodedMesh, const GlTfMeshSP& mesh);
+
+	bool buildMeshes(GlTfDecodedMesh& decodedMesh, const std::string& name);
+
 	void processMinMax(const float* vertices, std::int32_t numberVertices, const Matrix4x4& matrix);
 
+	void processMinMax(const MeshSP& mesh, const Matrix4x4& matrix);
+
 	NodeSP buildNode(const NodeSP& parentNode, const GlTfNodeSP& node, const Matrix4x4& parentMatrix);
 
 	//
 
+	/**
+	 * Runs the task on a worker thread and stores, if it succeeded. Without workers, the task is run immediately.
+	 */
+	void publishDecodeCommand(const std::function<bool()>& task, bool& result);
+
+	void waitDecodeAllFinished() const;
+
+	//
+
 	void cleanUp();
 
 public:
@@ -121,6 +244,11 @@ public:
 
 	ModelEntitySP loadGlTfModelFile(const std::string& identifier, const std::string& fileName, const std::string& folderName, float scale);
 
+	/**
+	 * The glTF file, its external buffers and images of the last load, relative to the folder.
+	 */
+	const std::vector<std::string>& getAllSourceFileNames() const;
+
 };
 
 #endif /* GLTFENTITYDECODERFACTORY_H_ */
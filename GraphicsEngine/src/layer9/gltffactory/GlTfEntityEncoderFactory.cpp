@@ -7,13 +7,33 @@
 
 #include "../../layer0/algorithm/Quicksort.h"
 #include "../../layer0/json/JSONencoder.h"
+#include "../../layer0/json/JSONfileSink.h"
 #include "../../layer0/os/Directory.h"
 #include "../../layer1/texture/TextureFactory.h"
 
+#include "GlTfGlb.h"
+
 #include "GlTfEntityEncoderFactory.h"
 
 using namespace std;
 
+/**
+ * Returns the attribute as floats. Packed attributes are unpacked, as they are saved as floats.
+ */
+static const float* unpackAttribute(vector<float>& unpacked, const void* data, const VertexFormat& format, int32_t numberComponents, uint32_t count)
+{
+	if (data == nullptr || format.isFloat())
+	{
+		return (const float*)data;
+	}
+
+	unpacked.resize((size_t)count * (size_t)numberComponents);
+
+	format.unpack(&unpacked[0], numberComponents, data, count);
+
+	return &unpacked[0];
+}
+
 GlTfEntityEncoderFactory::GlTfEntityEncoderFactory()
 {
 }
@@ -244,7 +264,7 @@ void GlTfEntityEncoderFactory::addChannelValues(JSONobjectSP& channelObject, con
 	targetObject->addKeyValue(elementString, elementValueString);
 }
 
-void GlTfEntityEncoderFactory::addAnimationBufferBufferViewAccessor(JSONobjectSP& animationsObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const ModelSP& model, const string& folderName) const
+void GlTfEntityEncoderFactory::addAnimationBufferBufferViewAccessor(JSONobjectSP& animationsObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const ModelSP& model, const string& folderName, GlTfBin* binaryBody) const
 {
 	char buffer[128];
 
@@ -255,7 +275,12 @@ void GlTfEntityEncoderFactory::addAnimationBufferBufferViewAccessor(JSONobjectSP
 
 		while (processAnimStacks)
 		{
-			GlTfBin bin;
+			GlTfBin fileBin;
+
+			// In a binary glTF, all data is appended to the body, so the offsets are already the final ones.
+			GlTfBin& bin = binaryBody ? *binaryBody : fileBin;
+
+			bin.addPadding(4);
 
 			string currentAnimation = "animation_";
 
@@ -265,7 +290,7 @@ void GlTfEntityEncoderFactory::addAnimationBufferBufferViewAccessor(JSONobjectSP
 
 			//
 
-			JSONstringSP animationBufferString = JSONstringSP(new JSONstring("buffer_" + currentAnimation));
+			JSONstringSP animationBufferString = JSONstringSP(new JSONstring(binaryBody ? GLTF_GLB_BUFFER : "buffer_" + currentAnimation));
 
 			//
 
@@ -370,6 +395,11 @@ void GlTfEntityEncoderFactory::addAnimationBufferBufferViewAccessor(JSONobjectSP
 				animStackIndex++;
 			}
 
+			if (binaryBody)
+			{
+				continue;
+			}
+
 			//
 			// Buffer
 			//
@@ -420,7 +450,7 @@ void GlTfEntityEncoderFactory::addAsset(JSONobjectSP& assetObject) const
 	assetObject->addKeyValue(versionString, valueString);
 }
 
-void GlTfEntityEncoderFactory::addImage(JSONobjectSP& imagesObject, const JSONstringSP& imageString, const Texture2DSP& texture, const string& folderName) const
+void GlTfEntityEncoderFactory::addImage(JSONobjectSP& imagesObject, const JSONstringSP& imageString, JSONobjectSP& bufferViewsObject, const Texture2DSP& texture, const string& folderName, GlTfBin* binaryBody) const
 {
 	auto walker = imagesObject->getAllKeys().begin();
 
@@ -440,10 +470,64 @@ void GlTfEntityEncoderFactory::addImage(JSONobjectSP& imagesObject, const JSONst
 
 	//
 
+	TextureFactory textureFactory;
+
 	JSONstringSP uriString = JSONstringSP(new JSONstring("uri"));
 
 	JSONstringSP valueString;
 
+	//
+	// Embed image into the binary glTF. If it can not be encoded, it is saved as a file.
+	//
+
+	vector<uint8_t> data;
+	string mimeType;
+
+	if (binaryBody && textureFactory.encodeTexture2D(texture, data, mimeType) && data.size() > 0)
+	{
+		JSONstringSP bufferViewString = JSONstringSP(new JSONstring("bufferView_" + imageString->getValue()));
+		JSONobjectSP bufferViewObject = JSONobjectSP(new JSONobject());
+		bufferViewsObject->addKeyValue(bufferViewString, bufferViewObject);
+
+		binaryBody->addPadding(4);
+
+		size_t beforeTotalLength = binaryBody->getLength();
+
+		binaryBody->addData(&data[0], data.size());
+
+		valueString = JSONstringSP(new JSONstring(GLTF_GLB_BUFFER));
+
+		addBufferViewValues(bufferViewObject, valueString, beforeTotalLength, data.size());
+
+		valueString = JSONstringSP(new JSONstring(GLTF_GLB_BUFFER_URI));
+		imageObject->addKeyValue(uriString, valueString);
+
+		JSONstringSP extensionsString = JSONstringSP(new JSONstring("extensions"));
+		JSONobjectSP extensionsObject = JSONobjectSP(new JSONobject());
+		imageObject->addKeyValue(extensionsString, extensionsObject);
+
+		JSONstringSP binaryGlTFString = JSONstringSP(new JSONstring(GLTF_GLB_EXTENSION));
+		JSONobjectSP binaryGlTFObject = JSONobjectSP(new JSONobject());
+		extensionsObject->addKeyValue(binaryGlTFString, binaryGlTFObject);
+
+		JSONstringSP bufferViewKeyString = JSONstringSP(new JSONstring("bufferView"));
+		binaryGlTFObject->addKeyValue(bufferViewKeyString, bufferViewString);
+
+		JSONstringSP mimeTypeString = JSONstringSP(new JSONstring("mimeType"));
+		valueString = JSONstringSP(new JSONstring(mimeType));
+		binaryGlTFObject->addKeyValue(mimeTypeString, valueString);
+
+		JSONstringSP widthString = JSONstringSP(new JSONstring("width"));
+		JSONnumberSP valueNumber = JSONnumberSP(new JSONnumber(texture->getWidth()));
+		binaryGlTFObject->addKeyValue(widthString, valueNumber);
+
+		JSONstringSP heightString = JSONstringSP(new JSONstring("height"));
+		valueNumber = JSONnumberSP(new JSONnumber(texture->getHeight()));
+		binaryGlTFObject->addKeyValue(heightString, valueNumber);
+
+		return;
+	}
+
 	string path = texture->getIdentifier();
 
 	if (texture->getType() == GL_FLOAT || texture->getType() == GL_HALF_FLOAT)
@@ -462,8 +546,6 @@ void GlTfEntityEncoderFactory::addImage(JSONobjectSP& imagesObject, const JSONst
 	// Save image to file.
 	//
 
-	TextureFactory textureFactory;
-
 	textureFactory.saveTexture2D(texture, folderName);
 }
 
@@ -556,13 +638,13 @@ void GlTfEntityEncoderFactory::addTexture(JSONobjectSP& texturesObject, const JS
 	textureObject->addKeyValue(typeString, valueNumber);
 }
 
-void GlTfEntityEncoderFactory::addTextureSamplerImage(JSONobjectSP& texturesObject, const JSONstringSP& textureString, JSONobjectSP& samplersObject, const JSONstringSP& samplerString, JSONobjectSP& imagesObject, const JSONstringSP& imageString, const Texture2DSP& texture, const string& folderName) const
+void GlTfEntityEncoderFactory::addTextureSamplerImage(JSONobjectSP& texturesObject, const JSONstringSP& textureString, JSONobjectSP& samplersObject, const JSONstringSP& samplerString, JSONobjectSP& imagesObject, const JSONstringSP& imageString, JSONobjectSP& bufferViewsObject, const Texture2DSP& texture, const string& folderName, GlTfBin* binaryBody) const
 {
 	addTexture(texturesObject, textureString, texture);
 
 	addSampler(samplersObject, samplerString, texture);
 
-	addImage(imagesObject, imageString, texture, folderName);
+	addImage(imagesObject, imageString, bufferViewsObject, texture, folderName, binaryBody);
 }
 
 void GlTfEntityEncoderFactory::addShader(JSONobjectSP& shadersObject, const JSONstringSP& shaderString, const ProgramSeparableSP programSeparable) const
@@ -737,7 +819,7 @@ void GlTfEntityEncoderFactory::addTechniqueProgramShader(JSONobjectSP& technique
 	addProgramShader(programsObject, shadersObject, valueString, programPipeline);
 }
 
-void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerImage(JSONobjectSP& materialsObject, JSONobjectSP& techniquesObject, JSONobjectSP& programsObject, JSONobjectSP& shadersObject, JSONobjectSP& texturesObject, JSONobjectSP& samplersObject, JSONobjectSP& imagesObject, const ModelSP& model, const string& folderName) const
+void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerImage(JSONobjectSP& materialsObject, JSONobjectSP& techniquesObject, JSONobjectSP& programsObject, JSONobjectSP& shadersObject, JSONobjectSP& texturesObject, JSONobjectSP& samplersObject, JSONobjectSP& imagesObject, JSONobjectSP& bufferViewsObject, const ModelSP& model, const string& folderName, GlTfBin* binaryBody) const
 {
 	JSONstringSP valueString;
 	JSONnumberSP valueNumber;
@@ -829,7 +911,7 @@ void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerIm
 
 			//
 
-			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, surfaceMaterial->getEmissiveTexture(), folderName);
+			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, bufferViewsObject, surfaceMaterial->getEmissiveTexture(), folderName, binaryBody);
 		}
 		else
 		{
@@ -854,7 +936,7 @@ void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerIm
 
 			//
 
-			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, surfaceMaterial->getDiffuseTexture(), folderName);
+			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, bufferViewsObject, surfaceMaterial->getDiffuseTexture(), folderName, binaryBody);
 		}
 		else
 		{
@@ -879,7 +961,7 @@ void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerIm
 
 			//
 
-			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, surfaceMaterial->getReflectionCoefficientTexture(), folderName);
+			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, bufferViewsObject, surfaceMaterial->getReflectionCoefficientTexture(), folderName, binaryBody);
 		}
 		else
 		{
@@ -899,7 +981,7 @@ void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerIm
 
 			//
 
-			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, surfaceMaterial->getRoughnessTexture(), folderName);
+			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, bufferViewsObject, surfaceMaterial->getRoughnessTexture(), folderName, binaryBody);
 		}
 		else
 		{
@@ -919,7 +1001,7 @@ void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerIm
 
 			//
 
-			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, surfaceMaterial->getTransparencyTexture(), folderName);
+			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, bufferViewsObject, surfaceMaterial->getTransparencyTexture(), folderName, binaryBody);
 		}
 		else
 		{
@@ -939,7 +1021,7 @@ void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerIm
 
 			//
 
-			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, surfaceMaterial->getNormalMapTexture(), folderName);
+			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, bufferViewsObject, surfaceMaterial->getNormalMapTexture(), folderName, binaryBody);
 		}
 
 		// Displacement map
@@ -953,7 +1035,7 @@ void GlTfEntityEncoderFactory::addMaterialTechniqueProgramShaderTextureSamplerIm
 
 			//
 
-			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, surfaceMaterial->getDisplacementMapTexture(), folderName);
+			addTextureSamplerImage(texturesObject, textureString, samplersObject, samplerString, imagesObject, imageString, bufferViewsObject, surfaceMaterial->getDisplacementMapTexture(), folderName, binaryBody);
 		}
 
 		//
@@ -1074,7 +1156,7 @@ void GlTfEntityEncoderFactory::addBufferViewValues(JSONobjectSP& bufferViewObjec
 	bufferViewObject->addKeyValue(byteLengthString, valueNumber);
 }
 
-void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffersObject, const JSONstringSP& bufferString, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const MeshSP& mesh, const string& folderName) const
+void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffersObject, const JSONstringSP& bufferString, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const MeshSP& mesh, const string& folderName, GlTfBin* binaryBody) const
 {
 	auto walker = buffersObject->getAllKeys().begin();
 
@@ -1088,6 +1170,12 @@ void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffers
 		walker++;
 	}
 
+	// The buffer of a binary glTF is shared, so an already added mesh is detected by its buffer view.
+	if (bufferViewsObject->hasKey(JSONstringSP(new JSONstring("bufferView_" + mesh->getName() + "_vertices"))))
+	{
+		return;
+	}
+
 	//
 
 	char buffer[128];
@@ -1101,13 +1189,29 @@ void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffers
 	JSONstringSP accessorString;
 	JSONobjectSP accessorObject;
 
-	GlTfBin bin;
+	GlTfBin fileBin;
+
+	GlTfBin& bin = binaryBody ? *binaryBody : fileBin;
+
+	bin.addPadding(4);
+
+	vector<float> unpackedVertices;
+	vector<float> unpackedNormals;
+	vector<float> unpackedBitangents;
+	vector<float> unpackedTangents;
+	vector<float> unpackedTexCoords;
+
+	const float* vertices = unpackAttribute(unpackedVertices, mesh->getVertexData(), mesh->getVertexFormat(), 4, mesh->getNumberVertices());
+	const float* normals = unpackAttribute(unpackedNormals, mesh->getNormalData(), mesh->getNormalFormat(), 3, mesh->getNumberVertices());
+	const float* bitangents = unpackAttribute(unpackedBitangents, mesh->getBitangentData(), mesh->getBitangentFormat(), 3, mesh->getNumberVertices());
+	const float* tangents = unpackAttribute(unpackedTangents, mesh->getTangentData(), mesh->getTangentFormat(), 3, mesh->getNumberVertices());
+	const float* texCoords = unpackAttribute(unpackedTexCoords, mesh->getTexCoordData(), mesh->getTexCoordFormat(), 2, mesh->getNumberVertices());
 
 	//
 
 	beforeTotalLength = bin.getLength();
 	currentLength = mesh->getNumberVertices() * 4 * sizeof(GLfloat);
-	bin.addData((const uint8_t*)mesh->getVertices(), currentLength);
+	bin.addData((const uint8_t*)vertices, currentLength);
 
 	bufferViewString = JSONstringSP(new JSONstring("bufferView_" + mesh->getName() + "_vertices"));
 	bufferViewObject = JSONobjectSP(new JSONobject());
@@ -1121,11 +1225,11 @@ void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffers
 
 	addAccessorValues(accessorObject, bufferViewString, 0, 0, GL_FLOAT, mesh->getNumberVertices(), "VEC4");
 
-	if (mesh->getNormals())
+	if (normals)
 	{
 		beforeTotalLength = bin.getLength();
 		currentLength = mesh->getNumberVertices() * 3 * sizeof(GLfloat);
-		bin.addData((const uint8_t*)mesh->getNormals(), currentLength);
+		bin.addData((const uint8_t*)normals, currentLength);
 
 		bufferViewString = JSONstringSP(new JSONstring("bufferView_" + mesh->getName() + "_normals"));
 		bufferViewObject = JSONobjectSP(new JSONobject());
@@ -1140,11 +1244,11 @@ void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffers
 		addAccessorValues(accessorObject, bufferViewString, 0, 0, GL_FLOAT, mesh->getNumberVertices(), "VEC3");
 	}
 
-	if (mesh->getBitangents())
+	if (bitangents)
 	{
 		beforeTotalLength = bin.getLength();
 		currentLength = mesh->getNumberVertices() * 3 * sizeof(GLfloat);
-		bin.addData((const uint8_t*)mesh->getBitangents(), currentLength);
+		bin.addData((const uint8_t*)bitangents, currentLength);
 
 		bufferViewString = JSONstringSP(new JSONstring("bufferView_" + mesh->getName() + "_bitangents"));
 		bufferViewObject = JSONobjectSP(new JSONobject());
@@ -1159,11 +1263,11 @@ void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffers
 		addAccessorValues(accessorObject, bufferViewString, 0, 0, GL_FLOAT, mesh->getNumberVertices(), "VEC3");
 	}
 
-	if (mesh->getTangents())
+	if (tangents)
 	{
 		beforeTotalLength = bin.getLength();
 		currentLength = mesh->getNumberVertices() * 3 * sizeof(GLfloat);
-		bin.addData((const uint8_t*)mesh->getTangents(), currentLength);
+		bin.addData((const uint8_t*)tangents, currentLength);
 
 		bufferViewString = JSONstringSP(new JSONstring("bufferView_" + mesh->getName() + "_tangents"));
 		bufferViewObject = JSONobjectSP(new JSONobject());
@@ -1178,11 +1282,11 @@ void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffers
 		addAccessorValues(accessorObject, bufferViewString, 0, 0, GL_FLOAT, mesh->getNumberVertices(), "VEC3");
 	}
 
-	if (mesh->getTexCoords())
+	if (texCoords)
 	{
 		beforeTotalLength = bin.getLength();
 		currentLength = mesh->getNumberVertices() * 2 * sizeof(GLfloat);
-		bin.addData((const uint8_t*)mesh->getTexCoords(), currentLength);
+		bin.addData((const uint8_t*)texCoords, currentLength);
 
 		bufferViewString = JSONstringSP(new JSONstring("bufferView_" + mesh->getName() + "_texcoords"));
 		bufferViewObject = JSONobjectSP(new JSONobject());
@@ -1308,7 +1412,12 @@ void GlTfEntityEncoderFactory::addBufferBufferViewAccessor(JSONobjectSP& buffers
 		accessorObject = JSONobjectSP(new JSONobject());
 		accessorsObject->addKeyValue(accessorString, accessorObject);
 
-		addAccessorValues(accessorObject, bufferViewString, 0 + currentSubMesh->getIndicesOffset(), 0, GL_UNSIGNED_INT, currentSubMesh->getTriangleCount() * 3, "SCALAR");
+		addAccessorValues(accessorObject, bufferViewString, (int32_t)(currentSubMesh->getIndicesOffset() * sizeof(GLuint)), 0, GL_UNSIGNED_INT, currentSubMesh->getTriangleCount() * 3, "SCALAR");
+	}
+
+	if (binaryBody)
+	{
+		return;
 	}
 
 	//
@@ -1414,28 +1523,28 @@ void GlTfEntityEncoderFactory::addMesh(JSONobjectSP& meshesObject, const JSONstr
 		attributeValueString = JSONstringSP(new JSONstring("accessor_" + mesh->getName() + "_vertices"));
 		valueObject->addKeyValue(attributeString, attributeValueString);
 
-		if (mesh->getNormals())
+		if (mesh->getNormalData())
 		{
 			attributeString = JSONstringSP(new JSONstring("NORMAL"));
 			attributeValueString = JSONstringSP(new JSONstring("accessor_" + mesh->getName() + "_normals"));
 			valueObject->addKeyValue(attributeString, attributeValueString);
 		}
 
-		if (mesh->getBitangents())
+		if (mesh->getBitangentData())
 		{
 			attributeString = JSONstringSP(new JSONstring("BITANGENT"));
 			attributeValueString = JSONstringSP(new JSONstring("accessor_" + mesh->getName() + "_bitangents"));
 			valueObject->addKeyValue(attributeString, attributeValueString);
 		}
 
-		if (mesh->getTangents())
+		if (mesh->getTangentData())
 		{
 			attributeString = JSONstringSP(new JSONstring("TANGENT"));
 			attributeValueString = JSONstringSP(new JSONstring("accessor_" + mesh->getName() + "_tangents"));
 			valueObject->addKeyValue(attributeString, attributeValueString);
 		}
 
-		if (mesh->getTexCoords())
+		if (mesh->getTexCoordData())
 		{
 			attributeString = JSONstringSP(new JSONstring("TEXCOORD"));
 			attributeValueString = JSONstringSP(new JSONstring("accessor_" + mesh->getName() + "_texcoords"));
@@ -1483,7 +1592,7 @@ void GlTfEntityEncoderFactory::addMesh(JSONobjectSP& meshesObject, const JSONstr
 	}
 }
 
-void GlTfEntityEncoderFactory::addNodeBufferBufferViewAccessorMesh(JSONobjectSP& nodesObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, JSONobjectSP& meshesObject, const ModelSP& model, const string& folderName) const
+void GlTfEntityEncoderFactory::addNodeBufferBufferViewAccessorMesh(JSONobjectSP& nodesObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, JSONobjectSP& meshesObject, const ModelSP& model, const string& folderName, GlTfBin* binaryBody) const
 {
 	JSONstringSP nodeString;
 	JSONobjectSP nodeObject;
@@ -1604,9 +1713,9 @@ void GlTfEntityEncoderFactory::addNodeBufferBufferViewAccessorMesh(JSONobjectSP&
 
 		if (node->getMesh())
 		{
-			nodeBufferString = JSONstringSP(new JSONstring("buffer_" + node->getMesh()->getName()));
+			nodeBufferString = JSONstringSP(new JSONstring(binaryBody ? GLTF_GLB_BUFFER : "buffer_" + node->getMesh()->getName()));
 
-			addBufferBufferViewAccessor(buffersObject, nodeBufferString, bufferViewsObject, accessorsObject, node->getMesh(), folderName);
+			addBufferBufferViewAccessor(buffersObject, nodeBufferString, bufferViewsObject, accessorsObject, node->getMesh(), folderName, binaryBody);
 
 			nodeMeshString = JSONstringSP(new JSONstring("mesh_" + node->getMesh()->getName()));
 
@@ -1672,7 +1781,7 @@ void GlTfEntityEncoderFactory::addScene(JSONobjectSP& scenesObject, const JSONst
 	nodesArray->addValue(rootNodeString);
 }
 
-void GlTfEntityEncoderFactory::addSkin(JSONobjectSP& skinsObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const ModelEntitySP& modelEntity, const string& folderName) const
+void GlTfEntityEncoderFactory::addSkin(JSONobjectSP& skinsObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const ModelEntitySP& modelEntity, const string& folderName, GlTfBin* binaryBody) const
 {
 	if (modelEntity->getModel()->isSkinned())
 	{
@@ -1680,7 +1789,11 @@ void GlTfEntityEncoderFactory::addSkin(JSONobjectSP& skinsObject, JSONobjectSP&
 		size_t currentLength;
 
 
-		GlTfBin bin;
+		GlTfBin fileBin;
+
+		GlTfBin& bin = binaryBody ? *binaryBody : fileBin;
+
+		bin.addPadding(4);
 
 		JSONstringSP skinString = JSONstringSP(new JSONstring("skin_" + getParentRootJointNode(modelEntity->getModel()->getRootNode())->getName()));
 		JSONobjectSP skinObject = JSONobjectSP(new JSONobject());
@@ -1727,11 +1840,11 @@ void GlTfEntityEncoderFactory::addSkin(JSONobjectSP& skinsObject, JSONobjectSP&
 			}
 		}
 
-		JSONstringSP bufferString = JSONstringSP(new JSONstring("buffer_" + skinString->getValue()));
+		JSONstringSP bufferString = JSONstringSP(new JSONstring(binaryBody ? GLTF_GLB_BUFFER : "buffer_" + skinString->getValue()));
 
 		//
 
-		currentLength = bin.getLength();
+		currentLength = bin.getLength() - beforeTotalLength;
 
 		JSONstringSP bufferViewString = JSONstringSP(new JSONstring("bufferView_" + skinString->getValue()));
 		JSONobjectSP bufferViewObject = JSONobjectSP(new JSONobject());
@@ -1744,6 +1857,11 @@ void GlTfEntityEncoderFactory::addSkin(JSONobjectSP& skinsObject, JSONobjectSP&
 
 		addAccessorValues(accessorObject, bufferViewString, 0, 0, GL_FLOAT, modelEntity->getNumberJoints(), "MAT4");
 
+		if (binaryBody)
+		{
+			return;
+		}
+
 		//
 		// Buffer
 		//
@@ -1777,7 +1895,77 @@ void GlTfEntityEncoderFactory::addSkin(JSONobjectSP& skinsObject, JSONobjectSP&
 	}
 }
 
-bool GlTfEntityEncoderFactory::saveGlTfModelFile(const ModelEntitySP& modelEntity, const string& identifier)
+bool GlTfEntityEncoderFactory::saveGlb(const JSONobjectSP& glTF, JSONobjectSP& buffersObject, const GlTfBin& binaryBody, const string& identifier, const string& folderName) const
+{
+	//
+	// Buffer of the binary body, as defined by KHR_binary_glTF.
+	//
+
+	JSONstringSP bufferString = JSONstringSP(new JSONstring(GLTF_GLB_BUFFER));
+	JSONobjectSP bufferObject = JSONobjectSP(new JSONobject());
+	buffersObject->addKeyValue(bufferString, bufferObject);
+
+	JSONstringSP byteLengthString = JSONstringSP(new JSONstring("byteLength"));
+	JSONstringSP typeString = JSONstringSP(new JSONstring("type"));
+	JSONstringSP uriString = JSONstringSP(new JSONstring("uri"));
+
+	JSONnumberSP valueNumber = JSONnumberSP(new JSONnumber((int32_t)binaryBody.getLength()));
+	bufferObject->addKeyValue(byteLengthString, valueNumber);
+
+	JSONstringSP valueString = JSONstringSP(new JSONstring("arraybuffer"));
+	bufferObject->addKeyValue(typeString, valueString);
+
+	valueString = JSONstringSP(new JSONstring(GLTF_GLB_BUFFER_URI));
+	bufferObject->addKeyValue(uriString, valueString);
+
+	JSONstringSP extensionsUsedString = JSONstringSP(new JSONstring("extensionsUsed"));
+	JSONarraySP extensionsUsedArray = JSONarraySP(new JSONarray());
+	extensionsUsedArray->addValue(JSONstringSP(new JSONstring(GLTF_GLB_EXTENSION)));
+	glTF->addKeyValue(extensionsUsedString, extensionsUsedArray);
+
+	//
+
+	string jsonText;
+
+	// Not pretty printed, as nobody reads the JSON content directly.
+	JSONencoder encoder(false);
+
+	if (!encoder.encode(glTF, jsonText))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not encode %s to %s", identifier.c_str(), folderName.c_str());
+
+		return false;
+	}
+
+	FILE* file = glusFileOpen((folderName + identifier + ".glb").c_str(), "wb");
+
+	if (!file)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not open %s%s.glb", folderName.c_str(), identifier.c_str());
+
+		return false;
+	}
+
+	bool result = GlTfGlb::save(file, jsonText, binaryBody);
+
+	if (glusFileClose(file) != 0)
+	{
+		result = false;
+	}
+
+	if (!result)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not save %s to %s", identifier.c_str(), folderName.c_str());
+
+		return false;
+	}
+
+	glusLogPrint(GLUS_LOG_INFO, "Saved %s to %s", identifier.c_str(), folderName.c_str());
+
+	return true;
+}
+
+bool GlTfEntityEncoderFactory::saveGlTfModelFile(const ModelEntitySP& modelEntity, const string& identifier, bool binary)
 {
 	if (modelEntity.get() == nullptr)
 	{
@@ -1796,6 +1984,11 @@ bool GlTfEntityEncoderFactory::saveGlTfModelFile(const ModelEntitySP& modelEntit
 
 	folderName.append("/");
 
+	// Binary body, only used for a binary glTF.
+	GlTfBin bin;
+
+	GlTfBin* binaryBody = binary ? &bin : nullptr;
+
 	//
 
 	JSONobjectSP glTF = JSONobjectSP(new JSONobject());
@@ -1885,7 +2078,7 @@ bool GlTfEntityEncoderFactory::saveGlTfModelFile(const ModelEntitySP& modelEntit
 
 	glTF->addKeyValue(animationsString, animationsObject);
 
-	addAnimationBufferBufferViewAccessor(animationsObject, buffersObject, bufferViewsObject, accessorsObject, modelEntity->getModel(), folderName);
+	addAnimationBufferBufferViewAccessor(animationsObject, buffersObject, bufferViewsObject, accessorsObject, modelEntity->getModel(), folderName, binaryBody);
 
 
 	//
@@ -1932,7 +2125,7 @@ bool GlTfEntityEncoderFactory::saveGlTfModelFile(const ModelEntitySP& modelEntit
 
 	glTF->addKeyValue(materialsString, materialsObject);
 
-	addMaterialTechniqueProgramShaderTextureSamplerImage(materialsObject, techniquesObject, programsObject, shadersObject, texturesObject, samplersObject, imagesObject, modelEntity->getModel(), folderName);
+	addMaterialTechniqueProgramShaderTextureSamplerImage(materialsObject, techniquesObject, programsObject, shadersObject, texturesObject, samplersObject, imagesObject, bufferViewsObject, modelEntity->getModel(), folderName, binaryBody);
 
 	//
 	// Meshes
@@ -1946,7 +2139,7 @@ bool GlTfEntityEncoderFactory::saveGlTfModelFile(const ModelEntitySP& modelEntit
 
 	glTF->addKeyValue(nodesString, nodesObject);
 
-	addNodeBufferBufferViewAccessorMesh(nodesObject, buffersObject, bufferViewsObject, accessorsObject, meshesObject, modelEntity->getModel(), folderName);
+	addNodeBufferBufferViewAccessorMesh(nodesObject, buffersObject, bufferViewsObject, accessorsObject, meshesObject, modelEntity->getModel(), folderName, binaryBody);
 
 	//
 	// Programs
@@ -1988,7 +2181,7 @@ bool GlTfEntityEncoderFactory::saveGlTfModelFile(const ModelEntitySP& modelEntit
 
 	glTF->addKeyValue(skinsString, skinsObject);
 
-	addSkin(skinsObject, buffersObject, bufferViewsObject, accessorsObject, modelEntity, folderName);
+	addSkin(skinsObject, buffersObject, bufferViewsObject, accessorsObject, modelEntity, folderName, binaryBody);
 
 	//
 	// Techniques
@@ -2006,23 +2199,37 @@ bool GlTfEntityEncoderFactory::saveGlTfModelFile(const ModelEntitySP& modelEntit
 	// Encode created content.
 	//
 
-	JSONencoder encoder;
-	string jsonText;
+	if (binaryBody)
+	{
+		return saveGlb(glTF, buffersObject, *binaryBody, identifier, folderName);
+	}
 
-	encoder.encode(glTF, jsonText);
+	// The text is streamed to the file, so it is never held in memory as a whole.
+	FILE* file = glusFileOpen((folderName + identifier + ".json").c_str(), "w");
 
-	glusLogPrint(GLUS_LOG_DEBUG, "\nEncoded:\n%s\n\n", jsonText.c_str());
+	if (!file)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not open %s%s.json", folderName.c_str(), identifier.c_str());
 
-	//
-	// Save JSON text to file.
-	//
+		return false;
+	}
 
-	GLUStextfile textfile;
+	JSONfileSink sink(file);
+	JSONencoder encoder;
+
+	bool result = encoder.encode(glTF, sink);
+
+	if (glusFileClose(file) != 0)
+	{
+		result = false;
+	}
 
-	textfile.length = jsonText.size();
-	textfile.text = (GLUSchar*)jsonText.c_str();
+	if (!result)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not encode %s to %s", identifier.c_str(), folderName.c_str());
 
-	glusFileSaveText((folderName + identifier + ".json").c_str(), &textfile);
+		return false;
+	}
 
 	glusLogPrint(GLUS_LOG_INFO, "Saved %s to %s", identifier.c_str(), folderName.c_str());
 
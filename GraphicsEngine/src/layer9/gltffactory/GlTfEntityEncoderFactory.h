@@ -34,19 +34,19 @@ private:
 
 	void addChannelParameterSampler(GlTfBin& bin, JSONarraySP& channelsArray, JSONobjectSP& parametersObject, JSONobjectSP& samplersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const JSONstringSP& bufferString, const JSONstringSP& nodeValueString, const std::string& identifier, const std::string& transform, const std::string& channel, const std::map<float, float>& timeValues, const std::map<float, const Interpolator*>& timeInterpolators) const;
 
-	void addAnimationBufferBufferViewAccessor(JSONobjectSP& animationsObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const ModelSP& model, const std::string& folderName) const;
+	void addAnimationBufferBufferViewAccessor(JSONobjectSP& animationsObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const ModelSP& model, const std::string& folderName, GlTfBin* binaryBody) const;
 
 
 	void addAsset(JSONobjectSP& assetObject) const;
 
 
-	void addImage(JSONobjectSP& imagesObject, const JSONstringSP& imageString, const Texture2DSP& texture, const std::string& folderName) const;
+	void addImage(JSONobjectSP& imagesObject, const JSONstringSP& imageString, JSONobjectSP& bufferViewsObject, const Texture2DSP& texture, const std::string& folderName, GlTfBin* binaryBody) const;
 
 	void addSampler(JSONobjectSP& samplersObject, const JSONstringSP& samplerString, const Texture2DSP& texture) const;
 
 	void addTexture(JSONobjectSP& texturesObject, const JSONstringSP& textureString, const Texture2DSP& texture) const;
 
-	void addTextureSamplerImage(JSONobjectSP& texturesObject, const JSONstringSP& textureString, JSONobjectSP& samplersObject, const JSONstringSP& samplerString, JSONobjectSP& imagesObject, const JSONstringSP& imageString, const Texture2DSP& texture, const std::string& folderName) const;
+	void addTextureSamplerImage(JSONobjectSP& texturesObject, const JSONstringSP& textureString, JSONobjectSP& samplersObject, const JSONstringSP& samplerString, JSONobjectSP& imagesObject, const JSONstringSP& imageString, JSONobjectSP& bufferViewsObject, const Texture2DSP& texture, const std::string& folderName, GlTfBin* binaryBody) const;
 
 
 	void addShader(JSONobjectSP& shadersObject, const JSONstringSP& shaderString, const ProgramSeparableSP programSeparable) const;
@@ -56,7 +56,7 @@ private:
 	void addTechniqueProgramShader(JSONobjectSP& techniquesObject, JSONobjectSP& programsObject, JSONobjectSP& shadersObject, const JSONstringSP& techniqueString, const ProgramPipelineSP programPipeline) const;
 
 
-	void addMaterialTechniqueProgramShaderTextureSamplerImage(JSONobjectSP& materialsObject, JSONobjectSP& techniquesObject, JSONobjectSP& programsObject, JSONobjectSP& shadersObject, JSONobjectSP& texturesObject, JSONobjectSP& samplersObject, JSONobjectSP& imagesObject, const ModelSP& model, const std::string& folderName) const;
+	void addMaterialTechniqueProgramShaderTextureSamplerImage(JSONobjectSP& materialsObject, JSONobjectSP& techniquesObject, JSONobjectSP& programsObject, JSONobjectSP& shadersObject, JSONobjectSP& texturesObject, JSONobjectSP& samplersObject, JSONobjectSP& imagesObject, JSONobjectSP& bufferViewsObject, const ModelSP& model, const std::string& folderName, GlTfBin* binaryBody) const;
 
 
 	void addFBXValues(JSONobjectSP& nodeObject, const NodeSP& node) const;
@@ -68,26 +68,32 @@ private:
 
 	void addBufferViewValues(JSONobjectSP& bufferViewObject, const JSONstringSP& bufferValueString, size_t byteOffset, size_t byteLength) const;
 
-	void addBufferBufferViewAccessor(JSONobjectSP& buffersObject, const JSONstringSP& bufferString, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const MeshSP& mesh, const std::string& folderName) const;
+	void addBufferBufferViewAccessor(JSONobjectSP& buffersObject, const JSONstringSP& bufferString, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const MeshSP& mesh, const std::string& folderName, GlTfBin* binaryBody) const;
 
 
 	void addMesh(JSONobjectSP& meshesObject, const JSONstringSP& meshString, const MeshSP& mesh) const;
 
 
-	void addNodeBufferBufferViewAccessorMesh(JSONobjectSP& nodesObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, JSONobjectSP& meshesObject, const ModelSP& model, const std::string& folderName) const;
+	void addNodeBufferBufferViewAccessorMesh(JSONobjectSP& nodesObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, JSONobjectSP& meshesObject, const ModelSP& model, const std::string& folderName, GlTfBin* binaryBody) const;
 
 
 	void addScene(JSONobjectSP& scenesObject, const JSONstringSP& sceneString, const NodeSP& rootNode) const;
 
 
-	void addSkin(JSONobjectSP& skinsObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const ModelEntitySP& modelEntity, const std::string& folderName) const;
+	void addSkin(JSONobjectSP& skinsObject, JSONobjectSP& buffersObject, JSONobjectSP& bufferViewsObject, JSONobjectSP& accessorsObject, const ModelEntitySP& modelEntity, const std::string& folderName, GlTfBin* binaryBody) const;
+
+
+	bool saveGlb(const JSONobjectSP& glTF, JSONobjectSP& buffersObject, const GlTfBin& binaryBody, const std::string& identifier, const std::string& folderName) const;
 
 public:
 
 	GlTfEntityEncoderFactory();
 	virtual ~GlTfEntityEncoderFactory();
 
-	bool saveGlTfModelFile(const ModelEntitySP& modelEntity, const std::string& identifier);
+	/**
+	 * Saves the model as glTF with external buffers and images or, if binary, as a single binary glTF file.
+	 */
+	bool saveGlTfModelFile(const ModelEntitySP& modelEntity, const std::string& identifier, bool binary = false);
 
 };
 
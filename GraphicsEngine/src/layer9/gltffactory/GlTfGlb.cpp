@@ -0,0 +1,158 @@
+/*
+ * GlTfGlb.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "GlTfGlb.h"
+
+using namespace std;
+
+// All values of the container are little endian.
+
+static uint32_t readUint32(const uint8_t* data)
+{
+	return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static bool writeUint32(FILE* file, uint32_t value)
+{
+	uint8_t data[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+
+	return fwrite(data, 1, 4, file) == 4;
+}
+
+static bool writePadding(FILE* file, size_t length, uint8_t value)
+{
+	while (length % 4 != 0)
+	{
+		if (fputc(value, file) == EOF)
+		{
+			return false;
+		}
+
+		length++;
+	}
+
+	return true;
+}
+
+GlTfGlb::GlTfGlb() :
+	jsonBegin(nullptr), jsonEnd(nullptr), binary(nullptr), binaryLength(0)
+{
+}
+
+GlTfGlb::~GlTfGlb()
+{
+}
+
+bool GlTfGlb::isGlb(const uint8_t* data, size_t length)
+{
+	return length >= 12 && readUint32(data) == GLTF_GLB_MAGIC;
+}
+
+bool GlTfGlb::decode(const uint8_t* data, size_t length)
+{
+	jsonBegin = nullptr;
+	jsonEnd = nullptr;
+
+	binary = nullptr;
+	binaryLength = 0;
+
+	if (!isGlb(data, length))
+	{
+		return false;
+	}
+
+	uint32_t version = readUint32(data + 4);
+
+	if (version != GLTF_GLB_VERSION)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Binary glTF version %u is not supported, only version %d of %s", version, GLTF_GLB_VERSION, GLTF_GLB_EXTENSION);
+
+		return false;
+	}
+
+	if (length < GLTF_GLB_HEADER_LENGTH)
+	{
+		return false;
+	}
+
+	size_t totalLength = (size_t)readUint32(data + 8);
+	size_t contentLength = (size_t)readUint32(data + 12);
+
+	if (totalLength < GLTF_GLB_HEADER_LENGTH || totalLength > length || contentLength > totalLength - GLTF_GLB_HEADER_LENGTH)
+	{
+		return false;
+	}
+
+	if (readUint32(data + 16) != GLTF_GLB_CONTENT_FORMAT_JSON)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Binary glTF content is not JSON");
+
+		return false;
+	}
+
+	jsonBegin = (const char*)(data + GLTF_GLB_HEADER_LENGTH);
+	jsonEnd = jsonBegin + contentLength;
+
+	size_t bodyOffset = GLTF_GLB_HEADER_LENGTH + contentLength;
+
+	if (totalLength > bodyOffset)
+	{
+		binary = data + bodyOffset;
+		binaryLength = totalLength - bodyOffset;
+	}
+
+	return true;
+}
+
+const char* GlTfGlb::getJsonBegin() const
+{
+	return jsonBegin;
+}
+
+const char* GlTfGlb::getJsonEnd() const
+{
+	return jsonEnd;
+}
+
+const uint8_t* GlTfGlb::getBinary() const
+{
+	return binary;
+}
+
+size_t GlTfGlb::getBinaryLength() const
+{
+	return binaryLength;
+}
+
+bool GlTfGlb::save(FILE* file, const string& json, const GlTfBin& binary)
+{
+	size_t contentLength = (json.length() + 3) & ~(size_t)3;
+
+	size_t totalLength = GLTF_GLB_HEADER_LENGTH + contentLength + binary.getLength();
+
+	if (totalLength > 0xFFFFFFFF)
+	{
+		return false;
+	}
+
+	if (!writeUint32(file, GLTF_GLB_MAGIC) || !writeUint32(file, GLTF_GLB_VERSION) || !writeUint32(file, (uint32_t)totalLength) || !writeUint32(file, (uint32_t)contentLength) || !writeUint32(file, GLTF_GLB_CONTENT_FORMAT_JSON))
+	{
+		return false;
+	}
+
+	if (fwrite(json.data(), 1, json.length(), file) != json.length() || !writePadding(file, json.length(), ' '))
+	{
+		return false;
+	}
+
+	if (binary.getLength() > 0 && fwrite(binary.getData(), 1, binary.getLength(), file) != binary.getLength())
+	{
+		return false;
+	}
+
+	return true;
+}
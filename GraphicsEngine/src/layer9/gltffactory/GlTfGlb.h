@@ -0,0 +1,69 @@
+/*
+ * GlTfGlb.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef GLTFGLB_H_
+#define GLTFGLB_H_
+
+#include "../../UsedLibs.h"
+
+#include "GlTfBin.h"
+
+// KHR_binary_glTF, which is the binary container of glTF 1.0.
+#define GLTF_GLB_EXTENSION "KHR_binary_glTF"
+
+#define GLTF_GLB_MAGIC 0x46546C67
+#define GLTF_GLB_VERSION 1
+
+#define GLTF_GLB_HEADER_LENGTH 20
+
+#define GLTF_GLB_CONTENT_FORMAT_JSON 0
+
+// Buffer, which is stored in the binary body.
+#define GLTF_GLB_BUFFER "binary_glTF"
+#define GLTF_GLB_BUFFER_URI "data:,"
+
+/**
+ * Container of a binary glTF 1.0: a header, the JSON content and the binary body up to the end.
+ * glTF 2.0 binary files, which are split into chunks, are not supported.
+ */
+class GlTfGlb
+{
+
+private:
+
+	const char* jsonBegin;
+	const char* jsonEnd;
+
+	const std::uint8_t* binary;
+	std::size_t binaryLength;
+
+public:
+
+	GlTfGlb();
+	virtual ~GlTfGlb();
+
+	static bool isGlb(const std::uint8_t* data, std::size_t length);
+
+	/**
+	 * Finds the content and the body. Nothing is copied, both point into the data.
+	 */
+	bool decode(const std::uint8_t* data, std::size_t length);
+
+	const char* getJsonBegin() const;
+	const char* getJsonEnd() const;
+
+	const std::uint8_t* getBinary() const;
+	std::size_t getBinaryLength() const;
+
+	/**
+	 * Writes the container. The JSON content is padded with spaces to four bytes, so the body is aligned.
+	 */
+	static bool save(FILE* file, const std::string& json, const GlTfBin& binary);
+
+};
+
+#endif /* GLTFGLB_H_ */
@@ -0,0 +1,425 @@
+/*
+ * GlTfJsonHandler.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#include "GlTfJsonHandler.h"
+
+using namespace std;
+
+GlTfJsonHandler::GlTfJsonHandler() :
+	JSONhandler(), section(GLTF_SECTION_NONE), depth(0), skipDepth(0), sectionKey(), currentId(), currentField(), currentBuffer(), currentBufferView(), currentAccessor(), domBuilder(), jsonGlTf(), allBufferDescriptions(), allBufferViewDescriptions(), allAccessorDescriptions()
+{
+	reset();
+}
+
+GlTfJsonHandler::~GlTfJsonHandler()
+{
+}
+
+bool GlTfJsonHandler::forward(bool result)
+{
+	if (result && domBuilder.isDone())
+	{
+		jsonGlTf->addKeyValue(JSONstringSP(new JSONstring(sectionKey)), domBuilder.getRoot());
+
+		domBuilder.reset();
+
+		section = GLTF_SECTION_NONE;
+	}
+
+	return result;
+}
+
+bool GlTfJsonHandler::beginEntry()
+{
+	switch (section)
+	{
+		case GLTF_SECTION_BUFFERS:
+			currentBuffer.uri = "";
+			currentBuffer.byteLength = -1;
+			return true;
+		case GLTF_SECTION_BUFFER_VIEWS:
+			currentBufferView.buffer = "";
+			currentBufferView.byteOffset = -1;
+			currentBufferView.byteLength = -1;
+			currentBufferView.target = 0;
+			return true;
+		case GLTF_SECTION_ACCESSORS:
+			currentAccessor.bufferView = "";
+			currentAccessor.byteOffset = -1;
+			currentAccessor.byteStride = -1;
+			currentAccessor.componentType = 0;
+			currentAccessor.count = -1;
+			currentAccessor.type = "";
+			currentAccessor.normalized = false;
+			return true;
+		default:
+			break;
+	}
+
+	return false;
+}
+
+void GlTfJsonHandler::endEntry()
+{
+	switch (section)
+	{
+		case GLTF_SECTION_BUFFERS:
+			allBufferDescriptions[currentId] = currentBuffer;
+			break;
+		case GLTF_SECTION_BUFFER_VIEWS:
+			allBufferViewDescriptions[currentId] = currentBufferView;
+			break;
+		case GLTF_SECTION_ACCESSORS:
+			allAccessorDescriptions[currentId] = currentAccessor;
+			break;
+		default:
+			break;
+	}
+}
+
+bool GlTfJsonHandler::setField(const string& value)
+{
+	if (section == GLTF_SECTION_BUFFERS && currentField == "uri")
+	{
+		currentBuffer.uri = value;
+	}
+	else if (section == GLTF_SECTION_BUFFER_VIEWS && currentField == "buffer")
+	{
+		currentBufferView.buffer = value;
+	}
+	else if (section == GLTF_SECTION_ACCESSORS && currentField == "bufferView")
+	{
+		currentAccessor.bufferView = value;
+	}
+	else if (section == GLTF_SECTION_ACCESSORS && currentField == "type")
+	{
+		currentAccessor.type = value;
+	}
+
+	return true;
+}
+
+bool GlTfJsonHandler::setField(int32_t value)
+{
+	if (section == GLTF_SECTION_BUFFERS)
+	{
+		if (currentField == "byteLength")
+		{
+			currentBuffer.byteLength = value;
+		}
+	}
+	else if (section == GLTF_SECTION_BUFFER_VIEWS)
+	{
+		if (currentField == "byteOffset")
+		{
+			currentBufferView.byteOffset = value;
+		}
+		else if (currentField == "byteLength")
+		{
+			currentBufferView.byteLength = value;
+		}
+		else if (currentField == "target")
+		{
+			currentBufferView.target = (GLenum)value;
+		}
+	}
+	else if (section == GLTF_SECTION_ACCESSORS)
+	{
+		if (currentField == "byteOffset")
+		{
+			currentAccessor.byteOffset = value;
+		}
+		else if (currentField == "byteStride")
+		{
+			currentAccessor.byteStride = value;
+		}
+		else if (currentField == "componentType")
+		{
+			currentAccessor.componentType = (GLenum)value;
+		}
+		else if (currentField == "count")
+		{
+			currentAccessor.count = value;
+		}
+	}
+
+	return true;
+}
+
+bool GlTfJsonHandler::setField(bool value)
+{
+	// Integers of quantized attributes, which are mapped to [-1, 1] or [0, 1].
+	if (section == GLTF_SECTION_ACCESSORS && currentField == "normalized")
+	{
+		currentAccessor.normalized = value;
+	}
+
+	return true;
+}
+
+void GlTfJsonHandler::reset()
+{
+	section = GLTF_SECTION_NONE;
+
+	depth = 0;
+
+	skipDepth = 0;
+
+	domBuilder.reset();
+
+	jsonGlTf = JSONobjectSP(new JSONobject());
+
+	allBufferDescriptions.clear();
+	allBufferViewDescriptions.clear();
+	allAccessorDescriptions.clear();
+}
+
+const JSONobjectSP& GlTfJsonHandler::getJsonGlTf() const
+{
+	return jsonGlTf;
+}
+
+const map<string, GlTfBufferDescription>& GlTfJsonHandler::getAllBufferDescriptions() const
+{
+	return allBufferDescriptions;
+}
+
+const map<string, GlTfBufferViewDescription>& GlTfJsonHandler::getAllBufferViewDescriptions() const
+{
+	return allBufferViewDescriptions;
+}
+
+const map<string, GlTfAccessorDescription>& GlTfJsonHandler::getAllAccessorDescriptions() const
+{
+	return allAccessorDescriptions;
+}
+
+//
+
+bool GlTfJsonHandler::beginObject()
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.beginObject());
+	}
+
+	if (skipDepth > 0)
+	{
+		skipDepth++;
+
+		return true;
+	}
+
+	switch (depth)
+	{
+		case 0:
+		case 1:
+			depth++;
+			return true;
+		case 2:
+			depth++;
+			return beginEntry();
+		default:
+			skipDepth = 1;
+			return true;
+	}
+}
+
+bool GlTfJsonHandler::key(const string& key)
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.key(key));
+	}
+
+	if (skipDepth > 0)
+	{
+		return true;
+	}
+
+	switch (depth)
+	{
+		case 1:
+			if (key == "buffers")
+			{
+				section = GLTF_SECTION_BUFFERS;
+			}
+			else if (key == "bufferViews")
+			{
+				section = GLTF_SECTION_BUFFER_VIEWS;
+			}
+			else if (key == "accessors")
+			{
+				section = GLTF_SECTION_ACCESSORS;
+			}
+			else
+			{
+				section = GLTF_SECTION_DOM;
+
+				sectionKey = key;
+			}
+			return true;
+		case 2:
+			currentId = key;
+			return true;
+		default:
+			currentField = key;
+			return true;
+	}
+}
+
+bool GlTfJsonHandler::endObject()
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.endObject());
+	}
+
+	if (skipDepth > 0)
+	{
+		skipDepth--;
+
+		return true;
+	}
+
+	switch (depth)
+	{
+		case 3:
+			endEntry();
+			break;
+		case 2:
+			section = GLTF_SECTION_NONE;
+			break;
+		default:
+			break;
+	}
+
+	depth--;
+
+	return true;
+}
+
+bool GlTfJsonHandler::beginArray()
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.beginArray());
+	}
+
+	if (skipDepth > 0)
+	{
+		skipDepth++;
+
+		return true;
+	}
+
+	if (depth < 3)
+	{
+		return false;
+	}
+
+	skipDepth = 1;
+
+	return true;
+}
+
+bool GlTfJsonHandler::endArray()
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.endArray());
+	}
+
+	skipDepth--;
+
+	return true;
+}
+
+bool GlTfJsonHandler::stringValue(const string& value)
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.stringValue(value));
+	}
+
+	if (skipDepth > 0)
+	{
+		return true;
+	}
+
+	return depth == 3 && setField(value);
+}
+
+bool GlTfJsonHandler::floatValue(float value)
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.floatValue(value));
+	}
+
+	if (skipDepth > 0)
+	{
+		return true;
+	}
+
+	return depth == 3 && setField(static_cast<int32_t>(value));
+}
+
+bool GlTfJsonHandler::integerValue(int32_t value)
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.integerValue(value));
+	}
+
+	if (skipDepth > 0)
+	{
+		return true;
+	}
+
+	return depth == 3 && setField(value);
+}
+
+bool GlTfJsonHandler::trueValue()
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.trueValue());
+	}
+
+	if (skipDepth > 0)
+	{
+		return true;
+	}
+
+	return depth == 3 && setField(true);
+}
+
+bool GlTfJsonHandler::falseValue()
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.falseValue());
+	}
+
+	if (skipDepth > 0)
+	{
+		return true;
+	}
+
+	return depth == 3 && setField(false);
+}
+
+bool GlTfJsonHandler::nullValue()
+{
+	if (section == GLTF_SECTION_DOM)
+	{
+		return forward(domBuilder.nullValue());
+	}
+
+	return skipDepth > 0 || depth == 3;
+}
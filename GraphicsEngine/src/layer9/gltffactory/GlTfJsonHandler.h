@@ -0,0 +1,136 @@
+/*
+ * GlTfJsonHandler.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: nopper
+ */
+
+#ifndef GLTFJSONHANDLER_H_
+#define GLTFJSONHANDLER_H_
+
+#include "../../UsedLibs.h"
+
+#include "../../layer0/json/JSONdomBuilder.h"
+#include "../../layer0/json/JSONhandler.h"
+
+// Integer fields, which are not in the glTF, are -1.
+
+struct GlTfBufferDescription
+{
+	std::string uri;
+	std::int32_t byteLength;
+};
+
+struct GlTfBufferViewDescription
+{
+	std::string buffer;
+	std::int32_t byteOffset;
+	std::int32_t byteLength;
+	GLenum target;
+};
+
+struct GlTfAccessorDescription
+{
+	std::string bufferView;
+	std::int32_t byteOffset;
+	std::int32_t byteStride;
+	GLenum componentType;
+	std::int32_t count;
+	std::string type;
+	bool normalized;
+};
+
+/**
+ * Fills the buffer, buffer view and accessor tables directly out of the JSONreader events. Only the other top level
+ * properties are built as JSON values.
+ */
+class GlTfJsonHandler : public JSONhandler
+{
+
+private:
+
+	enum GlTfSection
+	{
+		GLTF_SECTION_NONE,
+		GLTF_SECTION_DOM,
+		GLTF_SECTION_BUFFERS,
+		GLTF_SECTION_BUFFER_VIEWS,
+		GLTF_SECTION_ACCESSORS
+	};
+
+	GlTfSection section;
+
+	// 1 is the glTF object, 2 a table and 3 an entry of a table.
+	std::int32_t depth;
+
+	// Nested values in table entries are not needed.
+	std::int32_t skipDepth;
+
+	std::string sectionKey;
+	std::string currentId;
+	std::string currentField;
+
+	GlTfBufferDescription currentBuffer;
+	GlTfBufferViewDescription currentBufferView;
+	GlTfAccessorDescription currentAccessor;
+
+	JSONdomBuilder domBuilder;
+
+	JSONobjectSP jsonGlTf;
+
+	std::map<std::string, GlTfBufferDescription> allBufferDescriptions;
+	std::map<std::string, GlTfBufferViewDescription> allBufferViewDescriptions;
+	std::map<std::string, GlTfAccessorDescription> allAccessorDescriptions;
+
+	bool forward(bool result);
+
+	bool beginEntry();
+
+	void endEntry();
+
+	bool setField(const std::string& value);
+
+	bool setField(std::int32_t value);
+
+	bool setField(bool value);
+
+public:
+
+	GlTfJsonHandler();
+	virtual ~GlTfJsonHandler();
+
+	void reset();
+
+	const JSONobjectSP& getJsonGlTf() const;
+
+	const std::map<std::string, GlTfBufferDescription>& getAllBufferDescriptions() const;
+	const std::map<std::string, GlTfBufferViewDescription>& getAllBufferViewDescriptions() const;
+	const std::map<std::string, GlTfAccessorDescription>& getAllAccessorDescriptions() const;
+
+	//
+
+	virtual bool beginObject();
+
+	virtual bool key(const std::string& key);
+
+	virtual bool endObject();
+
+	virtual bool beginArray();
+
+	virtual bool endArray();
+
+	virtual bool stringValue(const std::string& value);
+
+	virtual bool floatValue(float value);
+
+	virtual bool integerValue(std::int32_t value);
+
+	virtual bool trueValue();
+
+	virtual bool falseValue();
+
+	virtual bool nullValue();
+
+};
+
+#endif /* GLTFJSONHANDLER_H_ */